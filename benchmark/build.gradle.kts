@@ -0,0 +1,45 @@
+plugins {
+    alias(libs.plugins.android.library)
+    alias(libs.plugins.androidx.benchmark)
+}
+
+android {
+    namespace = "com.hyntix.pdfium.benchmark"
+    compileSdk = 36
+
+    defaultConfig {
+        minSdk = 26
+
+        testInstrumentationRunner = "androidx.benchmark.junit4.AndroidBenchmarkRunner"
+
+        ndk {
+            abiFilters += listOf("arm64-v8a")
+        }
+    }
+
+    // Benchmarks must run against an optimized, non-debuggable build
+    testBuildType = "release"
+
+    sourceSets {
+        getByName("androidTest") {
+            java.srcDirs("../src/androidTest/shared")
+        }
+    }
+
+    buildTypes {
+        release {
+            isDefault = true
+        }
+    }
+
+    compileOptions {
+        sourceCompatibility = JavaVersion.VERSION_21
+        targetCompatibility = JavaVersion.VERSION_21
+    }
+}
+
+dependencies {
+    androidTestImplementation(project(":"))
+    androidTestImplementation(libs.androidx.benchmark.junit4)
+    androidTestImplementation(libs.androidx.junit)
+}
@@ -0,0 +1,46 @@
+package com.hyntix.pdfium.benchmark
+
+import androidx.benchmark.junit4.BenchmarkRule
+import androidx.benchmark.junit4.measureRepeated
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.hyntix.pdfium.PdfiumCore
+import com.hyntix.pdfium.utils.PdfTestDataGenerator
+import org.junit.After
+import org.junit.Before
+import org.junit.Rule
+import org.junit.Test
+import org.junit.runner.RunWith
+
+/**
+ * Benchmarks for reading AcroForm field values.
+ */
+@RunWith(AndroidJUnit4::class)
+class FormBenchmark {
+
+    @get:Rule
+    val benchmarkRule = BenchmarkRule()
+
+    private lateinit var core: PdfiumCore
+    private lateinit var data: ByteArray
+
+    @Before
+    fun setUp() {
+        core = PdfiumCore()
+        core.initLibrary()
+        data = PdfTestDataGenerator.generateFormPdf()
+    }
+
+    @After
+    fun tearDown() {
+        core.destroyLibrary()
+    }
+
+    @Test
+    fun exportFormData() {
+        benchmarkRule.measureRepeated {
+            core.openDocument(data)!!.use { doc ->
+                doc.getFormData()
+            }
+        }
+    }
+}
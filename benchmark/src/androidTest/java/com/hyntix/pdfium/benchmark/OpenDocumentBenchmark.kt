@@ -0,0 +1,74 @@
+package com.hyntix.pdfium.benchmark
+
+import androidx.benchmark.junit4.BenchmarkRule
+import androidx.benchmark.junit4.measureRepeated
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import androidx.test.platform.app.InstrumentationRegistry
+import com.hyntix.pdfium.DocumentLoadMode
+import com.hyntix.pdfium.PdfiumCore
+import com.hyntix.pdfium.utils.PdfTestDataGenerator
+import org.junit.After
+import org.junit.Before
+import org.junit.Rule
+import org.junit.Test
+import org.junit.runner.RunWith
+import java.io.File
+
+/**
+ * Benchmarks for opening and closing documents through each load path.
+ */
+@RunWith(AndroidJUnit4::class)
+class OpenDocumentBenchmark {
+
+    @get:Rule
+    val benchmarkRule = BenchmarkRule()
+
+    private lateinit var core: PdfiumCore
+    private lateinit var data: ByteArray
+    private lateinit var file: File
+
+    @Before
+    fun setUp() {
+        core = PdfiumCore()
+        core.initLibrary()
+        data = PdfTestDataGenerator.generateTextPdf(pageCount = 50)
+        file = File(InstrumentationRegistry.getInstrumentation().targetContext.cacheDir, "open_benchmark.pdf")
+        file.writeBytes(data)
+    }
+
+    @After
+    fun tearDown() {
+        file.delete()
+        core.destroyLibrary()
+    }
+
+    @Test
+    fun openFromBytes() {
+        benchmarkRule.measureRepeated {
+            core.openDocument(data)!!.close()
+        }
+    }
+
+    @Test
+    fun openFromPathStreaming() {
+        benchmarkRule.measureRepeated {
+            core.openDocument(file.path, loadMode = DocumentLoadMode.STREAMING)!!.close()
+        }
+    }
+
+    @Test
+    fun openFromPathInMemory() {
+        benchmarkRule.measureRepeated {
+            core.openDocument(file.path, loadMode = DocumentLoadMode.IN_MEMORY)!!.close()
+        }
+    }
+
+    @Test
+    fun openFirstPage() {
+        benchmarkRule.measureRepeated {
+            core.openDocument(data)!!.use { doc ->
+                doc.openPage(0).close()
+            }
+        }
+    }
+}
@@ -0,0 +1,63 @@
+package com.hyntix.pdfium.benchmark
+
+import android.graphics.Bitmap
+import androidx.benchmark.junit4.BenchmarkRule
+import androidx.benchmark.junit4.measureRepeated
+import com.hyntix.pdfium.PdfDocument
+import com.hyntix.pdfium.PdfPage
+import com.hyntix.pdfium.PdfiumCore
+import com.hyntix.pdfium.utils.PdfTestDataGenerator
+import org.junit.After
+import org.junit.Before
+import org.junit.Rule
+import org.junit.Test
+import org.junit.runner.RunWith
+import org.junit.runners.Parameterized
+
+/**
+ * Benchmarks for rasterizing a text page at common output resolutions.
+ */
+@RunWith(Parameterized::class)
+class RenderBenchmark(private val dpi: Int) {
+
+    companion object {
+        @JvmStatic
+        @Parameterized.Parameters(name = "dpi={0}")
+        fun parameters(): List<Int> = listOf(72, 150, 300)
+    }
+
+    @get:Rule
+    val benchmarkRule = BenchmarkRule()
+
+    private lateinit var core: PdfiumCore
+    private lateinit var document: PdfDocument
+    private lateinit var page: PdfPage
+    private lateinit var bitmap: Bitmap
+
+    @Before
+    fun setUp() {
+        core = PdfiumCore()
+        core.initLibrary()
+        document = core.openDocument(PdfTestDataGenerator.generateTextPdf(pageCount = 1))!!
+        page = document.openPage(0)
+        // Page sizes are in points (1/72 inch)
+        val width = (page.width * dpi / 72).toInt()
+        val height = (page.height * dpi / 72).toInt()
+        bitmap = Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888)
+    }
+
+    @After
+    fun tearDown() {
+        bitmap.recycle()
+        page.close()
+        document.close()
+        core.destroyLibrary()
+    }
+
+    @Test
+    fun renderPage() {
+        benchmarkRule.measureRepeated {
+            page.render(bitmap)
+        }
+    }
+}
@@ -0,0 +1,65 @@
+package com.hyntix.pdfium.benchmark
+
+import androidx.benchmark.junit4.BenchmarkRule
+import androidx.benchmark.junit4.measureRepeated
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.hyntix.pdfium.PdfDocument
+import com.hyntix.pdfium.PdfiumCore
+import com.hyntix.pdfium.utils.PdfTestDataGenerator
+import org.junit.After
+import org.junit.Before
+import org.junit.Rule
+import org.junit.Test
+import org.junit.runner.RunWith
+
+/**
+ * Benchmarks for text extraction and search across a multi-page corpus.
+ */
+@RunWith(AndroidJUnit4::class)
+class TextBenchmark {
+
+    @get:Rule
+    val benchmarkRule = BenchmarkRule()
+
+    private lateinit var core: PdfiumCore
+    private lateinit var document: PdfDocument
+
+    @Before
+    fun setUp() {
+        core = PdfiumCore()
+        core.initLibrary()
+        document = core.openDocument(PdfTestDataGenerator.generateTextPdf(pageCount = 20))!!
+    }
+
+    @After
+    fun tearDown() {
+        document.close()
+        core.destroyLibrary()
+    }
+
+    @Test
+    fun extractAllText() {
+        benchmarkRule.measureRepeated {
+            for (i in 0 until document.pageCount) {
+                document.openPage(i).use { page ->
+                    page.openTextPage().use { text ->
+                        text.extractText(0, text.charCount)
+                    }
+                }
+            }
+        }
+    }
+
+    @Test
+    fun searchAllPages() {
+        benchmarkRule.measureRepeated {
+            for (i in 0 until document.pageCount) {
+                document.openPage(i).use { page ->
+                    page.openTextPage().use { text ->
+                        text.search("lazy dog")
+                    }
+                }
+            }
+        }
+    }
+}
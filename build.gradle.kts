@@ -30,6 +30,8 @@ android {
     sourceSets {
         getByName("androidTest") {
             assets.srcDirs("src/androidTest/assets")
+            // Generators shared with the :benchmark module
+            java.srcDirs("src/androidTest/shared")
         }
     }
 
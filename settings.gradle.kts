@@ -21,3 +21,4 @@ dependencyResolutionManagement {
 
 rootProject.name = "KotlinPdfium"
 include(":")
+include(":benchmark")
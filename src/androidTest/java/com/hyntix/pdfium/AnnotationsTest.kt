@@ -22,6 +22,7 @@ import org.junit.runner.RunWith
  * - Annotation modification and deletion
  * - Annotation persistence across sessions
  * - Edge cases and error handling
+ * - Bulk link maps and JVM-side link hit testing
  * 
  * Score Target: Annotations 95/100 → 100/100
  */
@@ -467,4 +468,154 @@ class AnnotationsTest {
         val colorWithAlpha = AnnotationColor.fromRGBA(255, 128, 64, 200)
         assertEquals("Alpha should be 200", 200, colorWithAlpha.alpha)
     }
+    
+    /**
+     * Test reading every annotation of a page in one native call.
+     * Verifies the requested property groups are decoded and the rest default.
+     */
+    @Test
+    fun testBatchAnnotationRead() {
+        core.initLibrary()
+        document = core.openDocument(PdfTestDataGenerator.generateAnnotatedPdf())
+        assertNotNull("Document should be opened", document)
+        
+        document!!.openPage(0).use { page ->
+            val annotations = page.getAllAnnotations()
+            assertEquals(1, annotations.size)
+            val annotation = annotations[0]
+            assertEquals(0, annotation.index)
+            assertEquals(AnnotationType.TEXT, annotation.type)
+            assertEquals("Test annotation", annotation.contents)
+            assertEquals(RectF(100f, 720f, 120f, 700f), annotation.rect)
+            assertEquals(255, annotation.color.red)
+            assertEquals(255, annotation.color.green)
+            assertEquals(0, annotation.color.blue)
+            assertEquals(1.0f, annotation.opacity, 0.001f)
+            
+            val rectsOnly = page.getAllAnnotations(PageAnnotation.FIELD_RECT)
+            assertEquals(annotation.rect, rectsOnly[0].rect)
+            assertEquals("", rectsOnly[0].contents)
+            
+            val legacy = page.getAnnotations()
+            assertEquals(PdfAnnotation.SUBTYPE_TEXT, legacy[0].subtype)
+            assertEquals(annotation.rect, legacy[0].rect)
+        }
+    }
+    
+    /**
+     * Test queued annotation edits applied in one commit.
+     * Verifies updates keep their original indices and creates append.
+     */
+    @Test
+    fun testAnnotationTransaction() {
+        core.initLibrary()
+        document = core.openDocument(PdfTestDataGenerator.generateAnnotatedPdf())
+        assertNotNull("Document should be opened", document)
+        
+        document!!.openPage(0).use { page ->
+            val quad = doubleArrayOf(50.0, 720.0, 150.0, 720.0, 50.0, 700.0, 150.0, 700.0)
+            val stroke = InkPath(listOf(doubleArrayOf(10.0, 10.0), doubleArrayOf(20.0, 30.0)))
+            val applied = page.beginAnnotationTransaction()
+                .update(0, AnnotationChanges(contents = "Edited", author = "Reviewer"))
+                .createHighlight(listOf(quad), contents = "First")
+                .createInk(listOf(stroke))
+                .commit()
+            assertEquals(3, applied)
+            
+            val annotations = page.getAllAnnotations()
+            assertEquals(3, annotations.size)
+            assertEquals("Edited", annotations[0].contents)
+            assertEquals("Reviewer", annotations[0].author)
+            assertEquals(AnnotationType.HIGHLIGHT, annotations[1].type)
+            assertEquals("First", annotations[1].contents)
+            assertEquals(1, annotations[1].quadPoints.size)
+            assertEquals(AnnotationType.INK, annotations[2].type)
+            assertEquals(2, annotations[2].inkList.single().points.size)
+            
+            val removed = page.beginAnnotationTransaction()
+                .remove(0)
+                .remove(2)
+                .commit()
+            assertEquals(2, removed)
+            assertEquals(AnnotationType.HIGHLIGHT, page.getAllAnnotations().single().type)
+        }
+    }
+    
+    /**
+     * Test flat ink stroke reads, writes and appends.
+     * Verifies strokes round-trip through the point and offset arrays.
+     */
+    @Test
+    fun testFlatInkStrokes() {
+        core.initLibrary()
+        document = core.openDocument(PdfTestDataGenerator.generateAnnotatedPdf())
+        assertNotNull("Document should be opened", document)
+        
+        document!!.openPage(0).use { page ->
+            val stroke = InkPath(listOf(doubleArrayOf(10.0, 10.0), doubleArrayOf(20.0, 30.0)))
+            assertTrue(page.createInkAnnotation(listOf(stroke)))
+            val index = page.getAllAnnotations(PageAnnotation.FIELD_RECT).lastIndex
+            
+            val ink = page.getInkStrokes(index)
+            assertNotNull(ink)
+            assertEquals(1, ink!!.strokeCount)
+            assertEquals(2, ink.getPointCount(0))
+            assertEquals(20f, ink.getX(0, 1), 0.001f)
+            assertEquals(30f, ink.getY(0, 1), 0.001f)
+            
+            // Second stroke taken from the middle of a reused buffer
+            val buffer = floatArrayOf(0f, 0f, 40f, 40f, 50f, 60f, 70f, 80f)
+            assertEquals(1, page.appendInkStroke(index, buffer, start = 1, count = 3))
+            val appended = page.getInkStrokes(index)!!
+            assertArrayEquals(intArrayOf(0, 2, 5), appended.offsets)
+            assertEquals(40f, appended.getX(1, 0), 0.001f)
+            
+            val replacement = InkStrokes(floatArrayOf(1f, 2f, 3f, 4f), intArrayOf(0, 2))
+            assertTrue(page.setInkStrokes(index, replacement))
+            assertArrayEquals(replacement.points, page.getInkStrokes(index)!!.points, 0.001f)
+        }
+    }
+    
+    /**
+     * Test reading all links of a page in one call and hit testing them on the JVM.
+     * Verifies actions, targets, web links and tap priority.
+     */
+    @Test
+    fun testLinkMapHitTest() {
+        core.initLibrary()
+        document = core.openDocument(PdfTestDataGenerator.generateLinkPdf())
+        assertNotNull("Document should be opened", document)
+        
+        document!!.openPage(0).use { page ->
+            val map = page.getLinkMap()
+            val annotationLinks = map.links.filter { !it.isWebLink }
+            assertEquals(2, annotationLinks.size)
+            
+            val goTo = annotationLinks[0]
+            assertEquals(1, goTo.destPageIndex)
+            assertEquals(PdfLink.ACTION_GOTO, goTo.actionType)
+            assertEquals(RectF(50f, 720f, 250f, 700f), goTo.rect)
+            
+            val uri = annotationLinks[1]
+            assertEquals(PdfLink.ACTION_URI, uri.actionType)
+            assertEquals("https://example.com", uri.uri)
+            assertEquals(-1, uri.destPageIndex)
+            
+            val web = map.links.singleOrNull { it.isWebLink }
+            assertNotNull("URL in the text should be detected", web)
+            assertEquals("https://www.example.org", web!!.uri)
+            assertTrue(web.rects.isNotEmpty())
+            
+            assertSame(goTo, map.hitTest(100f, 710f))
+            assertSame(uri, map.hitTest(100f, 610f))
+            assertNull(map.hitTest(100f, 650f))
+            assertSame("Tolerance should reach a nearby link", uri, map.hitTest(100f, 625f, tolerance = 8f))
+            val webCenter = web.rects[0]
+            assertSame(web, map.hitTest(webCenter.centerX(), (webCenter.top + webCenter.bottom) / 2))
+            
+            // getLinks keeps returning annotation links only, as before
+            assertEquals(annotationLinks, page.getLinks())
+            assertEquals(2, page.getLinkMap(includeWebLinks = false).size)
+        }
+    }
 }
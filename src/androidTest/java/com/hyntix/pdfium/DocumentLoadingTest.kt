@@ -0,0 +1,254 @@
+package com.hyntix.pdfium
+
+import android.os.ParcelFileDescriptor
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.hyntix.pdfium.utils.PdfTestDataGenerator
+import com.hyntix.pdfium.utils.TestUtils
+import org.junit.After
+import org.junit.Assert.*
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+
+/**
+ * Instrumentation tests for document loading.
+ *
+ * Tests cover:
+ * - Streaming (custom document) and in-memory loading from paths and descriptors
+ * - Descriptor ownership for streaming opens
+ * - Failure on missing files
+ * - Progressive loading through a range fetcher
+ * - Zero-copy opens from direct and native buffers
+ * - Concurrent opens and closes
+ * - Outline snapshots and the table of contents built from them
+ */
+@RunWith(AndroidJUnit4::class)
+class DocumentLoadingTest {
+
+    private lateinit var core: PdfiumCore
+
+    @Before
+    fun setUp() {
+        core = PdfiumCore()
+        core.initLibrary()
+    }
+
+    @After
+    fun tearDown() {
+        core.destroyLibrary()
+    }
+
+    /**
+     * Both load modes should produce the same document from a path.
+     */
+    @Test
+    fun testOpenPathStreamingMatchesInMemory() {
+        val pdfFile = TestUtils.createTempPdf(PdfTestDataGenerator.generateSimplePdf())
+
+        try {
+            val streamed = core.openDocument(pdfFile.absolutePath)
+            val inMemory = core.openDocument(pdfFile.absolutePath, loadMode = DocumentLoadMode.IN_MEMORY)
+            assertNotNull("Streaming open should succeed", streamed)
+            assertNotNull("In-memory open should succeed", inMemory)
+
+            assertEquals(inMemory!!.pageCount, streamed!!.pageCount)
+            assertEquals(inMemory.getPageSize(0), streamed.getPageSize(0))
+
+            streamed.close()
+            inMemory.close()
+        } finally {
+            TestUtils.cleanupFiles(pdfFile)
+        }
+    }
+
+    /**
+     * A streamed document keeps its own descriptor, so it stays usable
+     * after the caller closes the one it passed in.
+     */
+    @Test
+    fun testOpenFdStreamingSurvivesCallerClose() {
+        val pdfFile = TestUtils.createTempPdf(PdfTestDataGenerator.generateSimplePdf())
+
+        try {
+            val pfd = ParcelFileDescriptor.open(pdfFile, ParcelFileDescriptor.MODE_READ_ONLY)
+            val document = core.openDocument(pfd.fd)
+            pfd.close()
+
+            assertNotNull("Streaming open should succeed", document)
+            document!!.openPage(0).use { page ->
+                assertTrue("Page should have a width", page.width > 0)
+            }
+            document.close()
+        } finally {
+            TestUtils.cleanupFiles(pdfFile)
+        }
+    }
+
+    /**
+     * Streaming open of a path that does not exist returns null.
+     */
+    @Test
+    fun testOpenMissingPathFails() {
+        val missing = TestUtils.getTestContext().cacheDir.resolve("does_not_exist.pdf").absolutePath
+        assertNull(core.openDocument(missing))
+    }
+
+    /**
+     * A document served through a range fetcher opens, and its pages become
+     * available on demand without fetching past the end of the file.
+     */
+    @Test
+    fun testOpenProgressiveFromRangeFetcher() {
+        val pdfBytes = PdfTestDataGenerator.generateSimplePdf()
+        var fetchCount = 0
+        val fetcher = PdfRangeFetcher { position, size ->
+            fetchCount++
+            assertTrue("Fetch must stay within the file", position + size <= pdfBytes.size)
+            pdfBytes.copyOfRange(position.toInt(), position.toInt() + size)
+        }
+
+        val document = core.openDocument(fetcher, pdfBytes.size.toLong())
+        assertNotNull("Progressive open should succeed", document)
+        assertTrue(document!!.isProgressive)
+        assertTrue("At least one range should have been fetched", fetchCount > 0)
+
+        assertTrue(document.ensurePageAvailable(0))
+        assertTrue(document.isPageAvailable(0))
+        document.openPage(0).use { page ->
+            assertTrue("Page should have a width", page.width > 0)
+        }
+        document.close()
+    }
+
+    /**
+     * A fetcher that cannot deliver data makes the open fail cleanly.
+     */
+    @Test
+    fun testOpenProgressiveFailingFetcher() {
+        val document = core.openDocument(PdfRangeFetcher { _, _ -> null }, 4096L)
+        assertNull(document)
+    }
+
+    /**
+     * A direct ByteBuffer is parsed in place, honoring its position and limit.
+     */
+    @Test
+    fun testOpenDirectByteBuffer() {
+        val pdfBytes = PdfTestDataGenerator.generateSimplePdf()
+        val buffer = java.nio.ByteBuffer.allocateDirect(pdfBytes.size + 16)
+        buffer.position(16)
+        buffer.put(pdfBytes)
+        buffer.position(16)
+
+        val document = core.openDocument(buffer)
+        assertNotNull("Direct buffer open should succeed", document)
+        assertTrue(document!!.pageCount > 0)
+        document.close()
+    }
+
+    /**
+     * A stream read into a native buffer is owned by the document after opening.
+     */
+    @Test
+    fun testOpenFromStreamTransfersOwnership() {
+        val pdfBytes = PdfTestDataGenerator.generateSimplePdf()
+
+        val document = core.openDocument(pdfBytes.inputStream(), pdfBytes.size)
+        assertNotNull("Stream open should succeed", document)
+        assertTrue(document!!.pageCount > 0)
+        document.close()
+
+        val nativeBuffer = core.allocateBuffer(pdfBytes.size)!!
+        nativeBuffer.buffer.put(pdfBytes).flip()
+        val owned = core.openDocument(nativeBuffer)
+        assertNotNull(owned)
+        assertTrue("Ownership should move to the document", nativeBuffer.isReleased)
+        owned!!.close()
+    }
+
+    /**
+     * A stream shorter than the declared length fails without leaking.
+     */
+    @Test
+    fun testOpenFromTruncatedStreamFails() {
+        val pdfBytes = PdfTestDataGenerator.generateSimplePdf()
+        assertNull(core.openDocument(pdfBytes.inputStream(), pdfBytes.size + 100))
+    }
+
+    /**
+     * Opening, reading and closing documents from many threads at once
+     * must not corrupt native state.
+     */
+    @Test
+    fun testConcurrentOpenAndClose() {
+        val pdfBytes = PdfTestDataGenerator.generateSimplePdf()
+        val failures = java.util.concurrent.atomic.AtomicInteger()
+        val threads = (0 until 8).map {
+            Thread {
+                repeat(25) {
+                    val document = core.openDocument(pdfBytes)
+                    if (document == null || document.pageCount <= 0) failures.incrementAndGet()
+                    document?.close()
+                }
+            }
+        }
+        threads.forEach { it.start() }
+        threads.forEach { it.join() }
+
+        assertEquals("All concurrent opens should succeed", 0, failures.get())
+    }
+
+    /**
+     * The flattened outline should keep preorder, nesting and destinations,
+     * and the eager table of contents should match it.
+     */
+    @Test
+    fun testOutlineSnapshot() {
+        val document = core.openDocument(PdfTestDataGenerator.generateOutlinePdf())
+        assertNotNull("Document should open", document)
+
+        val outline = document!!.getOutline()
+        assertEquals(6, outline.size)
+        assertEquals(listOf("Chapter 1", "Chapter 2", "Appendix"), outline.roots.map { it.title })
+
+        val chapter1 = outline.roots[0]
+        assertEquals(0, chapter1.pageIndex)
+        assertEquals(2, chapter1.descendantCount)
+        assertEquals(listOf("Section 1.1", "Section 1.2"), chapter1.children.map { it.title })
+        assertEquals(listOf(1, 2), chapter1.children.map { it.pageIndex })
+        assertEquals(1, chapter1.children[1].depth)
+        assertEquals(chapter1, chapter1.children[1].parent)
+
+        val chapter2 = outline.roots[1]
+        assertFalse(chapter2.hasChildren)
+        assertTrue(chapter2.children.isEmpty())
+
+        val appendix = outline.roots[2]
+        assertFalse("Appendix has no destination", appendix.hasDestination())
+        assertEquals("Notes", appendix.children.single().title)
+        assertEquals(3, appendix.children.single().pageIndex)
+        assertNull(appendix.parent)
+
+        val toc = document.getTableOfContents()
+        assertEquals(outline.roots.map { it.title }, toc.map { it.title })
+        assertEquals(listOf(1L, 2L), toc[0].children.map { it.pageIndex })
+        assertEquals(-1L, toc[2].pageIndex)
+        assertEquals("Notes", toc[2].children.single().title)
+
+        document.close()
+
+        // The snapshot does not depend on the document
+        assertEquals("Section 1.2", outline.getNode(2).title)
+    }
+
+    /**
+     * Documents without bookmarks give an empty outline.
+     */
+    @Test
+    fun testOutlineEmpty() {
+        val document = core.openDocument(PdfTestDataGenerator.generateSimplePdf())!!
+        assertTrue(document.getOutline().isEmpty())
+        assertTrue(document.getTableOfContents().isEmpty())
+        document.close()
+    }
+}
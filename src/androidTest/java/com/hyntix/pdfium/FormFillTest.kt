@@ -1,5 +1,9 @@
 package com.hyntix.pdfium
 
+import android.graphics.Bitmap
+import android.graphics.Color
+import android.graphics.Rect
+import android.os.ParcelFileDescriptor
 import androidx.test.ext.junit.runners.AndroidJUnit4
 import com.hyntix.pdfium.form.*
 import com.hyntix.pdfium.utils.PdfTestDataGenerator
@@ -623,4 +627,201 @@ class FormFillTest {
         assertTrue("Item 2 should be selected", options[1].isSelected)
         assertFalse("Item 3 should not be selected", options[2].isSelected)
     }
+    
+    /**
+     * Test native snapshot export and batch restore.
+     * Verifies one-call export sees every widget and restore writes values back.
+     */
+    @Test
+    fun testNativeSnapshotRoundTrip() {
+        core.initLibrary()
+        document = core.openDocument(PdfTestDataGenerator.generateFormPdf())
+        assertNotNull("Document should be opened", document)
+        form = document!!.initForm()
+        assertNotNull("Form should be created", form)
+        
+        val snapshot = form!!.exportFormData()
+        assertEquals(listOf("textfield1", "checkbox1"), snapshot.fields.map { it.name })
+        val text = snapshot.fields.first { it.name == "textfield1" }
+        assertEquals(FormFieldType.TEXTFIELD, text.type)
+        assertEquals("Default Text", text.value)
+        
+        val edited = snapshot.copy(fields = snapshot.fields.map {
+            if (it.name == "textfield1") it.copy(value = "Changed") else it
+        })
+        assertTrue(form!!.restoreFromSnapshot(edited))
+        assertEquals("Changed", form!!.exportFormData().fields.first { it.name == "textfield1" }.value)
+    }
+    
+    /**
+     * Test field lookups by name through the field-name index.
+     * Verifies reads, writes and validation address a single field.
+     */
+    @Test
+    fun testFieldNameIndexLookups() {
+        core.initLibrary()
+        document = core.openDocument(PdfTestDataGenerator.generateFormPdf())
+        form = document!!.initForm()
+        assertNotNull("Form should be created", form)
+        
+        assertEquals(listOf(FormFieldWidget(0, 0)), form!!.findWidgets("textfield1"))
+        assertEquals(listOf(FormFieldWidget(0, 1)), form!!.findWidgets("checkbox1"))
+        assertTrue(form!!.findWidgets("missing").isEmpty())
+        assertNull(form!!.getFieldData("missing"))
+        
+        assertTrue(form!!.setFieldValue("textfield1", "Indexed"))
+        assertEquals("Indexed", form!!.getFieldData("textfield1")?.value)
+        assertFalse(form!!.setFieldValue("missing", "x"))
+        
+        document!!.openPage(0).use { page ->
+            val field = page.getFormFieldByName(form!!.formPtr, "checkbox1")
+            assertNotNull(field)
+            assertEquals(FormFieldType.CHECKBOX, field!!.type)
+            page.closeFormField(field)
+        }
+        
+        form!!.close()
+        form = null
+        assertTrue(document!!.validateFormField("textfield1").isValid)
+        assertFalse(document!!.validateFormField("missing").isValid)
+    }
+    
+    /**
+     * Test the field-name index after pages holding a field's widgets change.
+     * Verifies re-indexed widgets keep their document order.
+     */
+    @Test
+    fun testFieldNameIndexKeepsWidgetOrder() {
+        core.initLibrary()
+        document = core.openDocument(PdfTestDataGenerator.generateMultiPageFormPdf(pageCount = 3))
+        form = document!!.initForm()
+        assertNotNull("Form should be created", form)
+        
+        val expected = listOf(FormFieldWidget(0, 0), FormFieldWidget(1, 0), FormFieldWidget(2, 0))
+        assertEquals(expected, form!!.findWidgets("shared"))
+        
+        for (pageIndex in listOf(1, 0)) {
+            document!!.openPage(pageIndex).use { page -> core.setPageRotation(page.getPointer(), 1) }
+            assertEquals(expected, form!!.findWidgets("shared"))
+            assertEquals("Shared Text", form!!.getFieldData("shared")?.value)
+        }
+    }
+    
+    /**
+     * Test saving a form edit as an incremental update in place.
+     * Verifies only the delta is appended, a second save replaces it and the
+     * edits survive a reopen.
+     */
+    @Test
+    fun testIncrementalSaveInPlace() {
+        core.initLibrary()
+        val original = PdfTestDataGenerator.generateFormPdf()
+        val pdfFile = TestUtils.createTempPdf(original)
+        
+        try {
+            ParcelFileDescriptor.open(pdfFile, ParcelFileDescriptor.MODE_READ_WRITE).use { pfd ->
+                document = core.openDocument(pfd.fd)
+                form = document!!.initForm()
+                assertTrue(form!!.setFieldValue("textfield1", "Saved in place"))
+                
+                val appended = document!!.saveInPlace(pfd)
+                assertTrue("Delta should be appended", appended > 0)
+                assertEquals(original.size + appended, pdfFile.length())
+                
+                assertTrue(form!!.setFieldValue("textfield1", "Saved in place twice"))
+                val replaced = document!!.saveInPlace(pfd)
+                assertTrue("Second delta should be written", replaced > 0)
+                assertEquals(original.size + replaced, pdfFile.length())
+            }
+            val saved = pdfFile.readBytes()
+            assertArrayEquals(original, saved.copyOf(original.size))
+            
+            form!!.close()
+            document!!.close()
+            document = core.openDocument(saved)
+            form = document!!.initForm()
+            assertEquals("Saved in place twice", form!!.getFieldData("textfield1")?.value)
+            
+            val copy = java.io.ByteArrayOutputStream()
+            assertTrue(document!!.save(copy, PdfSaveMode.INCREMENTAL, blockSize = 1024))
+            assertArrayEquals(saved, copy.toByteArray().copyOf(saved.size))
+        } finally {
+            TestUtils.cleanupFiles(pdfFile)
+        }
+    }
+    
+    /**
+     * Test rendering content and form fields in one pass.
+     * Verifies it matches the two-call render and that a clip leaves the rest alone.
+     */
+    @Test
+    fun testRenderPageWithForm() {
+        core.initLibrary()
+        document = core.openDocument(PdfTestDataGenerator.generateFormPdf())
+        form = document!!.initForm()
+        assertNotNull(form)
+        
+        document!!.openPage(0).use { page ->
+            val combined = Bitmap.createBitmap(120, 160, Bitmap.Config.ARGB_8888)
+            val separate = Bitmap.createBitmap(120, 160, Bitmap.Config.ARGB_8888)
+            page.render(combined, form = form)
+            page.render(separate)
+            // FPDF_ANNOT | FPDF_REVERSE_BYTE_ORDER, as the combined render uses
+            core.renderFormBitmap(form!!.formPtr, separate, page.getPointer(), 0, 0, 120, 160, 0, 0x11)
+            assertTrue(combined.sameAs(separate))
+            
+            val clipped = Bitmap.createBitmap(120, 160, Bitmap.Config.ARGB_8888)
+            clipped.eraseColor(Color.RED)
+            page.render(clipped, form = form, clip = Rect(20, 30, 70, 90))
+            assertEquals(Color.RED, clipped.getPixel(10, 10))
+            assertEquals(Color.RED, clipped.getPixel(80, 100))
+            for (y in 30 until 90 step 6) {
+                for (x in 20 until 70 step 5) {
+                    assertEquals(combined.getPixel(x, y), clipped.getPixel(x, y))
+                }
+            }
+            
+            // Nothing has focus before any input
+            assertNull(page.getFocusedFieldBounds(form!!, 0, 0, 120, 160))
+            
+            combined.recycle()
+            separate.recycle()
+            clipped.recycle()
+        }
+    }
+    
+    /**
+     * Test that form input queues repaint areas for the page.
+     * Verifies a keystroke in a text field dirties that field and nothing stays queued.
+     */
+    @Test
+    fun testFormDirtyRects() {
+        core.initLibrary()
+        document = core.openDocument(PdfTestDataGenerator.generateFormPdf())
+        form = document!!.initForm()
+        assertNotNull(form)
+        
+        document!!.openPage(0).use { page ->
+            val width = (page.width / 2).toInt()
+            val height = (page.height / 2).toInt()
+            page.pollFormDirtyRects(0, 0, width, height)
+            
+            // textfield1 spans [50 700 250 720] in page space
+            form!!.onLButtonDown(page, 150.0, 710.0)
+            form!!.onLButtonUp(page, 150.0, 710.0)
+            form!!.onChar(page, 'X'.code)
+            
+            val dirty = page.pollFormDirtyRects(0, 0, width, height)
+            assertTrue("Edit should dirty the field", dirty.isNotEmpty())
+            val field = Rect()
+            page.mapRectToDevice(0, 0, width, height, android.graphics.RectF(50f, 720f, 250f, 700f)).roundOut(field)
+            assertTrue(dirty.any { Rect.intersects(it, field) })
+            assertTrue(page.pollFormDirtyRects(0, 0, width, height).isEmpty())
+            
+            val bitmap = Bitmap.createBitmap(width, height, Bitmap.Config.RGB_565)
+            page.render(bitmap, form = form)
+            dirty.forEach { page.render(bitmap, form = form, clip = it) }
+            bitmap.recycle()
+        }
+    }
 }
@@ -0,0 +1,172 @@
+package com.hyntix.pdfium
+
+import android.os.CancellationSignal
+import android.os.ParcelFileDescriptor
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.hyntix.pdfium.merge.PdfImposition
+import com.hyntix.pdfium.merge.PdfMergeEntry
+import com.hyntix.pdfium.merge.PdfMergeResult
+import com.hyntix.pdfium.merge.PdfMergeSource
+import com.hyntix.pdfium.merge.PdfMerger
+import com.hyntix.pdfium.merge.PdfSheetSlot
+import com.hyntix.pdfium.utils.PdfTestDataGenerator
+import com.hyntix.pdfium.utils.TestUtils
+import org.junit.After
+import org.junit.Assert.*
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+import java.io.File
+
+/**
+ * Instrumentation tests for manifest-driven document assembly.
+ *
+ * Tests cover:
+ * - Page selection, ordering and insert positions across sources
+ * - Lazy source opening and early release
+ * - Streaming the result to a descriptor
+ * - Failure and cancellation reporting
+ * - N-up, grid, booklet and custom imposition
+ */
+@RunWith(AndroidJUnit4::class)
+class MergeTest {
+
+    private lateinit var core: PdfiumCore
+
+    @Before
+    fun setUp() {
+        core = PdfiumCore()
+        core.initLibrary()
+    }
+
+    @After
+    fun tearDown() {
+        core.destroyLibrary()
+    }
+
+    /**
+     * Entries should land in manifest order at their insert positions,
+     * with each source opened once and released after its last entry.
+     */
+    @Test
+    fun testMergeManifestToDescriptor() {
+        val textFile = TestUtils.createTempPdf(PdfTestDataGenerator.generateTextPdf(pageCount = 5, linesPerPage = 1))
+        val simpleFile = TestUtils.createTempPdf(PdfTestDataGenerator.generateSimplePdf())
+        val output = File.createTempFile("merged", ".pdf")
+
+        try {
+            val text = PdfMergeSource.file(textFile)
+            val simple = PdfMergeSource.file(simpleFile)
+            val entries = listOf(
+                PdfMergeEntry.range(text, 0, 2),                        // text pages 1-3
+                PdfMergeEntry(simple),                                  // blank page at the end
+                PdfMergeEntry(text, intArrayOf(4), insertIndex = 0)     // text page 5 first
+            )
+
+            val progress = ArrayList<Int>()
+            val result = ParcelFileDescriptor.open(
+                output,
+                ParcelFileDescriptor.MODE_READ_WRITE or ParcelFileDescriptor.MODE_CREATE or ParcelFileDescriptor.MODE_TRUNCATE
+            ).use { pfd ->
+                PdfMerger(core).merge(entries, pfd, listener = { done, count, _ ->
+                    assertEquals(3, count)
+                    progress.add(done)
+                })
+            }
+
+            assertEquals(PdfMergeResult.Status.COMPLETED, result.status)
+            assertEquals(-1, result.failedEntry)
+            assertEquals(5, result.pagesImported)
+            assertEquals("Each source opens once", 2, result.sourcesOpened)
+            assertEquals("text stays open across the simple entry", 2, result.peakOpenSources)
+            assertEquals(listOf(1, 2, 3), progress)
+            assertTrue(result.saveNanos > 0)
+
+            val merged = core.openDocument(output.absolutePath)!!
+            assertEquals(5, merged.pageCount)
+            val firstLines = (0 until 4).map { index ->
+                merged.openPage(index).use { page ->
+                    page.openTextPage().use { it.text.substringBefore(" The") }
+                }
+            }
+            assertEquals(listOf("Page 5 line 1", "Page 1 line 1", "Page 2 line 1", "Page 3 line 1"), firstLines)
+            merged.close()
+        } finally {
+            TestUtils.cleanupFiles(textFile, simpleFile, output)
+        }
+    }
+
+    /**
+     * A bad entry or a cancelled signal should stop the run and say why.
+     */
+    @Test
+    fun testMergeFailureAndCancellation() {
+        val source = core.openDocument(PdfTestDataGenerator.generateSimplePdf())!!
+        val destination = core.newDocument()!!
+        val merger = PdfMerger(core)
+
+        val failed = merger.importInto(destination, listOf(
+            PdfMergeEntry(PdfMergeSource.document(source)),
+            PdfMergeEntry(PdfMergeSource.document(source), intArrayOf(3))
+        ))
+        assertEquals(PdfMergeResult.Status.FAILED, failed.status)
+        assertEquals(1, failed.failedEntry)
+        assertEquals(1, destination.pageCount)
+        assertTrue("Caller-owned sources stay open", source.pageCount == 1)
+
+        val missing = merger.importInto(destination, listOf(PdfMergeEntry(PdfMergeSource.file(File("/does/not/exist.pdf")))))
+        assertEquals(PdfMergeResult.Status.FAILED, missing.status)
+        assertEquals(0, missing.failedEntry)
+
+        val signal = CancellationSignal().apply { cancel() }
+        val cancelled = merger.importInto(destination, listOf(PdfMergeEntry(PdfMergeSource.document(source))),
+            cancellationSignal = signal)
+        assertEquals(PdfMergeResult.Status.CANCELLED, cancelled.status)
+        assertEquals(1, destination.pageCount)
+
+        destination.close()
+        source.close()
+    }
+
+    /**
+     * Imposed sheets should hold the right source pages, in vector form.
+     */
+    @Test
+    fun testImposeGridBookletAndCustom() {
+        val source = core.openDocument(PdfTestDataGenerator.generateTextPdf(pageCount = 6, linesPerPage = 1))!!
+
+        fun pagesOn(document: PdfDocument, sheet: Int): List<Int> = document.openPage(sheet).use { page ->
+            page.openTextPage().use { textPage ->
+                Regex("Page (\\d+) line").findAll(textPage.text).map { it.groupValues[1].toInt() }.sorted().toList()
+            }
+        }
+
+        val grid = source.impose(PdfImposition.grid(612f, 792f, columns = 2, rows = 2, margin = 18f, gutter = 9f))!!
+        assertEquals(2, grid.pageCount)
+        assertEquals(612.0 to 792.0, grid.getPageSize(0))
+        assertEquals(listOf(1, 2, 3, 4), pagesOn(grid, 0))
+        assertEquals(listOf(5, 6), pagesOn(grid, 1))
+        grid.close()
+
+        // Six pages pad to eight: four sides, two of them with a blank half
+        val booklet = source.impose(PdfImposition.booklet(1224f, 792f))!!
+        assertEquals(4, booklet.pageCount)
+        assertEquals(listOf(listOf(1), listOf(2), listOf(3, 6), listOf(4, 5)), (0 until 4).map { pagesOn(booklet, it) })
+        booklet.close()
+
+        val repeat = PdfImposition.custom(612f, 792f, listOf(listOf(
+            PdfSheetSlot.fit(0, 612f, 792f, 0f, 396f, 612f, 396f),
+            PdfSheetSlot.fit(0, 612f, 792f, 0f, 0f, 612f, 396f, rotation = 180)
+        )))
+        val repeated = source.impose(repeat)!!
+        assertEquals(1, repeated.pageCount)
+        assertEquals(listOf(1, 1), pagesOn(repeated, 0))
+        repeated.close()
+
+        val nUp = source.importNPagesToOne(792f, 612f, 2, 1)!!
+        assertEquals(3, nUp.pageCount)
+        nUp.close()
+
+        source.close()
+    }
+}
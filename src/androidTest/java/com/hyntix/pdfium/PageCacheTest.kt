@@ -0,0 +1,105 @@
+package com.hyntix.pdfium
+
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.hyntix.pdfium.utils.PdfTestDataGenerator
+import org.junit.After
+import org.junit.Assert.*
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+
+/**
+ * Instrumentation tests for the native page cache.
+ *
+ * Tests cover:
+ * - Reopening a closed page hits the cache
+ * - Disabling the cache
+ * - Page insertion invalidates cached indices
+ * - Concurrent openers of one index get separate pages
+ */
+@RunWith(AndroidJUnit4::class)
+class PageCacheTest {
+
+    private lateinit var core: PdfiumCore
+    private var document: PdfDocument? = null
+
+    @Before
+    fun setUp() {
+        core = PdfiumCore()
+        core.initLibrary()
+        document = core.openDocument(PdfTestDataGenerator.generateSimplePdf())
+        assertNotNull(document)
+    }
+
+    @After
+    fun tearDown() {
+        document?.close()
+        document = null
+        core.destroyLibrary()
+    }
+
+    @Test
+    fun testReopenedPageIsServedFromCache() {
+        val doc = document!!
+        doc.openPage(0).close()
+        doc.openPage(0).close()
+
+        val stats = doc.pageCacheStats
+        assertEquals(1L, stats.misses)
+        assertEquals(1L, stats.hits)
+        assertEquals(1, stats.cachedPages)
+        assertTrue(stats.bytesHeld > 0)
+    }
+
+    @Test
+    fun testDisabledCacheParsesEveryTime() {
+        val doc = document!!
+        doc.configurePageCache(0)
+        doc.openPage(0).close()
+        doc.openPage(0).close()
+
+        val stats = doc.pageCacheStats
+        assertEquals(0L, stats.hits)
+        assertEquals(0, stats.cachedPages)
+        assertEquals(0L, stats.capacityBytes)
+    }
+
+    @Test
+    fun testInsertingPageInvalidatesCache() {
+        val doc = document!!
+        val originalWidth = doc.openPage(0).use { it.width }
+
+        doc.addNewPage(0, 100.0, 100.0).close()
+
+        // Index 0 is now the new page, not the cached original
+        doc.openPage(0).use { page ->
+            assertEquals(100.0, page.width, 0.01)
+        }
+        doc.openPage(1).use { page ->
+            assertEquals(originalWidth, page.width, 0.01)
+        }
+    }
+
+    /**
+     * A page that is already open is not shared with a second opener, and an
+     * edit through the second page drops the stale cached copy.
+     */
+    @Test
+    fun testConcurrentOpenersGetTheirOwnPage() {
+        val doc = document!!
+        val first = doc.openPage(0)
+        doc.openPage(0).use { second ->
+            assertNotEquals(first.getPointer(), second.getPointer())
+            core.setPageRotation(second.getPointer(), 1)
+        }
+        first.close()
+
+        doc.openPage(0).use { page ->
+            assertEquals(1, core.getPageRotation(page.getPointer()))
+        }
+        val stats = doc.pageCacheStats
+        assertEquals(3L, stats.misses)
+        assertEquals(0L, stats.hits)
+        assertEquals(1, stats.cachedPages)
+    }
+}
@@ -0,0 +1,418 @@
+package com.hyntix.pdfium
+
+import android.graphics.Bitmap
+import android.graphics.Color
+import android.os.ParcelFileDescriptor
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.hyntix.pdfium.render.PageRenderRequest
+import com.hyntix.pdfium.render.PdfRenderCache
+import com.hyntix.pdfium.render.PdfRenderPool
+import com.hyntix.pdfium.utils.PdfTestDataGenerator
+import com.hyntix.pdfium.utils.TestUtils
+import org.junit.After
+import org.junit.Assert.*
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+import java.io.ByteArrayOutputStream
+import java.io.File
+import java.util.concurrent.ConcurrentHashMap
+
+/**
+ * Instrumentation tests for page rendering.
+ *
+ * Tests cover:
+ * - Rendering a page to ARGB_8888, RGB_565 and ALPHA_8 bitmaps
+ * - Multi-process rendering through PdfRenderPool
+ * - Tiled rendering through PdfTilePool
+ * - Time-sliced and cancelled progressive rendering
+ * - Render result caching and invalidation on edit, in memory and on disk
+ * - Batch thumbnail generation
+ * - Placing bitmap and JPEG image objects
+ */
+@RunWith(AndroidJUnit4::class)
+class RenderingTest {
+
+    private lateinit var core: PdfiumCore
+    private var document: PdfDocument? = null
+
+    @Before
+    fun setUp() {
+        core = PdfiumCore()
+        core.initLibrary()
+    }
+
+    @After
+    fun tearDown() {
+        document?.close()
+        document = null
+        core.destroyLibrary()
+    }
+
+    /**
+     * Rendering fills the bitmap with an opaque white background at least.
+     */
+    @Test
+    fun testRenderPageToBitmap() {
+        document = core.openDocument(PdfTestDataGenerator.generateSimplePdf())
+        assertNotNull(document)
+
+        document!!.openPage(0).use { page ->
+            val bitmap = Bitmap.createBitmap(100, 140, Bitmap.Config.ARGB_8888)
+            page.render(bitmap)
+            assertEquals(255, Color.alpha(bitmap.getPixel(0, 0)))
+            bitmap.recycle()
+        }
+    }
+
+    /**
+     * RGB_565 renders match ARGB_8888 ones to 565 precision, and ALPHA_8
+     * renders hold no coverage over the white background.
+     */
+    @Test
+    fun testRenderConvertedFormats() {
+        document = core.openDocument(PdfTestDataGenerator.generateTextPdf(pageCount = 1))
+        assertNotNull(document)
+
+        document!!.openPage(0).use { page ->
+            val reference = Bitmap.createBitmap(120, 160, Bitmap.Config.ARGB_8888)
+            val rgb565 = Bitmap.createBitmap(120, 160, Bitmap.Config.RGB_565)
+            val alpha8 = Bitmap.createBitmap(120, 160, Bitmap.Config.ALPHA_8)
+            page.render(reference)
+            page.render(rgb565)
+            page.render(alpha8)
+
+            for (y in 0 until 160 step 7) {
+                for (x in 0 until 120 step 5) {
+                    val expected = reference.getPixel(x, y)
+                    val actual = rgb565.getPixel(x, y)
+                    assertEquals(Color.red(expected).toFloat(), Color.red(actual).toFloat(), 8f)
+                    assertEquals(Color.green(expected).toFloat(), Color.green(actual).toFloat(), 4f)
+                    assertEquals(Color.blue(expected).toFloat(), Color.blue(actual).toFloat(), 8f)
+                }
+            }
+            assertEquals(0, Color.alpha(alpha8.getPixel(0, 0)))
+
+            reference.recycle()
+            rgb565.recycle()
+            alpha8.recycle()
+        }
+    }
+
+    /**
+     * Every requested page comes back from the worker processes.
+     */
+    @Test
+    fun testRenderPoolRendersAllPages() {
+        val pdfFile = TestUtils.createTempPdf(PdfTestDataGenerator.generateSimplePdf())
+        val rendered = ConcurrentHashMap<Int, Bitmap>()
+
+        try {
+            val pageCount = core.openDocument(pdfFile.absolutePath)!!.use { it.pageCount }
+            val requests = List(pageCount * 3) { PageRenderRequest(it % pageCount, 80, 110) }
+
+            val failed = PdfRenderPool(TestUtils.getTestContext(), workerCount = 2).use { pool ->
+                ParcelFileDescriptor.open(pdfFile, ParcelFileDescriptor.MODE_READ_ONLY).use { pfd ->
+                    pool.renderPages(pfd, requests) { request, bitmap ->
+                        rendered[request.pageIndex] = bitmap
+                    }
+                }
+            }
+
+            assertTrue("No request should fail", failed.isEmpty())
+            assertEquals(pageCount, rendered.size)
+            rendered.values.forEach { assertEquals(80, it.width) }
+        } finally {
+            TestUtils.cleanupFiles(pdfFile)
+        }
+    }
+
+    /**
+     * Each tile is cleared and rendered into its own bitmap.
+     */
+    @Test
+    fun testRenderTilesIntoBitmaps() {
+        document = core.openDocument(PdfTestDataGenerator.generateSimplePdf())
+        assertNotNull(document)
+
+        val pool = core.createTilePool(tileWidth = 64, tileHeight = 64, capacity = 1)!!
+        try {
+            document!!.openPage(0).use { page ->
+                val tiles = listOf(PdfTile(0, 0), PdfTile(1, 0), PdfTile(0, 1))
+                val bitmaps = tiles.map { Bitmap.createBitmap(64, 64, Bitmap.Config.ARGB_8888) }
+
+                assertEquals(tiles.size, page.renderTiles(pool, 2f, tiles, bitmaps))
+                bitmaps.forEach { bitmap ->
+                    assertEquals(255, Color.alpha(bitmap.getPixel(0, 0)))
+                    assertEquals(255, Color.alpha(bitmap.getPixel(63, 63)))
+                    bitmap.recycle()
+                }
+            }
+        } finally {
+            pool.close()
+        }
+    }
+
+    /**
+     * Hardware tiles stay leased until closed, and the pool stops when exhausted.
+     */
+    @Test
+    fun testHardwareTilesAreLeased() {
+        document = core.openDocument(PdfTestDataGenerator.generateSimplePdf())
+        assertNotNull(document)
+
+        val pool = core.createTilePool(capacity = 2, useHardwareBuffers = true)!!
+        try {
+            document!!.openPage(0).use { page ->
+                val tiles = listOf(PdfTile(0, 0), PdfTile(1, 0), PdfTile(2, 0))
+                val first = page.renderTilesToHardwareBuffers(pool, 1f, tiles)
+                assertEquals(2, first.size)
+                assertEquals(tiles[1], first[1].tile)
+                assertEquals(256, first[0].hardwareBuffer.width)
+
+                first[0].close()
+                val second = page.renderTilesToHardwareBuffers(pool, 1f, tiles.subList(2, 3))
+                assertEquals(1, second.size)
+
+                (first + second).forEach { it.close() }
+            }
+        } finally {
+            pool.close()
+        }
+    }
+
+    /**
+     * Stepping a session with a small budget eventually finishes the page.
+     */
+    @Test
+    fun testRenderSessionCompletesInSteps() {
+        document = core.openDocument(PdfTestDataGenerator.generateSimplePdf())
+        assertNotNull(document)
+
+        document!!.openPage(0).use { page ->
+            val bitmap = Bitmap.createBitmap(200, 280, Bitmap.Config.ARGB_8888)
+            page.startRender(bitmap).use { session ->
+                var steps = 0
+                while (session.step(budgetNanos = 1_000_000L) == PdfRenderSession.Status.IN_PROGRESS) {
+                    assertTrue("Render should finish", ++steps < 10_000)
+                }
+                assertEquals(PdfRenderSession.Status.DONE, session.status)
+            }
+            assertEquals(255, Color.alpha(bitmap.getPixel(0, 0)))
+            bitmap.recycle()
+        }
+    }
+
+    /**
+     * A cancelled session stops without rendering further.
+     */
+    @Test
+    fun testRenderSessionCancel() {
+        document = core.openDocument(PdfTestDataGenerator.generateSimplePdf())
+        assertNotNull(document)
+
+        document!!.openPage(0).use { page ->
+            val bitmap = Bitmap.createBitmap(200, 280, Bitmap.Config.ARGB_8888)
+            val session = page.startRender(bitmap)
+            session.cancel()
+            assertEquals(PdfRenderSession.Status.CANCELLED, session.step())
+
+            // Rendering the page directly replaces the session
+            page.render(bitmap)
+            assertTrue(session.isClosed())
+            bitmap.recycle()
+        }
+    }
+
+    /**
+     * Repeated renders are served from the cache until the page is edited.
+     */
+    @Test
+    fun testRenderCacheReusesUntilEdited() {
+        document = core.openDocument(PdfTestDataGenerator.generateSimplePdf())
+        assertNotNull(document)
+
+        PdfRenderCache(TestUtils.getTestContext(), maxMemoryBytes = 4 * 1024 * 1024).use { cache ->
+            document!!.openPage(0).use { page ->
+                val first = cache.getOrRender(page, 100, 140)
+                assertSame(first, cache.getOrRender(page, 100, 140))
+                assertNotSame(first, cache.getOrRender(page, 100, 140, renderAnnot = false))
+
+                core.setPageRotation(page.getPointer(), 1)
+                assertNotSame(first, cache.getOrRender(page, 100, 140))
+            }
+
+            cache.onTrimMemory(android.content.ComponentCallbacks2.TRIM_MEMORY_BACKGROUND)
+            assertEquals(0, cache.memoryBytes)
+        }
+    }
+
+    /**
+     * Only renders of unedited pages reach the disk level, since revisions
+     * restart with every open.
+     */
+    @Test
+    fun testDiskCacheSkipsEditedPages() {
+        document = core.openDocument(PdfTestDataGenerator.generateSimplePdf())
+        assertNotNull(document)
+        val dir = File(TestUtils.getTestContext().cacheDir, "render-cache-test").apply { deleteRecursively() }
+
+        PdfRenderCache(TestUtils.getTestContext(), maxMemoryBytes = 4 * 1024 * 1024, diskCacheDir = dir).use { cache ->
+            document!!.openPage(0).use { page ->
+                cache.getOrRender(page, 100, 140, documentKey = "simple")
+                assertEquals(1, dir.listFiles()!!.size)
+
+                core.setPageRotation(page.getPointer(), 1)
+                cache.getOrRender(page, 100, 140, documentKey = "simple")
+                assertEquals(1, dir.listFiles()!!.size)
+            }
+            cache.clear()
+        }
+        dir.deleteRecursively()
+    }
+
+    /**
+     * Without a documentKey renders stay in memory, since the serial that
+     * tells documents apart restarts in every process.
+     */
+    @Test
+    fun testDiskCacheNeedsDocumentKey() {
+        document = core.openDocument(PdfTestDataGenerator.generateSimplePdf())
+        assertNotNull(document)
+        val other = core.openDocument(PdfTestDataGenerator.generateTextPdf(pageCount = 1))
+        assertNotNull(other)
+        val dir = File(TestUtils.getTestContext().cacheDir, "render-cache-test").apply { deleteRecursively() }
+
+        try {
+            PdfRenderCache(TestUtils.getTestContext(), maxMemoryBytes = 4 * 1024 * 1024, diskCacheDir = dir).use { cache ->
+                val first = document!!.openPage(0).use { cache.getOrRender(it, 100, 140) }
+                val second = other!!.openPage(0).use { cache.getOrRender(it, 100, 140) }
+                assertFalse("Each document gets its own render", first.sameAs(second))
+                assertTrue(dir.listFiles().isNullOrEmpty())
+                cache.clear()
+            }
+        } finally {
+            other!!.close()
+            dir.deleteRecursively()
+        }
+    }
+
+    /**
+     * Thumbnails fit the requested edge, reuse pooled bitmaps and come back
+     * from the render cache on a second pass.
+     */
+    @Test
+    fun testGenerateThumbnails() {
+        document = core.openDocument(PdfTestDataGenerator.generateTextPdf(pageCount = 5))
+        assertNotNull(document)
+
+        val pool = PdfBitmapPool()
+        val thumbnails = ArrayList<Bitmap>()
+        assertTrue(document!!.generateThumbnails(maxEdge = 64, pool = pool) { pageIndex, bitmap, source ->
+            assertEquals(thumbnails.size, pageIndex)
+            assertEquals(PdfThumbnailSource.RENDERED, source)
+            assertEquals(64, maxOf(bitmap.width, bitmap.height))
+            assertEquals(Bitmap.Config.RGB_565, bitmap.config)
+            thumbnails.add(bitmap)
+        })
+        assertEquals(5, thumbnails.size)
+
+        // Released thumbnails are decoded into again
+        thumbnails.forEach { pool.release(it) }
+        val reused = ArrayList<Bitmap>()
+        assertTrue(document!!.generateThumbnails(0..1, maxEdge = 64, pool = pool) { _, bitmap, _ ->
+            reused.add(bitmap)
+        })
+        assertTrue(reused.all { bitmap -> thumbnails.any { it === bitmap } })
+
+        // Stopping from the sink ends the run
+        var delivered = 0
+        assertFalse(document!!.generateThumbnails(maxEdge = 64) { _, _, _ -> ++delivered < 2 })
+        assertEquals(2, delivered)
+
+        PdfRenderCache(TestUtils.getTestContext(), maxMemoryBytes = 4 * 1024 * 1024).use { cache ->
+            val sources = ArrayList<PdfThumbnailSource>()
+            document!!.generateThumbnails(maxEdge = 48, cache = cache) { _, _, source -> sources.add(source) }
+            document!!.generateThumbnails(maxEdge = 48, cache = cache) { _, _, source -> sources.add(source) }
+            assertEquals(List(5) { PdfThumbnailSource.RENDERED } + List(5) { PdfThumbnailSource.CACHED }, sources)
+
+            // Another config or embedded preference is a different entry
+            sources.clear()
+            document!!.generateThumbnails(maxEdge = 48, config = Bitmap.Config.ARGB_8888, cache = cache) { _, _, source ->
+                sources.add(source)
+            }
+            document!!.generateThumbnails(maxEdge = 48, preferEmbedded = false, cache = cache) { _, _, source ->
+                sources.add(source)
+            }
+            assertEquals(List(10) { PdfThumbnailSource.RENDERED }, sources)
+        }
+
+        // Only thumbnails of a keyed document reach the disk level
+        val dir = File(TestUtils.getTestContext().cacheDir, "thumbnail-cache-test").apply { deleteRecursively() }
+        PdfRenderCache(TestUtils.getTestContext(), maxMemoryBytes = 4 * 1024 * 1024, diskCacheDir = dir).use { cache ->
+            document!!.generateThumbnails(0..1, maxEdge = 48, cache = cache) { _, _, _ -> true }
+            assertTrue(dir.listFiles().isNullOrEmpty())
+            document!!.generateThumbnails(0..1, maxEdge = 48, cache = cache, documentKey = "text") { _, _, _ -> true }
+            assertEquals(2, dir.listFiles()!!.size)
+            cache.clear()
+        }
+        dir.deleteRecursively()
+    }
+
+    /**
+     * Bitmaps and JPEGs placed in one batch should render where they were put,
+     * and the JPEG should be stored byte for byte.
+     */
+    @Test
+    fun testInsertBitmapAndJpegImages() {
+        document = core.openDocument(PdfTestDataGenerator.generateSimplePdf())
+        assertNotNull(document)
+
+        val red = Bitmap.createBitmap(16, 16, Bitmap.Config.ARGB_8888).apply { eraseColor(Color.RED) }
+        val blue = Bitmap.createBitmap(16, 16, Bitmap.Config.RGB_565).apply { eraseColor(Color.BLUE) }
+        val jpegBytes = ByteArrayOutputStream().also {
+            Bitmap.createBitmap(32, 32, Bitmap.Config.ARGB_8888).apply { eraseColor(Color.GREEN) }
+                .compress(Bitmap.CompressFormat.JPEG, 90, it)
+        }.toByteArray()
+        val jpegFile = File.createTempFile("image", ".jpg", TestUtils.getTestContext().cacheDir)
+        jpegFile.writeBytes(jpegBytes)
+
+        try {
+            document!!.openPage(0).use { page ->
+                val w = page.width.toFloat()
+                val h = page.height.toFloat()
+                val before = core.countPageObjects(page.getPointer())
+                val placed = ParcelFileDescriptor.open(jpegFile, ParcelFileDescriptor.MODE_READ_ONLY).use { jpeg ->
+                    page.insertImages(listOf(
+                        PdfPageImage.bitmap(red, 0f, h / 2, w / 2, h / 2),           // top left
+                        PdfPageImage.bitmap(blue, w / 2, h / 2, w / 2, h / 2),       // top right
+                        PdfPageImage.jpeg(jpeg, 0f, 0f, w, h / 2)                    // bottom half
+                    ))
+                }
+                assertEquals(3, placed)
+                assertEquals(before + 3, core.countPageObjects(page.getPointer()))
+
+                val bitmap = Bitmap.createBitmap(100, 140, Bitmap.Config.ARGB_8888)
+                page.render(bitmap)
+                assertEquals(Color.RED, bitmap.getPixel(25, 35))
+                assertEquals(Color.BLUE, bitmap.getPixel(75, 35))
+                val jpegPixel = bitmap.getPixel(50, 105)
+                assertTrue(Color.green(jpegPixel) > 200 && Color.red(jpegPixel) < 60 && Color.blue(jpegPixel) < 60)
+                bitmap.recycle()
+
+                // Hardware bitmaps have no lockable pixels and are rejected up front
+                val hardware = runCatching { PdfPageImage.bitmap(red.copy(Bitmap.Config.HARDWARE, false), 0f, 0f, 1f, 1f) }
+                assertTrue(hardware.isFailure)
+            }
+
+            val saved = ByteArrayOutputStream()
+            assertTrue(document!!.save(saved))
+            val latin1 = Charsets.ISO_8859_1
+            assertTrue("JPEG is embedded without re-encoding", String(saved.toByteArray(), latin1).contains(String(jpegBytes, latin1)))
+        } finally {
+            red.recycle()
+            blue.recycle()
+            TestUtils.cleanupFiles(jpegFile)
+        }
+    }
+}
@@ -0,0 +1,78 @@
+package com.hyntix.pdfium
+
+import android.graphics.Bitmap
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.hyntix.pdfium.utils.PdfTestDataGenerator
+import org.junit.After
+import org.junit.Assert.*
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+
+/**
+ * Instrumentation tests for native performance counters.
+ *
+ * Tests cover:
+ * - Open documents and buffer bytes are tracked
+ * - Page loads and renders are attributed to their document
+ * - Resetting counters
+ */
+@RunWith(AndroidJUnit4::class)
+class StatsTest {
+
+    private lateinit var core: PdfiumCore
+
+    @Before
+    fun setUp() {
+        core = PdfiumCore()
+        core.initLibrary()
+        core.resetStats()
+    }
+
+    @After
+    fun tearDown() {
+        core.destroyLibrary()
+    }
+
+    @Test
+    fun testOpenDocumentIsCounted() {
+        val data = PdfTestDataGenerator.generateSimplePdf()
+        val before = core.stats().documentsOpen
+        val doc = core.openDocument(data)!!
+
+        val stats = core.stats()
+        assertEquals(before + 1, stats.documentsOpen)
+        assertTrue(stats.bufferBytesHeld >= data.size)
+
+        doc.close()
+        assertEquals(before, core.stats().documentsOpen)
+    }
+
+    @Test
+    fun testRenderIsRecordedPerDocument() {
+        core.openDocument(PdfTestDataGenerator.generateSimplePdf())!!.use { doc ->
+            val bitmap = Bitmap.createBitmap(100, 100, Bitmap.Config.ARGB_8888)
+            doc.openPage(0).use { page -> page.render(bitmap) }
+            bitmap.recycle()
+
+            val stats = doc.stats
+            assertEquals(1L, stats.pagesLoaded)
+            assertEquals(1L, stats.render.count)
+            assertEquals(1L, stats.render.histogram.sum())
+            assertTrue(stats.render.totalNanos > 0)
+        }
+        assertTrue(core.stats().render.count >= 1L)
+    }
+
+    @Test
+    fun testResetClearsCounters() {
+        core.openDocument(PdfTestDataGenerator.generateSimplePdf())!!.use { doc ->
+            doc.openPage(0).close()
+        }
+        core.resetStats()
+
+        val stats = core.stats()
+        assertEquals(0L, stats.pagesLoaded)
+        assertEquals(0L, stats.render.count)
+    }
+}
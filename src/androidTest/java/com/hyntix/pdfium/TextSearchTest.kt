@@ -0,0 +1,208 @@
+package com.hyntix.pdfium
+
+import android.os.CancellationSignal
+import android.os.ParcelFileDescriptor
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import com.hyntix.pdfium.search.PdfTextIndexStore
+import com.hyntix.pdfium.utils.PdfTestDataGenerator
+import com.hyntix.pdfium.utils.TestUtils
+import org.junit.After
+import org.junit.Assert.*
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+
+/**
+ * Instrumentation tests for document-wide text search.
+ *
+ * Tests cover:
+ * - Hits and rects on every page in one pass
+ * - Agreement with per-page search
+ * - Stopping and cancelling a search
+ * - Building, reopening and querying a persistent text index
+ * - Index keys for documents without /ID, and rejecting corrupt index files
+ * - Bulk text layout agreeing with per-char native calls
+ * - Streaming text extraction to a sink and to a file descriptor
+ */
+@RunWith(AndroidJUnit4::class)
+class TextSearchTest {
+
+    private lateinit var core: PdfiumCore
+    private var document: PdfDocument? = null
+
+    @Before
+    fun setUp() {
+        core = PdfiumCore()
+        core.initLibrary()
+        document = core.openDocument(PdfTestDataGenerator.generateTextPdf(pageCount = 12, linesPerPage = 5))
+        assertNotNull(document)
+    }
+
+    @After
+    fun tearDown() {
+        document?.close()
+        document = null
+        core.destroyLibrary()
+    }
+
+    @Test
+    fun testSearchDocumentFindsEveryPage() {
+        val batches = document!!.searchDocument("lazy dog")
+
+        assertEquals(12, batches.size)
+        assertEquals((0 until 12).toList(), batches.map { it.pageIndex })
+        batches.forEach { batch ->
+            assertEquals(5, batch.hitCount)
+            assertEquals(8, batch.count(0))
+            assertTrue(batch.rectCount(0) >= 1)
+            val rect = batch.rectsOf(0).first()
+            assertTrue(rect.right > rect.left)
+        }
+    }
+
+    @Test
+    fun testSearchDocumentMatchesPageSearch() {
+        val doc = document!!
+        val batch = doc.searchDocument("Page 3 line").single()
+        val expected = doc.openPage(2).use { page ->
+            page.openTextPage().use { it.search("Page 3 line") }
+        }
+        assertEquals(expected, batch.toMatches())
+    }
+
+    @Test
+    fun testSearchDocumentStopsAndCancels() {
+        val doc = document!!
+        val seen = ArrayList<Int>()
+        assertFalse(doc.searchDocument("fox") { seen.add(it.pageIndex); false })
+        assertEquals(listOf(0), seen)
+
+        val signal = CancellationSignal()
+        seen.clear()
+        assertFalse(doc.searchDocument("fox", cancellationSignal = signal) {
+            seen.add(it.pageIndex)
+            signal.cancel()
+            true
+        })
+        assertEquals(listOf(0), seen)
+    }
+
+    @Test
+    fun testTextIndexPhraseAndPrefix() {
+        val doc = document!!
+        val store = PdfTextIndexStore(TestUtils.getTestContext().cacheDir.resolve("text_index_test"))
+        store.clear()
+
+        val index = store.getOrBuild(doc, key = "generated-text")
+        assertNotNull(index)
+        index!!.use {
+            assertEquals(12, it.pageCount)
+            assertEquals(60, it.search("Lazy, dog!").size)
+            assertEquals(60, it.search("the qui").size)
+            assertTrue(it.search("the qui", prefixMatch = false).isEmpty())
+
+            val hits = it.search("page 3 line")
+            assertEquals(5, hits.size)
+            assertTrue(hits.all { hit -> hit.pageIndex == 2 && hit.rects.size == 3 })
+            val expected = doc.openPage(2).use { page ->
+                page.openTextPage().use { text -> text.search("Page 3 line") }
+            }
+            assertEquals(expected.map { m -> m.startIndex }, hits.map { hit -> hit.startIndex })
+        }
+
+        // A second open maps the stored file instead of rebuilding
+        val reopened = store.get("generated-text")
+        assertNotNull(reopened)
+        reopened!!.use { assertEquals(5, it.search("page 12 line").size) }
+        assertTrue(store.remove("generated-text"))
+    }
+
+    /**
+     * Documents without /ID are keyed by their source, corrupt index files are
+     * rejected and rebuilt, and a closed index refuses searches.
+     */
+    @Test
+    fun testTextIndexFallbackKeyAndCorruptFile() {
+        val doc = document!!
+        val dir = TestUtils.getTestContext().cacheDir.resolve("text_index_corrupt_test")
+        val store = PdfTextIndexStore(dir)
+        store.clear()
+
+        assertNotNull(doc.sourceFingerprint)
+        val index = store.getOrBuild(doc)
+        assertNotNull(index)
+        index!!.close()
+        assertTrue(runCatching { index.search("page") }.isFailure)
+
+        // Cut the file inside the posting table
+        val file = dir.listFiles { f -> f.name.endsWith(".idx") }!!.single()
+        java.io.RandomAccessFile(file, "rw").use { it.setLength(file.length() / 2) }
+        val rebuilt = store.getOrBuild(doc)
+        assertNotNull(rebuilt)
+        rebuilt!!.use { assertEquals(5, it.search("page 12 line").size) }
+        store.clear()
+    }
+
+    @Test
+    fun testTextLayoutMatchesPerCharCalls() {
+        document!!.openPage(0).use { page ->
+            page.openTextPage().use { textPage ->
+                val layout = textPage.getLayout()
+                assertEquals(textPage.charCount, layout.charCount)
+                assertEquals(textPage.text, layout.text)
+                assertEquals(5, layout.lineCount)
+
+                val index = layout.text.indexOf("quick")
+                val box = textPage.getCharBox(index)
+                val fastBox = layout.getCharBox(index)
+                assertEquals(box[0].toFloat(), fastBox.left, 0.01f)
+                assertEquals(box[2].toFloat(), fastBox.right, 0.01f)
+                assertTrue(layout.getFontSize(index) > 0f)
+
+                assertEquals(index until index + 5, layout.getWordRange(index + 2))
+                assertEquals(0, layout.getLineForChar(index))
+                assertEquals(index, layout.getCharIndexAt(fastBox.centerX(), fastBox.centerY()))
+                assertEquals(1, layout.getSelectionRects(index, 5).size)
+                assertEquals(2, layout.getSelectionRects(index, layout.getLineStart(1) + 2 - index).size)
+            }
+        }
+    }
+
+    @Test
+    fun testExtractTextStreamsPages() {
+        val doc = document!!
+        val pages = ArrayList<Int>()
+        assertTrue(doc.extractText { pageIndex, text ->
+            assertEquals(doc.openPage(pageIndex).use { it.openTextPage().use { t -> t.text } }, text)
+            pages.add(pageIndex)
+        })
+        assertEquals((0 until 12).toList(), pages)
+
+        pages.clear()
+        assertFalse(doc.extractText(2..10) { pageIndex, _ -> pages.add(pageIndex); pageIndex < 4 })
+        assertEquals(listOf(2, 3, 4), pages)
+    }
+
+    @Test
+    fun testExtractTextFromFdToFd() {
+        val dir = TestUtils.getTestContext().cacheDir
+        val input = dir.resolve("extract_input.pdf").apply {
+            writeBytes(PdfTestDataGenerator.generateTextPdf(pageCount = 3, linesPerPage = 2))
+        }
+        val output = dir.resolve("extract_output.txt")
+
+        ParcelFileDescriptor.open(input, ParcelFileDescriptor.MODE_READ_ONLY).use { inFd ->
+            ParcelFileDescriptor.open(
+                output,
+                ParcelFileDescriptor.MODE_WRITE_ONLY or ParcelFileDescriptor.MODE_CREATE or ParcelFileDescriptor.MODE_TRUNCATE
+            ).use { outFd ->
+                assertTrue(core.extractText(inFd.fd, outFd))
+            }
+        }
+
+        val pages = output.readText().split('\u000C')
+        assertEquals(4, pages.size)    // trailing form feed
+        assertTrue(pages[1].contains("Page 2 line 1"))
+        assertEquals("", pages[3])
+    }
+}
@@ -0,0 +1,868 @@
+package com.hyntix.pdfium.utils
+
+import java.io.ByteArrayOutputStream
+
+/**
+ * Generates minimal valid PDF documents for testing purposes.
+ * 
+ * This class creates basic PDFs programmatically without external dependencies.
+ * The PDFs are minimal but valid according to PDF specification.
+ * 
+ * Note: For production use, consider using a proper PDF library.
+ * These are simplified test PDFs for validation purposes only.
+ */
+object PdfTestDataGenerator {
+    
+    /**
+     * Generate a simple PDF with one blank page.
+     * 
+     * @return ByteArray containing the PDF content
+     */
+    fun generateSimplePdf(): ByteArray {
+        val output = ByteArrayOutputStream()
+        
+        // PDF Header
+        output.write("%PDF-1.4\n".toByteArray())
+        output.write("%âãÏÓ\n".toByteArray()) // Binary marker
+        
+        // Objects
+        val objects = mutableListOf<ByteArray>()
+        
+        // Object 1: Catalog
+        objects.add("""
+            1 0 obj
+            <<
+            /Type /Catalog
+            /Pages 2 0 R
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 2: Pages
+        objects.add("""
+            2 0 obj
+            <<
+            /Type /Pages
+            /Kids [3 0 R]
+            /Count 1
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 3: Page
+        objects.add("""
+            3 0 obj
+            <<
+            /Type /Page
+            /Parent 2 0 R
+            /MediaBox [0 0 612 792]
+            /Contents 4 0 R
+            /Resources <<
+            /ProcSet [/PDF]
+            >>
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 4: Contents (empty)
+        objects.add("""
+            4 0 obj
+            <<
+            /Length 0
+            >>
+            stream
+            endstream
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Write objects and track offsets
+        val offsets = mutableListOf<Long>()
+        objects.forEach { obj ->
+            offsets.add(output.size().toLong())
+            output.write(obj)
+            output.write("\n".toByteArray())
+        }
+        
+        // Write xref table
+        val xrefPos = output.size()
+        output.write("xref\n".toByteArray())
+        output.write("0 ${objects.size + 1}\n".toByteArray())
+        output.write("0000000000 65535 f \n".toByteArray())
+        offsets.forEach { offset ->
+            output.write(String.format("%010d 00000 n \n", offset).toByteArray())
+        }
+        
+        // Write trailer
+        output.write("""
+            trailer
+            <<
+            /Size ${objects.size + 1}
+            /Root 1 0 R
+            >>
+            startxref
+            $xrefPos
+            %%EOF
+        """.trimIndent().toByteArray())
+        
+        return output.toByteArray()
+    }
+    
+    /**
+     * Generate a multi-page PDF with lines of searchable Helvetica text.
+     * Each line reads "Page <n> line <m> The quick brown fox jumps over the lazy dog".
+     *
+     * @param pageCount Number of pages
+     * @param linesPerPage Number of text lines on each page
+     * @return ByteArray containing the PDF content
+     */
+    fun generateTextPdf(pageCount: Int = 10, linesPerPage: Int = 40): ByteArray {
+        val output = ByteArrayOutputStream()
+        
+        // PDF Header
+        output.write("%PDF-1.4\n".toByteArray())
+        output.write("%âãÏÓ\n".toByteArray())
+        
+        val objects = mutableListOf<ByteArray>()
+        
+        // Page N uses objects 4 + 2N (page) and 5 + 2N (contents)
+        val kids = (0 until pageCount).joinToString(" ") { "${4 + 2 * it} 0 R" }
+        
+        // Object 1: Catalog
+        objects.add("""
+            1 0 obj
+            <<
+            /Type /Catalog
+            /Pages 2 0 R
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 2: Pages
+        objects.add("""
+            2 0 obj
+            <<
+            /Type /Pages
+            /Kids [$kids]
+            /Count $pageCount
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 3: Shared font
+        objects.add("""
+            3 0 obj
+            <<
+            /Type /Font
+            /Subtype /Type1
+            /BaseFont /Helvetica
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        for (page in 0 until pageCount) {
+            val pageObj = 4 + 2 * page
+            val content = buildString {
+                append("BT\n/F1 10 Tf\n14 TL\n40 760 Td\n")
+                for (line in 0 until linesPerPage) {
+                    append("(Page ${page + 1} line ${line + 1} The quick brown fox jumps over the lazy dog) Tj T*\n")
+                }
+                append("ET")
+            }
+            
+            objects.add("""
+                $pageObj 0 obj
+                <<
+                /Type /Page
+                /Parent 2 0 R
+                /MediaBox [0 0 612 792]
+                /Contents ${pageObj + 1} 0 R
+                /Resources <<
+                /ProcSet [/PDF /Text]
+                /Font << /F1 3 0 R >>
+                >>
+                >>
+                endobj
+            """.trimIndent().toByteArray())
+            
+            objects.add(("${pageObj + 1} 0 obj\n<<\n/Length ${content.length}\n>>\nstream\n" +
+                "$content\nendstream\nendobj").toByteArray())
+        }
+        
+        // Write objects
+        val offsets = mutableListOf<Long>()
+        objects.forEach { obj ->
+            offsets.add(output.size().toLong())
+            output.write(obj)
+            output.write("\n".toByteArray())
+        }
+        
+        // Write xref
+        val xrefPos = output.size()
+        output.write("xref\n".toByteArray())
+        output.write("0 ${objects.size + 1}\n".toByteArray())
+        output.write("0000000000 65535 f \n".toByteArray())
+        offsets.forEach { offset ->
+            output.write(String.format("%010d 00000 n \n", offset).toByteArray())
+        }
+        
+        // Write trailer
+        output.write("""
+            trailer
+            <<
+            /Size ${objects.size + 1}
+            /Root 1 0 R
+            >>
+            startxref
+            $xrefPos
+            %%EOF
+        """.trimIndent().toByteArray())
+        
+        return output.toByteArray()
+    }
+    
+    /**
+     * Generate a four-page PDF with a nested outline:
+     * "Chapter 1" (page 0) with "Section 1.1" (page 1) and "Section 1.2" (page 2),
+     * "Chapter 2" (page 3), and "Appendix" (no destination) with "Notes" (page 3).
+     *
+     * @return ByteArray containing the PDF content
+     */
+    fun generateOutlinePdf(): ByteArray {
+        val output = ByteArrayOutputStream()
+        
+        // PDF Header
+        output.write("%PDF-1.4\n".toByteArray())
+        output.write("%âãÏÓ\n".toByteArray())
+        
+        val objects = mutableListOf<ByteArray>()
+        
+        // Objects 1-3: Catalog, Pages, Outlines root
+        objects.add("1 0 obj\n<< /Type /Catalog /Pages 2 0 R /Outlines 3 0 R /PageMode /UseOutlines >>\nendobj".toByteArray())
+        objects.add("2 0 obj\n<< /Type /Pages /Kids [4 0 R 5 0 R 6 0 R 7 0 R] /Count 4 >>\nendobj".toByteArray())
+        objects.add("3 0 obj\n<< /Type /Outlines /First 9 0 R /Last 13 0 R /Count 6 >>\nendobj".toByteArray())
+        
+        // Objects 4-7: Pages sharing the empty contents in object 8
+        for (page in 4..7) {
+            objects.add(("$page 0 obj\n<< /Type /Page /Parent 2 0 R /MediaBox [0 0 612 792] " +
+                "/Contents 8 0 R /Resources << /ProcSet [/PDF] >> >>\nendobj").toByteArray())
+        }
+        objects.add("8 0 obj\n<< /Length 0 >>\nstream\nendstream\nendobj".toByteArray())
+        
+        // Objects 9-14: Outline items
+        objects.add("9 0 obj\n<< /Title (Chapter 1) /Parent 3 0 R /Next 12 0 R /First 10 0 R /Last 11 0 R /Count 2 /Dest [4 0 R /Fit] >>\nendobj".toByteArray())
+        objects.add("10 0 obj\n<< /Title (Section 1.1) /Parent 9 0 R /Next 11 0 R /Dest [5 0 R /Fit] >>\nendobj".toByteArray())
+        objects.add("11 0 obj\n<< /Title (Section 1.2) /Parent 9 0 R /Prev 10 0 R /Dest [6 0 R /Fit] >>\nendobj".toByteArray())
+        objects.add("12 0 obj\n<< /Title (Chapter 2) /Parent 3 0 R /Prev 9 0 R /Next 13 0 R /Dest [7 0 R /Fit] >>\nendobj".toByteArray())
+        objects.add("13 0 obj\n<< /Title (Appendix) /Parent 3 0 R /Prev 12 0 R /First 14 0 R /Last 14 0 R /Count 1 >>\nendobj".toByteArray())
+        objects.add("14 0 obj\n<< /Title (Notes) /Parent 13 0 R /Dest [7 0 R /XYZ 0 792 0] >>\nendobj".toByteArray())
+        
+        // Write objects
+        val offsets = mutableListOf<Long>()
+        objects.forEach { obj ->
+            offsets.add(output.size().toLong())
+            output.write(obj)
+            output.write("\n".toByteArray())
+        }
+        
+        // Write xref
+        val xrefPos = output.size()
+        output.write("xref\n".toByteArray())
+        output.write("0 ${objects.size + 1}\n".toByteArray())
+        output.write("0000000000 65535 f \n".toByteArray())
+        offsets.forEach { offset ->
+            output.write(String.format("%010d 00000 n \n", offset).toByteArray())
+        }
+        
+        // Write trailer
+        output.write("""
+            trailer
+            <<
+            /Size ${objects.size + 1}
+            /Root 1 0 R
+            >>
+            startxref
+            $xrefPos
+            %%EOF
+        """.trimIndent().toByteArray())
+        
+        return output.toByteArray()
+    }
+    
+    /**
+     * Generate a two-page PDF whose first page has link annotations and a URL in its text:
+     * a GoTo link to page 1 at [50 700 250 720], a URI link to "https://example.com"
+     * at [50 600 250 620] and the text "Visit https://www.example.org today" at y = 400.
+     *
+     * @return ByteArray containing the PDF content
+     */
+    fun generateLinkPdf(): ByteArray {
+        val output = ByteArrayOutputStream()
+        
+        // PDF Header
+        output.write("%PDF-1.4\n".toByteArray())
+        output.write("%âãÏÓ\n".toByteArray())
+        
+        val objects = mutableListOf<ByteArray>()
+        val content = "BT\n/F1 12 Tf\n50 400 Td\n(Visit https://www.example.org today) Tj\nET"
+        
+        objects.add("1 0 obj\n<< /Type /Catalog /Pages 2 0 R >>\nendobj".toByteArray())
+        objects.add("2 0 obj\n<< /Type /Pages /Kids [3 0 R 4 0 R] /Count 2 >>\nendobj".toByteArray())
+        
+        // Object 3: First page with two link annotations
+        objects.add(("3 0 obj\n<< /Type /Page /Parent 2 0 R /MediaBox [0 0 612 792] /Contents 5 0 R " +
+            "/Resources << /ProcSet [/PDF /Text] /Font << /F1 6 0 R >> >> /Annots [7 0 R 8 0 R] >>\nendobj").toByteArray())
+        objects.add("4 0 obj\n<< /Type /Page /Parent 2 0 R /MediaBox [0 0 612 792] >>\nendobj".toByteArray())
+        objects.add("5 0 obj\n<< /Length ${content.length} >>\nstream\n$content\nendstream\nendobj".toByteArray())
+        objects.add("6 0 obj\n<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica >>\nendobj".toByteArray())
+        
+        // Objects 7-8: Link annotations
+        objects.add("7 0 obj\n<< /Type /Annot /Subtype /Link /Rect [50 700 250 720] /Border [0 0 0] /Dest [4 0 R /Fit] >>\nendobj".toByteArray())
+        objects.add(("8 0 obj\n<< /Type /Annot /Subtype /Link /Rect [50 600 250 620] /Border [0 0 0] " +
+            "/A << /S /URI /URI (https://example.com) >> >>\nendobj").toByteArray())
+        
+        // Write objects
+        val offsets = mutableListOf<Long>()
+        objects.forEach { obj ->
+            offsets.add(output.size().toLong())
+            output.write(obj)
+            output.write("\n".toByteArray())
+        }
+        
+        // Write xref
+        val xrefPos = output.size()
+        output.write("xref\n".toByteArray())
+        output.write("0 ${objects.size + 1}\n".toByteArray())
+        output.write("0000000000 65535 f \n".toByteArray())
+        offsets.forEach { offset ->
+            output.write(String.format("%010d 00000 n \n", offset).toByteArray())
+        }
+        
+        // Write trailer
+        output.write("""
+            trailer
+            <<
+            /Size ${objects.size + 1}
+            /Root 1 0 R
+            >>
+            startxref
+            $xrefPos
+            %%EOF
+        """.trimIndent().toByteArray())
+        
+        return output.toByteArray()
+    }
+    
+    /**
+     * Generate a PDF with a simple text annotation.
+     * 
+     * @return ByteArray containing the PDF content
+     */
+    fun generateAnnotatedPdf(): ByteArray {
+        val output = ByteArrayOutputStream()
+        
+        // PDF Header
+        output.write("%PDF-1.4\n".toByteArray())
+        output.write("%âãÏÓ\n".toByteArray())
+        
+        val objects = mutableListOf<ByteArray>()
+        
+        // Object 1: Catalog
+        objects.add("""
+            1 0 obj
+            <<
+            /Type /Catalog
+            /Pages 2 0 R
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 2: Pages
+        objects.add("""
+            2 0 obj
+            <<
+            /Type /Pages
+            /Kids [3 0 R]
+            /Count 1
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 3: Page with annotation
+        objects.add("""
+            3 0 obj
+            <<
+            /Type /Page
+            /Parent 2 0 R
+            /MediaBox [0 0 612 792]
+            /Contents 4 0 R
+            /Annots [5 0 R]
+            /Resources <<
+            /ProcSet [/PDF /Text]
+            /Font <<
+            /F1 <<
+            /Type /Font
+            /Subtype /Type1
+            /BaseFont /Helvetica
+            >>
+            >>
+            >>
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 4: Contents
+        objects.add("""
+            4 0 obj
+            <<
+            /Length 44
+            >>
+            stream
+            BT
+            /F1 12 Tf
+            50 700 Td
+            (Test) Tj
+            ET
+            endstream
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 5: Text Annotation
+        objects.add("""
+            5 0 obj
+            <<
+            /Type /Annot
+            /Subtype /Text
+            /Rect [100 700 120 720]
+            /Contents (Test annotation)
+            /Name /Comment
+            /C [1.0 1.0 0.0]
+            /CA 1.0
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Write objects
+        val offsets = mutableListOf<Long>()
+        objects.forEach { obj ->
+            offsets.add(output.size().toLong())
+            output.write(obj)
+            output.write("\n".toByteArray())
+        }
+        
+        // Write xref
+        val xrefPos = output.size()
+        output.write("xref\n".toByteArray())
+        output.write("0 ${objects.size + 1}\n".toByteArray())
+        output.write("0000000000 65535 f \n".toByteArray())
+        offsets.forEach { offset ->
+            output.write(String.format("%010d 00000 n \n", offset).toByteArray())
+        }
+        
+        // Write trailer
+        output.write("""
+            trailer
+            <<
+            /Size ${objects.size + 1}
+            /Root 1 0 R
+            >>
+            startxref
+            $xrefPos
+            %%EOF
+        """.trimIndent().toByteArray())
+        
+        return output.toByteArray()
+    }
+    
+    /**
+     * Generate a PDF with form fields.
+     * 
+     * @return ByteArray containing the PDF content
+     */
+    fun generateFormPdf(): ByteArray {
+        val output = ByteArrayOutputStream()
+        
+        // PDF Header
+        output.write("%PDF-1.4\n".toByteArray())
+        output.write("%âãÏÓ\n".toByteArray())
+        
+        val objects = mutableListOf<ByteArray>()
+        
+        // Object 1: Catalog with AcroForm
+        objects.add("""
+            1 0 obj
+            <<
+            /Type /Catalog
+            /Pages 2 0 R
+            /AcroForm <<
+            /Fields [5 0 R 6 0 R]
+            /NeedAppearances true
+            >>
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 2: Pages
+        objects.add("""
+            2 0 obj
+            <<
+            /Type /Pages
+            /Kids [3 0 R]
+            /Count 1
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 3: Page with form fields
+        objects.add("""
+            3 0 obj
+            <<
+            /Type /Page
+            /Parent 2 0 R
+            /MediaBox [0 0 612 792]
+            /Contents 4 0 R
+            /Annots [5 0 R 6 0 R]
+            /Resources <<
+            /ProcSet [/PDF /Text]
+            /Font <<
+            /F1 <<
+            /Type /Font
+            /Subtype /Type1
+            /BaseFont /Helvetica
+            >>
+            >>
+            >>
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 4: Contents
+        objects.add("""
+            4 0 obj
+            <<
+            /Length 0
+            >>
+            stream
+            endstream
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 5: Text Field
+        objects.add("""
+            5 0 obj
+            <<
+            /Type /Annot
+            /Subtype /Widget
+            /FT /Tx
+            /T (textfield1)
+            /V (Default Text)
+            /Rect [50 700 250 720]
+            /F 4
+            /MK <<
+            /BC [0 0 0]
+            >>
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 6: Checkbox
+        objects.add("""
+            6 0 obj
+            <<
+            /Type /Annot
+            /Subtype /Widget
+            /FT /Btn
+            /T (checkbox1)
+            /V /Off
+            /Rect [50 650 70 670]
+            /F 4
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Write objects
+        val offsets = mutableListOf<Long>()
+        objects.forEach { obj ->
+            offsets.add(output.size().toLong())
+            output.write(obj)
+            output.write("\n".toByteArray())
+        }
+        
+        // Write xref
+        val xrefPos = output.size()
+        output.write("xref\n".toByteArray())
+        output.write("0 ${objects.size + 1}\n".toByteArray())
+        output.write("0000000000 65535 f \n".toByteArray())
+        offsets.forEach { offset ->
+            output.write(String.format("%010d 00000 n \n", offset).toByteArray())
+        }
+        
+        // Write trailer
+        output.write("""
+            trailer
+            <<
+            /Size ${objects.size + 1}
+            /Root 1 0 R
+            >>
+            startxref
+            $xrefPos
+            %%EOF
+        """.trimIndent().toByteArray())
+        
+        return output.toByteArray()
+    }
+    
+    /**
+     * Generate a PDF with one text field whose widgets are spread over
+     * [pageCount] pages, one widget per page.
+     *
+     * @return ByteArray containing the PDF content
+     */
+    fun generateMultiPageFormPdf(pageCount: Int = 3): ByteArray {
+        val output = ByteArrayOutputStream()
+        
+        // PDF Header
+        output.write("%PDF-1.4\n".toByteArray())
+        output.write("%âãÏÓ\n".toByteArray())
+        
+        val objects = mutableListOf<ByteArray>()
+        // Per page: page, contents and widget objects, starting at 4
+        val pageRefs = (0 until pageCount).joinToString(" ") { "${4 + it * 3} 0 R" }
+        val widgetRefs = (0 until pageCount).joinToString(" ") { "${6 + it * 3} 0 R" }
+        
+        // Object 1: Catalog with AcroForm
+        objects.add("""
+            1 0 obj
+            <<
+            /Type /Catalog
+            /Pages 2 0 R
+            /AcroForm <<
+            /Fields [3 0 R]
+            /NeedAppearances true
+            >>
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 2: Pages
+        objects.add("""
+            2 0 obj
+            <<
+            /Type /Pages
+            /Kids [$pageRefs]
+            /Count $pageCount
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 3: Text field holding the widgets
+        objects.add("""
+            3 0 obj
+            <<
+            /FT /Tx
+            /T (shared)
+            /V (Shared Text)
+            /Kids [$widgetRefs]
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        for (i in 0 until pageCount) {
+            val pageObj = 4 + i * 3
+            objects.add("""
+                $pageObj 0 obj
+                <<
+                /Type /Page
+                /Parent 2 0 R
+                /MediaBox [0 0 612 792]
+                /Contents ${pageObj + 1} 0 R
+                /Annots [${pageObj + 2} 0 R]
+                >>
+                endobj
+            """.trimIndent().toByteArray())
+            
+            objects.add("""
+                ${pageObj + 1} 0 obj
+                <<
+                /Length 0
+                >>
+                stream
+                endstream
+                endobj
+            """.trimIndent().toByteArray())
+            
+            objects.add("""
+                ${pageObj + 2} 0 obj
+                <<
+                /Type /Annot
+                /Subtype /Widget
+                /Parent 3 0 R
+                /P $pageObj 0 R
+                /Rect [50 700 250 720]
+                /F 4
+                >>
+                endobj
+            """.trimIndent().toByteArray())
+        }
+        
+        // Write objects
+        val offsets = mutableListOf<Long>()
+        objects.forEach { obj ->
+            offsets.add(output.size().toLong())
+            output.write(obj)
+            output.write("\n".toByteArray())
+        }
+        
+        // Write xref
+        val xrefPos = output.size()
+        output.write("xref\n".toByteArray())
+        output.write("0 ${objects.size + 1}\n".toByteArray())
+        output.write("0000000000 65535 f \n".toByteArray())
+        offsets.forEach { offset ->
+            output.write(String.format("%010d 00000 n \n", offset).toByteArray())
+        }
+        
+        // Write trailer
+        output.write("""
+            trailer
+            <<
+            /Size ${objects.size + 1}
+            /Root 1 0 R
+            >>
+            startxref
+            $xrefPos
+            %%EOF
+        """.trimIndent().toByteArray())
+        
+        return output.toByteArray()
+    }
+    
+    /**
+     * Generate a simple PDF that mimics XFA structure.
+     * Note: True XFA forms require complex XML structure.
+     * This is a simplified version for testing detection.
+     * 
+     * @return ByteArray containing the PDF content
+     */
+    fun generateXfaPdf(): ByteArray {
+        val output = ByteArrayOutputStream()
+        
+        // PDF Header
+        output.write("%PDF-1.5\n".toByteArray())
+        output.write("%âãÏÓ\n".toByteArray())
+        
+        val objects = mutableListOf<ByteArray>()
+        
+        // Simple XFA XML content
+        val xfaContent = """
+            <?xml version="1.0" encoding="UTF-8"?>
+            <xdp:xdp xmlns:xdp="http://ns.adobe.com/xdp/">
+                <template xmlns="http://www.xfa.org/schema/xfa-template/3.3/">
+                    <subform name="form1">
+                        <field name="TextField1">
+                            <ui>
+                                <textEdit/>
+                            </ui>
+                        </field>
+                    </subform>
+                </template>
+            </xdp:xdp>
+        """.trimIndent()
+        
+        // Object 1: Catalog with XFA
+        objects.add("""
+            1 0 obj
+            <<
+            /Type /Catalog
+            /Pages 2 0 R
+            /AcroForm <<
+            /Fields []
+            /XFA [
+            (template) 5 0 R
+            ]
+            >>
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 2: Pages
+        objects.add("""
+            2 0 obj
+            <<
+            /Type /Pages
+            /Kids [3 0 R]
+            /Count 1
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 3: Page
+        objects.add("""
+            3 0 obj
+            <<
+            /Type /Page
+            /Parent 2 0 R
+            /MediaBox [0 0 612 792]
+            /Contents 4 0 R
+            /Resources <<
+            /ProcSet [/PDF]
+            >>
+            >>
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 4: Contents
+        objects.add("""
+            4 0 obj
+            <<
+            /Length 0
+            >>
+            stream
+            endstream
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Object 5: XFA Stream
+        val xfaBytes = xfaContent.toByteArray()
+        objects.add("""
+            5 0 obj
+            <<
+            /Length ${xfaBytes.size}
+            >>
+            stream
+            $xfaContent
+            endstream
+            endobj
+        """.trimIndent().toByteArray())
+        
+        // Write objects
+        val offsets = mutableListOf<Long>()
+        objects.forEach { obj ->
+            offsets.add(output.size().toLong())
+            output.write(obj)
+            output.write("\n".toByteArray())
+        }
+        
+        // Write xref
+        val xrefPos = output.size()
+        output.write("xref\n".toByteArray())
+        output.write("0 ${objects.size + 1}\n".toByteArray())
+        output.write("0000000000 65535 f \n".toByteArray())
+        offsets.forEach { offset ->
+            output.write(String.format("%010d 00000 n \n", offset).toByteArray())
+        }
+        
+        // Write trailer
+        output.write("""
+            trailer
+            <<
+            /Size ${objects.size + 1}
+            /Root 1 0 R
+            >>
+            startxref
+            $xrefPos
+            %%EOF
+        """.trimIndent().toByteArray())
+        
+        return output.toByteArray()
+    }
+}
@@ -6,10 +6,29 @@
 
 #include <jni.h>
 #include <string>
+#include <algorithm>
 #include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 #include <map>
+#include <unordered_set>
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <functional>
 #include <android/log.h>
 #include <android/bitmap.h>
+#include <android/sharedmem.h>
+#include <android/trace.h>
+#include <android/hardware_buffer.h>
+#include <android/hardware_buffer_jni.h>
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 #include <fpdfview.h>
 #include <fpdf_doc.h>
 #include <fpdf_text.h>
@@ -33,2720 +52,3952 @@
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
 #define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
 
-static int libraryReferenceCount = 0;
-static std::map<FPDF_DOCUMENT, char*> g_docBuffers;
-
-extern "C" {
-
 /**
- * Initialize PDFium library
+ * Locking policy
+ *
+ * PDFium is not thread-safe, even across unrelated documents: it keeps
+ * process-wide state such as font caches and the last error. By default every
+ * JNI entry point holds g_pdfiumMutex (through PdfiumLock) for its whole
+ * duration, which serializes all PDFium work in the process. The mutex is
+ * recursive because some entry points call back into Java (range fetchers),
+ * and that Java code may re-enter.
+ *
+ * A process that keeps PDFium on a single thread, such as a dedicated render
+ * worker process, can turn the lock off with nativeSetLockingEnabled(false).
+ * Every process has its own PDFium instance, so documents in different worker
+ * processes never contend for a lock.
+ *
+ * The library refcount and the document resource registry have their own
+ * locks. They stay protected under either policy.
  */
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeInitLibrary(JNIEnv *env, jobject thiz) {
-    if (libraryReferenceCount == 0) {
-        FPDF_LIBRARY_CONFIG config;
-        config.version = 2;
-        config.m_pUserFontPaths = nullptr;
-        config.m_pIsolate = nullptr;
-        config.m_v8EmbedderSlot = 0;
-        FPDF_InitLibraryWithConfig(&config);
-        LOGI("PDFium library initialized");
+static std::recursive_mutex g_pdfiumMutex;
+static std::atomic<bool> g_lockingEnabled(true);
+
+class PdfiumLock {
+public:
+    PdfiumLock() : locked(g_lockingEnabled.load(std::memory_order_acquire)) {
+        if (locked) g_pdfiumMutex.lock();
     }
-    libraryReferenceCount++;
-}
+    ~PdfiumLock() {
+        if (locked) g_pdfiumMutex.unlock();
+    }
+    PdfiumLock(const PdfiumLock&) = delete;
+    PdfiumLock& operator=(const PdfiumLock&) = delete;
+
+private:
+    bool locked;
+};
+
+static std::mutex g_libraryMutex;
+static std::atomic<int> libraryReferenceCount(0);
 
 /**
- * Destroy PDFium library
+ * Random-access reader over a file descriptor, used with FPDF_LoadCustomDocument.
+ * PDFium pulls blocks on demand, so only the parts of the file that are actually
+ * parsed are ever read into memory. The descriptor is owned by this struct.
  */
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeDestroyLibrary(JNIEnv *env, jobject thiz) {
-    libraryReferenceCount--;
-    if (libraryReferenceCount == 0) {
-        FPDF_DestroyLibrary();
-        LOGI("PDFium library destroyed");
+struct FdFileAccess : public FPDF_FILEACCESS {
+    int fd;
+
+    static int GetBlockImpl(void *param, unsigned long position,
+                            unsigned char *pBuf, unsigned long size) {
+        FdFileAccess *self = (FdFileAccess*) param;
+        unsigned char *ptr = pBuf;
+        unsigned long remaining = size;
+        off_t offset = (off_t) position;
+        while (remaining > 0) {
+            ssize_t bytesRead = pread(self->fd, ptr, remaining, offset);
+            if (bytesRead < 0 && errno == EINTR) continue;
+            if (bytesRead <= 0) {
+                LOGE("pread failed at offset %ld (%lu bytes left)", (long) offset, remaining);
+                return 0;
+            }
+            ptr += bytesRead;
+            offset += bytesRead;
+            remaining -= bytesRead;
+        }
+        return 1;
     }
-}
+};
 
 /**
- * Get last error code
+ * Get a JNIEnv for the calling thread, attaching it to the VM if needed.
  */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetLastError(JNIEnv *env, jobject thiz) {
-    return (jint) FPDF_GetLastError();
+static JNIEnv* getThreadEnv(JavaVM *vm) {
+    JNIEnv *env = nullptr;
+    jint status = vm->GetEnv((void**) &env, JNI_VERSION_1_6);
+    if (status == JNI_EDETACHED) {
+        if (vm->AttachCurrentThread(&env, nullptr) != JNI_OK) return nullptr;
+    } else if (status != JNI_OK) {
+        return nullptr;
+    }
+    return env;
 }
 
 /**
- * Open document from file descriptor
+ * Range-request data provider behind FPDF_AVAIL.
+ *
+ * Bytes are fetched from a Java PdfRangeFetcher in fixed-size chunks and kept in a
+ * sparse cache, so only the ranges PDFium reports through FX_DOWNLOADHINTS (or
+ * actually reads) are ever downloaded. Contiguous missing chunks are coalesced
+ * into a single fetch to keep the number of round trips low.
  */
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeOpenDocument(JNIEnv *env, jobject thiz,
-                                                      jint fd, jstring password) {
-    const char *cPassword = nullptr;
-    if (password != nullptr) {
-        cPassword = env->GetStringUTFChars(password, nullptr);
+struct RangeLoader {
+    static const size_t kChunkSize = 64 * 1024;
+
+    struct FileAvail : public FX_FILEAVAIL {
+        RangeLoader *owner;
+    };
+
+    struct DownloadHints : public FX_DOWNLOADHINTS {
+        RangeLoader *owner;
+    };
+
+    JavaVM *vm = nullptr;
+    jobject fetcher = nullptr;          // Global ref to the PdfRangeFetcher
+    jmethodID fetchMethod = nullptr;
+    size_t fileLength = 0;
+    bool fetchFailed = false;
+
+    FileAvail fileAvail;
+    DownloadHints hints;
+    FPDF_FILEACCESS fileAccess;
+    FPDF_AVAIL avail = nullptr;
+
+    std::map<size_t, std::vector<unsigned char>> chunks;
+    std::vector<std::pair<size_t, size_t>> pendingSegments;
+
+    size_t chunkCount() const {
+        return (fileLength + kChunkSize - 1) / kChunkSize;
     }
 
-    // Get file size
-    off_t fileSize = lseek(fd, 0, SEEK_END);
-    if (fileSize <= 0) {
-        if (password != nullptr) {
-            env->ReleaseStringUTFChars(password, cPassword);
+    bool hasRange(size_t offset, size_t size) const {
+        if (size == 0) return true;
+        if (offset >= fileLength) return false;
+        size_t last = std::min(offset + size, fileLength) - 1;
+        for (size_t i = offset / kChunkSize; i <= last / kChunkSize; i++) {
+            if (chunks.find(i) == chunks.end()) return false;
         }
-        LOGE("Failed to get file size or empty file");
-        return 0;
+        return true;
     }
-    lseek(fd, 0, SEEK_SET);
-    
-    char *buffer = new (std::nothrow) char[fileSize];
-    if (!buffer) {
-        if (password != nullptr) {
-            env->ReleaseStringUTFChars(password, cPassword);
+
+    /**
+     * Download chunks [first, first + count) in a single call to the Java
+     * fetcher. Touches no loader state, so it can run without the library lock.
+     * Returns null on failure.
+     */
+    jbyteArray downloadChunks(JNIEnv *env, size_t first, size_t count) const {
+        size_t position = first * kChunkSize;
+        size_t length = std::min(count * kChunkSize, fileLength - position);
+
+        jbyteArray data = (jbyteArray) env->CallObjectMethod(fetcher, fetchMethod,
+                                                             (jlong) position, (jint) length);
+        if (env->ExceptionCheck()) {
+            env->ExceptionDescribe();
+            env->ExceptionClear();
+            data = nullptr;
         }
-        LOGE("Failed to allocate buffer of size %ld", (long)fileSize);
-        return 0;
-    }
-    
-    // Read file with proper loop to handle partial reads
-    char *ptr = buffer;
-    size_t remaining = fileSize;
-    while (remaining > 0) {
-        ssize_t bytesRead = read(fd, ptr, remaining);
-        if (bytesRead <= 0) {
-            delete[] buffer;
-            if (password != nullptr) {
-                env->ReleaseStringUTFChars(password, cPassword);
-            }
-            LOGE("Read error: only read %ld of %ld bytes", (long)(fileSize - remaining), (long)fileSize);
-            return 0;
+        if (!data || (size_t) env->GetArrayLength(data) != length) {
+            LOGE("Range fetch failed at %zu (%zu bytes)", position, length);
+            if (data) env->DeleteLocalRef(data);
+            return nullptr;
         }
-        ptr += bytesRead;
-        remaining -= bytesRead;
+        return data;
     }
-    
-    FPDF_DOCUMENT doc = FPDF_LoadMemDocument(buffer, fileSize, cPassword);
-    
-    if (password != nullptr) {
-        env->ReleaseStringUTFChars(password, cPassword);
+
+    /**
+     * Store what downloadChunks returned for [first, first + count) and drop
+     * the local ref. A null result marks the loader as failed.
+     */
+    bool storeChunks(JNIEnv *env, size_t first, size_t count, jbyteArray data) {
+        if (!data) {
+            fetchFailed = true;
+            return false;
+        }
+        size_t length = (size_t) env->GetArrayLength(data);
+        for (size_t i = 0; i < count; i++) {
+            size_t chunkOffset = i * kChunkSize;
+            size_t chunkLength = std::min(kChunkSize, length - chunkOffset);
+            std::vector<unsigned char> &chunk = chunks[first + i];
+            chunk.resize(chunkLength);
+            env->GetByteArrayRegion(data, (jsize) chunkOffset, (jsize) chunkLength,
+                                    (jbyte*) chunk.data());
+        }
+        env->DeleteLocalRef(data);
+        return true;
     }
-    
-    if (!doc) {
-        delete[] buffer;
-        LOGE("Failed to load document, error: %lu", FPDF_GetLastError());
-        return 0;
+
+    // Runs of missing chunks [first, first + count) covering [offset, offset + size), appended to runs
+    void missingRuns(size_t offset, size_t size, std::vector<std::pair<size_t, size_t>> &runs) const {
+        if (size == 0 || offset >= fileLength) return;
+        size_t first = offset / kChunkSize;
+        size_t last = (std::min(offset + size, fileLength) - 1) / kChunkSize;
+
+        size_t i = first;
+        while (i <= last) {
+            if (chunks.find(i) != chunks.end()) {
+                i++;
+                continue;
+            }
+            size_t runStart = i;
+            while (i <= last && chunks.find(i) == chunks.end()) i++;
+            runs.emplace_back(runStart, i - runStart);
+        }
     }
-    
-    // Track buffer for cleanup when document is closed
-    g_docBuffers[doc] = buffer;
-    LOGI("Document opened successfully, pages: %d", FPDF_GetPageCount(doc));
-    return (jlong) doc;
-}
 
-/**
- * Open document from memory buffer
- */
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeOpenMemDocument(JNIEnv *env, jobject thiz,
-                                                         jbyteArray data, jstring password) {
-    const char *cPassword = nullptr;
-    if (password != nullptr) {
-        cPassword = env->GetStringUTFChars(password, nullptr);
+    // Synchronous fetch for GetBlock, which PDFium calls with the library lock held
+    bool fetchRange(size_t offset, size_t size) {
+        JNIEnv *env = getThreadEnv(vm);
+        if (!env) return false;
+        std::vector<std::pair<size_t, size_t>> runs;
+        missingRuns(offset, size, runs);
+        for (const auto &run : runs) {
+            if (!storeChunks(env, run.first, run.second, downloadChunks(env, run.first, run.second))) return false;
+        }
+        return true;
     }
-    
-    jsize length = env->GetArrayLength(data);
-    jbyte *buffer = env->GetByteArrayElements(data, nullptr);
-    
-    // We must copy the data because ReleaseByteArrayElements might free 'buffer'
-    // and PDFium needs it to persist until the document is closed.
-    // However, FPDF_LoadMemDocument copies the data internally usually? 
-    // Wait, FPDF_LoadMemDocument documentation says:
-    // "The memory buffer must remain valid during the life-time of the document."
-    // So we absolutely need to allocate a copy that persists.
-    
-    char* docBuffer = new char[length];
-    memcpy(docBuffer, buffer, length);
 
-    FPDF_DOCUMENT doc = FPDF_LoadMemDocument(docBuffer, length, cPassword);
-    
-    env->ReleaseByteArrayElements(data, buffer, 0);
-    if (password != nullptr) {
-        env->ReleaseStringUTFChars(password, cPassword);
+    /**
+     * Take the segments PDFium has hinted at since the last call off the
+     * pending list and return the chunk runs still missing for them. When
+     * none are (PDFium reported NOTAVAIL without hints after reading through
+     * GetBlock, or its hint tables are malformed), the first missing chunk is
+     * returned instead so every round makes progress; an empty result means
+     * the whole file is cached and waiting longer cannot help.
+     */
+    std::vector<std::pair<size_t, size_t>> takeMissingRuns() {
+        std::vector<std::pair<size_t, size_t>> runs;
+        for (const auto &segment : pendingSegments) missingRuns(segment.first, segment.second, runs);
+        pendingSegments.clear();
+        if (runs.empty()) {
+            for (size_t i = 0; i < chunkCount(); i++) {
+                if (chunks.find(i) == chunks.end()) {
+                    runs.emplace_back(i, 1);
+                    break;
+                }
+            }
+        }
+        return runs;
     }
-    
-    if (!doc) {
-        delete[] docBuffer;
-        LOGE("Failed to load document from memory, error: %lu", FPDF_GetLastError());
-        return 0;
+
+    static FPDF_BOOL IsDataAvailImpl(FX_FILEAVAIL *pThis, size_t offset, size_t size) {
+        RangeLoader *self = ((FileAvail*) pThis)->owner;
+        return self->hasRange(offset, size);
     }
-    
-    // Track buffer for cleanup when document is closed
-    g_docBuffers[doc] = docBuffer;
-    LOGI("Document opened from memory, pages: %d", FPDF_GetPageCount(doc));
-    return (jlong) doc;
-}
 
-/**
- * Open document from file path
- */
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeOpenDocumentPath(JNIEnv *env, jobject thiz,
-                                                          jstring path, jstring password) {
-    const char *cPath = env->GetStringUTFChars(path, nullptr);
-    const char *cPassword = nullptr;
-    if (password != nullptr) {
-        cPassword = env->GetStringUTFChars(password, nullptr);
+    static void AddSegmentImpl(FX_DOWNLOADHINTS *pThis, size_t offset, size_t size) {
+        RangeLoader *self = ((DownloadHints*) pThis)->owner;
+        self->pendingSegments.emplace_back(offset, size);
     }
 
-    // FPDF_LoadDocument() is not a standard exported function in some builds,
-    // but FPDF_LoadCustomDocument is. However, standart fpdfview.h usually has:
-    // FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV FPDF_LoadDocument(FPDF_STRING file_path, FPDF_BYTESTRING password);
-    // Let's try it.
-    FPDF_DOCUMENT doc = FPDF_LoadDocument(cPath, cPassword);
+    static int GetBlockImpl(void *param, unsigned long position,
+                            unsigned char *pBuf, unsigned long size) {
+        RangeLoader *self = (RangeLoader*) param;
+        if (position + size > self->fileLength) return 0;
 
-    env->ReleaseStringUTFChars(path, cPath);
-    if (password != nullptr) {
-        env->ReleaseStringUTFChars(password, cPassword);
-    }
+        // PDFium normally only reads what it reported as available, but fall back
+        // to a synchronous fetch rather than failing the parse
+        if (!self->hasRange(position, size) && !self->fetchRange(position, size)) {
+            return 0;
+        }
 
-    if (!doc) {
-        LOGE("Failed to load document from path, error: %lu", FPDF_GetLastError());
-        return 0;
+        size_t offset = position;
+        unsigned char *ptr = pBuf;
+        size_t remaining = size;
+        while (remaining > 0) {
+            const std::vector<unsigned char> &chunk = self->chunks[offset / kChunkSize];
+            size_t chunkOffset = offset % kChunkSize;
+            size_t n = std::min(remaining, chunk.size() - chunkOffset);
+            memcpy(ptr, chunk.data() + chunkOffset, n);
+            ptr += n;
+            offset += n;
+            remaining -= n;
+        }
+        return 1;
     }
+};
 
-    return (jlong) doc;
+static void destroyRangeLoader(RangeLoader *loader) {
+    if (!loader) return;
+    if (loader->avail) FPDFAvail_Destroy(loader->avail);
+    JNIEnv *env = getThreadEnv(loader->vm);
+    if (env && loader->fetcher) env->DeleteGlobalRef(loader->fetcher);
+    delete loader;
 }
 
 /**
- * Close document
+ * Native resources that must outlive an open document and are released
+ * by nativeCloseDocument.
  */
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeCloseDocument(JNIEnv *env, jobject thiz,
-                                                       jlong docPtr) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (doc) {
-        FPDF_CloseDocument(doc);
-        
-        // Free the buffer associated with this document
-        auto it = g_docBuffers.find(doc);
-        if (it != g_docBuffers.end()) {
-            delete[] it->second;
-            g_docBuffers.erase(it);
-        }
-        LOGI("Document closed");
-    }
+struct DocumentResources {
+    char *buffer = nullptr;                 // Heap copy for in-memory opens
+    FdFileAccess *fileAccess = nullptr;     // On-demand reader for streaming opens
+    RangeLoader *rangeLoader = nullptr;     // Data provider for progressive opens
+    jobject pinnedBuffer = nullptr;         // Global ref keeping a direct ByteBuffer alive
+    size_t pinnedOffset = 0;                // Start of the document in pinnedBuffer
+    size_t bufferBytes = 0;                 // Size of buffer or pinnedBuffer
+    uint64_t savedLength = 0;               // File length after the last in-place save, or 0
+};
+
+static std::mutex g_docResourcesMutex;
+static std::map<FPDF_DOCUMENT, DocumentResources> g_docResources;
+
+static void trackDocumentResources(FPDF_DOCUMENT doc, const DocumentResources &res) {
+    std::lock_guard<std::mutex> guard(g_docResourcesMutex);
+    g_docResources[doc] = res;
 }
 
 /**
- * Get page count
+ * Remove a document from the registry. Returns false if it was not tracked.
  */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageCount(JNIEnv *env, jobject thiz,
-                                                      jlong docPtr) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return 0;
-    return FPDF_GetPageCount(doc);
+static bool untrackDocumentResources(FPDF_DOCUMENT doc, DocumentResources *out) {
+    std::lock_guard<std::mutex> guard(g_docResourcesMutex);
+    auto it = g_docResources.find(doc);
+    if (it == g_docResources.end()) return false;
+    *out = it->second;
+    g_docResources.erase(it);
+    return true;
+}
+
+static void releaseDocumentResources(JNIEnv *env, DocumentResources &res) {
+    if (res.pinnedBuffer) {
+        env->DeleteGlobalRef(res.pinnedBuffer);
+        res.pinnedBuffer = nullptr;
+    }
+    delete[] res.buffer;
+    res.buffer = nullptr;
+    if (res.fileAccess) {
+        close(res.fileAccess->fd);
+        delete res.fileAccess;
+        res.fileAccess = nullptr;
+    }
+    destroyRangeLoader(res.rangeLoader);
+    res.rangeLoader = nullptr;
 }
 
 /**
- * Get document metadata
+ * Bytes of the document source when it is held in memory, or nullptr.
  */
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetMetaText(JNIEnv *env, jobject thiz,
-                                                     jlong docPtr, jstring tag) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return nullptr;
-    
-    const char *cTag = env->GetStringUTFChars(tag, nullptr);
-    
-    // First call to get required buffer size
-    unsigned long size = FPDF_GetMetaText(doc, cTag, nullptr, 0);
-    if (size == 0) {
-        env->ReleaseStringUTFChars(tag, cTag);
-        return env->NewStringUTF("");
-    }
-    
-    // Allocate buffer and get text
-    // FPDF_GetMetaText returns size in bytes including terminator.
-    // The buffer should be cast to unsigned short* (UTF-16LE).
-    unsigned short *buffer = new unsigned short[size];
-    FPDF_GetMetaText(doc, cTag, buffer, size);
-    
-    env->ReleaseStringUTFChars(tag, cTag);
-    
-    // Convert UTF-16 to Java string. Size is in bytes, so divide by 2.
-    // Subtract 1 for null terminator if it exists (check logic safely)
-    jstring result = env->NewString((jchar*) buffer, size / 2 - 1);
-    delete[] buffer;
-    
-    return result;
+static const uint8_t *sourceMemory(JNIEnv *env, const DocumentResources &res) {
+    if (res.buffer) return (const uint8_t*) res.buffer;
+    if (!res.pinnedBuffer) return nullptr;
+    const uint8_t *address = (const uint8_t*) env->GetDirectBufferAddress(res.pinnedBuffer);
+    return address ? address + res.pinnedOffset : nullptr;
 }
 
 /**
- * Get page label (actual page number as displayed in PDF)
+ * Instrumentation
+ *
+ * TraceSection emits ATrace sections (visible in Perfetto and systrace) around
+ * the load, parse, render, text and save entry points. DocumentStats counts work
+ * per document and across the whole process; nativeGetStats reads it. The
+ * counters are protected by PdfiumLock.
  */
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageLabel(JNIEnv *env, jobject thiz,
-                                                      jlong docPtr, jint pageIndex) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return env->NewStringUTF("");
-    
-    // First call to get required buffer size
-    unsigned long size = FPDF_GetPageLabel(doc, pageIndex, nullptr, 0);
-    if (size == 0) {
-        return env->NewStringUTF("");
+class TraceSection {
+public:
+    explicit TraceSection(const char *name) {
+        ATrace_beginSection(name);
     }
-    
-    // Allocate buffer and get label
-    // FPDF_GetPageLabel returns UTF-16LE encoded string
-    unsigned short *buffer = new unsigned short[size];
-    FPDF_GetPageLabel(doc, pageIndex, buffer, size * sizeof(unsigned short));
-    
-    // Convert UTF-16 to Java string
-    jstring result = env->NewString((jchar*) buffer, size / 2 - 1);
-    delete[] buffer;
-    
-    return result ? result : env->NewStringUTF("");
+    ~TraceSection() {
+        ATrace_endSection();
+    }
+    TraceSection(const TraceSection&) = delete;
+    TraceSection& operator=(const TraceSection&) = delete;
+};
+
+// Upper bounds (ms) of the render time histogram buckets; the last bucket is open-ended
+static const int kRenderBucketCount = 10;
+static const uint64_t kRenderBucketBoundsMs[kRenderBucketCount - 1] = {1, 2, 4, 8, 16, 32, 64, 128, 256};
+
+struct DocumentStats {
+    uint64_t pagesLoaded = 0;
+    uint64_t textPagesLoaded = 0;
+    uint64_t renders = 0;
+    uint64_t renderNanos = 0;
+    uint64_t renderBuckets[kRenderBucketCount] = {};
+
+    void addRender(uint64_t nanos) {
+        renders++;
+        renderNanos += nanos;
+        uint64_t ms = nanos / 1000000;
+        int bucket = 0;
+        while (bucket < kRenderBucketCount - 1 && ms >= kRenderBucketBoundsMs[bucket]) bucket++;
+        renderBuckets[bucket]++;
+    }
+};
+
+static DocumentStats g_processStats;
+static std::map<FPDF_DOCUMENT, DocumentStats> g_docStats;
+struct PageOwner {
+    FPDF_DOCUMENT doc;
+    int index;      // -1 once pages were inserted or removed after loading
+};
+static std::map<FPDF_PAGE, PageOwner> g_pageOwners;    // Pages loaded through nativeLoadPage
+
+static void recordPageLoad(FPDF_DOCUMENT doc, FPDF_PAGE page, int index) {
+    g_pageOwners[page] = PageOwner{doc, index};
+    g_docStats[doc].pagesLoaded++;
+    g_processStats.pagesLoaded++;
 }
 
-/**
- * Load Page
- */
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeLoadPage(JNIEnv *env, jobject thiz,
-                                                  jlong docPtr, jint pageIndex) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return 0;
-    return (jlong) FPDF_LoadPage(doc, pageIndex);
+// Areas PDFium asked to repaint through the form fill callbacks, in page
+// coordinates, until drained by nativePollFormDirtyRects
+static std::map<FPDF_PAGE, std::vector<FS_RECTF>> g_formDirtyRects;
+
+static void forgetPage(FPDF_PAGE page) {
+    g_pageOwners.erase(page);
+    g_formDirtyRects.erase(page);
 }
 
-/**
- * Close Page
- */
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeClosePage(JNIEnv *env, jobject thiz,
-                                                   jlong pagePtr) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (page) {
-        FPDF_ClosePage(page);
+static void recordTextPageLoad(FPDF_DOCUMENT doc) {
+    g_docStats[doc].textPagesLoaded++;
+    g_processStats.textPagesLoaded++;
+}
+
+static void recordRender(FPDF_PAGE page, uint64_t nanos) {
+    g_processStats.addRender(nanos);
+    auto it = g_pageOwners.find(page);
+    if (it != g_pageOwners.end()) g_docStats[it->second.doc].addRender(nanos);
+}
+
+static void forgetDocumentStats(FPDF_DOCUMENT doc) {
+    g_docStats.erase(doc);
+    for (auto it = g_pageOwners.begin(); it != g_pageOwners.end();) {
+        if (it->second.doc == doc) {
+            g_formDirtyRects.erase(it->first);
+            it = g_pageOwners.erase(it);
+        } else {
+            ++it;
+        }
     }
 }
 
 /**
- * Get Page Width
+ * Records the time of one full page render on destruction
  */
-JNIEXPORT jdouble JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageWidth(JNIEnv *env, jobject thiz,
-                                                      jlong pagePtr) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return 0.0;
-    return FPDF_GetPageWidth(page);
-}
+class RenderTimer {
+public:
+    explicit RenderTimer(FPDF_PAGE page) : page(page), start(std::chrono::steady_clock::now()) {}
+    ~RenderTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        recordRender(page, (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+    RenderTimer(const RenderTimer&) = delete;
+    RenderTimer& operator=(const RenderTimer&) = delete;
+
+private:
+    FPDF_PAGE page;
+    std::chrono::steady_clock::time_point start;
+};
 
 /**
- * Get Page Height
+ * Edit revisions, so render caches above JNI can tell when output is stale.
+ *
+ * Each page index has a counter that is bumped by edits which change how the
+ * page renders (content generation, flattening, annotation changes). Inserting
+ * or removing pages shifts indices, so it bumps the document-wide structure
+ * counter instead. The serial is unique per opened document in this process,
+ * which keeps keys distinct when a closed document's handle is reused.
  */
-JNIEXPORT jdouble JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageHeight(JNIEnv *env, jobject thiz,
-                                                       jlong pagePtr) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return 0.0;
-    return FPDF_GetPageHeight(page);
+struct DocumentRevisions {
+    uint64_t serial;
+    uint32_t structure = 0;
+    std::map<int, uint32_t> pages;
+};
+
+static std::map<FPDF_DOCUMENT, DocumentRevisions> g_docRevisions;
+static std::map<FPDF_ANNOTATION, FPDF_PAGE> g_annotPages;  // Annotations handed out by page
+static uint64_t g_nextDocumentSerial = 1;
+
+static DocumentRevisions& getDocumentRevisions(FPDF_DOCUMENT doc) {
+    auto it = g_docRevisions.find(doc);
+    if (it == g_docRevisions.end()) {
+        it = g_docRevisions.emplace(doc, DocumentRevisions{g_nextDocumentSerial++}).first;
+    }
+    return it->second;
 }
 
-/**
- * Get Page Size by Index (without loading page)
- * This is much faster than loadPage+getWidth/getHeight for bulk size queries.
- */
-JNIEXPORT jdoubleArray JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageSizeByIndex(JNIEnv *env, jobject thiz,
-                                                            jlong docPtr, jint pageIndex) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return nullptr;
-    
-    double width = 0.0, height = 0.0;
-    int success = FPDF_GetPageSizeByIndex(doc, pageIndex, &width, &height);
-    
-    if (!success) {
-        // Return default A4 size if failed
-        width = 595.0;
-        height = 842.0;
+static void markStructureEdited(FPDF_DOCUMENT doc) {
+    getDocumentRevisions(doc).structure++;
+    // Indices recorded for open pages no longer hold
+    for (auto &pair : g_pageOwners) {
+        if (pair.second.doc == doc) pair.second.index = -1;
+    }
+}
+
+static void markPageEdited(FPDF_PAGE page) {
+    auto it = g_pageOwners.find(page);
+    if (it == g_pageOwners.end()) return;
+    if (it->second.index < 0) {
+        getDocumentRevisions(it->second.doc).structure++;
+    } else {
+        getDocumentRevisions(it->second.doc).pages[it->second.index]++;
     }
-    
-    jdoubleArray result = env->NewDoubleArray(2);
-    jdouble values[2] = {width, height};
-    env->SetDoubleArrayRegion(result, 0, 2, values);
-    return result;
+}
+
+static void trackAnnot(FPDF_ANNOTATION annot, FPDF_PAGE page) {
+    if (annot) g_annotPages[annot] = page;
+}
+
+static void markAnnotEdited(FPDF_ANNOTATION annot) {
+    auto it = g_annotPages.find(annot);
+    if (it != g_annotPages.end()) markPageEdited(it->second);
+}
+
+static void forgetDocumentRevisions(FPDF_DOCUMENT doc) {
+    g_docRevisions.erase(doc);
 }
 
 /**
- * Render Page to Bitmap
+ * Per-document map of fully qualified field name to its widgets, so lookups
+ * by name don't walk every page.
+ *
+ * Built on the first lookup. Afterwards the edit revisions drive updates:
+ * a page whose revision moved (annotations created, removed or edited) is
+ * re-indexed on its own, and a structure change (pages inserted, removed or
+ * imported) rebuilds the whole index.
  */
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeRenderPageBitmap(JNIEnv *env, jobject thiz,
-                                                          jlong pagePtr, jobject bitmap,
-                                                          jint startX, jint startY,
-                                                          jint drawWidth, jint drawHeight,
-                                                          jboolean renderAnnot) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page || !bitmap) return;
+struct FieldWidget {
+    int page;
+    int annot;
+};
 
-    AndroidBitmapInfo info;
-    int ret = AndroidBitmap_getInfo(env, bitmap, &info);
-    if (ret != ANDROID_BITMAP_RESULT_SUCCESS) {
-        LOGE("AndroidBitmap_getInfo failed: %d", ret);
-        return;
+struct FormFieldIndex {
+    bool built = false;
+    uint32_t structure = 0;
+    std::map<int, uint32_t> pageRevisions;                 // Revision each page was indexed at
+    std::map<int, std::vector<std::u16string>> pageNames;  // Names indexed per page
+    std::map<std::u16string, std::vector<FieldWidget>> fields;   // Widgets in (page, annot) order
+};
+
+static std::map<FPDF_DOCUMENT, FormFieldIndex> g_formFieldIndexes;
+
+static void forgetFormFieldIndex(FPDF_DOCUMENT doc) {
+    g_formFieldIndexes.erase(doc);
+}
+
+/**
+ * Per-document LRU of loaded FPDF_PAGE handles (and optionally FPDF_TEXTPAGE).
+ *
+ * nativeLoadPage hands out leases on cached pages instead of parsing the page
+ * again; nativeClosePage returns the lease. Pages without leases are evicted
+ * least-recently-used first once the estimated bytes held exceed the capacity.
+ * Leased pages are never evicted, so the cache may run over capacity while many
+ * pages are open. Adding or removing pages shifts indices, so those operations
+ * call invalidate(): unleased entries are closed, and leased ones are orphaned
+ * (closed on their last release).
+ *
+ * A cached page is leased to one holder at a time. FPDF_PAGE carries state of
+ * its holder (a progressive render, a form page view), so a second opener of
+ * the same index gets a private page that is closed on release. If a private
+ * page was edited, the cached copy is dropped on its release, so later openers
+ * parse the new content.
+ *
+ * All cache state is protected by PdfiumLock.
+ */
+struct PageCache {
+    static const size_t kDefaultCapacity = 8 * 1024 * 1024;
+
+    // Rough memory estimates; PDFium does not report per-page memory use
+    static const size_t kPageBaseCost = 16 * 1024;
+    static const size_t kPageObjectCost = 256;
+    static const size_t kTextCharCost = 64;
+
+    struct Entry {
+        int index;
+        FPDF_PAGE page;
+        FPDF_TEXTPAGE textPage;
+        int leases;
+        size_t cost;
+        bool orphaned;
+    };
+
+    // Page loaded for a second opener while the cached one was leased
+    struct PrivatePage {
+        int index;          // -1 once the structure changed
+        uint32_t revision;  // Edit revision when loaded
+    };
+
+    FPDF_DOCUMENT doc;
+    size_t capacity = kDefaultCapacity;
+    bool cacheTextPages = false;
+
+    std::list<Entry> lru;   // Most recently used first
+    std::map<int, std::list<Entry>::iterator> byIndex;
+    std::map<FPDF_PAGE, PrivatePage> privatePages;
+
+    size_t bytesHeld = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+
+    explicit PageCache(FPDF_DOCUMENT d) : doc(d) {}
+
+    std::list<Entry>::iterator find(FPDF_PAGE page) {
+        for (auto it = lru.begin(); it != lru.end(); ++it) {
+            if (it->page == page) return it;
+        }
+        return lru.end();
     }
 
-    // Validate bitmap dimensions
-    if (info.width == 0 || info.height == 0) {
-        LOGE("Invalid bitmap dimensions: %dx%d", info.width, info.height);
-        return;
+    bool manages(FPDF_PAGE page) {
+        return privatePages.count(page) > 0 || find(page) != lru.end();
     }
 
-    // Check bitmap format - PDFium requires 4 bytes per pixel (ARGB_8888)
-    // RGB_565 is NOT supported by FPDFBitmap_CreateEx
-    if (info.format != ANDROID_BITMAP_FORMAT_RGBA_8888) {
-        // Cannot render to RGB_565 or other formats directly
-        // Skip silently - caller should use ARGB_8888 bitmaps
-        return;
+    uint32_t revision(int index) {
+        const std::map<int, uint32_t> &pages = getDocumentRevisions(doc).pages;
+        auto it = pages.find(index);
+        return it != pages.end() ? it->second : 0;
     }
 
-    void *pixels;
-    ret = AndroidBitmap_lockPixels(env, bitmap, &pixels);
-    if (ret != ANDROID_BITMAP_RESULT_SUCCESS) {
-        LOGE("AndroidBitmap_lockPixels failed: %d", ret);
-        return;
+    std::list<Entry>::iterator findText(FPDF_TEXTPAGE textPage) {
+        for (auto it = lru.begin(); it != lru.end(); ++it) {
+            if (it->textPage == textPage) return it;
+        }
+        return lru.end();
     }
-    
-    // Create PDFium bitmap wrapper using BGRA format for ARGB_8888 Android bitmap
-    FPDF_BITMAP fpdfBitmap = FPDFBitmap_CreateEx(info.width, info.height, FPDFBitmap_BGRA, pixels, info.stride);
-    
-    if (!fpdfBitmap) {
-        LOGE("FPDFBitmap_CreateEx failed for %dx%d bitmap (stride=%d)", info.width, info.height, info.stride);
-        AndroidBitmap_unlockPixels(env, bitmap);
-        return;
+
+    void closeEntry(Entry &entry) {
+        if (entry.textPage) FPDFText_ClosePage(entry.textPage);
+        forgetPage(entry.page);
+        FPDF_ClosePage(entry.page);
+        bytesHeld -= entry.cost;
     }
 
-    // Fill background with white
-    FPDFBitmap_FillRect(fpdfBitmap, 0, 0, info.width, info.height, 0xFFFFFFFF);
+    void trim() {
+        auto it = lru.end();
+        while (bytesHeld > capacity && it != lru.begin()) {
+            --it;
+            if (it->leases > 0) continue;
+            byIndex.erase(it->index);
+            closeEntry(*it);
+            it = lru.erase(it);
+            evictions++;
+        }
+    }
 
-    int flags = FPDF_REVERSE_BYTE_ORDER; // Android uses ARGB, PDFium uses BGRA
-    if (renderAnnot) {
-        flags |= FPDF_ANNOT;
+    FPDF_PAGE acquire(int index) {
+        auto found = byIndex.find(index);
+        if (found != byIndex.end() && found->second->leases == 0) {
+            hits++;
+            lru.splice(lru.begin(), lru, found->second);
+            found->second->leases++;
+            return found->second->page;
+        }
+
+        misses++;
+        FPDF_PAGE page = FPDF_LoadPage(doc, index);
+        if (!page) return nullptr;
+        recordPageLoad(doc, page, index);
+        if (found != byIndex.end()) {
+            // In use by another holder: hand out a page of its own
+            privatePages[page] = PrivatePage{index, revision(index)};
+            return page;
+        }
+
+        size_t cost = kPageBaseCost + (size_t) FPDFPage_CountObjects(page) * kPageObjectCost;
+        lru.push_front(Entry{index, page, nullptr, 1, cost, false});
+        byIndex[index] = lru.begin();
+        bytesHeld += cost;
+        trim();
+        return page;
+    }
+
+    /**
+     * Return a lease. Returns false if the page is not managed by this cache.
+     */
+    bool release(FPDF_PAGE page) {
+        auto priv = privatePages.find(page);
+        if (priv != privatePages.end()) {
+            releasePrivate(priv);
+            return true;
+        }
+        auto it = find(page);
+        if (it == lru.end()) return false;
+        if (it->leases > 0) it->leases--;
+        if (it->leases == 0 && it->orphaned) {
+            closeEntry(*it);
+            lru.erase(it);
+        } else {
+            trim();
+        }
+        return true;
     }
 
-    FPDF_RenderPageBitmap(fpdfBitmap, page, startX, startY, drawWidth, drawHeight, 0, flags);
+    void releasePrivate(std::map<FPDF_PAGE, PrivatePage>::iterator priv) {
+        int index = priv->second.index;
+        bool edited = index >= 0 && revision(index) != priv->second.revision;
+        forgetPage(priv->first);
+        FPDF_ClosePage(priv->first);
+        privatePages.erase(priv);
+        if (!edited) return;
+
+        // The cached copy predates the edit; close it, or orphan it if still leased
+        auto found = byIndex.find(index);
+        if (found == byIndex.end()) return;
+        auto it = found->second;
+        byIndex.erase(found);
+        if (it->leases > 0) {
+            it->orphaned = true;
+        } else {
+            closeEntry(*it);
+            lru.erase(it);
+        }
+    }
 
-    FPDFBitmap_Destroy(fpdfBitmap);
-    AndroidBitmap_unlockPixels(env, bitmap);
+    /**
+     * Lease the text page of a cached page, loading it on first use.
+     * Returns nullptr if the page is not cached or text caching is off.
+     */
+    FPDF_TEXTPAGE acquireText(FPDF_PAGE page) {
+        if (!cacheTextPages) return nullptr;
+        auto it = find(page);
+        if (it == lru.end()) return nullptr;
+        if (!it->textPage) {
+            it->textPage = FPDFText_LoadPage(page);
+            if (!it->textPage) return nullptr;
+            recordTextPageLoad(doc);
+            size_t textCost = (size_t) FPDFText_CountChars(it->textPage) * kTextCharCost;
+            it->cost += textCost;
+            bytesHeld += textCost;
+        }
+        it->leases++;
+        return it->textPage;
+    }
+
+    bool releaseText(FPDF_TEXTPAGE textPage) {
+        auto it = findText(textPage);
+        if (it == lru.end()) return false;
+        release(it->page);
+        return true;
+    }
+
+    void invalidate() {
+        byIndex.clear();
+        for (auto &pair : privatePages) pair.second.index = -1;
+        for (auto it = lru.begin(); it != lru.end();) {
+            if (it->leases == 0) {
+                closeEntry(*it);
+                it = lru.erase(it);
+            } else {
+                it->orphaned = true;
+                ++it;
+            }
+        }
+    }
+
+    void clear() {
+        for (Entry &entry : lru) closeEntry(entry);
+        lru.clear();
+        byIndex.clear();
+        for (auto &pair : privatePages) {
+            forgetPage(pair.first);
+            FPDF_ClosePage(pair.first);
+        }
+        privatePages.clear();
+    }
+};
+
+static std::map<FPDF_DOCUMENT, PageCache*> g_pageCaches;
+
+static PageCache* getPageCache(FPDF_DOCUMENT doc, bool create) {
+    auto it = g_pageCaches.find(doc);
+    if (it != g_pageCaches.end()) return it->second;
+    if (!create) return nullptr;
+    PageCache *cache = new PageCache(doc);
+    g_pageCaches[doc] = cache;
+    return cache;
 }
 
 /**
- * Device to Page Coordinate Conversion
+ * Find the cache managing a page handle, if any
  */
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeDeviceToPage(JNIEnv *env, jobject thiz,
-                                                      jlong pagePtr,
-                                                      jint startX, jint startY,
-                                                      jint sizeX, jint sizeY,
-                                                      jint rotate,
-                                                      jint deviceX, jint deviceY,
-                                                      jdoubleArray result) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return;
-    
-    double pageX, pageY;
-    FPDF_DeviceToPage(page, startX, startY, sizeX, sizeY, rotate, deviceX, deviceY, &pageX, &pageY);
-    
-    jdouble *body = env->GetDoubleArrayElements(result, nullptr);
-    body[0] = pageX;
-    body[1] = pageY;
-    env->ReleaseDoubleArrayElements(result, body, 0);
+static PageCache* findPageCacheForPage(FPDF_PAGE page) {
+    for (auto &pair : g_pageCaches) {
+        if (pair.second->manages(page)) return pair.second;
+    }
+    return nullptr;
+}
+
+static void invalidatePageCache(FPDF_DOCUMENT doc) {
+    PageCache *cache = getPageCache(doc, false);
+    if (cache) cache->invalidate();
+}
+
+static void destroyPageCache(FPDF_DOCUMENT doc) {
+    auto it = g_pageCaches.find(doc);
+    if (it == g_pageCaches.end()) return;
+    it->second->clear();
+    delete it->second;
+    g_pageCaches.erase(it);
 }
 
 /**
- * Page to Device Coordinate Conversion
+ * Load a document through FPDF_LoadCustomDocument reading blocks from fd with pread.
+ * Takes ownership of fd: it is closed on failure or when the document is closed.
  */
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativePageToDevice(JNIEnv *env, jobject thiz,
-                                                      jlong pagePtr,
-                                                      jint startX, jint startY,
-                                                      jint sizeX, jint sizeY,
-                                                      jint rotate,
-                                                      jdouble pageX, jdouble pageY,
-                                                      jintArray result) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return;
-    
-    int deviceX, deviceY;
-    FPDF_PageToDevice(page, startX, startY, sizeX, sizeY, rotate, pageX, pageY, &deviceX, &deviceY);
-    
-    jint *body = env->GetIntArrayElements(result, nullptr);
-    body[0] = deviceX;
-    body[1] = deviceY;
-    env->ReleaseIntArrayElements(result, body, 0);
+static FPDF_DOCUMENT loadCustomDocumentFromFd(int fd, const char *password) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        LOGE("Failed to get file size or empty file");
+        close(fd);
+        return nullptr;
+    }
+
+    FdFileAccess *fileAccess = new (std::nothrow) FdFileAccess();
+    if (!fileAccess) {
+        close(fd);
+        return nullptr;
+    }
+    fileAccess->m_FileLen = (unsigned long) st.st_size;
+    fileAccess->m_GetBlock = FdFileAccess::GetBlockImpl;
+    fileAccess->m_Param = fileAccess;
+    fileAccess->fd = fd;
+
+    FPDF_DOCUMENT doc = FPDF_LoadCustomDocument(fileAccess, password);
+    if (!doc) {
+        LOGE("Failed to load custom document, error: %lu", FPDF_GetLastError());
+        close(fd);
+        delete fileAccess;
+        return nullptr;
+    }
+
+    // Track the reader for cleanup when document is closed
+    DocumentResources res;
+    res.fileAccess = fileAccess;
+    trackDocumentResources(doc, res);
+    LOGI("Document opened (streaming), size: %ld, pages: %d", (long) st.st_size, FPDF_GetPageCount(doc));
+    return doc;
 }
 
+// ----------------------------------------------------------------------------
+// String Scratch
+// ----------------------------------------------------------------------------
+
 /**
- * Load Text Page
+ * Transient buffer for one string on its way between PDFium and the JVM.
+ * Strings up to kInlineBytes stay in the object, on the caller's stack.
+ * Longer ones up to kSharedBytes use a per-thread buffer that only grows,
+ * so walks over thousands of titles or field names stop allocating once it
+ * has warmed up. Anything larger, or a second scratch live on the same
+ * thread, gets its own heap buffer, so one huge string doesn't stay pinned
+ * per thread and the first scratch isn't clobbered.
  */
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeLoadTextPage(JNIEnv *env, jobject thiz,
-                                                      jlong docPtr, jlong pagePtr) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!doc || !page) return 0;
-    return (jlong) FPDFText_LoadPage(page);
-}
+class StringScratch {
+public:
+    static const size_t kInlineBytes = 256;
+    static const size_t kSharedBytes = 64 * 1024;
+
+    explicit StringScratch(size_t bytes) {
+        if (bytes <= kInlineBytes) {
+            m_data = m_inline;
+        } else if (bytes <= kSharedBytes && !t_sharedBusy) {
+            t_sharedBusy = m_holdsShared = true;
+            if (t_shared.size() < bytes) t_shared.resize(bytes);
+            m_data = t_shared.data();
+        } else {
+            m_own.resize(bytes);
+            m_data = m_own.data();
+        }
+    }
+
+    ~StringScratch() {
+        if (m_holdsShared) t_sharedBusy = false;
+    }
+
+    StringScratch(const StringScratch &) = delete;
+    StringScratch &operator=(const StringScratch &) = delete;
+
+    void *data() { return m_data; }
+    FPDF_WCHAR *wide() { return (FPDF_WCHAR*) m_data; }
+    char *chars() { return (char*) m_data; }
+
+private:
+    alignas(8) uint8_t m_inline[kInlineBytes];
+    uint8_t *m_data;
+    bool m_holdsShared = false;
+    std::vector<uint8_t> m_own;
+
+    static thread_local std::vector<uint8_t> t_shared;
+    static thread_local bool t_sharedBusy;
+};
+
+thread_local std::vector<uint8_t> StringScratch::t_shared;
+thread_local bool StringScratch::t_sharedBusy = false;
 
 /**
- * Close Text Page
+ * Grow-only buffer shared by every call of one kind, so repeated renders,
+ * text reads and ink edits stop allocating once it has warmed up. It has no
+ * guard of its own: only touch it under PdfiumLock.
  */
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeCloseTextPage(JNIEnv *env, jobject thiz,
-                                                       jlong textPagePtr) {
-    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
-    if (textPage) {
-        FPDFText_ClosePage(textPage);
+template <typename Buffer>
+class LockedScratch {
+public:
+    typedef typename Buffer::value_type value_type;
+
+    // Grow to at least count elements, keeping the contents
+    value_type *reserve(size_t count) {
+        if (m_buffer.size() < count) m_buffer.resize(count);
+        return m_buffer.data();
     }
+
+    value_type *data() { return m_buffer.data(); }
+    value_type &operator[](size_t index) { return m_buffer[index]; }
+    Buffer &get() { return m_buffer; }
+
+private:
+    Buffer m_buffer;
+};
+
+/**
+ * Read a UTF-16LE string from a getter, called as
+ * getter(void *buffer, unsigned long bytes), that fills buffer and returns
+ * the full size in bytes, terminator included. Empty strings come back as ""
+ * or, with nullIfEmpty, as null.
+ */
+template <typename Getter>
+static jstring newStringFromWide(JNIEnv *env, const Getter &getter, bool nullIfEmpty = false) {
+    unsigned long bytes = getter(nullptr, 0);
+    if (bytes <= 2) return nullIfEmpty ? nullptr : env->NewStringUTF("");
+    StringScratch scratch(bytes);
+    unsigned long written = getter(scratch.data(), bytes);
+    if (written < 2 || written > bytes) return nullIfEmpty ? nullptr : env->NewStringUTF("");
+    return env->NewString((const jchar*) scratch.data(), (jsize) (written / 2 - 1));
 }
 
 /**
- * Get Text Count
+ * Read a NUL-terminated 7-bit or UTF-8 string from a getter that returns its
+ * size in bytes, terminator included. Same empty handling as newStringFromWide.
  */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeTextCountChars(JNIEnv *env, jobject thiz,
-                                                        jlong textPagePtr) {
-    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
-    if (!textPage) return 0;
-    return FPDFText_CountChars(textPage);
+template <typename Getter>
+static jstring newStringFromBytes(JNIEnv *env, const Getter &getter, bool nullIfEmpty = false) {
+    unsigned long bytes = getter(nullptr, 0);
+    if (bytes <= 1) return nullIfEmpty ? nullptr : env->NewStringUTF("");
+    StringScratch scratch(bytes);
+    unsigned long written = getter(scratch.data(), bytes);
+    if (written < 1 || written > bytes) return nullIfEmpty ? nullptr : env->NewStringUTF("");
+    scratch.chars()[written - 1] = '\0';
+    return env->NewStringUTF(scratch.chars());
 }
 
 /**
- * Get Text in range
+ * A Java string as a NUL-terminated FPDF_WIDESTRING, copied with
+ * GetStringRegion into a StringScratch. A null jstring reads as "".
  */
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetText(JNIEnv *env, jobject thiz,
-                                                 jlong textPagePtr, jint startIndex, jint count) {
-    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
-    if (!textPage) return nullptr;
-    
-    // FPDFText_GetText requires buffer size in unsigned shorts (not bytes) + 1 for null terminator
-    // The documentation says "number of characters", but it returns UTF-16LE.
-    // Ensure we allocate enough.
-    
-    int length = count + 1;
-    unsigned short *buffer = new unsigned short[length];
-    
-    int written = FPDFText_GetText(textPage, startIndex, count, buffer);
-    
-    jstring result;
-    if (written > 0) {
-        result = env->NewString((jchar*) buffer, written - 1);
-    } else {
-        result = env->NewStringUTF("");
+class WideStringArg {
+public:
+    WideStringArg(JNIEnv *env, jstring value)
+            : m_length(value ? env->GetStringLength(value) : 0),
+              m_scratch(((size_t) m_length + 1) * sizeof(FPDF_WCHAR)) {
+        if (m_length > 0) env->GetStringRegion(value, 0, m_length, (jchar*) m_scratch.wide());
+        m_scratch.wide()[m_length] = 0;
     }
-    
-    delete[] buffer;
-    return result;
-}
+
+    FPDF_WIDESTRING get() { return m_scratch.wide(); }
+    jsize length() const { return m_length; }
+
+private:
+    jsize m_length;
+    StringScratch m_scratch;
+};
+
+extern "C" {
 
 /**
- * Get Character Box
+ * Initialize PDFium library
  */
 JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetCharBox(JNIEnv *env, jobject thiz,
-                                                    jlong textPagePtr, jint index,
-                                                    jdoubleArray result) {
-    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
-    if (!textPage) return;
-    
-    double left, right, bottom, top;
-    FPDFText_GetCharBox(textPage, index, &left, &right, &bottom, &top);
-    
-    jdouble *body = env->GetDoubleArrayElements(result, nullptr);
-    body[0] = left;
-    body[1] = top;
-    body[2] = right;
-    body[3] = bottom;
-    env->ReleaseDoubleArrayElements(result, body, 0);
+Java_com_hyntix_pdfium_PdfiumCore_nativeInitLibrary(JNIEnv *env, jobject thiz) {
+    std::lock_guard<std::mutex> guard(g_libraryMutex);
+    if (libraryReferenceCount.fetch_add(1) == 0) {
+        FPDF_LIBRARY_CONFIG config;
+        config.version = 2;
+        config.m_pUserFontPaths = nullptr;
+        config.m_pIsolate = nullptr;
+        config.m_v8EmbedderSlot = 0;
+        FPDF_InitLibraryWithConfig(&config);
+        LOGI("PDFium library initialized");
+    }
 }
 
 /**
- * Get Character Index at Position
+ * Destroy PDFium library
  */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetCharIndexAtPos(JNIEnv *env, jobject thiz,
-                                                           jlong textPagePtr,
-                                                           jdouble x, jdouble y,    
-                                                           jdouble xTolerance, jdouble yTolerance) {
-    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
-    if (!textPage) return -1;
-    return FPDFText_GetCharIndexAtPos(textPage, x, y, xTolerance, yTolerance);
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeDestroyLibrary(JNIEnv *env, jobject thiz) {
+    std::lock_guard<std::mutex> guard(g_libraryMutex);
+    if (libraryReferenceCount.load() == 0) {
+        LOGE("nativeDestroyLibrary called without matching nativeInitLibrary");
+        return;
+    }
+    if (libraryReferenceCount.fetch_sub(1) == 1) {
+        FPDF_DestroyLibrary();
+        LOGI("PDFium library destroyed");
+    }
 }
 
 /**
- * Start Text Search
+ * Enable or disable the process-wide PDFium lock (see "Locking policy" above)
  */
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeTextFindStart(JNIEnv *env, jobject thiz,
-                                                       jlong textPagePtr, jstring query,
-                                                       jboolean matchCase, jboolean matchWholeWord) {
-    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
-    if (!textPage) return 0;
-    
-    const char *cQuery = env->GetStringUTFChars(query, nullptr);
-    // Convert query to wide string implementation if needed, but FPDFText_FindStart takes FPDF_WIDESTRING
-    // Use helper to convert UTF-8 to UTF-16LE
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetLockingEnabled(JNIEnv *env, jobject thiz,
+                                                           jboolean enabled) {
+    g_lockingEnabled.store(enabled == JNI_TRUE, std::memory_order_release);
+    LOGI("PDFium locking %s", enabled ? "enabled" : "disabled");
+}
+
+/**
+ * Get last error code
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetLastError(JNIEnv *env, jobject thiz) {
+    PdfiumLock lock;
+    return (jint) FPDF_GetLastError();
+}
+
+/**
+ * Open document from file descriptor
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeOpenDocument(JNIEnv *env, jobject thiz,
+                                                      jint fd, jstring password) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:openDocument");
+    const char *cPassword = nullptr;
+    if (password != nullptr) {
+        cPassword = env->GetStringUTFChars(password, nullptr);
+    }
+
+    // Get file size
+    off_t fileSize = lseek(fd, 0, SEEK_END);
+    if (fileSize <= 0) {
+        if (password != nullptr) {
+            env->ReleaseStringUTFChars(password, cPassword);
+        }
+        LOGE("Failed to get file size or empty file");
+        return 0;
+    }
+    lseek(fd, 0, SEEK_SET);
     
-    jsize queryLen = env->GetStringLength(query);
-    const jchar *queryChars = env->GetStringChars(query, nullptr);
+    char *buffer = new (std::nothrow) char[fileSize];
+    if (!buffer) {
+        if (password != nullptr) {
+            env->ReleaseStringUTFChars(password, cPassword);
+        }
+        LOGE("Failed to allocate buffer of size %ld", (long)fileSize);
+        return 0;
+    }
     
-    // FPDF_WIDESTRING is unsigned short*
-    unsigned short *wQuery = new unsigned short[queryLen + 1];
-    for (int i = 0; i < queryLen; i++) {
-        wQuery[i] = (unsigned short) queryChars[i];
+    // Read file with proper loop to handle partial reads
+    char *ptr = buffer;
+    size_t remaining = fileSize;
+    while (remaining > 0) {
+        ssize_t bytesRead = read(fd, ptr, remaining);
+        if (bytesRead <= 0) {
+            delete[] buffer;
+            if (password != nullptr) {
+                env->ReleaseStringUTFChars(password, cPassword);
+            }
+            LOGE("Read error: only read %ld of %ld bytes", (long)(fileSize - remaining), (long)fileSize);
+            return 0;
+        }
+        ptr += bytesRead;
+        remaining -= bytesRead;
     }
-    wQuery[queryLen] = 0;
     
-    unsigned long flags = 0;
-    if (matchCase) flags |= FPDF_MATCHCASE;
-    if (matchWholeWord) flags |= FPDF_MATCHWHOLEWORD;
+    FPDF_DOCUMENT doc = FPDF_LoadMemDocument(buffer, fileSize, cPassword);
     
-    FPDF_SCHHANDLE search = FPDFText_FindStart(textPage, wQuery, flags, 0);
+    if (password != nullptr) {
+        env->ReleaseStringUTFChars(password, cPassword);
+    }
     
-    delete[] wQuery;
-    env->ReleaseStringChars(query, queryChars);
-    env->ReleaseStringUTFChars(query, cQuery); // Actually we didn't use this one, redundant but safe to release if valid
+    if (!doc) {
+        delete[] buffer;
+        LOGE("Failed to load document, error: %lu", FPDF_GetLastError());
+        return 0;
+    }
     
-    return (jlong) search;
+    // Track buffer for cleanup when document is closed
+    DocumentResources res;
+    res.buffer = buffer;
+    res.bufferBytes = (size_t) fileSize;
+    trackDocumentResources(doc, res);
+    LOGI("Document opened successfully, pages: %d", FPDF_GetPageCount(doc));
+    return (jlong) doc;
 }
 
 /**
- * Find Next
+ * Open document from memory buffer
  */
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeTextFindNext(JNIEnv *env, jobject thiz,
-                                                      jlong searchHandle) {
-    FPDF_SCHHANDLE search = (FPDF_SCHHANDLE) searchHandle;
-    if (!search) return JNI_FALSE;
-    return FPDFText_FindNext(search) ? JNI_TRUE : JNI_FALSE;
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeOpenMemDocument(JNIEnv *env, jobject thiz,
+                                                         jbyteArray data, jstring password) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:openDocument");
+    const char *cPassword = nullptr;
+    if (password != nullptr) {
+        cPassword = env->GetStringUTFChars(password, nullptr);
+    }
+    
+    // PDFium requires the buffer to stay valid for the life of the document,
+    // so copy straight from the Java array into a native buffer we own.
+    // GetByteArrayRegion avoids the extra copy GetByteArrayElements may make.
+    jsize length = env->GetArrayLength(data);
+    char *docBuffer = new (std::nothrow) char[length];
+    if (!docBuffer) {
+        LOGE("Failed to allocate %d bytes for document", length);
+        if (password != nullptr) {
+            env->ReleaseStringUTFChars(password, cPassword);
+        }
+        return 0;
+    }
+    env->GetByteArrayRegion(data, 0, length, (jbyte*) docBuffer);
+
+    FPDF_DOCUMENT doc = FPDF_LoadMemDocument(docBuffer, length, cPassword);
+    
+    if (password != nullptr) {
+        env->ReleaseStringUTFChars(password, cPassword);
+    }
+    
+    if (!doc) {
+        delete[] docBuffer;
+        LOGE("Failed to load document from memory, error: %lu", FPDF_GetLastError());
+        return 0;
+    }
+    
+    // Track buffer for cleanup when document is closed
+    DocumentResources res;
+    res.buffer = docBuffer;
+    res.bufferBytes = (size_t) length;
+    trackDocumentResources(doc, res);
+    LOGI("Document opened from memory, pages: %d", FPDF_GetPageCount(doc));
+    return (jlong) doc;
 }
 
 /**
- * Find Previous
+ * Open document directly over a direct ByteBuffer (no copy).
+ * The buffer is pinned with a global ref until the document is closed.
  */
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeTextFindPrev(JNIEnv *env, jobject thiz,
-                                                      jlong searchHandle) {
-    FPDF_SCHHANDLE search = (FPDF_SCHHANDLE) searchHandle;
-    if (!search) return JNI_FALSE;
-    return FPDFText_FindPrev(search) ? JNI_TRUE : JNI_FALSE;
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeOpenDirectBufferDocument(JNIEnv *env, jobject thiz,
+                                                                  jobject buffer, jint offset,
+                                                                  jint length, jstring password) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:openDocument");
+    char *address = (char*) env->GetDirectBufferAddress(buffer);
+    jlong capacity = env->GetDirectBufferCapacity(buffer);
+    if (!address || offset < 0 || length <= 0 || offset + (jlong) length > capacity) {
+        LOGE("Invalid direct buffer for document");
+        return 0;
+    }
+
+    const char *cPassword = nullptr;
+    if (password != nullptr) {
+        cPassword = env->GetStringUTFChars(password, nullptr);
+    }
+
+    FPDF_DOCUMENT doc = FPDF_LoadMemDocument64(address + offset, (size_t) length, cPassword);
+
+    if (password != nullptr) {
+        env->ReleaseStringUTFChars(password, cPassword);
+    }
+
+    if (!doc) {
+        LOGE("Failed to load document from direct buffer, error: %lu", FPDF_GetLastError());
+        return 0;
+    }
+
+    DocumentResources res;
+    res.pinnedBuffer = env->NewGlobalRef(buffer);
+    res.pinnedOffset = (size_t) offset;
+    res.bufferBytes = (size_t) length;
+    trackDocumentResources(doc, res);
+    LOGI("Document opened from direct buffer, pages: %d", FPDF_GetPageCount(doc));
+    return (jlong) doc;
 }
 
 /**
- * Get Search Result Index
+ * Allocate a native buffer that can later be handed to nativeOpenOwnedBufferDocument
  */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeTextGetSchResultIndex(JNIEnv *env, jobject thiz,
-                                                               jlong searchHandle) {
-    FPDF_SCHHANDLE search = (FPDF_SCHHANDLE) searchHandle;
-    if (!search) return -1;
-    return FPDFText_GetSchResultIndex(search);
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeAllocateBuffer(JNIEnv *env, jobject thiz, jint size) {
+    PdfiumLock lock;
+    if (size <= 0) return 0;
+    char *buffer = new (std::nothrow) char[size];
+    if (!buffer) LOGE("Failed to allocate %d byte native buffer", size);
+    return (jlong) buffer;
 }
 
-/**
- * Get Search Result Count
- */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeTextGetSchCount(JNIEnv *env, jobject thiz,
-                                                         jlong searchHandle) {
-    FPDF_SCHHANDLE search = (FPDF_SCHHANDLE) searchHandle;
-    if (!search) return 0;
-    return FPDFText_GetSchCount(search);
+JNIEXPORT jobject JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeWrapBuffer(JNIEnv *env, jobject thiz,
+                                                    jlong bufferPtr, jint size) {
+    PdfiumLock lock;
+    if (!bufferPtr) return nullptr;
+    return env->NewDirectByteBuffer((void*) bufferPtr, size);
 }
 
-/**
- * Close Text Search
- */
 JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeTextFindClose(JNIEnv *env, jobject thiz,
-                                                       jlong searchHandle) {
-    FPDF_SCHHANDLE search = (FPDF_SCHHANDLE) searchHandle;
-    if (search) {
-        FPDFText_FindClose(search);
-    }
+Java_com_hyntix_pdfium_PdfiumCore_nativeFreeBuffer(JNIEnv *env, jobject thiz, jlong bufferPtr) {
+    PdfiumLock lock;
+    delete[] (char*) bufferPtr;
 }
 
 /**
- * Get First Child Bookmark
+ * Open document over a buffer from nativeAllocateBuffer.
+ * On success the document takes ownership and frees it on close.
  */
 JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetFirstChildBookmark(JNIEnv *env, jobject thiz,
-                                                               jlong docPtr, jlong bookmarkPtr) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    FPDF_BOOKMARK bookmark = (FPDF_BOOKMARK) bookmarkPtr; // Can be NULL for root
-    if (!doc) return 0;
-    return (jlong) FPDFBookmark_GetFirstChild(doc, bookmark);
+Java_com_hyntix_pdfium_PdfiumCore_nativeOpenOwnedBufferDocument(JNIEnv *env, jobject thiz,
+                                                                 jlong bufferPtr, jint length,
+                                                                 jstring password) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:openDocument");
+    char *buffer = (char*) bufferPtr;
+    if (!buffer || length <= 0) return 0;
+
+    const char *cPassword = nullptr;
+    if (password != nullptr) {
+        cPassword = env->GetStringUTFChars(password, nullptr);
+    }
+
+    FPDF_DOCUMENT doc = FPDF_LoadMemDocument64(buffer, (size_t) length, cPassword);
+
+    if (password != nullptr) {
+        env->ReleaseStringUTFChars(password, cPassword);
+    }
+
+    if (!doc) {
+        LOGE("Failed to load document from native buffer, error: %lu", FPDF_GetLastError());
+        return 0;
+    }
+
+    DocumentResources res;
+    res.buffer = buffer;
+    res.bufferBytes = (size_t) length;
+    trackDocumentResources(doc, res);
+    LOGI("Document opened from native buffer, pages: %d", FPDF_GetPageCount(doc));
+    return (jlong) doc;
 }
 
 /**
- * Get Next Sibling Bookmark
+ * Open document from file descriptor, reading blocks on demand (no full copy)
  */
 JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetNextSiblingBookmark(JNIEnv *env, jobject thiz,
-                                                                jlong docPtr, jlong bookmarkPtr) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    FPDF_BOOKMARK bookmark = (FPDF_BOOKMARK) bookmarkPtr;
-    if (!doc || !bookmark) return 0;
-    return (jlong) FPDFBookmark_GetNextSibling(doc, bookmark);
+Java_com_hyntix_pdfium_PdfiumCore_nativeOpenCustomDocument(JNIEnv *env, jobject thiz,
+                                                            jint fd, jstring password) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:openDocument");
+    // Duplicate the descriptor so the caller may close theirs once the document is open
+    int ownedFd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (ownedFd < 0) {
+        LOGE("Failed to duplicate file descriptor %d, errno: %d", fd, errno);
+        return 0;
+    }
+
+    const char *cPassword = nullptr;
+    if (password != nullptr) {
+        cPassword = env->GetStringUTFChars(password, nullptr);
+    }
+
+    FPDF_DOCUMENT doc = loadCustomDocumentFromFd(ownedFd, cPassword);
+
+    if (password != nullptr) {
+        env->ReleaseStringUTFChars(password, cPassword);
+    }
+    return (jlong) doc;
 }
 
 /**
- * Get Bookmark Title
+ * Open document from file path, reading blocks on demand (no full copy)
  */
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetBookmarkTitle(JNIEnv *env, jobject thiz,
-                                                          jlong bookmarkPtr) {
-    FPDF_BOOKMARK bookmark = (FPDF_BOOKMARK) bookmarkPtr;
-    if (!bookmark) return nullptr;
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeOpenDocumentPath(JNIEnv *env, jobject thiz,
+                                                          jstring path, jstring password) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:openDocument");
+    const char *cPath = env->GetStringUTFChars(path, nullptr);
+    int fd = open(cPath, O_RDONLY | O_CLOEXEC);
+    env->ReleaseStringUTFChars(path, cPath);
+    if (fd < 0) {
+        LOGE("Failed to open document path, errno: %d", errno);
+        return 0;
+    }
 
-    unsigned long size = FPDFBookmark_GetTitle(bookmark, nullptr, 0);
-    if (size == 0) return env->NewStringUTF("");
+    const char *cPassword = nullptr;
+    if (password != nullptr) {
+        cPassword = env->GetStringUTFChars(password, nullptr);
+    }
 
-    unsigned short *buffer = new unsigned short[size];
-    FPDFBookmark_GetTitle(bookmark, buffer, size);
+    FPDF_DOCUMENT doc = loadCustomDocumentFromFd(fd, cPassword);
 
-    jstring result = env->NewString((jchar*) buffer, size / 2 - 1);
-    delete[] buffer;
-    return result;
+    if (password != nullptr) {
+        env->ReleaseStringUTFChars(password, cPassword);
+    }
+    return (jlong) doc;
 }
 
 /**
- * Get Bookmark Dest Page Index
+ * Close document
  */
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetBookmarkDestIndex(JNIEnv *env, jobject thiz,
-                                                              jlong docPtr, jlong bookmarkPtr) {
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeCloseDocument(JNIEnv *env, jobject thiz,
+                                                       jlong docPtr) {
+    PdfiumLock lock;
     FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    FPDF_BOOKMARK bookmark = (FPDF_BOOKMARK) bookmarkPtr;
-    if (!doc || !bookmark) return -1;
-
-    FPDF_DEST dest = FPDFBookmark_GetDest(doc, bookmark);
-    if (!dest) {
-        // Try action
-        FPDF_ACTION action = FPDFBookmark_GetAction(bookmark);
-        if (action) {
-            dest = FPDFAction_GetDest(doc, action);
+    if (doc) {
+        // Cached pages must be closed before their document
+        destroyPageCache(doc);
+        forgetDocumentStats(doc);
+        forgetDocumentRevisions(doc);
+        forgetFormFieldIndex(doc);
+        FPDF_CloseDocument(doc);
+        
+        // Free the buffer or file reader associated with this document
+        DocumentResources res;
+        if (untrackDocumentResources(doc, &res)) {
+            releaseDocumentResources(env, res);
         }
+        LOGI("Document closed");
     }
-    
-    if (!dest) return -1;
-    return FPDFDest_GetDestPageIndex(doc, dest);
 }
 
 /**
- * Get Link at Point
+ * Get page count
  */
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetLinkAtPoint(JNIEnv *env, jobject thiz,
-                                                        jlong pagePtr, jdouble x, jdouble y) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return 0;
-    return (jlong) FPDFLink_GetLinkAtPoint(page, x, y);
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageCount(JNIEnv *env, jobject thiz,
+                                                      jlong docPtr) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return 0;
+    return FPDF_GetPageCount(doc);
 }
 
 /**
- * Get Link Dest Page Index
+ * Get a trailer file identifier (0 = permanent, 1 = changing) as raw bytes
  */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetLinkDestIndex(JNIEnv *env, jobject thiz,
-                                                          jlong docPtr, jlong linkPtr) {
+JNIEXPORT jbyteArray JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetFileIdentifier(JNIEnv *env, jobject thiz,
+                                                          jlong docPtr, jint idType) {
+    PdfiumLock lock;
     FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    FPDF_LINK link = (FPDF_LINK) linkPtr;
-    if (!doc || !link) return -1;
-    
-    FPDF_DEST dest = FPDFLink_GetDest(doc, link);
-    if (!dest) {
-         FPDF_ACTION action = FPDFLink_GetAction(link);
-         if (action) {
-             dest = FPDFAction_GetDest(doc, action);
-         }
-    }
-    
-    if (!dest) return -1;
-    return FPDFDest_GetDestPageIndex(doc, dest);
+    if (!doc) return nullptr;
+
+    FPDF_FILEIDTYPE type = idType == 0 ? FILEIDTYPE_PERMANENT : FILEIDTYPE_CHANGING;
+    unsigned long size = FPDF_GetFileIdentifier(doc, type, nullptr, 0);
+    if (size <= 1) return nullptr;
+
+    std::vector<char> buffer(size);
+    FPDF_GetFileIdentifier(doc, type, buffer.data(), size);
+    jbyteArray result = env->NewByteArray((jsize) (size - 1));
+    env->SetByteArrayRegion(result, 0, (jsize) (size - 1), (const jbyte*) buffer.data());
+    return result;
 }
 
 /**
- * Get Link URI
+ * Sample of the bytes a document was opened from: the source length as 8
+ * little-endian bytes, then its first and last kSourceSampleBytes (the whole
+ * source when shorter). Returns null for new documents and progressive opens,
+ * which never hold the whole source.
  */
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetLinkURI(JNIEnv *env, jobject thiz,
-                                                    jlong docPtr, jlong linkPtr) {
+static const size_t kSourceSampleBytes = 64 * 1024;
+
+JNIEXPORT jbyteArray JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetSourceSample(JNIEnv *env, jobject thiz, jlong docPtr) {
+    PdfiumLock lock;
     FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    FPDF_LINK link = (FPDF_LINK) linkPtr;
-    if (!doc || !link) return nullptr;
+    if (!doc) return nullptr;
 
-    FPDF_ACTION action = FPDFLink_GetAction(link);
-    if (!action) return nullptr;
-    
-    unsigned long size = FPDFAction_GetURIPath(doc, action, nullptr, 0);
-    if (size == 0) return nullptr;
-    
-    char *buffer = new char[size];
-    FPDFAction_GetURIPath(doc, action, buffer, size);
-    
-    jstring result = env->NewStringUTF(buffer);
-    delete[] buffer;
+    DocumentResources res;
+    {
+        std::lock_guard<std::mutex> guard(g_docResourcesMutex);
+        auto it = g_docResources.find(doc);
+        if (it == g_docResources.end()) return nullptr;
+        res = it->second;
+    }
+
+    const uint8_t *memory = sourceMemory(env, res);
+    uint64_t length = memory ? res.bufferBytes : res.fileAccess ? res.fileAccess->m_FileLen : 0;
+    if (length == 0) return nullptr;
+
+    size_t head = (size_t) std::min<uint64_t>(length, kSourceSampleBytes);
+    size_t tail = length > kSourceSampleBytes ? head : 0;
+    std::vector<uint8_t> sample(8 + head + tail);
+    for (int i = 0; i < 8; i++) sample[i] = (uint8_t) (length >> (8 * i));
+    uint64_t tailStart = length - tail;
+    if (memory) {
+        memcpy(sample.data() + 8, memory, head);
+        if (tail) memcpy(sample.data() + 8 + head, memory + tailStart, tail);
+    } else {
+        FdFileAccess *access = res.fileAccess;
+        if (!access->m_GetBlock(access->m_Param, 0, sample.data() + 8, (unsigned long) head)) return nullptr;
+        if (tail && !access->m_GetBlock(access->m_Param, (unsigned long) tailStart,
+                                        sample.data() + 8 + head, (unsigned long) tail)) return nullptr;
+    }
+
+    jbyteArray result = env->NewByteArray((jsize) sample.size());
+    if (result) env->SetByteArrayRegion(result, 0, (jsize) sample.size(), (const jbyte*) sample.data());
     return result;
 }
 
 /**
- * Get Link Rect
+ * Get document metadata
  */
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetLinkRect(JNIEnv *env, jobject thiz,
-                                                     jlong linkPtr, jdoubleArray result) {
-    FPDF_LINK link = (FPDF_LINK) linkPtr;
-    if (!link) return;
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetMetaText(JNIEnv *env, jobject thiz,
+                                                     jlong docPtr, jstring tag) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return nullptr;
     
-    FS_RECTF rect;
-    if (FPDFLink_GetAnnotRect(link, &rect)) {
-        jdouble *body = env->GetDoubleArrayElements(result, nullptr);
-        body[0] = rect.left;
-        body[1] = rect.top;
-        body[2] = rect.right;
-        body[3] = rect.bottom;
-        env->ReleaseDoubleArrayElements(result, body, 0);
-    }
+    const char *cTag = env->GetStringUTFChars(tag, nullptr);
+    // FPDF_GetMetaText returns the UTF-16LE size in bytes including the terminator
+    jstring result = newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDF_GetMetaText(doc, cTag, buffer, bytes);
+    });
+    env->ReleaseStringUTFChars(tag, cTag);
+    return result;
 }
 
 /**
- * Get Annotation Count
+ * Get page label (actual page number as displayed in PDF)
  */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotCount(JNIEnv *env, jobject thiz,
-                                                       jlong pagePtr) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return 0;
-    return FPDFPage_GetAnnotCount(page);
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageLabel(JNIEnv *env, jobject thiz,
+                                                      jlong docPtr, jint pageIndex) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return env->NewStringUTF("");
+    
+    // FPDF_GetPageLabel returns UTF-16LE encoded string
+    return newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDF_GetPageLabel(doc, pageIndex, buffer, bytes);
+    });
 }
 
 /**
- * Get Annotation
+ * Load Page
  */
 JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnot(JNIEnv *env, jobject thiz,
-                                                  jlong pagePtr, jint index) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return 0;
-    return (jlong) FPDFPage_GetAnnot(page, index);
+Java_com_hyntix_pdfium_PdfiumCore_nativeLoadPage(JNIEnv *env, jobject thiz,
+                                                  jlong docPtr, jint pageIndex) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:loadPage");
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return 0;
+
+    PageCache *cache = getPageCache(doc, true);
+    if (cache->capacity > 0) return (jlong) cache->acquire(pageIndex);
+
+    FPDF_PAGE page = FPDF_LoadPage(doc, pageIndex);
+    if (page) recordPageLoad(doc, page, pageIndex);
+    return (jlong) page;
 }
 
 /**
- * Close Annotation
+ * Close Page
  */
 JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeCloseAnnot(JNIEnv *env, jobject thiz,
-                                                    jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (annot) {
-        FPDFPage_CloseAnnot(annot);
+Java_com_hyntix_pdfium_PdfiumCore_nativeClosePage(JNIEnv *env, jobject thiz,
+                                                   jlong pagePtr) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (page) {
+        // Cached pages only give back their lease
+        PageCache *cache = findPageCacheForPage(page);
+        if (!cache || !cache->release(page)) {
+            forgetPage(page);
+            FPDF_ClosePage(page);
+        }
     }
 }
 
 /**
- * Get Annotation Subtype
+ * Configure the page cache of a document. A capacity of 0 disables caching;
+ * pages already cached are trimmed to the new capacity.
  */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotSubtype(JNIEnv *env, jobject thiz,
-                                                         jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return -1;
-    return (jint) FPDFAnnot_GetSubtype(annot);
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeConfigurePageCache(JNIEnv *env, jobject thiz,
+                                                            jlong docPtr, jlong capacityBytes,
+                                                            jboolean cacheTextPages) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return;
+    PageCache *cache = getPageCache(doc, true);
+    cache->capacity = capacityBytes > 0 ? (size_t) capacityBytes : 0;
+    cache->cacheTextPages = cacheTextPages == JNI_TRUE;
+    cache->trim();
 }
 
 /**
- * Get Annotation Rect
+ * Page cache counters: [hits, misses, evictions, bytesHeld, cachedPages, capacity]
  */
 JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotRect(JNIEnv *env, jobject thiz,
-                                                      jlong annotPtr, jdoubleArray result) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return;
-    
-    FS_RECTF rect;
-    if (FPDFAnnot_GetRect(annot, &rect)) {
-        jdouble *body = env->GetDoubleArrayElements(result, nullptr);
-        body[0] = rect.left;
-        body[1] = rect.top;
-        body[2] = rect.right;
-        body[3] = rect.bottom;
-        env->ReleaseDoubleArrayElements(result, body, 0);
-    }
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageCacheStats(JNIEnv *env, jobject thiz,
+                                                           jlong docPtr, jlongArray result) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return;
+    PageCache *cache = getPageCache(doc, true);
+    jlong values[6] = {
+        (jlong) cache->hits, (jlong) cache->misses, (jlong) cache->evictions,
+        (jlong) cache->bytesHeld, (jlong) cache->lru.size(), (jlong) cache->capacity
+    };
+    env->SetLongArrayRegion(result, 0, 6, values);
 }
 
 /**
- * Create Annotation
+ * Instrumentation counters for one document, or for the whole process when docPtr is 0.
+ * Layout: [documentsOpen, bufferBytes, pageCacheBytes, pagesLoaded, textPagesLoaded,
+ *          renders, renderNanos, renderBuckets...]
  */
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeCreateAnnot(JNIEnv *env, jobject thiz,
-                                                     jlong pagePtr, jint subtype) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return 0;
-    return (jlong) FPDFPage_CreateAnnot(page, subtype);
-}
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetStats(JNIEnv *env, jobject thiz,
+                                                  jlong docPtr, jlongArray result) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
 
-/**
- * Set Annotation Rect
- */
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotRect(JNIEnv *env, jobject thiz,
-                                                      jlong annotPtr, jdoubleArray rectArray) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return JNI_FALSE;
-    
-    jdouble *rectData = env->GetDoubleArrayElements(rectArray, nullptr);
-    FS_RECTF rect;
-    rect.left = (float) rectData[0];
-    rect.top = (float) rectData[1];
-    rect.right = (float) rectData[2];
-    rect.bottom = (float) rectData[3];
-    env->ReleaseDoubleArrayElements(rectArray, rectData, 0);
-    
-    return FPDFAnnot_SetRect(annot, &rect) ? JNI_TRUE : JNI_FALSE;
+    jlong documentsOpen = 0;
+    jlong bufferBytes = 0;
+    {
+        std::lock_guard<std::mutex> guard(g_docResourcesMutex);
+        for (const auto &pair : g_docResources) {
+            if (doc && pair.first != doc) continue;
+            documentsOpen++;
+            bufferBytes += (jlong) pair.second.bufferBytes;
+            if (pair.second.rangeLoader) {
+                bufferBytes += (jlong) (pair.second.rangeLoader->chunks.size() * RangeLoader::kChunkSize);
+            }
+        }
+    }
+
+    jlong pageCacheBytes = 0;
+    for (const auto &pair : g_pageCaches) {
+        if (doc && pair.first != doc) continue;
+        pageCacheBytes += (jlong) pair.second->bytesHeld;
+    }
+
+    DocumentStats stats;
+    if (doc) {
+        auto it = g_docStats.find(doc);
+        if (it != g_docStats.end()) stats = it->second;
+    } else {
+        stats = g_processStats;
+    }
+
+    jlong values[7 + kRenderBucketCount] = {
+        documentsOpen, bufferBytes, pageCacheBytes,
+        (jlong) stats.pagesLoaded, (jlong) stats.textPagesLoaded,
+        (jlong) stats.renders, (jlong) stats.renderNanos
+    };
+    for (int i = 0; i < kRenderBucketCount; i++) {
+        values[7 + i] = (jlong) stats.renderBuckets[i];
+    }
+    env->SetLongArrayRegion(result, 0, 7 + kRenderBucketCount, values);
 }
 
 /**
- * Set Annotation Contents
+ * Reset the load and render counters for the process and all open documents.
+ * Byte counts reflect live memory and are not affected.
  */
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotContents(JNIEnv *env, jobject thiz,
-                                                          jlong annotPtr, jstring contents) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return JNI_FALSE;
-    
-    const char *cContents = env->GetStringUTFChars(contents, nullptr);
-    jsize len = env->GetStringLength(contents);
-    const jchar *wContents = env->GetStringChars(contents, nullptr);
-    
-    unsigned short *buffer = new unsigned short[len + 1];
-    for (int i = 0; i < len; i++) {
-        buffer[i] = (unsigned short) wContents[i];
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeResetStats(JNIEnv *env, jobject thiz) {
+    PdfiumLock lock;
+    g_processStats = DocumentStats();
+    for (auto &pair : g_docStats) {
+        pair.second = DocumentStats();
     }
-    buffer[len] = 0;
-    
-    jboolean result = FPDFAnnot_SetStringValue(annot, "Contents", buffer) ? JNI_TRUE : JNI_FALSE;
-    
-    delete[] buffer;
-    env->ReleaseStringChars(contents, wContents);
-    env->ReleaseStringUTFChars(contents, cContents);
-    
-    return result;
 }
 
 /**
- * Set Annotation Color
+ * Get the edit revision of a page: out[0] is the document serial, out[1] the
+ * structure revision in the high 32 bits and the page revision in the low ones
  */
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotColor(JNIEnv *env, jobject thiz,
-                                                       jlong annotPtr, 
-                                                       jint type, 
-                                                       jint r, jint g, jint b, jint a) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return JNI_FALSE;
-    return FPDFAnnot_SetColor(annot, (FPDFANNOT_COLORTYPE)type, r, g, b, a) ? JNI_TRUE : JNI_FALSE;
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageRevision(JNIEnv *env, jobject thiz,
+                                                        jlong docPtr, jint pageIndex,
+                                                        jlongArray out) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc || !out || env->GetArrayLength(out) < 2) return;
+
+    DocumentRevisions &revisions = getDocumentRevisions(doc);
+    auto page = revisions.pages.find(pageIndex);
+    uint32_t pageRevision = page != revisions.pages.end() ? page->second : 0;
+    jlong values[2] = {
+        (jlong) revisions.serial,
+        (jlong) (((uint64_t) revisions.structure << 32) | pageRevision)
+    };
+    env->SetLongArrayRegion(out, 0, 2, values);
 }
 
 /**
- * Set Annotation Flags
+ * Get Page Width
  */
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotFlags(JNIEnv *env, jobject thiz,
-                                                       jlong annotPtr, jint flags) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return JNI_FALSE;
-    return FPDFAnnot_SetFlags(annot, flags) ? JNI_TRUE : JNI_FALSE;
+JNIEXPORT jdouble JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageWidth(JNIEnv *env, jobject thiz,
+                                                      jlong pagePtr) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return 0.0;
+    return FPDF_GetPageWidth(page);
 }
 
-
 /**
- * Create New Document
+ * Get Page Height
  */
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeNewDocument(JNIEnv *env, jobject thiz) {
-    return (jlong) FPDF_CreateNewDocument();
+JNIEXPORT jdouble JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageHeight(JNIEnv *env, jobject thiz,
+                                                       jlong pagePtr) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return 0.0;
+    return FPDF_GetPageHeight(page);
 }
 
 /**
- * Create New Page
+ * Get Page Size by Index (without loading page)
+ * This is much faster than loadPage+getWidth/getHeight for bulk size queries.
  */
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeNewPage(JNIEnv *env, jobject thiz,
-                                                 jlong docPtr, jint index, jdouble width, jdouble height) {
+JNIEXPORT jdoubleArray JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageSizeByIndex(JNIEnv *env, jobject thiz,
+                                                            jlong docPtr, jint pageIndex) {
+    PdfiumLock lock;
     FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return 0;
-    return (jlong) FPDFPage_New(doc, index, width, height);
-}
-
-// File Write Interface Implementation
-struct FPDF_FILEWRITE_IMPL : public FPDF_FILEWRITE {
-    FILE *file;
+    if (!doc) return nullptr;
     
-    static int WriteBlockImpl(FPDF_FILEWRITE* pThis, const void* pData, unsigned long size) {
-        FPDF_FILEWRITE_IMPL* pImpl = (FPDF_FILEWRITE_IMPL*)pThis;
-        return fwrite(pData, 1, size, pImpl->file) == size;
+    double width = 0.0, height = 0.0;
+    int success = FPDF_GetPageSizeByIndex(doc, pageIndex, &width, &height);
+    
+    if (!success) {
+        // Return default A4 size if failed
+        width = 595.0;
+        height = 842.0;
     }
-};
-
-/**
- * Save Document
- */
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSaveDocument(JNIEnv *env, jobject thiz,
-                                                      jlong docPtr, jstring path) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return JNI_FALSE;
-    
-    const char *cPath = env->GetStringUTFChars(path, nullptr);
-    FILE *file = fopen(cPath, "wb");
-    if (!file) {
-        env->ReleaseStringUTFChars(path, cPath);
-        return JNI_FALSE;
-    }
-    
-    FPDF_FILEWRITE_IMPL writer;
-    writer.version = 1;
-    writer.WriteBlock = FPDF_FILEWRITE_IMPL::WriteBlockImpl;
-    writer.file = file;
     
-    bool success = FPDF_SaveAsCopy(doc, &writer, 0);
-    
-    fclose(file);
-    env->ReleaseStringUTFChars(path, cPath);
-    return success ? JNI_TRUE : JNI_FALSE;
+    jdoubleArray result = env->NewDoubleArray(2);
+    jdouble values[2] = {width, height};
+    env->SetDoubleArrayRegion(result, 0, 2, values);
+    return result;
 }
 
 // ----------------------------------------------------------------------------
-// Form Filling Support
+// Bitmap Format Conversion
 // ----------------------------------------------------------------------------
 
-struct FormFillInfo : public FPDF_FORMFILLINFO {
-    // Keeping it simple for now, can extend to call Java methods later if needed
-};
+// BGRx pixels for RGB_565 and A_8 render targets
+static LockedScratch<std::vector<uint8_t>> g_renderScratch;
+
+#if defined(__ARM_NEON)
+static inline uint16x8_t packRgb565(uint8x8_t r, uint8x8_t g, uint8x8_t b) {
+    // Shift-right-insert keeps the top bits of each field: rrrrrggg gggbbbbb
+    uint16x8_t packed = vshll_n_u8(r, 8);
+    packed = vsriq_n_u16(packed, vshll_n_u8(g, 8), 5);
+    return vsriq_n_u16(packed, vshll_n_u8(b, 8), 11);
+}
+
+static inline uint8x8_t inkCoverage(uint8x8_t r, uint8x8_t g, uint8x8_t b) {
+    uint16x8_t luma = vmull_u8(r, vdup_n_u8(77));
+    luma = vmlal_u8(luma, g, vdup_n_u8(150));
+    luma = vmlal_u8(luma, b, vdup_n_u8(29));
+    return vmvn_u8(vshrn_n_u16(luma, 8));
+}
+#endif
+
+// One row of BGRx pixels to RGB_565
+static void convertRowTo565(const uint8_t *src, uint16_t *dst, int width) {
+    int x = 0;
+#if defined(__ARM_NEON)
+    for (; x + 16 <= width; x += 16) {
+        uint8x16x4_t px = vld4q_u8(src + x * 4);
+        vst1q_u16(dst + x, packRgb565(vget_low_u8(px.val[2]), vget_low_u8(px.val[1]), vget_low_u8(px.val[0])));
+        vst1q_u16(dst + x + 8, packRgb565(vget_high_u8(px.val[2]), vget_high_u8(px.val[1]), vget_high_u8(px.val[0])));
+    }
+#endif
+    for (; x < width; x++) {
+        const uint8_t *p = src + x * 4;
+        dst[x] = (uint16_t) (((p[2] >> 3) << 11) | ((p[1] >> 2) << 5) | (p[0] >> 3));
+    }
+}
 
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeInitFormFillEnvironment(JNIEnv *env, jobject thiz,
-                                                                 jlong docPtr) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return 0;
-    
-    // We allocate the struct on heap, it must be freed in ExitFormFillEnvironment
-    FormFillInfo *formInfo = new FormFillInfo();
-    memset(formInfo, 0, sizeof(FPDF_FORMFILLINFO));
-    formInfo->version = 1;
-    // formInfo->m_pJsPlatform = ...; // JS support if needed
-    
-    // Initialize callbacks to stub/null or simple implementations if required
-    // FPDFDOC_InitFormFillEnvironment checks version and some pointers.
-    // For read-only/basic forms, 0-initialized might be okay or crash.
-    // Let's implement basics.
-    
-    FPDF_FORMHANDLE formHandle = FPDFDOC_InitFormFillEnvironment(doc, formInfo);
-    
-    // Store the info pointer in the user data of form handle if possible, 
-    // or we just trust the caller to manage it? 
-    // FPDFDOC_InitFormFillEnvironment returns a handle, but doesn't take ownership of info.
-    // We need to associate them. For now, we return the HANDLE. 
-    // But we need to delete formInfo later. 
-    // We can map handle -> info in a global map, OR we create a struct wrapper.
-    // Simpler: We assume the caller (Java) holds the pointer to formInfo? No, it holds native pointer.
-    // Wait, FPDF_FORMHANDLE is opaque.
-    // Let's modify the signature to return a pair or just return handle, and leak the info for now (bad practice)
-    // OR we just assume we'll fix memory management in a robust wrapper.
-    // For this implementation, I will just return the FormHandle. 
-    // ISSUE: We need to free `formInfo` when closing.
-    // WORKAROUND: We can store formInfo in the `m_pUserData` if unused, or just implement Release callback?
-    // FPDF_FORMFILLINFO::Release is called when... FPDFDOC_ExitFormFillEnvironment is called?
-    // Documentation says: "Release - Give the implementation a chance to release any data..."
-    // Let's use that.
-    
-    formInfo->Release = [](FPDF_FORMFILLINFO* pThis) {
-        delete (FormFillInfo*)pThis;
-    };
-    
-    return (jlong) formHandle;
+// One row of BGRx pixels to A_8 ink coverage (255 - luminance)
+static void convertRowToCoverage(const uint8_t *src, uint8_t *dst, int width) {
+    int x = 0;
+#if defined(__ARM_NEON)
+    for (; x + 16 <= width; x += 16) {
+        uint8x16x4_t px = vld4q_u8(src + x * 4);
+        uint8x8_t low = inkCoverage(vget_low_u8(px.val[2]), vget_low_u8(px.val[1]), vget_low_u8(px.val[0]));
+        uint8x8_t high = inkCoverage(vget_high_u8(px.val[2]), vget_high_u8(px.val[1]), vget_high_u8(px.val[0]));
+        vst1q_u8(dst + x, vcombine_u8(low, high));
+    }
+#endif
+    for (; x < width; x++) {
+        const uint8_t *p = src + x * 4;
+        dst[x] = (uint8_t) (255 - ((p[2] * 77 + p[1] * 150 + p[0] * 29) >> 8));
+    }
 }
 
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeExitFormFillEnvironment(JNIEnv *env, jobject thiz,
-                                                                 jlong formHandlePtr) {
-    FPDF_FORMHANDLE formHandle = (FPDF_FORMHANDLE) formHandlePtr;
-    if (formHandle) {
-        FPDFDOC_ExitFormFillEnvironment(formHandle);
+// One row of RGB_565 pixels back to BGRx, replicating the high bits into the low ones
+static void expandRowFrom565(const uint16_t *src, uint8_t *dst, int width) {
+    int x = 0;
+#if defined(__ARM_NEON)
+    for (; x + 8 <= width; x += 8) {
+        uint16x8_t v = vld1q_u16(src + x);
+        uint8x8_t r = vshrn_n_u16(v, 8);
+        uint8x8_t g = vshrn_n_u16(v, 3);
+        uint8x8_t b = vmovn_u16(vshlq_n_u16(v, 3));
+        uint8x8x4_t px;
+        px.val[0] = vsri_n_u8(b, b, 5);
+        px.val[1] = vsri_n_u8(g, g, 6);
+        px.val[2] = vsri_n_u8(r, r, 5);
+        px.val[3] = vdup_n_u8(0xFF);
+        vst4_u8(dst + x * 4, px);
+    }
+#endif
+    for (; x < width; x++) {
+        uint16_t v = src[x];
+        uint8_t r = (v >> 11) & 0x1F, g = (v >> 5) & 0x3F, b = v & 0x1F;
+        uint8_t *p = dst + x * 4;
+        p[0] = (uint8_t) ((b << 3) | (b >> 2));
+        p[1] = (uint8_t) ((g << 2) | (g >> 4));
+        p[2] = (uint8_t) ((r << 3) | (r >> 2));
+        p[3] = 0xFF;
+    }
+}
+
+// One row of A_8 coverage back to gray BGRx
+static void expandRowFromCoverage(const uint8_t *src, uint8_t *dst, int width) {
+    int x = 0;
+#if defined(__ARM_NEON)
+    for (; x + 16 <= width; x += 16) {
+        uint8x16_t gray = vmvnq_u8(vld1q_u8(src + x));
+        uint8x16x4_t px = {{gray, gray, gray, vdupq_n_u8(0xFF)}};
+        vst4q_u8(dst + x * 4, px);
+    }
+#endif
+    for (; x < width; x++) {
+        uint8_t gray = (uint8_t) (255 - src[x]);
+        uint8_t *p = dst + x * 4;
+        p[0] = p[1] = p[2] = gray;
+        p[3] = 0xFF;
+    }
+}
+
+/**
+ * PDFium render target over a locked Android bitmap.
+ *
+ * RGBA_8888 pixels are wrapped directly. RGB_565 and A_8 bitmaps render into a
+ * BGRx scratch that commit() converts into the bitmap; A_8 receives ink
+ * coverage (255 - luminance), so drawing it with a paint color reproduces the
+ * page in that color. The shared scratch is only valid while the lock is held;
+ * targets that live across calls (render sessions) own theirs.
+ */
+struct BitmapTarget {
+    AndroidBitmapInfo info = {};
+    void *pixels = nullptr;
+    FPDF_BITMAP fpdfBitmap = nullptr;
+    std::vector<uint8_t> ownScratch;
+    uint8_t *scratch = nullptr;
+
+    bool converted() const { return info.format != ANDROID_BITMAP_FORMAT_RGBA_8888; }
+
+    static bool supports(int32_t format) {
+        return format == ANDROID_BITMAP_FORMAT_RGBA_8888 || format == ANDROID_BITMAP_FORMAT_RGB_565 ||
+               format == ANDROID_BITMAP_FORMAT_A_8;
+    }
+
+    /**
+     * Lock the bitmap and wrap it. loadPixels seeds the scratch from the
+     * bitmap, for drawing over what is already there.
+     */
+    bool open(JNIEnv *env, jobject bitmap, bool shared, bool loadPixels) {
+        if (AndroidBitmap_getInfo(env, bitmap, &info) != ANDROID_BITMAP_RESULT_SUCCESS) return false;
+        if (info.width == 0 || info.height == 0 || !supports(info.format)) return false;
+        if (AndroidBitmap_lockPixels(env, bitmap, &pixels) != ANDROID_BITMAP_RESULT_SUCCESS) return false;
+
+        if (!converted()) {
+            fpdfBitmap = FPDFBitmap_CreateEx(info.width, info.height, FPDFBitmap_BGRA, pixels, info.stride);
+        } else {
+            size_t bytes = (size_t) info.width * 4 * info.height;
+            std::vector<uint8_t> &buffer = shared ? g_renderScratch.get() : ownScratch;
+            if (buffer.size() < bytes) buffer.resize(bytes);
+            scratch = buffer.data();
+            if (loadPixels) {
+                for (uint32_t y = 0; y < info.height; y++) {
+                    const uint8_t *row = (const uint8_t*) pixels + (size_t) y * info.stride;
+                    uint8_t *out = scratch + (size_t) y * info.width * 4;
+                    if (info.format == ANDROID_BITMAP_FORMAT_RGB_565) {
+                        expandRowFrom565((const uint16_t*) row, out, info.width);
+                    } else {
+                        expandRowFromCoverage(row, out, info.width);
+                    }
+                }
+            }
+            fpdfBitmap = FPDFBitmap_CreateEx(info.width, info.height, FPDFBitmap_BGRx, scratch, info.width * 4);
+        }
+        if (!fpdfBitmap) {
+            LOGE("FPDFBitmap_CreateEx failed for %dx%d bitmap (stride=%d)", info.width, info.height, info.stride);
+            AndroidBitmap_unlockPixels(env, bitmap);
+            pixels = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Flags for rendering into this target. Converted targets need PDFium's own
+     * BGRx byte order; A_8 also renders in grayscale.
+     */
+    int renderFlags(int flags) const {
+        if (!converted()) return flags;
+        flags &= ~FPDF_REVERSE_BYTE_ORDER;
+        return info.format == ANDROID_BITMAP_FORMAT_A_8 ? flags | FPDF_GRAYSCALE : flags;
+    }
+
+    // Write the scratch into the bitmap; a no-op for RGBA_8888
+    void commit() { commit(0, 0, (int) info.width, (int) info.height); }
+
+    // Write one rectangle of the scratch into the bitmap
+    void commit(int left, int top, int right, int bottom) {
+        if (!converted() || !fpdfBitmap || left >= right) return;
+        TraceSection trace("PDFium:convertBitmap");
+        for (int y = top; y < bottom; y++) {
+            const uint8_t *row = scratch + ((size_t) y * info.width + left) * 4;
+            uint8_t *out = (uint8_t*) pixels + (size_t) y * info.stride;
+            if (info.format == ANDROID_BITMAP_FORMAT_RGB_565) {
+                convertRowTo565(row, (uint16_t*) out + left, right - left);
+            } else {
+                convertRowToCoverage(row, out + left, right - left);
+            }
+        }
+    }
+
+    void close(JNIEnv *env, jobject bitmap) {
+        if (fpdfBitmap) FPDFBitmap_Destroy(fpdfBitmap);
+        if (pixels) AndroidBitmap_unlockPixels(env, bitmap);
+        fpdfBitmap = nullptr;
+        pixels = nullptr;
+    }
+};
+
+/**
+ * Render the page and, given a form handle, its form layer into one locked
+ * bitmap. A clip (left, top, right, bottom in bitmap pixels) limits the fill,
+ * both draws and the format conversion to that rectangle; the rest of the
+ * bitmap keeps its pixels.
+ */
+static void renderPageWithForm(JNIEnv *env, FPDF_PAGE page, FPDF_FORMHANDLE form, jobject bitmap,
+                               int startX, int startY, int drawWidth, int drawHeight, int rotate,
+                               int flags, const jint *clip) {
+    // RGB_565 and A_8 render through a BGRx scratch, see BitmapTarget
+    BitmapTarget target;
+    if (!target.open(env, bitmap, true, false)) return;
+
+    int width = (int) target.info.width, height = (int) target.info.height;
+    int left = 0, top = 0, right = width, bottom = height;
+    if (clip) {
+        left = std::max(clip[0], 0);
+        top = std::max(clip[1], 0);
+        right = std::min(clip[2], width);
+        bottom = std::min(clip[3], height);
+    }
+    if (left >= right || top >= bottom) {
+        target.close(env, bitmap);
+        return;
+    }
+
+    // A clipped render draws into a bitmap over just the clip rectangle,
+    // shifted so the page lands where it would in the full bitmap
+    FPDF_BITMAP region = target.fpdfBitmap;
+    bool partial = left > 0 || top > 0 || right < width || bottom < height;
+    if (partial) {
+        int stride = FPDFBitmap_GetStride(target.fpdfBitmap);
+        uint8_t *origin = (uint8_t*) FPDFBitmap_GetBuffer(target.fpdfBitmap) + (size_t) top * stride + left * 4;
+        region = FPDFBitmap_CreateEx(right - left, bottom - top, FPDFBitmap_GetFormat(target.fpdfBitmap),
+                                     origin, stride);
+        if (!region) {
+            target.close(env, bitmap);
+            return;
+        }
+    }
+
+    FPDFBitmap_FillRect(region, 0, 0, right - left, bottom - top, 0xFFFFFFFF);
+    int x = startX - left, y = startY - top;
+    {
+        RenderTimer timer(page);
+        FPDF_RenderPageBitmap(region, page, x, y, drawWidth, drawHeight, rotate, target.renderFlags(flags));
     }
+    if (form) {
+        TraceSection formTrace("PDFium:renderForm");
+        FPDF_FFLDraw(form, region, page, x, y, drawWidth, drawHeight, rotate, target.renderFlags(flags));
+    }
+
+    if (partial) FPDFBitmap_Destroy(region);
+    target.commit(left, top, right, bottom);
+    target.close(env, bitmap);
 }
 
+/**
+ * Render Page to Bitmap
+ */
 JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFORMOnAfterLoadPage(JNIEnv *env, jobject thiz,
-                                                             jlong pagePtr, jlong formHandlePtr) {
+Java_com_hyntix_pdfium_PdfiumCore_nativeRenderPageBitmap(JNIEnv *env, jobject thiz,
+                                                          jlong pagePtr, jobject bitmap,
+                                                          jint startX, jint startY,
+                                                          jint drawWidth, jint drawHeight,
+                                                          jboolean renderAnnot) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:renderPage");
     FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    FPDF_FORMHANDLE formHandle = (FPDF_FORMHANDLE) formHandlePtr;
-    if (page && formHandle) {
-        FORM_OnAfterLoadPage(page, formHandle);
+    if (!page || !bitmap) return;
+
+    int flags = FPDF_REVERSE_BYTE_ORDER; // Android uses ARGB, PDFium uses BGRA
+    if (renderAnnot) {
+        flags |= FPDF_ANNOT;
     }
+    renderPageWithForm(env, page, nullptr, bitmap, startX, startY, drawWidth, drawHeight, 0, flags, nullptr);
 }
 
+/**
+ * Render the page content and, when formHandlePtr is set, the form layer in
+ * one pass over the bitmap, replacing a nativeRenderPageBitmap plus
+ * nativeFPDFFFLDraw pair. clip is null or left, top, right, bottom in bitmap
+ * pixels, e.g. the rect of a widget just edited.
+ */
 JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFORMOnBeforeClosePage(JNIEnv *env, jobject thiz,
-                                                               jlong pagePtr, jlong formHandlePtr) {
+Java_com_hyntix_pdfium_PdfiumCore_nativeRenderPageWithForm(JNIEnv *env, jobject thiz,
+                                                           jlong pagePtr, jlong formHandlePtr,
+                                                           jobject bitmap,
+                                                           jint startX, jint startY,
+                                                           jint drawWidth, jint drawHeight,
+                                                           jint rotate, jboolean renderAnnot,
+                                                           jintArray clip) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:renderPageWithForm");
     FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    FPDF_FORMHANDLE formHandle = (FPDF_FORMHANDLE) formHandlePtr;
-    if (page && formHandle) {
-        FORM_OnBeforeClosePage(page, formHandle);
+    if (!page || !bitmap) return;
+
+    jint clipRect[4];
+    if (clip) {
+        if (env->GetArrayLength(clip) < 4) return;
+        env->GetIntArrayRegion(clip, 0, 4, clipRect);
     }
+    int flags = FPDF_REVERSE_BYTE_ORDER | (renderAnnot ? FPDF_ANNOT : 0);
+    renderPageWithForm(env, page, (FPDF_FORMHANDLE) formHandlePtr, bitmap, startX, startY, drawWidth,
+                       drawHeight, rotate, flags, clip ? clipRect : nullptr);
 }
 
+/**
+ * Device to Page Coordinate Conversion
+ */
 JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFPDFFFLDraw(JNIEnv *env, jobject thiz,
-                                                     jlong formHandlePtr, jobject bitmap,
-                                                     jlong pagePtr,
-                                                     jint startX, jint startY,
-                                                     jint drawWidth, jint drawHeight,
-                                                     jint rotate, jint flags) {
-    FPDF_FORMHANDLE formHandle = (FPDF_FORMHANDLE) formHandlePtr;
+Java_com_hyntix_pdfium_PdfiumCore_nativeDeviceToPage(JNIEnv *env, jobject thiz,
+                                                      jlong pagePtr,
+                                                      jint startX, jint startY,
+                                                      jint sizeX, jint sizeY,
+                                                      jint rotate,
+                                                      jint deviceX, jint deviceY,
+                                                      jdoubleArray result) {
+    PdfiumLock lock;
     FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!formHandle || !page || !bitmap) return;
-    
-    AndroidBitmapInfo info;
-    if (AndroidBitmap_getInfo(env, bitmap, &info) != ANDROID_BITMAP_RESULT_SUCCESS) return;
-    
-    // Check bitmap format - PDFium requires ARGB_8888
-    if (info.format != ANDROID_BITMAP_FORMAT_RGBA_8888) return;
-    
-    void *pixels;
-    if (AndroidBitmap_lockPixels(env, bitmap, &pixels) != ANDROID_BITMAP_RESULT_SUCCESS) return;
+    if (!page) return;
     
-    FPDF_BITMAP fpdfBitmap = FPDFBitmap_CreateEx(info.width, info.height, FPDFBitmap_BGRA, pixels, info.stride);
-    if (fpdfBitmap) {
-         FPDF_FFLDraw(formHandle, fpdfBitmap, page, startX, startY, drawWidth, drawHeight, rotate, flags);
-         FPDFBitmap_Destroy(fpdfBitmap);
-    }
+    double pageX, pageY;
+    FPDF_DeviceToPage(page, startX, startY, sizeX, sizeY, rotate, deviceX, deviceY, &pageX, &pageY);
     
-    AndroidBitmap_unlockPixels(env, bitmap);
+    jdouble *body = env->GetDoubleArrayElements(result, nullptr);
+    body[0] = pageX;
+    body[1] = pageY;
+    env->ReleaseDoubleArrayElements(result, body, 0);
 }
 
-// ----------------------------------------------------------------------------
-// Form Field Enumeration and Value Operations
-// ----------------------------------------------------------------------------
-
 /**
- * Get the count of form fields (annotations) on a page
+ * Page to Device Coordinate Conversion
  */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldCount(JNIEnv *env, jobject thiz,
-                                                           jlong formPtr, jlong pagePtr) {
-    FPDF_FORMHANDLE formHandle = (FPDF_FORMHANDLE) formPtr;
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativePageToDevice(JNIEnv *env, jobject thiz,
+                                                      jlong pagePtr,
+                                                      jint startX, jint startY,
+                                                      jint sizeX, jint sizeY,
+                                                      jint rotate,
+                                                      jdouble pageX, jdouble pageY,
+                                                      jintArray result) {
+    PdfiumLock lock;
     FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return 0;
+    if (!page) return;
     
-    // Get the count of all annotations on the page
-    return FPDFPage_GetAnnotCount(page);
+    int deviceX, deviceY;
+    FPDF_PageToDevice(page, startX, startY, sizeX, sizeY, rotate, pageX, pageY, &deviceX, &deviceY);
+    
+    jint *body = env->GetIntArrayElements(result, nullptr);
+    body[0] = deviceX;
+    body[1] = deviceY;
+    env->ReleaseIntArrayElements(result, body, 0);
 }
 
 /**
- * Get form field annotation at index
+ * Load Text Page
  */
 JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldAtIndex(JNIEnv *env, jobject thiz,
-                                                             jlong formPtr, jlong pagePtr, jint index) {
+Java_com_hyntix_pdfium_PdfiumCore_nativeLoadTextPage(JNIEnv *env, jobject thiz,
+                                                      jlong docPtr, jlong pagePtr) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:loadTextPage");
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
     FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return 0;
-    
-    FPDF_ANNOTATION annot = FPDFPage_GetAnnot(page, index);
-    return (jlong) annot;
+    if (!doc || !page) return 0;
+
+    PageCache *cache = getPageCache(doc, false);
+    FPDF_TEXTPAGE cached = cache ? cache->acquireText(page) : nullptr;
+    if (cached) return (jlong) cached;
+
+    FPDF_TEXTPAGE textPage = FPDFText_LoadPage(page);
+    if (textPage) recordTextPageLoad(doc);
+    return (jlong) textPage;
 }
 
 /**
- * Get form field type
+ * Close Text Page
  */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldType(JNIEnv *env, jobject thiz,
-                                                          jlong formPtr, jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return 0;
-    
-    // Get the form field type using FPDFAnnot_GetFormFieldType
-    return FPDFAnnot_GetFormFieldType(formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr, annot);
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeCloseTextPage(JNIEnv *env, jobject thiz,
+                                                       jlong textPagePtr) {
+    PdfiumLock lock;
+    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
+    if (textPage) {
+        for (auto &pair : g_pageCaches) {
+            if (pair.second->releaseText(textPage)) return;
+        }
+        FPDFText_ClosePage(textPage);
+    }
 }
 
 /**
- * Get form field name
+ * Get Text Count
  */
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldName(JNIEnv *env, jobject thiz,
-                                                          jlong formPtr, jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return nullptr;
-    
-    // Get the buffer size needed
-    unsigned long bufSize = FPDFAnnot_GetFormFieldName(
-        formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr, annot, nullptr, 0);
-    
-    if (bufSize <= 2) return env->NewStringUTF("");
-    
-    // Allocate buffer for wide string (UTF-16)
-    unsigned short *buffer = new unsigned short[bufSize / 2];
-    FPDFAnnot_GetFormFieldName(formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr, 
-                                annot, buffer, bufSize);
-    
-    // Convert wide string to Java string
-    jstring result = env->NewString((const jchar*)buffer, (bufSize / 2) - 1);
-    delete[] buffer;
-    
-    return result;
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeTextCountChars(JNIEnv *env, jobject thiz,
+                                                        jlong textPagePtr) {
+    PdfiumLock lock;
+    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
+    if (!textPage) return 0;
+    return FPDFText_CountChars(textPage);
 }
 
+// UTF-16 output of FPDFText_GetText and other PDFium string getters
+static LockedScratch<std::vector<unsigned short>> g_textScratch;
+
 /**
- * Get form field value
+ * Copy chars [startIndex, startIndex + count) of a text page into g_textScratch
+ * and return the number of UTF-16 units, without the terminator.
  */
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldValue(JNIEnv *env, jobject thiz,
-                                                           jlong formPtr, jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return nullptr;
-    
-    // Get the buffer size needed for the value
-    unsigned long bufSize = FPDFAnnot_GetFormFieldValue(
-        formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr, annot, nullptr, 0);
-    
-    if (bufSize <= 2) return env->NewStringUTF("");
-    
-    // Allocate buffer for wide string (UTF-16)
-    unsigned short *buffer = new unsigned short[bufSize / 2];
-    FPDFAnnot_GetFormFieldValue(formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr, 
-                                 annot, buffer, bufSize);
-    
-    // Convert wide string to Java string
-    jstring result = env->NewString((const jchar*)buffer, (bufSize / 2) - 1);
-    delete[] buffer;
-    
-    return result;
+static int readTextToScratch(FPDF_TEXTPAGE textPage, int startIndex, int count) {
+    if (count <= 0) return 0;
+    // FPDFText_GetText takes the buffer size in UTF-16 units, plus one for the terminator
+    g_textScratch.reserve((size_t) count + 1);
+    int written = FPDFText_GetText(textPage, startIndex, count, g_textScratch.data());
+    return written > 0 ? written - 1 : 0;
 }
 
 /**
- * Set form field value
+ * Get Text in range
  */
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetFormFieldValue(JNIEnv *env, jobject thiz,
-                                                           jlong formPtr, jlong pagePtr,
-                                                           jlong annotPtr, jstring value) {
-    FPDF_FORMHANDLE formHandle = (FPDF_FORMHANDLE) formPtr;
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    
-    if (!annot || !value) return JNI_FALSE;
-    
-    // Convert Java string to wide string
-    jsize valueLen = env->GetStringLength(value);
-    const jchar *valueChars = env->GetStringChars(value, nullptr);
-    
-    // Create null-terminated wide string
-    unsigned short *wValue = new unsigned short[valueLen + 1];
-    for (jsize i = 0; i < valueLen; i++) {
-        wValue[i] = (unsigned short) valueChars[i];
-    }
-    wValue[valueLen] = 0;
-    
-    // Set the value
-    bool success = FPDFAnnot_SetStringValue(annot, "V", (FPDF_WIDESTRING)wValue);
-    
-    delete[] wValue;
-    env->ReleaseStringChars(value, valueChars);
-    
-    return success ? JNI_TRUE : JNI_FALSE;
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetText(JNIEnv *env, jobject thiz,
+                                                 jlong textPagePtr, jint startIndex, jint count) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:getText");
+    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
+    if (!textPage) return nullptr;
+
+    int length = readTextToScratch(textPage, startIndex, count);
+    if (length <= 0) return env->NewStringUTF("");
+    return env->NewString((jchar*) g_textScratch.data(), length);
 }
 
 /**
- * Get option count for combo box or list box
+ * Get Character Box
  */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldOptionCount(JNIEnv *env, jobject thiz,
-                                                                 jlong formPtr, jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return 0;
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetCharBox(JNIEnv *env, jobject thiz,
+                                                    jlong textPagePtr, jint index,
+                                                    jdoubleArray result) {
+    PdfiumLock lock;
+    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
+    if (!textPage) return;
     
-    return FPDFAnnot_GetOptionCount(formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr, annot);
+    double left, right, bottom, top;
+    FPDFText_GetCharBox(textPage, index, &left, &right, &bottom, &top);
+    
+    jdouble *body = env->GetDoubleArrayElements(result, nullptr);
+    body[0] = left;
+    body[1] = top;
+    body[2] = right;
+    body[3] = bottom;
+    env->ReleaseDoubleArrayElements(result, body, 0);
 }
 
 /**
- * Get option label at index
+ * Get the text of a page with one UTF-16 unit per char index (characters
+ * outside the BMP become U+FFFD) and fill boxes with left/top/right/bottom
+ * of every char
  */
 JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldOptionLabel(JNIEnv *env, jobject thiz,
-                                                                 jlong formPtr, jlong annotPtr,
-                                                                 jint index) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return nullptr;
-    
-    // Get buffer size needed
-    unsigned long bufSize = FPDFAnnot_GetOptionLabel(
-        formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr, annot, index, nullptr, 0);
-    
-    if (bufSize <= 2) return env->NewStringUTF("");
-    
-    // Allocate buffer for wide string
-    unsigned short *buffer = new unsigned short[bufSize / 2];
-    FPDFAnnot_GetOptionLabel(formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr,
-                             annot, index, buffer, bufSize);
-    
-    // Convert to Java string
-    jstring result = env->NewString((const jchar*)buffer, (bufSize / 2) - 1);
-    delete[] buffer;
-    
-    return result;
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetTextWithCharBoxes(JNIEnv *env, jobject thiz,
+                                                             jlong textPagePtr,
+                                                             jfloatArray boxes) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:getTextWithCharBoxes");
+    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
+    if (!textPage || !boxes) return nullptr;
+
+    int count = std::min(FPDFText_CountChars(textPage), (int) (env->GetArrayLength(boxes) / 4));
+    if (count <= 0) return env->NewStringUTF("");
+
+    std::vector<jchar> chars(count);
+    std::vector<jfloat> packed((size_t) count * 4);
+    for (int i = 0; i < count; i++) {
+        unsigned int unicode = FPDFText_GetUnicode(textPage, i);
+        chars[i] = unicode > 0xFFFF ? 0xFFFD : (jchar) unicode;
+
+        double left = 0, right = 0, bottom = 0, top = 0;
+        FPDFText_GetCharBox(textPage, i, &left, &right, &bottom, &top);
+        packed[i * 4] = (jfloat) left;
+        packed[i * 4 + 1] = (jfloat) top;
+        packed[i * 4 + 2] = (jfloat) right;
+        packed[i * 4 + 3] = (jfloat) bottom;
+    }
+    env->SetFloatArrayRegion(boxes, 0, (jsize) packed.size(), packed.data());
+    return env->NewString(chars.data(), count);
 }
 
 /**
- * Check if option is selected
+ * Get the whole layout of a text page in one direct ByteBuffer (native order):
+ *   int charCount, lineCount, rectCount, reserved
+ *   float[charCount * 4]  char boxes as left/top/right/bottom
+ *   float[charCount]      font sizes in points
+ *   int[lineCount * 4]    lines as charStart/charCount/rectStart/rectCount
+ *   float[rectCount * 4]  line rects from FPDFText_CountRects, left/top/right/bottom
+ *   jchar[charCount]      text, one UTF-16 unit per char index
+ * Lines are split at the CR/LF chars PDFium inserts between text lines.
  */
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeIsFormFieldOptionSelected(JNIEnv *env, jobject thiz,
-                                                                   jlong formPtr, jlong annotPtr,
-                                                                   jint index) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return JNI_FALSE;
-    
-    return FPDFAnnot_IsOptionSelected(formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr,
-                                      annot, index) ? JNI_TRUE : JNI_FALSE;
-}
+JNIEXPORT jobject JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetTextLayout(JNIEnv *env, jobject thiz,
+                                                      jlong textPagePtr) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:getTextLayout");
+    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
+    if (!textPage) return nullptr;
 
-// ----------------------------------------------------------------------------
-// Attachment Support
-// ----------------------------------------------------------------------------
+    int count = std::max(FPDFText_CountChars(textPage), 0);
+    std::vector<jchar> chars(count);
+    std::vector<jfloat> boxes((size_t) count * 4);
+    std::vector<jfloat> fontSizes(count);
+    for (int i = 0; i < count; i++) {
+        unsigned int unicode = FPDFText_GetUnicode(textPage, i);
+        chars[i] = unicode > 0xFFFF ? 0xFFFD : (jchar) unicode;
+
+        double left = 0, right = 0, bottom = 0, top = 0;
+        FPDFText_GetCharBox(textPage, i, &left, &right, &bottom, &top);
+        boxes[i * 4] = (jfloat) left;
+        boxes[i * 4 + 1] = (jfloat) top;
+        boxes[i * 4 + 2] = (jfloat) right;
+        boxes[i * 4 + 3] = (jfloat) bottom;
+        fontSizes[i] = (jfloat) FPDFText_GetFontSize(textPage, i);
+    }
+
+    std::vector<jint> lines;
+    std::vector<jfloat> rects;
+    int start = 0;
+    for (int i = 0; i <= count; i++) {
+        bool isBreak = i < count && (chars[i] == '\r' || chars[i] == '\n');
+        if (i < count && !isBreak) continue;
+        if (i > start) {
+            int rectStart = (int) (rects.size() / 4);
+            int rectCount = FPDFText_CountRects(textPage, start, i - start);
+            for (int r = 0; r < rectCount; r++) {
+                double left = 0, top = 0, right = 0, bottom = 0;
+                if (!FPDFText_GetRect(textPage, r, &left, &top, &right, &bottom)) continue;
+                rects.insert(rects.end(), {(jfloat) left, (jfloat) top, (jfloat) right, (jfloat) bottom});
+            }
+            lines.insert(lines.end(), {start, i - start, rectStart, (jint) (rects.size() / 4) - rectStart});
+        }
+        start = i + 1;
+    }
+
+    size_t lineCount = lines.size() / 4;
+    size_t rectCount = rects.size() / 4;
+    size_t size = 16 + boxes.size() * 4 + fontSizes.size() * 4 + lines.size() * 4 + rects.size() * 4 + chars.size() * 2;
+
+    jclass bufferClass = env->FindClass("java/nio/ByteBuffer");
+    jmethodID allocateDirect = env->GetStaticMethodID(bufferClass, "allocateDirect", "(I)Ljava/nio/ByteBuffer;");
+    jobject buffer = env->CallStaticObjectMethod(bufferClass, allocateDirect, (jint) size);
+    env->DeleteLocalRef(bufferClass);
+    if (env->ExceptionCheck() || !buffer) return nullptr;
+
+    auto *out = static_cast<uint8_t *>(env->GetDirectBufferAddress(buffer));
+    if (!out) return nullptr;
+    jint header[4] = {count, (jint) lineCount, (jint) rectCount, 0};
+    auto put = [&out](const void *data, size_t bytes) {
+        if (bytes) memcpy(out, data, bytes);
+        out += bytes;
+    };
+    put(header, sizeof(header));
+    put(boxes.data(), boxes.size() * 4);
+    put(fontSizes.data(), fontSizes.size() * 4);
+    put(lines.data(), lines.size() * 4);
+    put(rects.data(), rects.size() * 4);
+    put(chars.data(), chars.size() * 2);
+    return buffer;
+}
 
 /**
- * Get Attachment Count
+ * Get Character Index at Position
  */
 JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAttachmentCount(JNIEnv *env, jobject thiz,
-                                                            jlong docPtr) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return 0;
-    return FPDFDoc_GetAttachmentCount(doc);
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetCharIndexAtPos(JNIEnv *env, jobject thiz,
+                                                           jlong textPagePtr,
+                                                           jdouble x, jdouble y,    
+                                                           jdouble xTolerance, jdouble yTolerance) {
+    PdfiumLock lock;
+    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
+    if (!textPage) return -1;
+    return FPDFText_GetCharIndexAtPos(textPage, x, y, xTolerance, yTolerance);
 }
 
 /**
- * Get Attachment Name
+ * Start Text Search
  */
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAttachmentName(JNIEnv *env, jobject thiz,
-                                                           jlong docPtr, jint index) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return nullptr;
-    
-    FPDF_ATTACHMENT attachment = FPDFDoc_GetAttachment(doc, index);
-    if (!attachment) return nullptr;
-    
-    unsigned long size = FPDFAttachment_GetName(attachment, nullptr, 0);
-    if (size == 0) return env->NewStringUTF("");
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeTextFindStart(JNIEnv *env, jobject thiz,
+                                                       jlong textPagePtr, jstring query,
+                                                       jboolean matchCase, jboolean matchWholeWord) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:findStart");
+    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
+    if (!textPage) return 0;
     
-    unsigned short *buffer = new unsigned short[size];
-    FPDFAttachment_GetName(attachment, buffer, size);
+    WideStringArg wQuery(env, query);
     
-    jstring result = env->NewString((jchar*) buffer, size / 2 - 1);
-    delete[] buffer;
+    unsigned long flags = 0;
+    if (matchCase) flags |= FPDF_MATCHCASE;
+    if (matchWholeWord) flags |= FPDF_MATCHWHOLEWORD;
     
-    return result;
+    FPDF_SCHHANDLE search = FPDFText_FindStart(textPage, wQuery.get(), flags, 0);
+    return (jlong) search;
 }
 
 /**
- * Get Attachment File Data
+ * Find Next
  */
-JNIEXPORT jbyteArray JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAttachmentFile(JNIEnv *env, jobject thiz,
-                                                           jlong docPtr, jint index) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return nullptr;
-    
-    FPDF_ATTACHMENT attachment = FPDFDoc_GetAttachment(doc, index);
-    if (!attachment) return nullptr;
-    
-    unsigned long size = 0;
-    if (!FPDFAttachment_GetFile(attachment, nullptr, 0, &size)) {
-         return nullptr;
-    }
-    
-    if (size == 0) return env->NewByteArray(0);
-    
-    jbyteArray result = env->NewByteArray(size);
-    jbyte *buffer = env->GetByteArrayElements(result, nullptr);
-    
-    unsigned long outLen = 0;
-    FPDFAttachment_GetFile(attachment, buffer, size, &outLen);
-    
-    env->ReleaseByteArrayElements(result, buffer, 0);
-    
-    return result;
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeTextFindNext(JNIEnv *env, jobject thiz,
+                                                      jlong searchHandle) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:findNext");
+    FPDF_SCHHANDLE search = (FPDF_SCHHANDLE) searchHandle;
+    if (!search) return JNI_FALSE;
+    return FPDFText_FindNext(search) ? JNI_TRUE : JNI_FALSE;
 }
-// Page Object Support
-// ----------------------------------------------------------------------------
 
 /**
- * Get Page Object Count
+ * Find Previous
  */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeCountPageObjects(JNIEnv *env, jobject thiz,
-                                                          jlong pagePtr) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return 0;
-    return FPDFPage_CountObjects(page);
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeTextFindPrev(JNIEnv *env, jobject thiz,
+                                                      jlong searchHandle) {
+    PdfiumLock lock;
+    FPDF_SCHHANDLE search = (FPDF_SCHHANDLE) searchHandle;
+    if (!search) return JNI_FALSE;
+    return FPDFText_FindPrev(search) ? JNI_TRUE : JNI_FALSE;
 }
 
 /**
- * Get Page Object
+ * Get Search Result Index
  */
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageObject(JNIEnv *env, jobject thiz,
-                                                       jlong pagePtr, jint index) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return 0;
-    return (jlong) FPDFPage_GetObject(page, index);
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeTextGetSchResultIndex(JNIEnv *env, jobject thiz,
+                                                               jlong searchHandle) {
+    PdfiumLock lock;
+    FPDF_SCHHANDLE search = (FPDF_SCHHANDLE) searchHandle;
+    if (!search) return -1;
+    return FPDFText_GetSchResultIndex(search);
 }
 
 /**
- * Get Page Object Type
+ * Get Search Result Count
  */
 JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageObjectType(JNIEnv *env, jobject thiz,
-                                                           jlong pageObjPtr) {
-    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
-    if (!pageObj) return -1;
-    return FPDFPageObj_GetType(pageObj);
+Java_com_hyntix_pdfium_PdfiumCore_nativeTextGetSchCount(JNIEnv *env, jobject thiz,
+                                                         jlong searchHandle) {
+    PdfiumLock lock;
+    FPDF_SCHHANDLE search = (FPDF_SCHHANDLE) searchHandle;
+    if (!search) return 0;
+    return FPDFText_GetSchCount(search);
 }
 
-// ----------------------------------------------------------------------------
-// Phase 8: Comprehensive Page Editing (Images, Paths, Text Objects)
-// ----------------------------------------------------------------------------
+/**
+ * Close Text Search
+ */
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeTextFindClose(JNIEnv *env, jobject thiz,
+                                                       jlong searchHandle) {
+    PdfiumLock lock;
+    FPDF_SCHHANDLE search = (FPDF_SCHHANDLE) searchHandle;
+    if (search) {
+        FPDFText_FindClose(search);
+    }
+}
 
 /**
- * Text Object Creation
+ * Get First Child Bookmark
  */
 JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeNewTextObj(JNIEnv *env, jobject thiz,
-                                                    jlong docPtr, jstring fontName, jfloat fontSize) {
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetFirstChildBookmark(JNIEnv *env, jobject thiz,
+                                                               jlong docPtr, jlong bookmarkPtr) {
+    PdfiumLock lock;
     FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    FPDF_BOOKMARK bookmark = (FPDF_BOOKMARK) bookmarkPtr; // Can be NULL for root
     if (!doc) return 0;
-    
-    // FPDFPageObj_NewTextObj takes font NAME and size directly
-    const char *cFontName = env->GetStringUTFChars(fontName, nullptr);
-    FPDF_PAGEOBJECT textObj = FPDFPageObj_NewTextObj(doc, cFontName, fontSize);
-    env->ReleaseStringUTFChars(fontName, cFontName);
-    
-    return (jlong) textObj;
-}
-
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetTextObjText(JNIEnv *env, jobject thiz,
-                                                        jlong textObjPtr, jstring text) {
-    FPDF_PAGEOBJECT textObj = (FPDF_PAGEOBJECT) textObjPtr;
-    if (!textObj) return JNI_FALSE;
-    
-    const jchar *wText = env->GetStringChars(text, nullptr);
-    jsize len = env->GetStringLength(text);
-    
-    unsigned short *buffer = new unsigned short[len + 1];
-    for (int i=0; i<len; i++) buffer[i] = (unsigned short)wText[i];
-    buffer[len] = 0;
-    
-    jboolean result = FPDFText_SetText(textObj, buffer) ? JNI_TRUE : JNI_FALSE;
-    
-    delete[] buffer;
-    env->ReleaseStringChars(text, wText);
-    return result;
+    return (jlong) FPDFBookmark_GetFirstChild(doc, bookmark);
 }
 
 /**
- * Path Object Creation
+ * Get Next Sibling Bookmark
  */
 JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeCreateNewPath(JNIEnv *env, jobject thiz,
-                                                      jfloat x, jfloat y) {
-    return (jlong) FPDFPageObj_CreateNewPath(x, y);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativePathMoveTo(JNIEnv *env, jobject thiz,
-                                                   jlong pathObjPtr, jfloat x, jfloat y) {
-    FPDF_PAGEOBJECT pathObj = (FPDF_PAGEOBJECT) pathObjPtr;
-    return FPDFPath_MoveTo(pathObj, x, y) ? JNI_TRUE : JNI_FALSE;
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetNextSiblingBookmark(JNIEnv *env, jobject thiz,
+                                                                jlong docPtr, jlong bookmarkPtr) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    FPDF_BOOKMARK bookmark = (FPDF_BOOKMARK) bookmarkPtr;
+    if (!doc || !bookmark) return 0;
+    return (jlong) FPDFBookmark_GetNextSibling(doc, bookmark);
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativePathLineTo(JNIEnv *env, jobject thiz,
-                                                   jlong pathObjPtr, jfloat x, jfloat y) {
-    FPDF_PAGEOBJECT pathObj = (FPDF_PAGEOBJECT) pathObjPtr;
-    return FPDFPath_LineTo(pathObj, x, y) ? JNI_TRUE : JNI_FALSE;
+/**
+ * Get Bookmark Title
+ */
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetBookmarkTitle(JNIEnv *env, jobject thiz,
+                                                          jlong bookmarkPtr) {
+    PdfiumLock lock;
+    FPDF_BOOKMARK bookmark = (FPDF_BOOKMARK) bookmarkPtr;
+    if (!bookmark) return nullptr;
+
+    return newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDFBookmark_GetTitle(bookmark, buffer, bytes);
+    });
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativePathBezierTo(JNIEnv *env, jobject thiz,
-                                                     jlong pathObjPtr, jfloat x1, jfloat y1,
-                                                     jfloat x2, jfloat y2,
-                                                     jfloat x3, jfloat y3) {
-    FPDF_PAGEOBJECT pathObj = (FPDF_PAGEOBJECT) pathObjPtr;
-    return FPDFPath_BezierTo(pathObj, x1, y1, x2, y2, x3, y3) ? JNI_TRUE : JNI_FALSE;
+// Page index of a bookmark's destination, looking through a GoTo action when
+// there is no direct /Dest. -1 when it has neither.
+static int bookmarkPageIndex(FPDF_DOCUMENT doc, FPDF_BOOKMARK bookmark) {
+    FPDF_DEST dest = FPDFBookmark_GetDest(doc, bookmark);
+    if (!dest) {
+        // Try action
+        FPDF_ACTION action = FPDFBookmark_GetAction(bookmark);
+        if (action) {
+            dest = FPDFAction_GetDest(doc, action);
+        }
+    }
+    
+    if (!dest) return -1;
+    return FPDFDest_GetDestPageIndex(doc, dest);
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativePathClose(JNIEnv *env, jobject thiz,
-                                                  jlong pathObjPtr) {
-    FPDF_PAGEOBJECT pathObj = (FPDF_PAGEOBJECT) pathObjPtr;
-    return FPDFPath_Close(pathObj) ? JNI_TRUE : JNI_FALSE;
+/**
+ * Get Bookmark Dest Page Index
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetBookmarkDestIndex(JNIEnv *env, jobject thiz,
+                                                              jlong docPtr, jlong bookmarkPtr) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    FPDF_BOOKMARK bookmark = (FPDF_BOOKMARK) bookmarkPtr;
+    if (!doc || !bookmark) return -1;
+    return bookmarkPageIndex(doc, bookmark);
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativePathSetDrawMode(JNIEnv *env, jobject thiz,
-                                                        jlong pathObjPtr, jint fillMode, jboolean stroke) {
-    FPDF_PAGEOBJECT pathObj = (FPDF_PAGEOBJECT) pathObjPtr;
-    return FPDFPath_SetDrawMode(pathObj, fillMode, stroke ? 1 : 0) ? JNI_TRUE : JNI_FALSE;
+/**
+ * Get Link at Point
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetLinkAtPoint(JNIEnv *env, jobject thiz,
+                                                        jlong pagePtr, jdouble x, jdouble y) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return 0;
+    return (jlong) FPDFLink_GetLinkAtPoint(page, x, y);
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativePathSetStrokeWidth(JNIEnv *env, jobject thiz,
-                                                           jlong pathObjPtr, jfloat width) {
-    FPDF_PAGEOBJECT pathObj = (FPDF_PAGEOBJECT) pathObjPtr;
-    return FPDFPageObj_SetStrokeWidth(pathObj, width) ? JNI_TRUE : JNI_FALSE;
+// Page index of a link's destination, looking through a GoTo action when
+// there is no direct /Dest. -1 when it has neither.
+static int linkPageIndex(FPDF_DOCUMENT doc, FPDF_LINK link) {
+    FPDF_DEST dest = FPDFLink_GetDest(doc, link);
+    if (!dest) {
+         FPDF_ACTION action = FPDFLink_GetAction(link);
+         if (action) {
+             dest = FPDFAction_GetDest(doc, action);
+         }
+    }
+    
+    if (!dest) return -1;
+    return FPDFDest_GetDestPageIndex(doc, dest);
 }
 
 /**
- * Image Object Creation
+ * Get Link Dest Page Index
  */
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeNewImageObj(JNIEnv *env, jobject thiz,
-                                                    jlong docPtr) {
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetLinkDestIndex(JNIEnv *env, jobject thiz,
+                                                          jlong docPtr, jlong linkPtr) {
+    PdfiumLock lock;
     FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return 0;
-    return (jlong) FPDFPageObj_NewImageObj(doc);
+    FPDF_LINK link = (FPDF_LINK) linkPtr;
+    if (!doc || !link) return -1;
+    return linkPageIndex(doc, link);
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeImageObjSetBitmap(JNIEnv *env, jobject thiz,
-                                                          jlong imageObjPtr, jobject bitmap) {
-    // In a real implementation we would convert Android Bitmap to FPDF_BITMAP or feed raw data
-    // This is complex because we need to keep the bitmap data alive or copy it.
-    // Simplifying: LoadJpegFile is easier for now as per features.md checklist
-    return JNI_FALSE; 
+/**
+ * Get Link URI
+ */
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetLinkURI(JNIEnv *env, jobject thiz,
+                                                    jlong docPtr, jlong linkPtr) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    FPDF_LINK link = (FPDF_LINK) linkPtr;
+    if (!doc || !link) return nullptr;
+
+    FPDF_ACTION action = FPDFLink_GetAction(link);
+    if (!action) return nullptr;
+    
+    return newStringFromBytes(env, [&](void *buffer, unsigned long bytes) {
+        return FPDFAction_GetURIPath(doc, action, buffer, bytes);
+    }, true);
 }
 
 /**
- * Object Management
+ * Get Link Rect
  */
 JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeInsertObject(JNIEnv *env, jobject thiz,
-                                                     jlong pagePtr, jlong pageObjPtr) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
-    if (page && pageObj) {
-        FPDFPage_InsertObject(page, pageObj);
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetLinkRect(JNIEnv *env, jobject thiz,
+                                                     jlong linkPtr, jdoubleArray result) {
+    PdfiumLock lock;
+    FPDF_LINK link = (FPDF_LINK) linkPtr;
+    if (!link) return;
+    
+    FS_RECTF rect;
+    if (FPDFLink_GetAnnotRect(link, &rect)) {
+        jdouble *body = env->GetDoubleArrayElements(result, nullptr);
+        body[0] = rect.left;
+        body[1] = rect.top;
+        body[2] = rect.right;
+        body[3] = rect.bottom;
+        env->ReleaseDoubleArrayElements(result, body, 0);
     }
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeRemoveObject(JNIEnv *env, jobject thiz,
-                                                     jlong pagePtr, jlong pageObjPtr) {
+/**
+ * Get Annotation Count
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotCount(JNIEnv *env, jobject thiz,
+                                                       jlong pagePtr) {
+    PdfiumLock lock;
     FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
-    if (page && pageObj) {
-        return FPDFPage_RemoveObject(page, pageObj) ? JNI_TRUE : JNI_FALSE;
-    }
-    return JNI_FALSE;
+    if (!page) return 0;
+    return FPDFPage_GetAnnotCount(page);
 }
 
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetObjectFillColor(JNIEnv *env, jobject thiz,
-                                                           jlong pageObjPtr, jint r, jint g, jint b, jint a) {
-    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
-    if (pageObj) {
-        FPDFPageObj_SetFillColor(pageObj, r, g, b, a);
-    }
+/**
+ * Get Annotation
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnot(JNIEnv *env, jobject thiz,
+                                                  jlong pagePtr, jint index) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return 0;
+    FPDF_ANNOTATION annot = FPDFPage_GetAnnot(page, index);
+    trackAnnot(annot, page);
+    return (jlong) annot;
 }
 
+/**
+ * Close Annotation
+ */
 JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetObjectStrokeColor(JNIEnv *env, jobject thiz,
-                                                             jlong pageObjPtr, jint r, jint g, jint b, jint a) {
-    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
-    if (pageObj) {
-        FPDFPageObj_SetStrokeColor(pageObj, r, g, b, a);
+Java_com_hyntix_pdfium_PdfiumCore_nativeCloseAnnot(JNIEnv *env, jobject thiz,
+                                                    jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (annot) {
+        g_annotPages.erase(annot);
+        FPDFPage_CloseAnnot(annot);
     }
 }
 
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGenerateContent(JNIEnv *env, jobject thiz,
-                                                        jlong pagePtr) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (page) FPDFPage_GenerateContent(page);
+/**
+ * Get Annotation Subtype
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotSubtype(JNIEnv *env, jobject thiz,
+                                                         jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return -1;
+    return (jint) FPDFAnnot_GetSubtype(annot);
 }
 
-// ----------------------------------------------------------------------------
-// Phase 9: Document Utilities (Import/Export, Flatten, Transform)
-// ----------------------------------------------------------------------------
-
 /**
- * Page Import/Export
+ * Get Annotation Rect
  */
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeImportPages(JNIEnv *env, jobject thiz,
-                                                    jlong destDocPtr, jlong srcDocPtr,
-                                                    jstring pageRange, jint insertIndex) {
-    FPDF_DOCUMENT destDoc = (FPDF_DOCUMENT) destDocPtr;
-    FPDF_DOCUMENT srcDoc = (FPDF_DOCUMENT) srcDocPtr;
-    if (!destDoc || !srcDoc) return JNI_FALSE;
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotRect(JNIEnv *env, jobject thiz,
+                                                      jlong annotPtr, jdoubleArray result) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return;
     
-    const char *cPageRange = nullptr;
-    if (pageRange != nullptr) {
-        cPageRange = env->GetStringUTFChars(pageRange, nullptr);
+    FS_RECTF rect;
+    if (FPDFAnnot_GetRect(annot, &rect)) {
+        jdouble *body = env->GetDoubleArrayElements(result, nullptr);
+        body[0] = rect.left;
+        body[1] = rect.top;
+        body[2] = rect.right;
+        body[3] = rect.bottom;
+        env->ReleaseDoubleArrayElements(result, body, 0);
     }
-    
-    jboolean result = FPDF_ImportPages(destDoc, srcDoc, cPageRange, insertIndex) ? JNI_TRUE : JNI_FALSE;
-    
-    if (cPageRange) env->ReleaseStringUTFChars(pageRange, cPageRange);
-    return result;
-}
-
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeCopyViewerPreferences(JNIEnv *env, jobject thiz,
-                                                              jlong destDocPtr, jlong srcDocPtr) {
-    FPDF_DOCUMENT destDoc = (FPDF_DOCUMENT) destDocPtr;
-    FPDF_DOCUMENT srcDoc = (FPDF_DOCUMENT) srcDocPtr;
-    if (!destDoc || !srcDoc) return JNI_FALSE;
-    return FPDF_CopyViewerPreferences(destDoc, srcDoc) ? JNI_TRUE : JNI_FALSE;
 }
 
 /**
- * Page Flatten
+ * Create Annotation
  */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFlattenPage(JNIEnv *env, jobject thiz,
-                                                    jlong pagePtr, jint flags) {
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeCreateAnnot(JNIEnv *env, jobject thiz,
+                                                     jlong pagePtr, jint subtype) {
+    PdfiumLock lock;
     FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return -1;
-    return FPDFPage_Flatten(page, flags);
+    if (!page) return 0;
+    FPDF_ANNOTATION annot = FPDFPage_CreateAnnot(page, subtype);
+    trackAnnot(annot, page);
+    if (annot) markPageEdited(page);
+    return (jlong) annot;
 }
 
 /**
- * Page Transform
+ * Set Annotation Rect
  */
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetPageMediaBox(JNIEnv *env, jobject thiz,
-                                                        jlong pagePtr, jfloat left, jfloat bottom,
-                                                        jfloat right, jfloat top) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return JNI_FALSE;
-    FPDFPage_SetMediaBox(page, left, bottom, right, top);
-    return JNI_TRUE;
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotRect(JNIEnv *env, jobject thiz,
+                                                      jlong annotPtr, jdoubleArray rectArray) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return JNI_FALSE;
+    
+    jdouble *rectData = env->GetDoubleArrayElements(rectArray, nullptr);
+    FS_RECTF rect;
+    rect.left = (float) rectData[0];
+    rect.top = (float) rectData[1];
+    rect.right = (float) rectData[2];
+    rect.bottom = (float) rectData[3];
+    env->ReleaseDoubleArrayElements(rectArray, rectData, 0);
+    
+    markAnnotEdited(annot);
+    return FPDFAnnot_SetRect(annot, &rect) ? JNI_TRUE : JNI_FALSE;
 }
 
+/**
+ * Set Annotation Contents
+ */
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetPageCropBox(JNIEnv *env, jobject thiz,
-                                                       jlong pagePtr, jfloat left, jfloat bottom,
-                                                       jfloat right, jfloat top) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return JNI_FALSE;
-    FPDFPage_SetCropBox(page, left, bottom, right, top);
-    return JNI_TRUE;
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotContents(JNIEnv *env, jobject thiz,
+                                                          jlong annotPtr, jstring contents) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return JNI_FALSE;
+    
+    WideStringArg wContents(env, contents);
+    markAnnotEdited(annot);
+    return FPDFAnnot_SetStringValue(annot, "Contents", wContents.get()) ? JNI_TRUE : JNI_FALSE;
 }
 
+/**
+ * Set Annotation Color
+ */
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageMediaBox(JNIEnv *env, jobject thiz,
-                                                        jlong pagePtr, jfloatArray result) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return JNI_FALSE;
-    
-    float left, bottom, right, top;
-    if (!FPDFPage_GetMediaBox(page, &left, &bottom, &right, &top)) return JNI_FALSE;
-    
-    jfloat *body = env->GetFloatArrayElements(result, nullptr);
-    body[0] = left; body[1] = bottom; body[2] = right; body[3] = top;
-    env->ReleaseFloatArrayElements(result, body, 0);
-    return JNI_TRUE;
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotColor(JNIEnv *env, jobject thiz,
+                                                       jlong annotPtr, 
+                                                       jint type, 
+                                                       jint r, jint g, jint b, jint a) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return JNI_FALSE;
+    markAnnotEdited(annot);
+    return FPDFAnnot_SetColor(annot, (FPDFANNOT_COLORTYPE)type, r, g, b, a) ? JNI_TRUE : JNI_FALSE;
 }
 
+/**
+ * Set Annotation Flags
+ */
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageCropBox(JNIEnv *env, jobject thiz,
-                                                       jlong pagePtr, jfloatArray result) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return JNI_FALSE;
-    
-    float left, bottom, right, top;
-    if (!FPDFPage_GetCropBox(page, &left, &bottom, &right, &top)) return JNI_FALSE;
-    
-    jfloat *body = env->GetFloatArrayElements(result, nullptr);
-    body[0] = left; body[1] = bottom; body[2] = right; body[3] = top;
-    env->ReleaseFloatArrayElements(result, body, 0);
-    return JNI_TRUE;
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotFlags(JNIEnv *env, jobject thiz,
+                                                       jlong annotPtr, jint flags) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return JNI_FALSE;
+    markAnnotEdited(annot);
+    return FPDFAnnot_SetFlags(annot, flags) ? JNI_TRUE : JNI_FALSE;
 }
 
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageRotation(JNIEnv *env, jobject thiz,
-                                                        jlong pagePtr) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return -1;
-    return FPDFPage_GetRotation(page);
-}
 
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetPageRotation(JNIEnv *env, jobject thiz,
-                                                        jlong pagePtr, jint rotation) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (page) FPDFPage_SetRotation(page, rotation);
+/**
+ * Create New Document
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeNewDocument(JNIEnv *env, jobject thiz) {
+    PdfiumLock lock;
+    return (jlong) FPDF_CreateNewDocument();
 }
 
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeDeletePage(JNIEnv *env, jobject thiz,
-                                                   jlong docPtr, jint pageIndex) {
+/**
+ * Create New Page
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeNewPage(JNIEnv *env, jobject thiz,
+                                                 jlong docPtr, jint index, jdouble width, jdouble height) {
+    PdfiumLock lock;
     FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (doc) FPDFPage_Delete(doc, pageIndex);
+    if (!doc) return 0;
+    invalidatePageCache(doc);
+    markStructureEdited(doc);
+    FPDF_PAGE page = FPDFPage_New(doc, index, width, height);
+    // Index -1: edits to the new page bump the structure revision
+    if (page) g_pageOwners[page] = PageOwner{doc, -1};
+    return (jlong) page;
 }
 
-// ----------------------------------------------------------------------------
-// Phase 10: Advanced Rendering & Navigation (Thumbnails, StructTree, Progressive)
-// ----------------------------------------------------------------------------
+/**
+ * Buffered FPDF_FILEWRITE over an fd or a Java OutputStream, flushing whole
+ * blocks. The first skip bytes of the output are dropped instead of written:
+ * an incremental save starts with an unchanged copy of the source file, so a
+ * save in place only needs what follows it. The head and tail of the dropped
+ * prefix are compared against the source as a sanity check.
+ */
+struct BlockFileWrite : public FPDF_FILEWRITE {
+    static const size_t kVerifyBytes = 4096;
+
+    int fd = -1;
+    off_t fdOffset = -1;                // pwrite position, or -1 to write at the fd position
+    JNIEnv *env = nullptr;
+    jobject stream = nullptr;
+    jmethodID writeMethod = nullptr;
+    jbyteArray chunk = nullptr;
+
+    std::vector<uint8_t> block;
+    size_t filled = 0;
+    uint64_t skip = 0;
+    uint64_t seen = 0;
+    uint64_t written = 0;
+    bool failed = false;
+    std::function<bool(uint64_t, uint8_t*, size_t)> readSource;
+
+    explicit BlockFileWrite(size_t blockSize) : block(std::max<size_t>(blockSize, 1)) {
+        version = 1;
+        WriteBlock = WriteBlockImpl;
+    }
+
+    bool flush() {
+        if (failed || filled == 0) return !failed;
+        if (stream) {
+            env->SetByteArrayRegion(chunk, 0, (jsize) filled, (const jbyte*) block.data());
+            env->CallVoidMethod(stream, writeMethod, chunk, 0, (jint) filled);
+            // Leave the IOException pending for the caller
+            if (env->ExceptionCheck()) failed = true;
+        } else {
+            size_t done = 0;
+            while (done < filled) {
+                ssize_t n = fdOffset >= 0 ? pwrite(fd, block.data() + done, filled - done, fdOffset + done)
+                                          : write(fd, block.data() + done, filled - done);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) { failed = true; break; }
+                done += n;
+            }
+            if (fdOffset >= 0) fdOffset += done;
+        }
+        if (!failed) written += filled;
+        filled = 0;
+        return !failed;
+    }
+
+    bool verifySkipped(uint64_t offset, const uint8_t *data, size_t size) {
+        if (!readSource) return true;
+        uint8_t expected[kVerifyBytes];
+        uint64_t windows[2][2] = {{0, std::min<uint64_t>(kVerifyBytes, skip)},
+                                  {skip > kVerifyBytes ? skip - kVerifyBytes : 0, skip}};
+        for (auto &window : windows) {
+            uint64_t from = std::max(offset, window[0]);
+            uint64_t to = std::min(offset + size, window[1]);
+            if (from >= to) continue;
+            if (!readSource(from, expected, (size_t) (to - from))) return false;
+            if (memcmp(expected, data + (from - offset), (size_t) (to - from)) != 0) return false;
+        }
+        return true;
+    }
+
+    static int WriteBlockImpl(FPDF_FILEWRITE *pThis, const void *pData, unsigned long size) {
+        BlockFileWrite *self = (BlockFileWrite*) pThis;
+        const uint8_t *data = (const uint8_t*) pData;
+        if (self->failed) return 0;
+
+        if (self->seen < self->skip) {
+            size_t dropped = (size_t) std::min<uint64_t>(size, self->skip - self->seen);
+            if (!self->verifySkipped(self->seen, data, dropped)) {
+                self->failed = true;
+                return 0;
+            }
+            self->seen += dropped;
+            data += dropped;
+            size -= dropped;
+        }
+        self->seen += size;
+
+        while (size > 0) {
+            size_t n = std::min<size_t>(size, self->block.size() - self->filled);
+            memcpy(self->block.data() + self->filled, data, n);
+            self->filled += n;
+            data += n;
+            size -= n;
+            if (self->filled == self->block.size() && !self->flush()) return 0;
+        }
+        return 1;
+    }
+};
 
 /**
- * Thumbnails
+ * Save Document
  */
-JNIEXPORT jbyteArray JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetDecodedThumbnailData(JNIEnv *env, jobject thiz,
-                                                                jlong pagePtr) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return nullptr;
-    
-    unsigned long size = FPDFPage_GetDecodedThumbnailData(page, nullptr, 0);
-    if (size == 0) return nullptr;
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSaveDocument(JNIEnv *env, jobject thiz,
+                                                      jlong docPtr, jstring path) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:saveDocument");
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return JNI_FALSE;
     
-    jbyteArray result = env->NewByteArray(size);
-    jbyte *buffer = env->GetByteArrayElements(result, nullptr);
-    FPDFPage_GetDecodedThumbnailData(page, buffer, size);
-    env->ReleaseByteArrayElements(result, buffer, 0);
-    return result;
-}
-
-JNIEXPORT jbyteArray JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetRawThumbnailData(JNIEnv *env, jobject thiz,
-                                                            jlong pagePtr) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return nullptr;
+    const char *cPath = env->GetStringUTFChars(path, nullptr);
+    int fd = open(cPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    env->ReleaseStringUTFChars(path, cPath);
+    if (fd < 0) return JNI_FALSE;
     
-    unsigned long size = FPDFPage_GetRawThumbnailData(page, nullptr, 0);
-    if (size == 0) return nullptr;
+    BlockFileWrite writer(64 * 1024);
+    writer.fd = fd;
+    bool success = FPDF_SaveAsCopy(doc, &writer, 0) && writer.flush();
     
-    jbyteArray result = env->NewByteArray(size);
-    jbyte *buffer = env->GetByteArrayElements(result, nullptr);
-    FPDFPage_GetRawThumbnailData(page, buffer, size);
-    env->ReleaseByteArrayElements(result, buffer, 0);
-    return result;
+    close(fd);
+    return success ? JNI_TRUE : JNI_FALSE;
 }
 
 /**
- * Structure Tree (Accessibility)
+ * Save to an fd at its current position with FPDF_SaveAsCopy flags
+ * (FPDF_INCREMENTAL, FPDF_NO_INCREMENTAL or FPDF_REMOVE_SECURITY), writing
+ * blockSize bytes at a time. An incremental save writes the source file
+ * followed by the changes.
  */
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetStructTreeForPage(JNIEnv *env, jobject thiz,
-                                                             jlong pagePtr) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return 0;
-    return (jlong) FPDF_StructTree_GetForPage(page);
-}
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSaveDocumentToFd(JNIEnv *env, jobject thiz, jlong docPtr,
+                                                          jint fd, jint flags, jint blockSize) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:saveDocument");
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc || fd < 0 || blockSize <= 0) return JNI_FALSE;
 
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeCloseStructTree(JNIEnv *env, jobject thiz,
-                                                        jlong structTreePtr) {
-    FPDF_STRUCTTREE tree = (FPDF_STRUCTTREE) structTreePtr;
-    if (tree) FPDF_StructTree_Close(tree);
+    BlockFileWrite writer((size_t) blockSize);
+    writer.fd = fd;
+    return FPDF_SaveAsCopy(doc, &writer, flags) && writer.flush() ? JNI_TRUE : JNI_FALSE;
 }
 
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeStructTreeCountChildren(JNIEnv *env, jobject thiz,
-                                                                jlong structTreePtr) {
-    FPDF_STRUCTTREE tree = (FPDF_STRUCTTREE) structTreePtr;
-    if (!tree) return 0;
-    return FPDF_StructTree_CountChildren(tree);
+/**
+ * Same as nativeSaveDocumentToFd, but hands each block to
+ * OutputStream.write(byte[], int, int). An IOException from the stream is
+ * left pending and fails the save.
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSaveDocumentToStream(JNIEnv *env, jobject thiz, jlong docPtr,
+                                                              jobject stream, jint flags, jint blockSize) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:saveDocument");
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc || !stream || blockSize <= 0) return JNI_FALSE;
+
+    jclass streamClass = env->GetObjectClass(stream);
+    BlockFileWrite writer((size_t) blockSize);
+    writer.env = env;
+    writer.stream = stream;
+    writer.writeMethod = env->GetMethodID(streamClass, "write", "([BII)V");
+    writer.chunk = env->NewByteArray(blockSize);
+    env->DeleteLocalRef(streamClass);
+    if (!writer.writeMethod || !writer.chunk) return JNI_FALSE;
+
+    bool success = FPDF_SaveAsCopy(doc, &writer, flags) && writer.flush();
+    env->DeleteLocalRef(writer.chunk);
+    return success ? JNI_TRUE : JNI_FALSE;
 }
 
+/**
+ * Append an incremental update to fd, which must hold exactly the file the
+ * document was opened from, or that file as the last in-place save left it.
+ * Only the changes are written, after the original bytes, so signatures over
+ * the original byte range stay valid. PDFium writes every update against the
+ * source, so a repeated save replaces the previous update, which it includes.
+ * Returns the bytes written after the source, or -1 if fd doesn't match or a
+ * write failed. A failed save puts the file back as it was before the call,
+ * including the update an earlier save left there.
+ */
 JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeStructTreeGetChildAtIndex(JNIEnv *env, jobject thiz,
-                                                                   jlong structTreePtr, jint index) {
-    FPDF_STRUCTTREE tree = (FPDF_STRUCTTREE) structTreePtr;
-    if (!tree) return 0;
-    return (jlong) FPDF_StructTree_GetChildAtIndex(tree, index);
-}
+Java_com_hyntix_pdfium_PdfiumCore_nativeSaveDocumentInPlace(JNIEnv *env, jobject thiz, jlong docPtr,
+                                                             jint fd, jint blockSize) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:saveDocumentInPlace");
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc || fd < 0 || blockSize <= 0) return -1;
+
+    DocumentResources res;
+    {
+        std::lock_guard<std::mutex> guard(g_docResourcesMutex);
+        auto it = g_docResources.find(doc);
+        if (it == g_docResources.end()) return -1;
+        res = it->second;
+    }
 
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeStructElementGetType(JNIEnv *env, jobject thiz,
-                                                             jlong structElemPtr) {
-    FPDF_STRUCTELEMENT elem = (FPDF_STRUCTELEMENT) structElemPtr;
-    if (!elem) return nullptr;
-    
-    unsigned long size = FPDF_StructElement_GetType(elem, nullptr, 0);
-    if (size == 0) return env->NewStringUTF("");
-    
-    unsigned short *buffer = new unsigned short[size];
-    FPDF_StructElement_GetType(elem, buffer, size);
-    jstring result = env->NewString((jchar*)buffer, size / 2 - 1);
-    delete[] buffer;
-    return result;
-}
+    BlockFileWrite writer((size_t) blockSize);
+    const uint8_t *memory = sourceMemory(env, res);
+    if (memory) {
+        writer.skip = res.bufferBytes;
+        writer.readSource = [memory](uint64_t offset, uint8_t *out, size_t size) {
+            memcpy(out, memory + offset, size);
+            return true;
+        };
+    } else if (res.fileAccess) {
+        FdFileAccess *access = res.fileAccess;
+        writer.skip = access->m_FileLen;
+        writer.readSource = [access](uint64_t offset, uint8_t *out, size_t size) {
+            return access->m_GetBlock(access->m_Param, (unsigned long) offset, out, (unsigned long) size) != 0;
+        };
+    } else {
+        // Progressive opens never hold the whole source
+        return -1;
+    }
 
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeStructElementGetAltText(JNIEnv *env, jobject thiz,
-                                                                jlong structElemPtr) {
-    FPDF_STRUCTELEMENT elem = (FPDF_STRUCTELEMENT) structElemPtr;
-    if (!elem) return nullptr;
-    
-    unsigned long size = FPDF_StructElement_GetAltText(elem, nullptr, 0);
-    if (size == 0) return env->NewStringUTF("");
-    
-    unsigned short *buffer = new unsigned short[size];
-    FPDF_StructElement_GetAltText(elem, buffer, size);
-    jstring result = env->NewString((jchar*)buffer, size / 2 - 1);
-    delete[] buffer;
-    return result;
+    uint64_t expected = res.savedLength ? res.savedLength : writer.skip;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (uint64_t) st.st_size != expected) return -1;
+
+    // The new update is written over the previous one, so keep it to restore on failure
+    std::vector<uint8_t> previous((size_t) (expected - writer.skip));
+    for (size_t done = 0; done < previous.size();) {
+        ssize_t n = pread(fd, previous.data() + done, previous.size() - done, (off_t) (writer.skip + done));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        done += n;
+    }
+
+    writer.fd = fd;
+    writer.fdOffset = (off_t) writer.skip;
+    bool success = FPDF_SaveAsCopy(doc, &writer, FPDF_INCREMENTAL) && writer.flush()
+            && writer.seen >= writer.skip;
+    uint64_t length = writer.skip + writer.written;
+    // A previous, longer update may still follow the new one
+    if (success && length < expected) success = ftruncate(fd, (off_t) length) == 0;
+    if (!success) {
+        // Nothing past the source was produced, so fd is as it was
+        if (writer.seen <= writer.skip) return -1;
+        for (size_t done = 0; done < previous.size();) {
+            ssize_t n = pwrite(fd, previous.data() + done, previous.size() - done, (off_t) (writer.skip + done));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            done += n;
+        }
+        ftruncate(fd, (off_t) expected);
+        return -1;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(g_docResourcesMutex);
+        auto it = g_docResources.find(doc);
+        if (it != g_docResources.end()) it->second.savedLength = length;
+    }
+    return (jlong) writer.written;
 }
 
 // ----------------------------------------------------------------------------
-// Phase 11: Specialized Features (Signatures, Data Availability)
+// Form Filling Support
 // ----------------------------------------------------------------------------
 
+struct FormFillInfo : public FPDF_FORMFILLINFO {
+    // Keeping it simple for now, can extend to call Java methods later if needed
+};
+
+// Past this many queued rects a page's queue collapses into their union
+static const size_t kFormDirtyRectLimit = 32;
+
 /**
- * Signatures
+ * Queue a repaint area for the page, dropping rects already covered by a
+ * queued one. Runs inside PDFium calls, so under the PDFium lock.
  */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetSignatureCount(JNIEnv *env, jobject thiz,
-                                                          jlong docPtr) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return 0;
-    return FPDF_GetSignatureCount(doc);
+static void recordFormDirtyRect(FPDF_PAGE page, double left, double top, double right, double bottom) {
+    if (!page) return;
+    FS_RECTF rect = {
+        (float) std::min(left, right), (float) std::max(top, bottom),
+        (float) std::max(left, right), (float) std::min(top, bottom)
+    };
+    auto covers = [](const FS_RECTF &outer, const FS_RECTF &inner) {
+        return outer.left <= inner.left && outer.right >= inner.right &&
+               outer.bottom <= inner.bottom && outer.top >= inner.top;
+    };
+
+    std::vector<FS_RECTF> &rects = g_formDirtyRects[page];
+    for (const FS_RECTF &queued : rects) {
+        if (covers(queued, rect)) return;
+    }
+    rects.erase(std::remove_if(rects.begin(), rects.end(),
+                               [&](const FS_RECTF &queued) { return covers(rect, queued); }),
+                rects.end());
+    rects.push_back(rect);
+
+    if (rects.size() > kFormDirtyRectLimit) {
+        FS_RECTF all = rects[0];
+        for (const FS_RECTF &queued : rects) {
+            all.left = std::min(all.left, queued.left);
+            all.top = std::max(all.top, queued.top);
+            all.right = std::max(all.right, queued.right);
+            all.bottom = std::min(all.bottom, queued.bottom);
+        }
+        rects.assign(1, all);
+    }
 }
 
 JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetSignatureObject(JNIEnv *env, jobject thiz,
-                                                           jlong docPtr, jint index) {
+Java_com_hyntix_pdfium_PdfiumCore_nativeInitFormFillEnvironment(JNIEnv *env, jobject thiz,
+                                                                 jlong docPtr) {
+    PdfiumLock lock;
     FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
     if (!doc) return 0;
-    return (jlong) FPDF_GetSignatureObject(doc, index);
-}
-
-JNIEXPORT jbyteArray JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetSignatureContents(JNIEnv *env, jobject thiz,
-                                                             jlong sigObjPtr) {
-    FPDF_SIGNATURE sig = (FPDF_SIGNATURE) sigObjPtr;
-    if (!sig) return nullptr;
-    
-    unsigned long size = FPDFSignatureObj_GetContents(sig, nullptr, 0);
-    if (size == 0) return nullptr;
     
-    jbyteArray result = env->NewByteArray(size);
-    jbyte *buffer = env->GetByteArrayElements(result, nullptr);
-    FPDFSignatureObj_GetContents(sig, buffer, size);
-    env->ReleaseByteArrayElements(result, buffer, 0);
-    return result;
-}
-
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetSignatureReason(JNIEnv *env, jobject thiz,
-                                                           jlong sigObjPtr) {
-    FPDF_SIGNATURE sig = (FPDF_SIGNATURE) sigObjPtr;
-    if (!sig) return nullptr;
+    // We allocate the struct on heap, it must be freed in ExitFormFillEnvironment
+    FormFillInfo *formInfo = new FormFillInfo();
+    memset(formInfo, 0, sizeof(FPDF_FORMFILLINFO));
+    formInfo->version = 1;
+    // formInfo->m_pJsPlatform = ...; // JS support if needed
+    
+    // Initialize callbacks to stub/null or simple implementations if required
+    // FPDFDOC_InitFormFillEnvironment checks version and some pointers.
+    // For read-only/basic forms, 0-initialized might be okay or crash.
+    // Let's implement basics.
     
-    unsigned long size = FPDFSignatureObj_GetReason(sig, nullptr, 0);
-    if (size == 0) return env->NewStringUTF("");
+    FPDF_FORMHANDLE formHandle = FPDFDOC_InitFormFillEnvironment(doc, formInfo);
     
-    char *buffer = new char[size];
-    FPDFSignatureObj_GetReason(sig, buffer, size);
-    jstring result = env->NewStringUTF(buffer);
-    delete[] buffer;
-    return result;
+    // Store the info pointer in the user data of form handle if possible, 
+    // or we just trust the caller to manage it? 
+    // FPDFDOC_InitFormFillEnvironment returns a handle, but doesn't take ownership of info.
+    // We need to associate them. For now, we return the HANDLE. 
+    // But we need to delete formInfo later. 
+    // We can map handle -> info in a global map, OR we create a struct wrapper.
+    // Simpler: We assume the caller (Java) holds the pointer to formInfo? No, it holds native pointer.
+    // Wait, FPDF_FORMHANDLE is opaque.
+    // Let's modify the signature to return a pair or just return handle, and leak the info for now (bad practice)
+    // OR we just assume we'll fix memory management in a robust wrapper.
+    // For this implementation, I will just return the FormHandle. 
+    // ISSUE: We need to free `formInfo` when closing.
+    // WORKAROUND: We can store formInfo in the `m_pUserData` if unused, or just implement Release callback?
+    // FPDF_FORMFILLINFO::Release is called when... FPDFDOC_ExitFormFillEnvironment is called?
+    // Documentation says: "Release - Give the implementation a chance to release any data..."
+    // Let's use that.
+    
+    formInfo->Release = [](FPDF_FORMFILLINFO* pThis) {
+        delete (FormFillInfo*)pThis;
+    };
+    
+    // Field edits, caret blinks and text selection report the areas to repaint
+    formInfo->FFI_Invalidate = [](FPDF_FORMFILLINFO*, FPDF_PAGE page,
+                                  double left, double top, double right, double bottom) {
+        recordFormDirtyRect(page, left, top, right, bottom);
+    };
+    formInfo->FFI_OutputSelectedRect = [](FPDF_FORMFILLINFO*, FPDF_PAGE page,
+                                          double left, double top, double right, double bottom) {
+        recordFormDirtyRect(page, left, top, right, bottom);
+    };
+    
+    return (jlong) formHandle;
 }
 
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetSignatureTime(JNIEnv *env, jobject thiz,
-                                                         jlong sigObjPtr) {
-    FPDF_SIGNATURE sig = (FPDF_SIGNATURE) sigObjPtr;
-    if (!sig) return nullptr;
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeExitFormFillEnvironment(JNIEnv *env, jobject thiz,
+                                                                 jlong formHandlePtr) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE formHandle = (FPDF_FORMHANDLE) formHandlePtr;
+    if (formHandle) {
+        FPDFDOC_ExitFormFillEnvironment(formHandle);
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFORMOnAfterLoadPage(JNIEnv *env, jobject thiz,
+                                                             jlong pagePtr, jlong formHandlePtr) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    FPDF_FORMHANDLE formHandle = (FPDF_FORMHANDLE) formHandlePtr;
+    if (page && formHandle) {
+        FORM_OnAfterLoadPage(page, formHandle);
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFORMOnBeforeClosePage(JNIEnv *env, jobject thiz,
+                                                               jlong pagePtr, jlong formHandlePtr) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    FPDF_FORMHANDLE formHandle = (FPDF_FORMHANDLE) formHandlePtr;
+    if (page && formHandle) {
+        FORM_OnBeforeClosePage(page, formHandle);
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFPDFFFLDraw(JNIEnv *env, jobject thiz,
+                                                     jlong formHandlePtr, jobject bitmap,
+                                                     jlong pagePtr,
+                                                     jint startX, jint startY,
+                                                     jint drawWidth, jint drawHeight,
+                                                     jint rotate, jint flags) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:renderForm");
+    FPDF_FORMHANDLE formHandle = (FPDF_FORMHANDLE) formHandlePtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!formHandle || !page || !bitmap) return;
     
-    unsigned long size = FPDFSignatureObj_GetTime(sig, nullptr, 0);
-    if (size == 0) return env->NewStringUTF("");
+    // Forms draw over the page, so converted targets start from the bitmap's pixels
+    BitmapTarget target;
+    if (!target.open(env, bitmap, true, true)) return;
     
-    char *buffer = new char[size];
-    FPDFSignatureObj_GetTime(sig, buffer, size);
-    jstring result = env->NewStringUTF(buffer);
-    delete[] buffer;
+    FPDF_FFLDraw(formHandle, target.fpdfBitmap, page, startX, startY, drawWidth, drawHeight, rotate,
+                 target.renderFlags(flags));
+    
+    target.commit();
+    target.close(env, bitmap);
+}
+
+/**
+ * Drain the page's queued repaint areas and map them to device rects
+ * (left, top, right, bottom, grown by a pixel for antialiasing) for a render
+ * at the given origin, size and rotation. Returns null when nothing is queued.
+ */
+JNIEXPORT jintArray JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativePollFormDirtyRects(JNIEnv *env, jobject thiz,
+                                                           jlong pagePtr,
+                                                           jint startX, jint startY,
+                                                           jint sizeX, jint sizeY, jint rotate) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    auto it = page ? g_formDirtyRects.find(page) : g_formDirtyRects.end();
+    if (it == g_formDirtyRects.end()) return nullptr;
+    std::vector<FS_RECTF> rects;
+    rects.swap(it->second);
+    g_formDirtyRects.erase(it);
+    if (rects.empty()) return nullptr;
+
+    std::vector<jint> values;
+    values.reserve(rects.size() * 4);
+    for (const FS_RECTF &rect : rects) {
+        int x0, y0, x1, y1;
+        FPDF_PageToDevice(page, startX, startY, sizeX, sizeY, rotate, rect.left, rect.top, &x0, &y0);
+        FPDF_PageToDevice(page, startX, startY, sizeX, sizeY, rotate, rect.right, rect.bottom, &x1, &y1);
+        values.push_back(std::min(x0, x1) - 1);
+        values.push_back(std::min(y0, y1) - 1);
+        values.push_back(std::max(x0, x1) + 1);
+        values.push_back(std::max(y0, y1) + 1);
+    }
+    jintArray result = env->NewIntArray((jsize) values.size());
+    if (result) env->SetIntArrayRegion(result, 0, (jsize) values.size(), values.data());
     return result;
 }
 
 /**
- * JavaScript
+ * Device rect (left, top, right, bottom) of the focused widget for a render of
+ * the page at the given origin, size and rotation, grown by a pixel for
+ * antialiasing. Returns false when no widget on this page has focus.
  */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetJavaScriptActionCount(JNIEnv *env, jobject thiz,
-                                                                  jlong docPtr) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return 0;
-    return FPDFDoc_GetJavaScriptActionCount(doc);
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetFocusedFieldDeviceRect(JNIEnv *env, jobject thiz,
+                                                                  jlong formHandlePtr, jlong pagePtr,
+                                                                  jint startX, jint startY,
+                                                                  jint sizeX, jint sizeY,
+                                                                  jint rotate, jintArray out) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE formHandle = (FPDF_FORMHANDLE) formHandlePtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!formHandle || !page || !out || env->GetArrayLength(out) < 4) return JNI_FALSE;
+
+    int pageIndex = -1;
+    FPDF_ANNOTATION annot = nullptr;
+    if (!FORM_GetFocusedAnnot(formHandle, &pageIndex, &annot) || !annot) return JNI_FALSE;
+
+    // The index is the document's; this page matches if it holds the widget
+    FS_RECTF rect;
+    bool found = FPDFPage_GetAnnotIndex(page, annot) >= 0 && FPDFAnnot_GetRect(annot, &rect);
+    FPDFPage_CloseAnnot(annot);
+    if (!found) return JNI_FALSE;
+
+    int x0, y0, x1, y1;
+    FPDF_PageToDevice(page, startX, startY, sizeX, sizeY, rotate, rect.left, rect.top, &x0, &y0);
+    FPDF_PageToDevice(page, startX, startY, sizeX, sizeY, rotate, rect.right, rect.bottom, &x1, &y1);
+    jint values[4] = {
+        std::min(x0, x1) - 1, std::min(y0, y1) - 1,
+        std::max(x0, x1) + 1, std::max(y0, y1) + 1
+    };
+    env->SetIntArrayRegion(out, 0, 4, values);
+    return JNI_TRUE;
 }
 
 // ----------------------------------------------------------------------------
-// Phase 12: Remaining Minor Features (WebLinks, Font Info, Enums, etc.)
+// Form Field Enumeration and Value Operations
 // ----------------------------------------------------------------------------
 
 /**
- * Web Links in Text
+ * Get the count of form fields (annotations) on a page
  */
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeLoadWebLinks(JNIEnv *env, jobject thiz,
-                                                     jlong textPagePtr) {
-    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
-    if (!textPage) return 0;
-    return (jlong) FPDFLink_LoadWebLinks(textPage);
-}
-
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeCloseWebLinks(JNIEnv *env, jobject thiz,
-                                                      jlong pageLinksPtr) {
-    FPDF_PAGELINK pageLinks = (FPDF_PAGELINK) pageLinksPtr;
-    if (pageLinks) FPDFLink_CloseWebLinks(pageLinks);
-}
-
 JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeCountWebLinks(JNIEnv *env, jobject thiz,
-                                                      jlong pageLinksPtr) {
-    FPDF_PAGELINK pageLinks = (FPDF_PAGELINK) pageLinksPtr;
-    if (!pageLinks) return 0;
-    return FPDFLink_CountWebLinks(pageLinks);
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldCount(JNIEnv *env, jobject thiz,
+                                                           jlong formPtr, jlong pagePtr) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE formHandle = (FPDF_FORMHANDLE) formPtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return 0;
+    
+    // Get the count of all annotations on the page
+    return FPDFPage_GetAnnotCount(page);
 }
 
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetWebLinkURL(JNIEnv *env, jobject thiz,
-                                                      jlong pageLinksPtr, jint index) {
-    FPDF_PAGELINK pageLinks = (FPDF_PAGELINK) pageLinksPtr;
-    if (!pageLinks) return nullptr;
-    
-    int size = FPDFLink_GetURL(pageLinks, index, nullptr, 0);
-    if (size <= 0) return env->NewStringUTF("");
+/**
+ * Get form field annotation at index
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldAtIndex(JNIEnv *env, jobject thiz,
+                                                             jlong formPtr, jlong pagePtr, jint index) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return 0;
     
-    unsigned short *buffer = new unsigned short[size];
-    FPDFLink_GetURL(pageLinks, index, buffer, size);
-    jstring result = env->NewString((jchar*)buffer, size - 1);
-    delete[] buffer;
-    return result;
+    FPDF_ANNOTATION annot = FPDFPage_GetAnnot(page, index);
+    trackAnnot(annot, page);
+    return (jlong) annot;
 }
 
 /**
- * Form Type
+ * Get form field type
  */
 JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormType(JNIEnv *env, jobject thiz,
-                                                    jlong docPtr) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return -1;
-    return FPDF_GetFormType(doc);
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldType(JNIEnv *env, jobject thiz,
+                                                          jlong formPtr, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return 0;
+    
+    // Get the form field type using FPDFAnnot_GetFormFieldType
+    return FPDFAnnot_GetFormFieldType(formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr, annot);
 }
 
 /**
- * Page Mode
+ * Get form field name
  */
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageMode(JNIEnv *env, jobject thiz,
-                                                    jlong docPtr) {
-    // FPDFDoc_GetPageMode is not in our PDFium build, return -1 (unknown)
-    return -1; 
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldName(JNIEnv *env, jobject thiz,
+                                                          jlong formPtr, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return nullptr;
+
+    return newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDFAnnot_GetFormFieldName(formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr, annot, (FPDF_WCHAR*) buffer, bytes);
+    });
 }
 
 /**
- * Transform Object
+ * Get form field value
  */
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeTransformPageObj(JNIEnv *env, jobject thiz,
-                                                         jlong pageObjPtr,
-                                                         jdouble a, jdouble b, jdouble c,
-                                                         jdouble d, jdouble e, jdouble f) {
-    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
-    if (pageObj) FPDFPageObj_Transform(pageObj, a, b, c, d, e, f);
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldValue(JNIEnv *env, jobject thiz,
+                                                           jlong formPtr, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return nullptr;
+
+    return newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDFAnnot_GetFormFieldValue(formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr, annot, (FPDF_WCHAR*) buffer, bytes);
+    });
 }
 
 /**
- * Get Object Bounds
+ * Set form field value
  */
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageObjBounds(JNIEnv *env, jobject thiz,
-                                                         jlong pageObjPtr, jfloatArray result) {
-    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
-    if (!pageObj) return JNI_FALSE;
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetFormFieldValue(JNIEnv *env, jobject thiz,
+                                                           jlong formPtr, jlong pagePtr,
+                                                           jlong annotPtr, jstring value) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE formHandle = (FPDF_FORMHANDLE) formPtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
     
-    float left, bottom, right, top;
-    if (!FPDFPageObj_GetBounds(pageObj, &left, &bottom, &right, &top)) return JNI_FALSE;
+    if (!annot || !value) return JNI_FALSE;
     
-    jfloat *body = env->GetFloatArrayElements(result, nullptr);
-    body[0] = left; body[1] = bottom; body[2] = right; body[3] = top;
-    env->ReleaseFloatArrayElements(result, body, 0);
-    return JNI_TRUE;
+    WideStringArg wValue(env, value);
+    markAnnotEdited(annot);
+    return FPDFAnnot_SetStringValue(annot, "V", wValue.get()) ? JNI_TRUE : JNI_FALSE;
 }
 
 /**
- * Remove Annotation
+ * Get option count for combo box or list box
  */
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeRemoveAnnot(JNIEnv *env, jobject thiz,
-                                                    jlong pagePtr, jint index) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return JNI_FALSE;
-    return FPDFPage_RemoveAnnot(page, index) ? JNI_TRUE : JNI_FALSE;
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldOptionCount(JNIEnv *env, jobject thiz,
+                                                                 jlong formPtr, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return 0;
+    
+    return FPDFAnnot_GetOptionCount(formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr, annot);
 }
 
-// ----------------------------------------------------------------------------
-// Progressive Rendering
-// ----------------------------------------------------------------------------
+/**
+ * Get option label at index
+ */
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldOptionLabel(JNIEnv *env, jobject thiz,
+                                                                 jlong formPtr, jlong annotPtr,
+                                                                 jint index) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return nullptr;
 
-// We need a simple IFSDK_PAUSE implementation that can call back to Java
-struct JavaPauseCallback : public IFSDK_PAUSE {
-    JNIEnv *env;
-    jobject callback;
-    jmethodID methodId;
-    
-    static FPDF_BOOL NeedToPauseNowImpl(IFSDK_PAUSE* pThis) {
-        JavaPauseCallback* self = static_cast<JavaPauseCallback*>(pThis);
-        if (self->env && self->callback && self->methodId) {
-            return self->env->CallBooleanMethod(self->callback, self->methodId) ? 1 : 0;
-        }
-        return 0; // Don't pause by default
-    }
-};
+    return newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDFAnnot_GetOptionLabel(formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr, annot, index, (FPDF_WCHAR*) buffer, bytes);
+    });
+}
 
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeRenderPageBitmapStart(JNIEnv *env, jobject thiz,
-                                                              jobject bitmap, jlong pagePtr,
-                                                              jint startX, jint startY,
-                                                              jint drawWidth, jint drawHeight,
-                                                              jint rotate, jint flags) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page || !bitmap) return FPDF_RENDER_FAILED;
+/**
+ * Check if option is selected
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeIsFormFieldOptionSelected(JNIEnv *env, jobject thiz,
+                                                                   jlong formPtr, jlong annotPtr,
+                                                                   jint index) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return JNI_FALSE;
     
-    AndroidBitmapInfo info;
-    if (AndroidBitmap_getInfo(env, bitmap, &info) != ANDROID_BITMAP_RESULT_SUCCESS) {
-        return FPDF_RENDER_FAILED;
-    }
+    return FPDFAnnot_IsOptionSelected(formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr,
+                                      annot, index) ? JNI_TRUE : JNI_FALSE;
+}
+
+// ----------------------------------------------------------------------------
+// Attachment Support
+// ----------------------------------------------------------------------------
+
+/**
+ * Get Attachment Count
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAttachmentCount(JNIEnv *env, jobject thiz,
+                                                            jlong docPtr) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return 0;
+    return FPDFDoc_GetAttachmentCount(doc);
+}
+
+/**
+ * Get Attachment Name
+ */
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAttachmentName(JNIEnv *env, jobject thiz,
+                                                           jlong docPtr, jint index) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return nullptr;
     
-    // Check bitmap format - PDFium requires ARGB_8888
-    if (info.format != ANDROID_BITMAP_FORMAT_RGBA_8888) {
-        return FPDF_RENDER_FAILED;
-    }
+    FPDF_ATTACHMENT attachment = FPDFDoc_GetAttachment(doc, index);
+    if (!attachment) return nullptr;
+
+    return newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDFAttachment_GetName(attachment, (FPDF_WCHAR*) buffer, bytes);
+    });
+}
+
+/**
+ * Get Attachment File Data
+ */
+JNIEXPORT jbyteArray JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAttachmentFile(JNIEnv *env, jobject thiz,
+                                                           jlong docPtr, jint index) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return nullptr;
     
-    void *pixels;
-    if (AndroidBitmap_lockPixels(env, bitmap, &pixels) != ANDROID_BITMAP_RESULT_SUCCESS) {
-        return FPDF_RENDER_FAILED;
-    }
+    FPDF_ATTACHMENT attachment = FPDFDoc_GetAttachment(doc, index);
+    if (!attachment) return nullptr;
     
-    FPDF_BITMAP fpdfBitmap = FPDFBitmap_CreateEx(info.width, info.height, FPDFBitmap_BGRA, pixels, info.stride);
-    if (!fpdfBitmap) {
-        AndroidBitmap_unlockPixels(env, bitmap);
-        return FPDF_RENDER_FAILED;
+    unsigned long size = 0;
+    if (!FPDFAttachment_GetFile(attachment, nullptr, 0, &size)) {
+         return nullptr;
     }
     
-    // Fill with white
-    FPDFBitmap_FillRect(fpdfBitmap, 0, 0, info.width, info.height, 0xFFFFFFFF);
+    if (size == 0) return env->NewByteArray(0);
+    
+    jbyteArray result = env->NewByteArray(size);
+    jbyte *buffer = env->GetByteArrayElements(result, nullptr);
     
-    // Start progressive rendering without pause callback (will complete in one go unless very large)
-    int status = FPDF_RenderPageBitmap_Start(fpdfBitmap, page, startX, startY, drawWidth, drawHeight, rotate, flags, nullptr);
+    unsigned long outLen = 0;
+    FPDFAttachment_GetFile(attachment, buffer, size, &outLen);
     
-    FPDFBitmap_Destroy(fpdfBitmap);
-    AndroidBitmap_unlockPixels(env, bitmap);
+    env->ReleaseByteArrayElements(result, buffer, 0);
     
-    return status;
+    return result;
 }
+// Page Object Support
+// ----------------------------------------------------------------------------
 
+/**
+ * Get Page Object Count
+ */
 JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeRenderPageContinue(JNIEnv *env, jobject thiz,
-                                                           jlong pagePtr) {
+Java_com_hyntix_pdfium_PdfiumCore_nativeCountPageObjects(JNIEnv *env, jobject thiz,
+                                                          jlong pagePtr) {
+    PdfiumLock lock;
     FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return FPDF_RENDER_FAILED;
-    
-    // Continue without pause - will finish immediately
-    return FPDF_RenderPage_Continue(page, nullptr);
+    if (!page) return 0;
+    return FPDFPage_CountObjects(page);
 }
 
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeRenderPageClose(JNIEnv *env, jobject thiz,
-                                                        jlong pagePtr) {
+/**
+ * Get Page Object
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageObject(JNIEnv *env, jobject thiz,
+                                                       jlong pagePtr, jint index) {
+    PdfiumLock lock;
     FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (page) FPDF_RenderPage_Close(page);
+    if (!page) return 0;
+    return (jlong) FPDFPage_GetObject(page, index);
 }
 
-// ============================================================================
-// COMPLETE IMPLEMENTATION - ALL REMAINING FEATURES
-// ============================================================================
-
-// --- Form Events ---
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFormOnMouseMove(JNIEnv *env, jobject thiz,
-                                                        jlong formPtr, jlong pagePtr,
-                                                        jint modifier, jdouble x, jdouble y) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!form || !page) return JNI_FALSE;
-    return FORM_OnMouseMove(form, page, modifier, x, y) ? JNI_TRUE : JNI_FALSE;
+/**
+ * Get Page Object Type
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageObjectType(JNIEnv *env, jobject thiz,
+                                                           jlong pageObjPtr) {
+    PdfiumLock lock;
+    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
+    if (!pageObj) return -1;
+    return FPDFPageObj_GetType(pageObj);
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFormOnLButtonDown(JNIEnv *env, jobject thiz,
-                                                          jlong formPtr, jlong pagePtr,
-                                                          jint modifier, jdouble x, jdouble y) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!form || !page) return JNI_FALSE;
-    return FORM_OnLButtonDown(form, page, modifier, x, y) ? JNI_TRUE : JNI_FALSE;
-}
+// ----------------------------------------------------------------------------
+// Phase 8: Comprehensive Page Editing (Images, Paths, Text Objects)
+// ----------------------------------------------------------------------------
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFormOnLButtonUp(JNIEnv *env, jobject thiz,
-                                                        jlong formPtr, jlong pagePtr,
-                                                        jint modifier, jdouble x, jdouble y) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!form || !page) return JNI_FALSE;
-    return FORM_OnLButtonUp(form, page, modifier, x, y) ? JNI_TRUE : JNI_FALSE;
+/**
+ * Text Object Creation
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeNewTextObj(JNIEnv *env, jobject thiz,
+                                                    jlong docPtr, jstring fontName, jfloat fontSize) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return 0;
+    
+    // FPDFPageObj_NewTextObj takes font NAME and size directly
+    const char *cFontName = env->GetStringUTFChars(fontName, nullptr);
+    FPDF_PAGEOBJECT textObj = FPDFPageObj_NewTextObj(doc, cFontName, fontSize);
+    env->ReleaseStringUTFChars(fontName, cFontName);
+    
+    return (jlong) textObj;
 }
 
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFormOnKeyDown(JNIEnv *env, jobject thiz,
-                                                      jlong formPtr, jlong pagePtr,
-                                                      jint keyCode, jint modifier) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!form || !page) return JNI_FALSE;
-    return FORM_OnKeyDown(form, page, keyCode, modifier) ? JNI_TRUE : JNI_FALSE;
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetTextObjText(JNIEnv *env, jobject thiz,
+                                                        jlong textObjPtr, jstring text) {
+    PdfiumLock lock;
+    FPDF_PAGEOBJECT textObj = (FPDF_PAGEOBJECT) textObjPtr;
+    if (!textObj) return JNI_FALSE;
+    
+    WideStringArg wText(env, text);
+    return FPDFText_SetText(textObj, wText.get()) ? JNI_TRUE : JNI_FALSE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFormOnKeyUp(JNIEnv *env, jobject thiz,
-                                                    jlong formPtr, jlong pagePtr,
-                                                    jint keyCode, jint modifier) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!form || !page) return JNI_FALSE;
-    return FORM_OnKeyUp(form, page, keyCode, modifier) ? JNI_TRUE : JNI_FALSE;
+/**
+ * Path Object Creation
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeCreateNewPath(JNIEnv *env, jobject thiz,
+                                                      jfloat x, jfloat y) {
+    PdfiumLock lock;
+    return (jlong) FPDFPageObj_CreateNewPath(x, y);
 }
 
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFormOnChar(JNIEnv *env, jobject thiz,
-                                                   jlong formPtr, jlong pagePtr,
-                                                   jint charCode, jint modifier) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!form || !page) return JNI_FALSE;
-    return FORM_OnChar(form, page, charCode, modifier) ? JNI_TRUE : JNI_FALSE;
+Java_com_hyntix_pdfium_PdfiumCore_nativePathMoveTo(JNIEnv *env, jobject thiz,
+                                                   jlong pathObjPtr, jfloat x, jfloat y) {
+    PdfiumLock lock;
+    FPDF_PAGEOBJECT pathObj = (FPDF_PAGEOBJECT) pathObjPtr;
+    return FPDFPath_MoveTo(pathObj, x, y) ? JNI_TRUE : JNI_FALSE;
 }
 
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFormOnFocus(JNIEnv *env, jobject thiz,
-                                                    jlong formPtr, jlong pagePtr,
-                                                    jint modifier, jdouble x, jdouble y) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!form || !page) return JNI_FALSE;
-    return FORM_OnFocus(form, page, modifier, x, y) ? JNI_TRUE : JNI_FALSE;
+Java_com_hyntix_pdfium_PdfiumCore_nativePathLineTo(JNIEnv *env, jobject thiz,
+                                                   jlong pathObjPtr, jfloat x, jfloat y) {
+    PdfiumLock lock;
+    FPDF_PAGEOBJECT pathObj = (FPDF_PAGEOBJECT) pathObjPtr;
+    return FPDFPath_LineTo(pathObj, x, y) ? JNI_TRUE : JNI_FALSE;
 }
 
-// --- Form Field Operations ---
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFormCanUndo(JNIEnv *env, jobject thiz,
-                                                    jlong formPtr, jlong pagePtr) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!form || !page) return JNI_FALSE;
-    return FORM_CanUndo(form, page) ? JNI_TRUE : JNI_FALSE;
+Java_com_hyntix_pdfium_PdfiumCore_nativePathBezierTo(JNIEnv *env, jobject thiz,
+                                                     jlong pathObjPtr, jfloat x1, jfloat y1,
+                                                     jfloat x2, jfloat y2,
+                                                     jfloat x3, jfloat y3) {
+    PdfiumLock lock;
+    FPDF_PAGEOBJECT pathObj = (FPDF_PAGEOBJECT) pathObjPtr;
+    return FPDFPath_BezierTo(pathObj, x1, y1, x2, y2, x3, y3) ? JNI_TRUE : JNI_FALSE;
 }
 
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFormCanRedo(JNIEnv *env, jobject thiz,
-                                                    jlong formPtr, jlong pagePtr) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!form || !page) return JNI_FALSE;
-    return FORM_CanRedo(form, page) ? JNI_TRUE : JNI_FALSE;
+Java_com_hyntix_pdfium_PdfiumCore_nativePathClose(JNIEnv *env, jobject thiz,
+                                                  jlong pathObjPtr) {
+    PdfiumLock lock;
+    FPDF_PAGEOBJECT pathObj = (FPDF_PAGEOBJECT) pathObjPtr;
+    return FPDFPath_Close(pathObj) ? JNI_TRUE : JNI_FALSE;
 }
 
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFormUndo(JNIEnv *env, jobject thiz,
-                                                 jlong formPtr, jlong pagePtr) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!form || !page) return JNI_FALSE;
-    return FORM_Undo(form, page) ? JNI_TRUE : JNI_FALSE;
+Java_com_hyntix_pdfium_PdfiumCore_nativePathSetDrawMode(JNIEnv *env, jobject thiz,
+                                                        jlong pathObjPtr, jint fillMode, jboolean stroke) {
+    PdfiumLock lock;
+    FPDF_PAGEOBJECT pathObj = (FPDF_PAGEOBJECT) pathObjPtr;
+    return FPDFPath_SetDrawMode(pathObj, fillMode, stroke ? 1 : 0) ? JNI_TRUE : JNI_FALSE;
 }
 
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFormRedo(JNIEnv *env, jobject thiz,
-                                                 jlong formPtr, jlong pagePtr) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!form || !page) return JNI_FALSE;
-    return FORM_Redo(form, page) ? JNI_TRUE : JNI_FALSE;
+Java_com_hyntix_pdfium_PdfiumCore_nativePathSetStrokeWidth(JNIEnv *env, jobject thiz,
+                                                           jlong pathObjPtr, jfloat width) {
+    PdfiumLock lock;
+    FPDF_PAGEOBJECT pathObj = (FPDF_PAGEOBJECT) pathObjPtr;
+    return FPDFPageObj_SetStrokeWidth(pathObj, width) ? JNI_TRUE : JNI_FALSE;
 }
 
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFormSelectAllText(JNIEnv *env, jobject thiz,
-                                                          jlong formPtr, jlong pagePtr) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (form && page) FORM_SelectAllText(form, page);
-}
+/**
+ * Image Object Content
+ *
+ * Android bitmaps are converted in one pass into a BGRA (or BGRx, when every
+ * pixel is opaque, so no soft mask is written) buffer and handed to
+ * FPDFImageObj_SetBitmap, which copies the pixels into the image stream. The
+ * buffer is local to the call, so a large image doesn't stay allocated.
+ * JPEGs go through FPDFImageObj_LoadJpegFileInline and are embedded as-is.
+ */
 
-// --- Annotation Getters ---
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotColor(JNIEnv *env, jobject thiz,
-                                                      jlong annotPtr, jint colorType, jintArray result) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return JNI_FALSE;
-    
-    unsigned int r, g, b, a;
-    if (!FPDFAnnot_GetColor(annot, (FPDFANNOT_COLORTYPE)colorType, &r, &g, &b, &a)) return JNI_FALSE;
-    
-    jint *body = env->GetIntArrayElements(result, nullptr);
-    body[0] = r; body[1] = g; body[2] = b; body[3] = a;
-    env->ReleaseIntArrayElements(result, body, 0);
-    return JNI_TRUE;
+// One row of RGBA_8888 pixels to straight BGRA, un-premultiplying them when
+// premultiplied is set. Returns whether every pixel was opaque
+static bool convertRowFromRgba(const uint8_t *src, uint8_t *dst, int width, bool premultiplied) {
+    bool opaque = true;
+    int x = 0;
+#if defined(__ARM_NEON)
+    for (; x + 16 <= width; x += 16) {
+        uint8x16x4_t px = vld4q_u8(src + x * 4);
+        if (vminvq_u8(px.val[3]) != 0xFF) break;   // Leave translucent runs to the scalar loop
+        uint8x16_t red = px.val[0];
+        px.val[0] = px.val[2];
+        px.val[2] = red;
+        vst4q_u8(dst + x * 4, px);
+    }
+#endif
+    for (; x < width; x++) {
+        const uint8_t *p = src + x * 4;
+        uint8_t *q = dst + x * 4;
+        uint8_t a = p[3];
+        if (a == 0xFF || !premultiplied) {
+            opaque &= a == 0xFF;
+            q[0] = p[2]; q[1] = p[1]; q[2] = p[0];
+        } else {
+            opaque = false;
+            if (a == 0) {
+                q[0] = q[1] = q[2] = 0;
+            } else {
+                q[0] = (uint8_t) std::min(255, (p[2] * 255 + a / 2) / a);
+                q[1] = (uint8_t) std::min(255, (p[1] * 255 + a / 2) / a);
+                q[2] = (uint8_t) std::min(255, (p[0] * 255 + a / 2) / a);
+            }
+        }
+        q[3] = a;
+    }
+    return opaque;
 }
 
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotFlags(JNIEnv *env, jobject thiz, jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return 0;
-    return FPDFAnnot_GetFlags(annot);
+// One row of A_8 pixels to black BGRA with that alpha
+static void expandRowFromAlpha(const uint8_t *src, uint8_t *dst, int width) {
+    for (int x = 0; x < width; x++) {
+        uint8_t *q = dst + x * 4;
+        q[0] = q[1] = q[2] = 0;
+        q[3] = src[x];
+    }
 }
 
-// --- Additional Annotation Getters ---
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotContents(JNIEnv *env, jobject thiz, jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return nullptr;
-    
-    unsigned long bufSize = FPDFAnnot_GetStringValue(annot, "Contents", nullptr, 0);
-    if (bufSize <= 2) return env->NewStringUTF("");
-    
-    unsigned short *buffer = new unsigned short[bufSize / 2];
-    FPDFAnnot_GetStringValue(annot, "Contents", buffer, bufSize);
-    jstring result = env->NewString((const jchar*)buffer, (bufSize / 2) - 1);
-    delete[] buffer;
-    return result;
+/**
+ * Set the content of an image object from an Android bitmap. pages, if given,
+ * are the pages showing the object, whose cached copies PDFium drops.
+ */
+static bool setImageFromBitmap(JNIEnv *env, FPDF_PAGE *pages, int count, FPDF_PAGEOBJECT imageObj, jobject bitmap) {
+    AndroidBitmapInfo info;
+    if (AndroidBitmap_getInfo(env, bitmap, &info) != ANDROID_BITMAP_RESULT_SUCCESS) return false;
+    if (info.width == 0 || info.height == 0 || !BitmapTarget::supports(info.format)) return false;
+
+    void *pixels = nullptr;
+    if (AndroidBitmap_lockPixels(env, bitmap, &pixels) != ANDROID_BITMAP_RESULT_SUCCESS) return false;
+
+    TraceSection trace("PDFium:convertBitmapToImage");
+    size_t rowBytes = (size_t) info.width * 4;
+    std::vector<uint8_t> converted(rowBytes * info.height);
+    bool premultiplied = (info.flags & ANDROID_BITMAP_FLAGS_ALPHA_MASK) != ANDROID_BITMAP_FLAGS_ALPHA_UNPREMUL;
+    bool opaque = true;
+    for (uint32_t y = 0; y < info.height; y++) {
+        const uint8_t *row = (const uint8_t*) pixels + (size_t) y * info.stride;
+        uint8_t *out = converted.data() + y * rowBytes;
+        if (info.format == ANDROID_BITMAP_FORMAT_RGBA_8888) {
+            opaque &= convertRowFromRgba(row, out, info.width, premultiplied);
+        } else if (info.format == ANDROID_BITMAP_FORMAT_RGB_565) {
+            expandRowFrom565((const uint16_t*) row, out, info.width);
+        } else {
+            expandRowFromAlpha(row, out, info.width);
+            opaque = false;
+        }
+    }
+    AndroidBitmap_unlockPixels(env, bitmap);
+
+    FPDF_BITMAP fpdfBitmap = FPDFBitmap_CreateEx(info.width, info.height, opaque ? FPDFBitmap_BGRx : FPDFBitmap_BGRA,
+                                                 converted.data(), (int) rowBytes);
+    if (!fpdfBitmap) return false;
+    bool ok = FPDFImageObj_SetBitmap(pages, count, imageObj, fpdfBitmap);
+    FPDFBitmap_Destroy(fpdfBitmap);
+    return ok;
 }
 
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotAuthor(JNIEnv *env, jobject thiz, jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return nullptr;
-    
-    unsigned long bufSize = FPDFAnnot_GetStringValue(annot, "T", nullptr, 0);
-    if (bufSize <= 2) return env->NewStringUTF("");
-    
-    unsigned short *buffer = new unsigned short[bufSize / 2];
-    FPDFAnnot_GetStringValue(annot, "T", buffer, bufSize);
-    jstring result = env->NewString((const jchar*)buffer, (bufSize / 2) - 1);
-    delete[] buffer;
-    return result;
+/**
+ * Set the content of an image object to the JPEG behind fd, copied in verbatim.
+ * The descriptor is read with pread from offset 0 and stays open.
+ */
+static bool setImageFromJpegFd(FPDF_PAGE *pages, int count, FPDF_PAGEOBJECT imageObj, int fd) {
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size <= 0) return false;
+
+    FdFileAccess access;
+    access.m_FileLen = (unsigned long) st.st_size;
+    access.m_GetBlock = FdFileAccess::GetBlockImpl;
+    access.m_Param = &access;
+    access.fd = fd;
+    TraceSection trace("PDFium:loadJpegInline");
+    return FPDFImageObj_LoadJpegFileInline(pages, count, imageObj, &access);
 }
 
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotSubject(JNIEnv *env, jobject thiz, jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return nullptr;
-    
-    unsigned long bufSize = FPDFAnnot_GetStringValue(annot, "Subj", nullptr, 0);
-    if (bufSize <= 2) return env->NewStringUTF("");
-    
-    unsigned short *buffer = new unsigned short[bufSize / 2];
-    FPDFAnnot_GetStringValue(annot, "Subj", buffer, bufSize);
-    jstring result = env->NewString((const jchar*)buffer, (bufSize / 2) - 1);
-    delete[] buffer;
-    return result;
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeNewImageObj(JNIEnv *env, jobject thiz,
+                                                    jlong docPtr) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return 0;
+    return (jlong) FPDFPageObj_NewImageObj(doc);
 }
 
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotModificationDate(JNIEnv *env, jobject thiz, jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return nullptr;
-    
-    unsigned long bufSize = FPDFAnnot_GetStringValue(annot, "M", nullptr, 0);
-    if (bufSize <= 2) return env->NewStringUTF("");
-    
-    unsigned short *buffer = new unsigned short[bufSize / 2];
-    FPDFAnnot_GetStringValue(annot, "M", buffer, bufSize);
-    jstring result = env->NewString((const jchar*)buffer, (bufSize / 2) - 1);
-    delete[] buffer;
-    return result;
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeImageObjSetBitmap(JNIEnv *env, jobject thiz,
+                                                          jlong imageObjPtr, jobject bitmap) {
+    PdfiumLock lock;
+    FPDF_PAGEOBJECT imageObj = (FPDF_PAGEOBJECT) imageObjPtr;
+    if (!imageObj || !bitmap) return JNI_FALSE;
+    return setImageFromBitmap(env, nullptr, 0, imageObj, bitmap) ? JNI_TRUE : JNI_FALSE;
 }
 
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotCreationDate(JNIEnv *env, jobject thiz, jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return nullptr;
-    
-    unsigned long bufSize = FPDFAnnot_GetStringValue(annot, "CreationDate", nullptr, 0);
-    if (bufSize <= 2) return env->NewStringUTF("");
-    
-    unsigned short *buffer = new unsigned short[bufSize / 2];
-    FPDFAnnot_GetStringValue(annot, "CreationDate", buffer, bufSize);
-    jstring result = env->NewString((const jchar*)buffer, (bufSize / 2) - 1);
-    delete[] buffer;
-    return result;
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeImageObjLoadJpeg(JNIEnv *env, jobject thiz,
+                                                         jlong imageObjPtr, jint fd) {
+    PdfiumLock lock;
+    FPDF_PAGEOBJECT imageObj = (FPDF_PAGEOBJECT) imageObjPtr;
+    if (!imageObj) return JNI_FALSE;
+    return setImageFromJpegFd(nullptr, 0, imageObj, fd) ? JNI_TRUE : JNI_FALSE;
 }
 
-JNIEXPORT jfloat JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotOpacity(JNIEnv *env, jobject thiz, jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return 1.0f;
-    
-    float opacity;
-    if (FPDFAnnot_GetNumberValue(annot, "CA", &opacity)) {
-        return opacity;
+/**
+ * Place images on a page and regenerate its content once. Image i comes from
+ * bitmaps[i] when that is non-null, else from the JPEG behind fds[i], and is
+ * mapped from the unit square by matrices[6 * i .. 6 * i + 5]. Stops at the
+ * first image that fails; images placed before it stay on the page.
+ *
+ * Returns the number of images placed.
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeInsertImages(JNIEnv *env, jobject thiz,
+                                                     jlong docPtr, jlong pagePtr, jobjectArray bitmaps,
+                                                     jintArray fds, jfloatArray matrices) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:insertImages");
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!doc || !page || !bitmaps || !fds || !matrices) return 0;
+
+    jsize count = env->GetArrayLength(bitmaps);
+    if (env->GetArrayLength(fds) != count || env->GetArrayLength(matrices) != count * 6) return 0;
+    std::vector<jint> fdValues(count);
+    std::vector<jfloat> m(count * 6);
+    env->GetIntArrayRegion(fds, 0, count, fdValues.data());
+    env->GetFloatArrayRegion(matrices, 0, count * 6, m.data());
+
+    int placed = 0;
+    for (jsize i = 0; i < count; i++) {
+        FPDF_PAGEOBJECT imageObj = FPDFPageObj_NewImageObj(doc);
+        if (!imageObj) break;
+
+        jobject bitmap = env->GetObjectArrayElement(bitmaps, i);
+        bool loaded = bitmap ? setImageFromBitmap(env, &page, 1, imageObj, bitmap)
+                             : setImageFromJpegFd(&page, 1, imageObj, fdValues[i]);
+        if (bitmap) env->DeleteLocalRef(bitmap);
+
+        const jfloat *mi = m.data() + i * 6;
+        FS_MATRIX matrix = {mi[0], mi[1], mi[2], mi[3], mi[4], mi[5]};
+        if (!loaded || !FPDFPageObj_SetMatrix(imageObj, &matrix)) {
+            LOGE("Failed to place image %d of %d", (int) i, (int) count);
+            FPDFPageObj_Destroy(imageObj);
+            break;
+        }
+        FPDFPage_InsertObject(page, imageObj);
+        placed++;
     }
-    return 1.0f;  // Default opacity is 1.0 (fully opaque)
+
+    if (placed > 0) {
+        FPDFPage_GenerateContent(page);
+        markPageEdited(page);
+    }
+    return placed;
 }
 
-JNIEXPORT jdoubleArray JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotQuadPoints(JNIEnv *env, jobject thiz, jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return nullptr;
-    
-    // Get the number of quad points
-    unsigned long quadPointsCount = FPDFAnnot_GetAttachmentPoints(annot, 0, nullptr);
-    if (quadPointsCount == 0) return nullptr;
-    
-    // Allocate array for all quad points (each has 8 values: 4 points * 2 coords)
-    jdoubleArray result = env->NewDoubleArray(quadPointsCount * 8);
-    if (!result) return nullptr;
-    
-    jdouble *resultData = env->GetDoubleArrayElements(result, nullptr);
-    
-    for (unsigned long i = 0; i < quadPointsCount; i++) {
-        FS_QUADPOINTSF quadPoints;
-        if (FPDFAnnot_GetAttachmentPoints(annot, i, &quadPoints)) {
-            resultData[i * 8 + 0] = quadPoints.x1;
-            resultData[i * 8 + 1] = quadPoints.y1;
-            resultData[i * 8 + 2] = quadPoints.x2;
-            resultData[i * 8 + 3] = quadPoints.y2;
-            resultData[i * 8 + 4] = quadPoints.x3;
-            resultData[i * 8 + 5] = quadPoints.y3;
-            resultData[i * 8 + 6] = quadPoints.x4;
-            resultData[i * 8 + 7] = quadPoints.y4;
-        }
+/**
+ * Object Management
+ */
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeInsertObject(JNIEnv *env, jobject thiz,
+                                                     jlong pagePtr, jlong pageObjPtr) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
+    if (page && pageObj) {
+        FPDFPage_InsertObject(page, pageObj);
+        markPageEdited(page);
     }
-    
-    env->ReleaseDoubleArrayElements(result, resultData, 0);
-    return result;
 }
 
-// --- Additional Annotation Setters ---
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotAuthor(JNIEnv *env, jobject thiz,
-                                                       jlong annotPtr, jstring author) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return JNI_FALSE;
-    
-    jsize len = env->GetStringLength(author);
-    const jchar *wAuthor = env->GetStringChars(author, nullptr);
-    
-    unsigned short *buffer = new unsigned short[len + 1];
-    for (int i = 0; i < len; i++) {
-        buffer[i] = (unsigned short) wAuthor[i];
+Java_com_hyntix_pdfium_PdfiumCore_nativeRemoveObject(JNIEnv *env, jobject thiz,
+                                                     jlong pagePtr, jlong pageObjPtr) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
+    if (page && pageObj) {
+        markPageEdited(page);
+        return FPDFPage_RemoveObject(page, pageObj) ? JNI_TRUE : JNI_FALSE;
     }
-    buffer[len] = 0;
-    
-    jboolean result = FPDFAnnot_SetStringValue(annot, "T", buffer) ? JNI_TRUE : JNI_FALSE;
-    
-    delete[] buffer;
-    env->ReleaseStringChars(author, wAuthor);
-    return result;
+    return JNI_FALSE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotSubject(JNIEnv *env, jobject thiz,
-                                                        jlong annotPtr, jstring subject) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return JNI_FALSE;
-    
-    jsize len = env->GetStringLength(subject);
-    const jchar *wSubject = env->GetStringChars(subject, nullptr);
-    
-    unsigned short *buffer = new unsigned short[len + 1];
-    for (int i = 0; i < len; i++) {
-        buffer[i] = (unsigned short) wSubject[i];
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetObjectFillColor(JNIEnv *env, jobject thiz,
+                                                           jlong pageObjPtr, jint r, jint g, jint b, jint a) {
+    PdfiumLock lock;
+    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
+    if (pageObj) {
+        FPDFPageObj_SetFillColor(pageObj, r, g, b, a);
     }
-    buffer[len] = 0;
-    
-    jboolean result = FPDFAnnot_SetStringValue(annot, "Subj", buffer) ? JNI_TRUE : JNI_FALSE;
-    
-    delete[] buffer;
-    env->ReleaseStringChars(subject, wSubject);
-    return result;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotOpacity(JNIEnv *env, jobject thiz,
-                                                        jlong annotPtr, jfloat opacity) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return JNI_FALSE;
-    
-    // Clamp opacity to valid range [0.0, 1.0]
-    float clampedOpacity = opacity < 0.0f ? 0.0f : (opacity > 1.0f ? 1.0f : opacity);
-    return FPDFAnnot_SetNumberValue(annot, "CA", clampedOpacity) ? JNI_TRUE : JNI_FALSE;
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetObjectStrokeColor(JNIEnv *env, jobject thiz,
+                                                             jlong pageObjPtr, jint r, jint g, jint b, jint a) {
+    PdfiumLock lock;
+    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
+    if (pageObj) {
+        FPDFPageObj_SetStrokeColor(pageObj, r, g, b, a);
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGenerateContent(JNIEnv *env, jobject thiz,
+                                                        jlong pagePtr) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return;
+    FPDFPage_GenerateContent(page);
+    markPageEdited(page);
 }
 
+// ----------------------------------------------------------------------------
+// Phase 9: Document Utilities (Import/Export, Flatten, Transform)
+// ----------------------------------------------------------------------------
+
+/**
+ * Page Import/Export
+ */
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotQuadPoints(JNIEnv *env, jobject thiz,
-                                                           jlong annotPtr, jdoubleArray quadPoints) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot || !quadPoints) return JNI_FALSE;
-    
-    jsize len = env->GetArrayLength(quadPoints);
-    if (len % 8 != 0) return JNI_FALSE;  // Must be multiple of 8 (4 points * 2 coords)
+Java_com_hyntix_pdfium_PdfiumCore_nativeImportPages(JNIEnv *env, jobject thiz,
+                                                    jlong destDocPtr, jlong srcDocPtr,
+                                                    jstring pageRange, jint insertIndex) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT destDoc = (FPDF_DOCUMENT) destDocPtr;
+    FPDF_DOCUMENT srcDoc = (FPDF_DOCUMENT) srcDocPtr;
+    if (!destDoc || !srcDoc) return JNI_FALSE;
     
-    jdouble *pointsData = env->GetDoubleArrayElements(quadPoints, nullptr);
+    const char *cPageRange = nullptr;
+    if (pageRange != nullptr) {
+        cPageRange = env->GetStringUTFChars(pageRange, nullptr);
+    }
     
-    // Clear all existing attachment points before setting new ones
-    // This ensures we replace the entire set of quad points rather than appending
-    FPDFAnnot_SetAttachmentPoints(annot, 0, nullptr, 0);
+    invalidatePageCache(destDoc);
     
-    // Set new quad points
-    jsize numQuads = len / 8;
-    for (jsize i = 0; i < numQuads; i++) {
-        FS_QUADPOINTSF quad;
-        quad.x1 = (float) pointsData[i * 8 + 0];
-        quad.y1 = (float) pointsData[i * 8 + 1];
-        quad.x2 = (float) pointsData[i * 8 + 2];
-        quad.y2 = (float) pointsData[i * 8 + 3];
-        quad.x3 = (float) pointsData[i * 8 + 4];
-        quad.y3 = (float) pointsData[i * 8 + 5];
-        quad.x4 = (float) pointsData[i * 8 + 6];
-        quad.y4 = (float) pointsData[i * 8 + 7];
-        
-        if (!FPDFAnnot_AppendAttachmentPoints(annot, &quad)) {
-            env->ReleaseDoubleArrayElements(quadPoints, pointsData, 0);
-            return JNI_FALSE;
-        }
-    }
+    markStructureEdited(destDoc);
+    jboolean result = FPDF_ImportPages(destDoc, srcDoc, cPageRange, insertIndex) ? JNI_TRUE : JNI_FALSE;
     
-    env->ReleaseDoubleArrayElements(quadPoints, pointsData, 0);
-    return JNI_TRUE;
-}
-
-// --- Ink Annotation Functions ---
-JNIEXPORT jobjectArray JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotInkList(JNIEnv *env, jobject thiz, jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return nullptr;
-    
-    // Get number of strokes (paths) in the ink annotation
-    unsigned long strokeCount = FPDFAnnot_GetInkListCount(annot);
-    if (strokeCount == 0) return nullptr;
-    
-    // Create outer array for strokes
-    jclass doubleArrayClass = env->FindClass("[D");
-    jobjectArray strokesArray = env->NewObjectArray(strokeCount, doubleArrayClass, nullptr);
-    if (!strokesArray) return nullptr;
-    
-    for (unsigned long i = 0; i < strokeCount; i++) {
-        // Get number of points in this stroke
-        unsigned long pointCount = FPDFAnnot_GetInkListPath(annot, i, nullptr, 0);
-        if (pointCount == 0) continue;
-        
-        // Create array for this stroke's points
-        jdoubleArray pointsArray = env->NewDoubleArray(pointCount * 2);  // x,y pairs
-        if (!pointsArray) continue;
-        
-        // Get the points
-        FS_POINTF *points = new FS_POINTF[pointCount];
-        if (FPDFAnnot_GetInkListPath(annot, i, points, pointCount)) {
-            jdouble *pointsData = env->GetDoubleArrayElements(pointsArray, nullptr);
-            for (unsigned long j = 0; j < pointCount; j++) {
-                pointsData[j * 2 + 0] = points[j].x;
-                pointsData[j * 2 + 1] = points[j].y;
-            }
-            env->ReleaseDoubleArrayElements(pointsArray, pointsData, 0);
-        }
-        delete[] points;
-        
-        env->SetObjectArrayElement(strokesArray, i, pointsArray);
-        env->DeleteLocalRef(pointsArray);
-    }
-    
-    return strokesArray;
+    if (cPageRange) env->ReleaseStringUTFChars(pageRange, cPageRange);
+    return result;
 }
 
+/**
+ * Import the pages at the given 0-based indices, in array order, with
+ * FPDF_ImportPagesByIndex. A null array imports every page.
+ */
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotInkList(JNIEnv *env, jobject thiz,
-                                                        jlong annotPtr, jobjectArray inkList) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot || !inkList) return JNI_FALSE;
-    
-    jsize strokeCount = env->GetArrayLength(inkList);
-    if (strokeCount == 0) return JNI_FALSE;
-    
-    for (jsize i = 0; i < strokeCount; i++) {
-        jdoubleArray pointsArray = (jdoubleArray) env->GetObjectArrayElement(inkList, i);
-        if (!pointsArray) continue;
-        
-        jsize pointCount = env->GetArrayLength(pointsArray) / 2;  // Divide by 2 for x,y pairs
-        if (pointCount == 0) {
-            env->DeleteLocalRef(pointsArray);
-            continue;
-        }
-        
-        jdouble *pointsData = env->GetDoubleArrayElements(pointsArray, nullptr);
-        
-        // Convert to FS_POINTF array
-        FS_POINTF *points = new FS_POINTF[pointCount];
-        for (jsize j = 0; j < pointCount; j++) {
-            points[j].x = (float) pointsData[j * 2 + 0];
-            points[j].y = (float) pointsData[j * 2 + 1];
-        }
-        
-        // Add the stroke
-        if (!FPDFAnnot_AddInkStroke(annot, points, pointCount)) {
-            delete[] points;
-            env->ReleaseDoubleArrayElements(pointsArray, pointsData, 0);
-            env->DeleteLocalRef(pointsArray);
-            return JNI_FALSE;
-        }
-        
-        delete[] points;
-        env->ReleaseDoubleArrayElements(pointsArray, pointsData, 0);
-        env->DeleteLocalRef(pointsArray);
+Java_com_hyntix_pdfium_PdfiumCore_nativeImportPagesByIndex(JNIEnv *env, jobject thiz,
+                                                           jlong destDocPtr, jlong srcDocPtr,
+                                                           jintArray pageIndices, jint insertIndex) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:importPages");
+    FPDF_DOCUMENT destDoc = (FPDF_DOCUMENT) destDocPtr;
+    FPDF_DOCUMENT srcDoc = (FPDF_DOCUMENT) srcDocPtr;
+    if (!destDoc || !srcDoc) return JNI_FALSE;
+
+    std::vector<int> indices;
+    if (pageIndices) {
+        jsize count = env->GetArrayLength(pageIndices);
+        if (count == 0) return JNI_TRUE;
+        indices.resize(count);
+        env->GetIntArrayRegion(pageIndices, 0, count, (jint*) indices.data());
     }
-    
-    return JNI_TRUE;
-}
 
-// --- Form Field Option Functions ---
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldOptionValue(JNIEnv *env, jobject thiz,
-                                                                 jlong formPtr, jlong annotPtr,
-                                                                 jint index) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return nullptr;
-    
-    // Note: PDFium's FPDFAnnot API doesn't provide a separate function to get option values
-    // distinct from labels. In PDF forms, the export value often equals the label unless
-    // explicitly set differently in the PDF. For now, we return the label as the value,
-    // which matches the common case. A more complete implementation would need to access
-    // the underlying form field dictionary directly to distinguish between display labels
-    // and export values.
-    unsigned long bufSize = FPDFAnnot_GetOptionLabel(
-        formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr, annot, index, nullptr, 0);
-    
-    if (bufSize <= 2) return env->NewStringUTF("");
-    
-    unsigned short *buffer = new unsigned short[bufSize / 2];
-    FPDFAnnot_GetOptionLabel(formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr,
-                             annot, index, buffer, bufSize);
-    
-    jstring result = env->NewString((const jchar*)buffer, (bufSize / 2) - 1);
-    delete[] buffer;
-    
-    return result;
-}
+    invalidatePageCache(destDoc);
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetFormFieldOptionSelection(JNIEnv *env, jobject thiz,
-                                                                     jlong formPtr, jlong pagePtr,
-                                                                     jlong annotPtr, jint index,
-                                                                     jboolean selected) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!form || !page || !annot) return JNI_FALSE;
-    
-    return FPDFAnnot_SetOptionSelected(form, annot, index, selected ? 1 : 0) ? JNI_TRUE : JNI_FALSE;
+    markStructureEdited(destDoc);
+    return FPDF_ImportPagesByIndex(destDoc, srcDoc, indices.empty() ? nullptr : indices.data(),
+                                   (unsigned long) indices.size(), insertIndex) ? JNI_TRUE : JNI_FALSE;
 }
 
-// --- Actions ---
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetActionType(JNIEnv *env, jobject thiz, jlong actionPtr) {
-    FPDF_ACTION action = (FPDF_ACTION) actionPtr;
-    if (!action) return -1;
-    return FPDFAction_GetType(action);
+/**
+ * N-up: a new document whose pages each hold numX * numY pages of the source
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeImportNPagesToOne(JNIEnv *env, jobject thiz,
+                                                          jlong srcDocPtr, jfloat outputWidth, jfloat outputHeight,
+                                                          jint numX, jint numY) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:importNPagesToOne");
+    FPDF_DOCUMENT srcDoc = (FPDF_DOCUMENT) srcDocPtr;
+    if (!srcDoc || numX <= 0 || numY <= 0) return 0;
+    return (jlong) FPDF_ImportNPagesToOne(srcDoc, outputWidth, outputHeight, (size_t) numX, (size_t) numY);
 }
 
 JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetActionDest(JNIEnv *env, jobject thiz,
-                                                      jlong docPtr, jlong actionPtr) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    FPDF_ACTION action = (FPDF_ACTION) actionPtr;
-    if (!doc || !action) return 0;
-    return (jlong) FPDFAction_GetDest(doc, action);
+Java_com_hyntix_pdfium_PdfiumCore_nativeNewXObjectFromPage(JNIEnv *env, jobject thiz,
+                                                           jlong destDocPtr, jlong srcDocPtr, jint srcPageIndex) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT destDoc = (FPDF_DOCUMENT) destDocPtr;
+    FPDF_DOCUMENT srcDoc = (FPDF_DOCUMENT) srcDocPtr;
+    if (!destDoc || !srcDoc) return 0;
+    return (jlong) FPDF_NewXObjectFromPage(destDoc, srcDoc, srcPageIndex);
 }
 
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetActionFilePath(JNIEnv *env, jobject thiz, jlong actionPtr) {
-    FPDF_ACTION action = (FPDF_ACTION) actionPtr;
-    if (!action) return nullptr;
-    
-    unsigned long size = FPDFAction_GetFilePath(action, nullptr, 0);
-    if (size == 0) return env->NewStringUTF("");
-    
-    char *buffer = new char[size];
-    FPDFAction_GetFilePath(action, buffer, size);
-    jstring result = env->NewStringUTF(buffer);
-    delete[] buffer;
-    return result;
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeCloseXObject(JNIEnv *env, jobject thiz, jlong xobjectPtr) {
+    PdfiumLock lock;
+    FPDF_XOBJECT xobject = (FPDF_XOBJECT) xobjectPtr;
+    if (xobject) FPDF_CloseXObject(xobject);
 }
 
-// --- Bookmarks ---
 JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeFindBookmark(JNIEnv *env, jobject thiz,
-                                                     jlong docPtr, jstring title) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc || !title) return 0;
-    
-    const jchar *wTitle = env->GetStringChars(title, nullptr);
-    FPDF_BOOKMARK bookmark = FPDFBookmark_Find(doc, (FPDF_WIDESTRING)wTitle);
-    env->ReleaseStringChars(title, wTitle);
-    return (jlong) bookmark;
+Java_com_hyntix_pdfium_PdfiumCore_nativeNewFormObjectFromXObject(JNIEnv *env, jobject thiz, jlong xobjectPtr) {
+    PdfiumLock lock;
+    FPDF_XOBJECT xobject = (FPDF_XOBJECT) xobjectPtr;
+    if (!xobject) return 0;
+    return (jlong) FPDF_NewFormObjectFromXObject(xobject);
 }
 
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetBookmarkDest(JNIEnv *env, jobject thiz,
-                                                        jlong docPtr, jlong bookmarkPtr) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    FPDF_BOOKMARK bookmark = (FPDF_BOOKMARK) bookmarkPtr;
-    if (!doc || !bookmark) return 0;
-    return (jlong) FPDFBookmark_GetDest(doc, bookmark);
-}
+/**
+ * Build imposed sheets in one pass. Appends sheetCount pages of sheetWidth x
+ * sheetHeight to destDoc and places form objects on them. slots holds
+ * (sheetIndex, srcPageIndex) pairs and matrices six floats a/b/c/d/e/f per
+ * slot, mapping source page space to sheet space. Each source page is turned
+ * into one XObject that every slot showing it reuses. Slots with a negative
+ * page index stay blank. Returns the number of sheets added, or -1.
+ *
+ * PDFium can't drop objects once they are imported into destDoc, and a save
+ * writes them whether or not a page refers to them. So every slot and source
+ * page is checked before anything is imported, and the sheets are only added
+ * once every XObject exists; a later failure deletes the sheets again.
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeImposePages(JNIEnv *env, jobject thiz,
+                                                    jlong destDocPtr, jlong srcDocPtr,
+                                                    jfloat sheetWidth, jfloat sheetHeight, jint sheetCount,
+                                                    jintArray slots, jfloatArray matrices) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:imposePages");
+    FPDF_DOCUMENT destDoc = (FPDF_DOCUMENT) destDocPtr;
+    FPDF_DOCUMENT srcDoc = (FPDF_DOCUMENT) srcDocPtr;
+    if (!destDoc || !srcDoc || !slots || !matrices || sheetCount < 0) return -1;
+
+    jsize slotCount = env->GetArrayLength(slots) / 2;
+    if (env->GetArrayLength(matrices) < slotCount * 6) return -1;
+    std::vector<jint> slotData((size_t) slotCount * 2);
+    std::vector<jfloat> matrixData((size_t) slotCount * 6);
+    env->GetIntArrayRegion(slots, 0, slotCount * 2, slotData.data());
+    env->GetFloatArrayRegion(matrices, 0, slotCount * 6, matrixData.data());
+
+    // Reject bad input before destDoc is touched
+    int srcPageCount = FPDF_GetPageCount(srcDoc);
+    std::map<int, FPDF_XOBJECT> xobjects;
+    for (jsize s = 0; s < slotCount; s++) {
+        jint sheetIndex = slotData[s * 2];
+        jint pageIndex = slotData[s * 2 + 1];
+        if (pageIndex < 0) continue;
+        if (sheetIndex < 0 || sheetIndex >= sheetCount || pageIndex >= srcPageCount) return -1;
+        if (xobjects.count(pageIndex)) continue;
+        FS_SIZEF size;
+        if (!FPDF_GetPageSizeByIndexF(srcDoc, pageIndex, &size)) return -1;
+        xobjects[pageIndex] = nullptr;
+    }
 
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetBookmarkAction(JNIEnv *env, jobject thiz, jlong bookmarkPtr) {
-    FPDF_BOOKMARK bookmark = (FPDF_BOOKMARK) bookmarkPtr;
-    if (!bookmark) return 0;
-    return (jlong) FPDFBookmark_GetAction(bookmark);
-}
+    bool ok = true;
+    for (auto &entry : xobjects) {
+        entry.second = FPDF_NewXObjectFromPage(destDoc, srcDoc, entry.first);
+        if (!entry.second) {
+            ok = false;
+            break;
+        }
+    }
 
-// --- Link Enumerate ---
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetLinkAction(JNIEnv *env, jobject thiz, jlong linkPtr) {
-    FPDF_LINK link = (FPDF_LINK) linkPtr;
-    if (!link) return 0;
-    return (jlong) FPDFLink_GetAction(link);
-}
+    int firstSheet = FPDF_GetPageCount(destDoc);
+    std::vector<FPDF_PAGE> sheets;
+    if (ok) {
+        invalidatePageCache(destDoc);
+        markStructureEdited(destDoc);
+        for (int i = 0; i < sheetCount; i++) {
+            FPDF_PAGE sheet = FPDFPage_New(destDoc, firstSheet + i, sheetWidth, sheetHeight);
+            if (!sheet) break;
+            sheets.push_back(sheet);
+        }
+        ok = (jint) sheets.size() == sheetCount;
+    }
 
-// --- Text Rectangles ---
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeTextCountRects(JNIEnv *env, jobject thiz,
-                                                       jlong textPagePtr, jint startIndex, jint count) {
-    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
-    if (!textPage) return 0;
-    return FPDFText_CountRects(textPage, startIndex, count);
-}
+    for (jsize s = 0; ok && s < slotCount; s++) {
+        jint pageIndex = slotData[s * 2 + 1];
+        if (pageIndex < 0) continue;
+        FPDF_PAGEOBJECT form = FPDF_NewFormObjectFromXObject(xobjects[pageIndex]);
+        if (!form) {
+            ok = false;
+            break;
+        }
+        const jfloat *m = &matrixData[s * 6];
+        FS_MATRIX matrix = {m[0], m[1], m[2], m[3], m[4], m[5]};
+        FPDFPageObj_TransformF(form, &matrix);
+        FPDFPage_InsertObject(sheets[slotData[s * 2]], form);
+    }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeTextGetRect(JNIEnv *env, jobject thiz,
-                                                    jlong textPagePtr, jint index, jdoubleArray result) {
-    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
-    if (!textPage) return JNI_FALSE;
-    
-    double left, top, right, bottom;
-    if (!FPDFText_GetRect(textPage, index, &left, &top, &right, &bottom)) return JNI_FALSE;
-    
-    jdouble *body = env->GetDoubleArrayElements(result, nullptr);
-    body[0] = left; body[1] = top; body[2] = right; body[3] = bottom;
-    env->ReleaseDoubleArrayElements(result, body, 0);
-    return JNI_TRUE;
-}
+    for (auto &entry : xobjects) {
+        if (entry.second) FPDF_CloseXObject(entry.second);
+    }
+    for (FPDF_PAGE sheet : sheets) {
+        if (ok) ok = FPDFPage_GenerateContent(sheet);
+        FPDF_ClosePage(sheet);
+    }
+    if (ok) return sheetCount;
 
-// --- Attachment Operations ---
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeAddAttachment(JNIEnv *env, jobject thiz,
-                                                      jlong docPtr, jstring name) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc || !name) return 0;
-    
-    const jchar *wName = env->GetStringChars(name, nullptr);
-    FPDF_ATTACHMENT attachment = FPDFDoc_AddAttachment(doc, (FPDF_WIDESTRING)wName);
-    env->ReleaseStringChars(name, wName);
-    return (jlong) attachment;
+    // Leave the page tree as it was
+    for (int i = (int) sheets.size() - 1; i >= 0; i--) FPDFPage_Delete(destDoc, firstSheet + i);
+    return -1;
 }
 
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeDeleteAttachment(JNIEnv *env, jobject thiz,
-                                                         jlong docPtr, jint index) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return JNI_FALSE;
-    return FPDFDoc_DeleteAttachment(doc, index) ? JNI_TRUE : JNI_FALSE;
+Java_com_hyntix_pdfium_PdfiumCore_nativeCopyViewerPreferences(JNIEnv *env, jobject thiz,
+                                                              jlong destDocPtr, jlong srcDocPtr) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT destDoc = (FPDF_DOCUMENT) destDocPtr;
+    FPDF_DOCUMENT srcDoc = (FPDF_DOCUMENT) srcDocPtr;
+    if (!destDoc || !srcDoc) return JNI_FALSE;
+    return FPDF_CopyViewerPreferences(destDoc, srcDoc) ? JNI_TRUE : JNI_FALSE;
 }
 
-// --- Page Object Colors (Get) ---
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetObjectStrokeColor(JNIEnv *env, jobject thiz,
-                                                             jlong pageObjPtr, jintArray result) {
-    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
-    if (!pageObj) return JNI_FALSE;
-    
-    unsigned int r, g, b, a;
-    if (!FPDFPageObj_GetStrokeColor(pageObj, &r, &g, &b, &a)) return JNI_FALSE;
-    
-    jint *body = env->GetIntArrayElements(result, nullptr);
-    body[0] = r; body[1] = g; body[2] = b; body[3] = a;
-    env->ReleaseIntArrayElements(result, body, 0);
-    return JNI_TRUE;
+/**
+ * Page Flatten
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFlattenPage(JNIEnv *env, jobject thiz,
+                                                    jlong pagePtr, jint flags) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return -1;
+    markPageEdited(page);
+    return FPDFPage_Flatten(page, flags);
 }
 
+/**
+ * Page Transform
+ */
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetObjectFillColor(JNIEnv *env, jobject thiz,
-                                                           jlong pageObjPtr, jintArray result) {
-    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
-    if (!pageObj) return JNI_FALSE;
-    
-    unsigned int r, g, b, a;
-    if (!FPDFPageObj_GetFillColor(pageObj, &r, &g, &b, &a)) return JNI_FALSE;
-    
-    jint *body = env->GetIntArrayElements(result, nullptr);
-    body[0] = r; body[1] = g; body[2] = b; body[3] = a;
-    env->ReleaseIntArrayElements(result, body, 0);
-    return JNI_TRUE;
-}
-
-// --- Page Boxes (Bleed, Trim, Art) ---
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetPageBleedBox(JNIEnv *env, jobject thiz,
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetPageMediaBox(JNIEnv *env, jobject thiz,
                                                         jlong pagePtr, jfloat left, jfloat bottom,
                                                         jfloat right, jfloat top) {
+    PdfiumLock lock;
     FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (page) FPDFPage_SetBleedBox(page, left, bottom, right, top);
+    if (!page) return JNI_FALSE;
+    FPDFPage_SetMediaBox(page, left, bottom, right, top);
+    return JNI_TRUE;
 }
 
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetPageTrimBox(JNIEnv *env, jobject thiz,
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetPageCropBox(JNIEnv *env, jobject thiz,
                                                        jlong pagePtr, jfloat left, jfloat bottom,
                                                        jfloat right, jfloat top) {
+    PdfiumLock lock;
     FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (page) FPDFPage_SetTrimBox(page, left, bottom, right, top);
-}
-
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetPageArtBox(JNIEnv *env, jobject thiz,
-                                                      jlong pagePtr, jfloat left, jfloat bottom,
-                                                      jfloat right, jfloat top) {
-    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (page) FPDFPage_SetArtBox(page, left, bottom, right, top);
+    if (!page) return JNI_FALSE;
+    FPDFPage_SetCropBox(page, left, bottom, right, top);
+    return JNI_TRUE;
 }
 
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageBleedBox(JNIEnv *env, jobject thiz,
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageMediaBox(JNIEnv *env, jobject thiz,
                                                         jlong pagePtr, jfloatArray result) {
+    PdfiumLock lock;
     FPDF_PAGE page = (FPDF_PAGE) pagePtr;
     if (!page) return JNI_FALSE;
     
     float left, bottom, right, top;
-    if (!FPDFPage_GetBleedBox(page, &left, &bottom, &right, &top)) return JNI_FALSE;
+    if (!FPDFPage_GetMediaBox(page, &left, &bottom, &right, &top)) return JNI_FALSE;
     
     jfloat *body = env->GetFloatArrayElements(result, nullptr);
     body[0] = left; body[1] = bottom; body[2] = right; body[3] = top;
@@ -2755,13 +4006,14 @@ Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageBleedBox(JNIEnv *env, jobject thi
 }
 
 JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageTrimBox(JNIEnv *env, jobject thiz,
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageCropBox(JNIEnv *env, jobject thiz,
                                                        jlong pagePtr, jfloatArray result) {
+    PdfiumLock lock;
     FPDF_PAGE page = (FPDF_PAGE) pagePtr;
     if (!page) return JNI_FALSE;
     
     float left, bottom, right, top;
-    if (!FPDFPage_GetTrimBox(page, &left, &bottom, &right, &top)) return JNI_FALSE;
+    if (!FPDFPage_GetCropBox(page, &left, &bottom, &right, &top)) return JNI_FALSE;
     
     jfloat *body = env->GetFloatArrayElements(result, nullptr);
     body[0] = left; body[1] = bottom; body[2] = right; body[3] = top;
@@ -2769,323 +4021,3486 @@ Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageTrimBox(JNIEnv *env, jobject thiz
     return JNI_TRUE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageArtBox(JNIEnv *env, jobject thiz,
-                                                      jlong pagePtr, jfloatArray result) {
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageRotation(JNIEnv *env, jobject thiz,
+                                                        jlong pagePtr) {
+    PdfiumLock lock;
     FPDF_PAGE page = (FPDF_PAGE) pagePtr;
-    if (!page) return JNI_FALSE;
-    
-    float left, bottom, right, top;
-    if (!FPDFPage_GetArtBox(page, &left, &bottom, &right, &top)) return JNI_FALSE;
-    
-    jfloat *body = env->GetFloatArrayElements(result, nullptr);
-    body[0] = left; body[1] = bottom; body[2] = right; body[3] = top;
-    env->ReleaseFloatArrayElements(result, body, 0);
-    return JNI_TRUE;
-}
-
-// --- StructTree Extended ---
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeStructElementCountChildren(JNIEnv *env, jobject thiz,
-                                                                   jlong structElemPtr) {
-    FPDF_STRUCTELEMENT elem = (FPDF_STRUCTELEMENT) structElemPtr;
-    if (!elem) return 0;
-    return FPDF_StructElement_CountChildren(elem);
-}
-
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeStructElementGetChildAtIndex(JNIEnv *env, jobject thiz,
-                                                                      jlong structElemPtr, jint index) {
-    FPDF_STRUCTELEMENT elem = (FPDF_STRUCTELEMENT) structElemPtr;
-    if (!elem) return 0;
-    return (jlong) FPDF_StructElement_GetChildAtIndex(elem, index);
+    if (!page) return -1;
+    return FPDFPage_GetRotation(page);
 }
 
-// --- Font Loading ---
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeLoadStandardFont(JNIEnv *env, jobject thiz,
-                                                         jlong docPtr, jstring fontName) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc || !fontName) return 0;
-    
-    const char *cFontName = env->GetStringUTFChars(fontName, nullptr);
-    FPDF_FONT font = FPDFText_LoadStandardFont(doc, cFontName);
-    env->ReleaseStringUTFChars(fontName, cFontName);
-    return (jlong) font;
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetPageRotation(JNIEnv *env, jobject thiz,
+                                                        jlong pagePtr, jint rotation) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return;
+    FPDFPage_SetRotation(page, rotation);
+    markPageEdited(page);
 }
 
 JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeCloseFont(JNIEnv *env, jobject thiz, jlong fontPtr) {
-    FPDF_FONT font = (FPDF_FONT) fontPtr;
-    if (font) FPDFFont_Close(font);
+Java_com_hyntix_pdfium_PdfiumCore_nativeDeletePage(JNIEnv *env, jobject thiz,
+                                                   jlong docPtr, jint pageIndex) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return;
+    invalidatePageCache(doc);
+    markStructureEdited(doc);
+    FPDFPage_Delete(doc, pageIndex);
 }
 
-// --- Data Availability ---
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeIsLinearized(JNIEnv *env, jobject thiz, jlong availPtr) {
-    FPDF_AVAIL avail = (FPDF_AVAIL) availPtr;
-    if (!avail) return JNI_FALSE;
-    // PDF_LINEARIZED is 1 in fpdf_dataavail.h (PDF_LINEARIZED)
-    return FPDFAvail_IsLinearized(avail) == 1 ? JNI_TRUE : JNI_FALSE;
-}
+// ----------------------------------------------------------------------------
+// Phase 10: Advanced Rendering & Navigation (Thumbnails, StructTree, Progressive)
+// ----------------------------------------------------------------------------
 
 /**
- * Get Link Handle from Annotation
+ * Thumbnails
  */
-JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetLinkFromAnnot(JNIEnv *env, jobject thiz,
-                                                         jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return 0;
+JNIEXPORT jbyteArray JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetDecodedThumbnailData(JNIEnv *env, jobject thiz,
+                                                                jlong pagePtr) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return nullptr;
     
-    // Use proper PDFium API to get link from annotation
-    FPDF_LINK link = FPDFAnnot_GetLink(annot);
-    return (jlong) link;
-}
-
-// --- Form Data Export/Import ---
-JNIEXPORT jobjectArray JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeExportFormData(JNIEnv *env, jobject thiz,
-                                                       jlong formPtr, jlong docPtr) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!form || !doc) return nullptr;
+    unsigned long size = FPDFPage_GetDecodedThumbnailData(page, nullptr, 0);
+    if (size == 0) return nullptr;
     
-    // PDFium doesn't have a direct "export all form data" API, so we return an empty array
-    // The actual export is handled at the Kotlin level by iterating through pages and fields
-    jclass stringClass = env->FindClass("java/lang/String");
-    return env->NewObjectArray(0, stringClass, nullptr);
+    jbyteArray result = env->NewByteArray(size);
+    jbyte *buffer = env->GetByteArrayElements(result, nullptr);
+    FPDFPage_GetDecodedThumbnailData(page, buffer, size);
+    env->ReleaseByteArrayElements(result, buffer, 0);
+    return result;
 }
 
-JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldDefaultValue(JNIEnv *env, jobject thiz,
-                                                                  jlong formPtr, jlong annotPtr) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!form || !annot) return nullptr;
-    
-    // Note: PDFium doesn't provide a direct API to get the default value (DV entry).
-    // The current implementation returns the current field value as a fallback.
-    // To get the true default value, one would need to access the field dictionary directly.
-    unsigned long bufSize = FPDFAnnot_GetFormFieldValue(form, annot, nullptr, 0);
-    if (bufSize <= 2) return env->NewStringUTF("");
-    
-    unsigned short *buffer = new unsigned short[bufSize / 2];
-    FPDFAnnot_GetFormFieldValue(form, annot, buffer, bufSize);
+JNIEXPORT jbyteArray JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetRawThumbnailData(JNIEnv *env, jobject thiz,
+                                                            jlong pagePtr) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return nullptr;
     
-    jstring result = env->NewString((const jchar*)buffer, (bufSize / 2) - 1);
-    delete[] buffer;
+    unsigned long size = FPDFPage_GetRawThumbnailData(page, nullptr, 0);
+    if (size == 0) return nullptr;
     
+    jbyteArray result = env->NewByteArray(size);
+    jbyte *buffer = env->GetByteArrayElements(result, nullptr);
+    FPDFPage_GetRawThumbnailData(page, buffer, size);
+    env->ReleaseByteArrayElements(result, buffer, 0);
     return result;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeIsFormFieldRequired(JNIEnv *env, jobject thiz,
-                                                            jlong formPtr, jlong annotPtr) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!form || !annot) return JNI_FALSE;
-    
-    // Check if the field has the required flag (Ff bit 2)
-    int flags = FPDFAnnot_GetFormFieldFlags(form, annot);
-    return (flags & 0x02) ? JNI_TRUE : JNI_FALSE;
+/**
+ * Structure Tree (Accessibility)
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetStructTreeForPage(JNIEnv *env, jobject thiz,
+                                                             jlong pagePtr) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return 0;
+    return (jlong) FPDF_StructTree_GetForPage(page);
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeIsFormFieldReadOnly(JNIEnv *env, jobject thiz,
-                                                            jlong formPtr, jlong annotPtr) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!form || !annot) return JNI_FALSE;
-    
-    // Check if the field has the read-only flag (Ff bit 1)
-    int flags = FPDFAnnot_GetFormFieldFlags(form, annot);
-    return (flags & 0x01) ? JNI_TRUE : JNI_FALSE;
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeCloseStructTree(JNIEnv *env, jobject thiz,
+                                                        jlong structTreePtr) {
+    PdfiumLock lock;
+    FPDF_STRUCTTREE tree = (FPDF_STRUCTTREE) structTreePtr;
+    if (tree) FPDF_StructTree_Close(tree);
 }
 
 JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldMaxLength(JNIEnv *env, jobject thiz,
-                                                              jlong formPtr, jlong annotPtr) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!form || !annot) return -1;
-    
-    // Get max length for text fields
-    return FPDFAnnot_GetFormFieldMaxLen(form, annot);
+Java_com_hyntix_pdfium_PdfiumCore_nativeStructTreeCountChildren(JNIEnv *env, jobject thiz,
+                                                                jlong structTreePtr) {
+    PdfiumLock lock;
+    FPDF_STRUCTTREE tree = (FPDF_STRUCTTREE) structTreePtr;
+    if (!tree) return 0;
+    return FPDF_StructTree_CountChildren(tree);
 }
 
-// --- Signature Field Support ---
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeIsSignatureField(JNIEnv *env, jobject thiz,
-                                                         jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return JNI_FALSE;
-    
-    // Check if annotation type is signature (FPDF_FORMFIELD_SIGNATURE = 7)
-    int type = FPDFAnnot_GetFormFieldType(nullptr, annot);
-    return (type == 7) ? JNI_TRUE : JNI_FALSE;
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeStructTreeGetChildAtIndex(JNIEnv *env, jobject thiz,
+                                                                   jlong structTreePtr, jint index) {
+    PdfiumLock lock;
+    FPDF_STRUCTTREE tree = (FPDF_STRUCTTREE) structTreePtr;
+    if (!tree) return 0;
+    return (jlong) FPDF_StructTree_GetChildAtIndex(tree, index);
 }
 
-JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetSignatureStatus(JNIEnv *env, jobject thiz,
-                                                           jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return 3; // ERROR
-    
-    // PDFium doesn't provide signature validation APIs directly
-    // Return 0 (UNSIGNED) as default
-    // A proper implementation would need to check the signature dictionary
-    return 0;
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeStructElementGetType(JNIEnv *env, jobject thiz,
+                                                             jlong structElemPtr) {
+    PdfiumLock lock;
+    FPDF_STRUCTELEMENT elem = (FPDF_STRUCTELEMENT) structElemPtr;
+    if (!elem) return nullptr;
+
+    return newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDF_StructElement_GetType(elem, buffer, bytes);
+    });
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeStructElementGetAltText(JNIEnv *env, jobject thiz,
+                                                                jlong structElemPtr) {
+    PdfiumLock lock;
+    FPDF_STRUCTELEMENT elem = (FPDF_STRUCTELEMENT) structElemPtr;
+    if (!elem) return nullptr;
+
+    return newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDF_StructElement_GetAltText(elem, buffer, bytes);
+    });
 }
 
+// ----------------------------------------------------------------------------
+// Phase 11: Specialized Features (Signatures, Data Availability)
+// ----------------------------------------------------------------------------
+
+/**
+ * Signatures
+ */
 JNIEXPORT jint JNICALL
 Java_com_hyntix_pdfium_PdfiumCore_nativeGetSignatureCount(JNIEnv *env, jobject thiz,
                                                           jlong docPtr) {
+    PdfiumLock lock;
     FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return -1;
-    
+    if (!doc) return 0;
     return FPDF_GetSignatureCount(doc);
 }
 
 JNIEXPORT jlong JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetSignatureAtIndex(JNIEnv *env, jobject thiz,
-                                                            jlong docPtr, jint index) {
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetSignatureObject(JNIEnv *env, jobject thiz,
+                                                           jlong docPtr, jint index) {
+    PdfiumLock lock;
     FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
     if (!doc) return 0;
-    
     return (jlong) FPDF_GetSignatureObject(doc, index);
 }
 
-// --- Appearance Stream Support ---
 JNIEXPORT jbyteArray JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotAppearanceStream(JNIEnv *env, jobject thiz,
-                                                                 jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return nullptr;
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetSignatureContents(JNIEnv *env, jobject thiz,
+                                                             jlong sigObjPtr) {
+    PdfiumLock lock;
+    FPDF_SIGNATURE sig = (FPDF_SIGNATURE) sigObjPtr;
+    if (!sig) return nullptr;
     
-    // PDFium doesn't provide a direct API to get appearance stream content
-    // Return empty byte array
-    jbyteArray result = env->NewByteArray(0);
+    unsigned long size = FPDFSignatureObj_GetContents(sig, nullptr, 0);
+    if (size == 0) return nullptr;
+    
+    jbyteArray result = env->NewByteArray(size);
+    jbyte *buffer = env->GetByteArrayElements(result, nullptr);
+    FPDFSignatureObj_GetContents(sig, buffer, size);
+    env->ReleaseByteArrayElements(result, buffer, 0);
     return result;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotAppearanceStream(JNIEnv *env, jobject thiz,
-                                                                 jlong annotPtr,
-                                                                 jbyteArray appearanceStream) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot || !appearanceStream) return JNI_FALSE;
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetSignatureReason(JNIEnv *env, jobject thiz,
+                                                           jlong sigObjPtr) {
+    PdfiumLock lock;
+    FPDF_SIGNATURE sig = (FPDF_SIGNATURE) sigObjPtr;
+    if (!sig) return nullptr;
     
-    // PDFium doesn't provide a direct API to set appearance stream content
-    // Return false to indicate not supported
-    return JNI_FALSE;
+    // The reason is UTF-16LE, unlike the time, which is plain ASCII
+    return newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDFSignatureObj_GetReason(sig, buffer, bytes);
+    });
 }
 
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGenerateAnnotDefaultAppearance(JNIEnv *env, jobject thiz,
-                                                                       jlong annotPtr) {
-    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
-    if (!annot) return JNI_FALSE;
-    
-    // Generate default appearance for the annotation
-    return FPDFAnnot_SetAP(annot, FPDF_ANNOT_APPEARANCEMODE_NORMAL, nullptr) ? JNI_TRUE : JNI_FALSE;
-}
-
-// --- XFA Form Support ---
-JNIEXPORT jboolean JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeHasXFAForms(JNIEnv *env, jobject thiz,
-                                                    jlong docPtr) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return JNI_FALSE;
-    
-    // Check if document has XFA forms by checking XFA packet count
-    int count = FPDF_GetXFAPacketCount(doc);
-    return (count > 0) ? JNI_TRUE : JNI_FALSE;
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetSignatureTime(JNIEnv *env, jobject thiz,
+                                                         jlong sigObjPtr) {
+    PdfiumLock lock;
+    FPDF_SIGNATURE sig = (FPDF_SIGNATURE) sigObjPtr;
+    if (!sig) return nullptr;
+
+    return newStringFromBytes(env, [&](void *buffer, unsigned long bytes) {
+        return FPDFSignatureObj_GetTime(sig, (char*) buffer, bytes);
+    });
 }
 
+/**
+ * JavaScript
+ */
 JNIEXPORT jint JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetXFAPacketCount(JNIEnv *env, jobject thiz,
-                                                          jlong docPtr) {
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetJavaScriptActionCount(JNIEnv *env, jobject thiz,
+                                                                  jlong docPtr) {
+    PdfiumLock lock;
     FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
     if (!doc) return 0;
-    
-    return FPDF_GetXFAPacketCount(doc);
+    return FPDFDoc_GetJavaScriptActionCount(doc);
+}
+
+// ----------------------------------------------------------------------------
+// Phase 12: Remaining Minor Features (WebLinks, Font Info, Enums, etc.)
+// ----------------------------------------------------------------------------
+
+/**
+ * Web Links in Text
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeLoadWebLinks(JNIEnv *env, jobject thiz,
+                                                     jlong textPagePtr) {
+    PdfiumLock lock;
+    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
+    if (!textPage) return 0;
+    return (jlong) FPDFLink_LoadWebLinks(textPage);
+}
+
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeCloseWebLinks(JNIEnv *env, jobject thiz,
+                                                      jlong pageLinksPtr) {
+    PdfiumLock lock;
+    FPDF_PAGELINK pageLinks = (FPDF_PAGELINK) pageLinksPtr;
+    if (pageLinks) FPDFLink_CloseWebLinks(pageLinks);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeCountWebLinks(JNIEnv *env, jobject thiz,
+                                                      jlong pageLinksPtr) {
+    PdfiumLock lock;
+    FPDF_PAGELINK pageLinks = (FPDF_PAGELINK) pageLinksPtr;
+    if (!pageLinks) return 0;
+    return FPDFLink_CountWebLinks(pageLinks);
 }
 
 JNIEXPORT jstring JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetXFAPacketName(JNIEnv *env, jobject thiz,
-                                                         jlong docPtr, jint index) {
-    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return nullptr;
-    
-    // Get the buffer size needed
-    unsigned long bufSize = FPDF_GetXFAPacketName(doc, index, nullptr, 0);
-    if (bufSize == 0) return env->NewStringUTF("");
-    
-    char *buffer = new char[bufSize];
-    FPDF_GetXFAPacketName(doc, index, buffer, bufSize);
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetWebLinkURL(JNIEnv *env, jobject thiz,
+                                                      jlong pageLinksPtr, jint index) {
+    PdfiumLock lock;
+    FPDF_PAGELINK pageLinks = (FPDF_PAGELINK) pageLinksPtr;
+    if (!pageLinks) return nullptr;
     
-    jstring result = env->NewStringUTF(buffer);
-    delete[] buffer;
+    // FPDFLink_GetURL counts in UTF-16 units rather than bytes
+    int size = FPDFLink_GetURL(pageLinks, index, nullptr, 0);
+    if (size <= 1) return env->NewStringUTF("");
     
-    return result;
+    StringScratch scratch((size_t) size * sizeof(unsigned short));
+    int written = FPDFLink_GetURL(pageLinks, index, (unsigned short*) scratch.data(), size);
+    if (written <= 1 || written > size) return env->NewStringUTF("");
+    return env->NewString((const jchar*) scratch.data(), written - 1);
 }
 
-JNIEXPORT jbyteArray JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeGetXFAPacketContent(JNIEnv *env, jobject thiz,
-                                                           jlong docPtr, jint index) {
+/**
+ * Form Type
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormType(JNIEnv *env, jobject thiz,
+                                                    jlong docPtr) {
+    PdfiumLock lock;
     FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
-    if (!doc) return nullptr;
+    if (!doc) return -1;
+    return FPDF_GetFormType(doc);
+}
+
+/**
+ * Page Mode
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageMode(JNIEnv *env, jobject thiz,
+                                                    jlong docPtr) {
+    PdfiumLock lock;
+    // FPDFDoc_GetPageMode is not in our PDFium build, return -1 (unknown)
+    return -1; 
+}
+
+/**
+ * Transform Object
+ */
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeTransformPageObj(JNIEnv *env, jobject thiz,
+                                                         jlong pageObjPtr,
+                                                         jdouble a, jdouble b, jdouble c,
+                                                         jdouble d, jdouble e, jdouble f) {
+    PdfiumLock lock;
+    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
+    if (pageObj) FPDFPageObj_Transform(pageObj, a, b, c, d, e, f);
+}
+
+/**
+ * Get Object Bounds
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageObjBounds(JNIEnv *env, jobject thiz,
+                                                         jlong pageObjPtr, jfloatArray result) {
+    PdfiumLock lock;
+    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
+    if (!pageObj) return JNI_FALSE;
     
-    // Get the buffer size needed
-    unsigned long bufSize = 0;
-    if (!FPDF_GetXFAPacketContent(doc, index, nullptr, 0, &bufSize) || bufSize == 0) {
-        return env->NewByteArray(0);
-    }
+    float left, bottom, right, top;
+    if (!FPDFPageObj_GetBounds(pageObj, &left, &bottom, &right, &top)) return JNI_FALSE;
     
-    unsigned char *buffer = new unsigned char[bufSize];
-    if (!FPDF_GetXFAPacketContent(doc, index, buffer, bufSize, &bufSize)) {
-        delete[] buffer;
-        return env->NewByteArray(0);
+    jfloat *body = env->GetFloatArrayElements(result, nullptr);
+    body[0] = left; body[1] = bottom; body[2] = right; body[3] = top;
+    env->ReleaseFloatArrayElements(result, body, 0);
+    return JNI_TRUE;
+}
+
+/**
+ * Remove Annotation
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeRemoveAnnot(JNIEnv *env, jobject thiz,
+                                                    jlong pagePtr, jint index) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return JNI_FALSE;
+    markPageEdited(page);
+    return FPDFPage_RemoveAnnot(page, index) ? JNI_TRUE : JNI_FALSE;
+}
+
+// ----------------------------------------------------------------------------
+// Progressive Rendering
+// ----------------------------------------------------------------------------
+
+/**
+ * State of one progressive render, kept across nativeRenderSessionStep calls.
+ *
+ * The Android bitmap stays locked and wrapped in an FPDF_BITMAP until the
+ * session is closed, so FPDF_RenderPage_Continue resumes into the same pixels.
+ * NeedToPauseNow yields once the current step's deadline passes or the cancel
+ * flag is set. nativeCancelRenderSession only stores the atomic flag and takes
+ * no lock, so another thread can stop a step while it holds the PDFium lock.
+ */
+struct RenderSession {
+    IFSDK_PAUSE pause;
+    FPDF_PAGE page;
+    jobject bitmap;             // Global ref; pixels locked for the session's lifetime
+    BitmapTarget target;        // Owns its scratch, since other renders run between steps
+    FPDF_FORMHANDLE form;       // Form layer drawn once the content is done, or null
+    int startX, startY, drawWidth, drawHeight, rotate, flags;
+    bool started = false;
+    int status = FPDF_RENDER_READY;
+    std::atomic<bool> cancelled{false};
+    std::chrono::steady_clock::time_point deadline;
+    uint64_t renderNanos = 0;   // Summed over steps, recorded once done
+
+    static FPDF_BOOL NeedToPauseNowImpl(IFSDK_PAUSE *pThis) {
+        RenderSession *self = static_cast<RenderSession*>(pThis->user);
+        if (self->cancelled.load(std::memory_order_relaxed)) return 1;
+        return std::chrono::steady_clock::now() >= self->deadline ? 1 : 0;
+    }
+};
+
+/**
+ * Lock a bitmap and prepare a progressive render of the page into it
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeOpenRenderSession(JNIEnv *env, jobject thiz,
+                                                          jobject bitmap, jlong pagePtr,
+                                                          jint startX, jint startY,
+                                                          jint drawWidth, jint drawHeight,
+                                                          jint rotate, jboolean renderAnnot,
+                                                          jlong formHandlePtr) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page || !bitmap) return 0;
+
+    RenderSession *session = new RenderSession();
+    if (!session->target.open(env, bitmap, false, false)) {
+        delete session;
+        return 0;
+    }
+    FPDFBitmap_FillRect(session->target.fpdfBitmap, 0, 0, session->target.info.width,
+                        session->target.info.height, 0xFFFFFFFF);
+
+    session->pause.version = 1;
+    session->pause.NeedToPauseNow = RenderSession::NeedToPauseNowImpl;
+    session->pause.user = session;
+    session->page = page;
+    session->form = (FPDF_FORMHANDLE) formHandlePtr;
+    session->bitmap = env->NewGlobalRef(bitmap);
+    session->startX = startX;
+    session->startY = startY;
+    session->drawWidth = drawWidth;
+    session->drawHeight = drawHeight;
+    session->rotate = rotate;
+    session->flags = session->target.renderFlags(FPDF_REVERSE_BYTE_ORDER | (renderAnnot ? FPDF_ANNOT : 0));
+    return (jlong) session;
+}
+
+/**
+ * Render until done, cancelled, or budgetNanos have passed. Returns the
+ * FPDF_RENDER_* status; a cancelled session stays FPDF_RENDER_TOBECONTINUED.
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeRenderSessionStep(JNIEnv *env, jobject thiz,
+                                                          jlong sessionPtr, jlong budgetNanos) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:renderSessionStep");
+    RenderSession *session = (RenderSession*) sessionPtr;
+    if (!session) return FPDF_RENDER_FAILED;
+    if (session->status == FPDF_RENDER_DONE || session->status == FPDF_RENDER_FAILED ||
+        session->cancelled.load()) {
+        return session->status;
+    }
+
+    // Clamp so the deadline cannot overflow; an hour is effectively "no limit"
+    const jlong maxBudgetNanos = 3600LL * 1000 * 1000 * 1000;
+    auto start = std::chrono::steady_clock::now();
+    session->deadline = start + std::chrono::nanoseconds(std::min(budgetNanos, maxBudgetNanos));
+    if (!session->started) {
+        session->started = true;
+        session->status = FPDF_RenderPageBitmap_Start(session->target.fpdfBitmap, session->page,
+                                                      session->startX, session->startY,
+                                                      session->drawWidth, session->drawHeight,
+                                                      session->rotate, session->flags,
+                                                      &session->pause);
+    } else {
+        session->status = FPDF_RenderPage_Continue(session->page, &session->pause);
     }
+    if (session->status == FPDF_RENDER_DONE && session->form) {
+        FPDF_FFLDraw(session->form, session->target.fpdfBitmap, session->page, session->startX,
+                     session->startY, session->drawWidth, session->drawHeight, session->rotate,
+                     session->flags);
+    }
+
+    // Converted targets show the partial render after every step, like RGBA ones
+    session->target.commit();
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    session->renderNanos += (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    if (session->status == FPDF_RENDER_DONE) recordRender(session->page, session->renderNanos);
+    return session->status;
+}
+
+/**
+ * Ask a running or paused session to stop. Safe to call from any thread.
+ */
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeCancelRenderSession(JNIEnv *env, jobject thiz,
+                                                            jlong sessionPtr) {
+    RenderSession *session = (RenderSession*) sessionPtr;
+    if (session) session->cancelled.store(true);
+}
+
+/**
+ * Release the progressive renderer, the PDFium bitmap and the locked pixels
+ */
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeCloseRenderSession(JNIEnv *env, jobject thiz,
+                                                           jlong sessionPtr) {
+    PdfiumLock lock;
+    RenderSession *session = (RenderSession*) sessionPtr;
+    if (!session) return;
+    if (session->started) FPDF_RenderPage_Close(session->page);
+    session->target.close(env, session->bitmap);
+    env->DeleteGlobalRef(session->bitmap);
+    delete session;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeRenderPageBitmapStart(JNIEnv *env, jobject thiz,
+                                                              jobject bitmap, jlong pagePtr,
+                                                              jint startX, jint startY,
+                                                              jint drawWidth, jint drawHeight,
+                                                              jint rotate, jint flags) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:renderPageStart");
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page || !bitmap) return FPDF_RENDER_FAILED;
     
-    jbyteArray result = env->NewByteArray(bufSize);
-    env->SetByteArrayRegion(result, 0, bufSize, (jbyte*)buffer);
+    BitmapTarget target;
+    if (!target.open(env, bitmap, true, false)) return FPDF_RENDER_FAILED;
     
-    delete[] buffer;
-    return result;
+    // Fill with white
+    FPDFBitmap_FillRect(target.fpdfBitmap, 0, 0, target.info.width, target.info.height, 0xFFFFFFFF);
+    
+    // No pause callback, so this completes in one go; use a render session to time-slice
+    int status = FPDF_RenderPageBitmap_Start(target.fpdfBitmap, page, startX, startY, drawWidth, drawHeight,
+                                             rotate, target.renderFlags(flags), nullptr);
+    
+    target.commit();
+    target.close(env, bitmap);
+    
+    return status;
 }
 
-// --- Appearance Settings ---
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetFormFieldHighlightColor(JNIEnv *env, jobject thiz,
-                                                                   jlong formPtr, jint r, jint g,
-                                                                   jint b, jint a) {
-    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    if (!form) return;
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeRenderPageContinue(JNIEnv *env, jobject thiz,
+                                                           jlong pagePtr) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:renderPageContinue");
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return FPDF_RENDER_FAILED;
     
-    // Set form field highlight color
-    FPDF_SetFormFieldHighlightColor(form, 0, (r << 16) | (g << 8) | b);
-    FPDF_SetFormFieldHighlightAlpha(form, a);
+    // Continue without pause - will finish immediately
+    return FPDF_RenderPage_Continue(page, nullptr);
 }
 
 JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeSetFormFieldHighlightAlpha(JNIEnv *env, jobject thiz,
-                                                                   jlong formPtr, jint alpha) {
+Java_com_hyntix_pdfium_PdfiumCore_nativeRenderPageClose(JNIEnv *env, jobject thiz,
+                                                        jlong pagePtr) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (page) FPDF_RenderPage_Close(page);
+}
+
+// ============================================================================
+// COMPLETE IMPLEMENTATION - ALL REMAINING FEATURES
+// ============================================================================
+
+// --- Form Events ---
+
+// Input PDFium handled may have changed a field value and its appearance
+static jboolean formInputHandled(FPDF_PAGE page, FPDF_BOOL handled) {
+    if (!handled) return JNI_FALSE;
+    markPageEdited(page);
+    return JNI_TRUE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFormOnMouseMove(JNIEnv *env, jobject thiz,
+                                                        jlong formPtr, jlong pagePtr,
+                                                        jint modifier, jdouble x, jdouble y) {
+    PdfiumLock lock;
     FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    if (!form) return;
-    
-    FPDF_SetFormFieldHighlightAlpha(form, alpha);
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!form || !page) return JNI_FALSE;
+    return FORM_OnMouseMove(form, page, modifier, x, y) ? JNI_TRUE : JNI_FALSE;
 }
 
-JNIEXPORT void JNICALL
-Java_com_hyntix_pdfium_PdfiumCore_nativeRemoveFormFieldHighlight(JNIEnv *env, jobject thiz,
-                                                                 jlong formPtr) {
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFormOnLButtonDown(JNIEnv *env, jobject thiz,
+                                                          jlong formPtr, jlong pagePtr,
+                                                          jint modifier, jdouble x, jdouble y) {
+    PdfiumLock lock;
     FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
-    if (!form) return;
-    
-    // Remove highlight by setting alpha to 0
-    FPDF_SetFormFieldHighlightAlpha(form, 0);
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!form || !page) return JNI_FALSE;
+    return formInputHandled(page, FORM_OnLButtonDown(form, page, modifier, x, y));
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFormOnLButtonUp(JNIEnv *env, jobject thiz,
+                                                        jlong formPtr, jlong pagePtr,
+                                                        jint modifier, jdouble x, jdouble y) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!form || !page) return JNI_FALSE;
+    return formInputHandled(page, FORM_OnLButtonUp(form, page, modifier, x, y));
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFormOnKeyDown(JNIEnv *env, jobject thiz,
+                                                      jlong formPtr, jlong pagePtr,
+                                                      jint keyCode, jint modifier) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!form || !page) return JNI_FALSE;
+    return formInputHandled(page, FORM_OnKeyDown(form, page, keyCode, modifier));
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFormOnKeyUp(JNIEnv *env, jobject thiz,
+                                                    jlong formPtr, jlong pagePtr,
+                                                    jint keyCode, jint modifier) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!form || !page) return JNI_FALSE;
+    return FORM_OnKeyUp(form, page, keyCode, modifier) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFormOnChar(JNIEnv *env, jobject thiz,
+                                                   jlong formPtr, jlong pagePtr,
+                                                   jint charCode, jint modifier) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!form || !page) return JNI_FALSE;
+    return formInputHandled(page, FORM_OnChar(form, page, charCode, modifier));
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFormOnFocus(JNIEnv *env, jobject thiz,
+                                                    jlong formPtr, jlong pagePtr,
+                                                    jint modifier, jdouble x, jdouble y) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!form || !page) return JNI_FALSE;
+    return FORM_OnFocus(form, page, modifier, x, y) ? JNI_TRUE : JNI_FALSE;
+}
+
+// --- Form Field Operations ---
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFormCanUndo(JNIEnv *env, jobject thiz,
+                                                    jlong formPtr, jlong pagePtr) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!form || !page) return JNI_FALSE;
+    return FORM_CanUndo(form, page) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFormCanRedo(JNIEnv *env, jobject thiz,
+                                                    jlong formPtr, jlong pagePtr) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!form || !page) return JNI_FALSE;
+    return FORM_CanRedo(form, page) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFormUndo(JNIEnv *env, jobject thiz,
+                                                 jlong formPtr, jlong pagePtr) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!form || !page) return JNI_FALSE;
+    return formInputHandled(page, FORM_Undo(form, page));
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFormRedo(JNIEnv *env, jobject thiz,
+                                                 jlong formPtr, jlong pagePtr) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!form || !page) return JNI_FALSE;
+    return formInputHandled(page, FORM_Redo(form, page));
+}
+
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFormSelectAllText(JNIEnv *env, jobject thiz,
+                                                          jlong formPtr, jlong pagePtr) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (form && page) FORM_SelectAllText(form, page);
+}
+
+// --- Annotation Getters ---
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotColor(JNIEnv *env, jobject thiz,
+                                                      jlong annotPtr, jint colorType, jintArray result) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return JNI_FALSE;
+    
+    unsigned int r, g, b, a;
+    if (!FPDFAnnot_GetColor(annot, (FPDFANNOT_COLORTYPE)colorType, &r, &g, &b, &a)) return JNI_FALSE;
+    
+    jint *body = env->GetIntArrayElements(result, nullptr);
+    body[0] = r; body[1] = g; body[2] = b; body[3] = a;
+    env->ReleaseIntArrayElements(result, body, 0);
+    return JNI_TRUE;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotFlags(JNIEnv *env, jobject thiz, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return 0;
+    return FPDFAnnot_GetFlags(annot);
+}
+
+// --- Additional Annotation Getters ---
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotContents(JNIEnv *env, jobject thiz, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return nullptr;
+
+    return newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDFAnnot_GetStringValue(annot, "Contents", (FPDF_WCHAR*) buffer, bytes);
+    });
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotAuthor(JNIEnv *env, jobject thiz, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return nullptr;
+
+    return newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDFAnnot_GetStringValue(annot, "T", (FPDF_WCHAR*) buffer, bytes);
+    });
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotSubject(JNIEnv *env, jobject thiz, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return nullptr;
+
+    return newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDFAnnot_GetStringValue(annot, "Subj", (FPDF_WCHAR*) buffer, bytes);
+    });
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotModificationDate(JNIEnv *env, jobject thiz, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return nullptr;
+
+    return newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDFAnnot_GetStringValue(annot, "M", (FPDF_WCHAR*) buffer, bytes);
+    });
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotCreationDate(JNIEnv *env, jobject thiz, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return nullptr;
+
+    return newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDFAnnot_GetStringValue(annot, "CreationDate", (FPDF_WCHAR*) buffer, bytes);
+    });
+}
+
+JNIEXPORT jfloat JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotOpacity(JNIEnv *env, jobject thiz, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return 1.0f;
+    
+    float opacity;
+    if (FPDFAnnot_GetNumberValue(annot, "CA", &opacity)) {
+        return opacity;
+    }
+    return 1.0f;  // Default opacity is 1.0 (fully opaque)
+}
+
+JNIEXPORT jdoubleArray JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotQuadPoints(JNIEnv *env, jobject thiz, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return nullptr;
+    
+    // Get the number of quad points
+    unsigned long quadPointsCount = FPDFAnnot_GetAttachmentPoints(annot, 0, nullptr);
+    if (quadPointsCount == 0) return nullptr;
+    
+    // Allocate array for all quad points (each has 8 values: 4 points * 2 coords)
+    jdoubleArray result = env->NewDoubleArray(quadPointsCount * 8);
+    if (!result) return nullptr;
+    
+    jdouble *resultData = env->GetDoubleArrayElements(result, nullptr);
+    
+    for (unsigned long i = 0; i < quadPointsCount; i++) {
+        FS_QUADPOINTSF quadPoints;
+        if (FPDFAnnot_GetAttachmentPoints(annot, i, &quadPoints)) {
+            resultData[i * 8 + 0] = quadPoints.x1;
+            resultData[i * 8 + 1] = quadPoints.y1;
+            resultData[i * 8 + 2] = quadPoints.x2;
+            resultData[i * 8 + 3] = quadPoints.y2;
+            resultData[i * 8 + 4] = quadPoints.x3;
+            resultData[i * 8 + 5] = quadPoints.y3;
+            resultData[i * 8 + 6] = quadPoints.x4;
+            resultData[i * 8 + 7] = quadPoints.y4;
+        }
+    }
+    
+    env->ReleaseDoubleArrayElements(result, resultData, 0);
+    return result;
+}
+
+// --- Additional Annotation Setters ---
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotAuthor(JNIEnv *env, jobject thiz,
+                                                       jlong annotPtr, jstring author) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return JNI_FALSE;
+    
+    WideStringArg wAuthor(env, author);
+    markAnnotEdited(annot);
+    return FPDFAnnot_SetStringValue(annot, "T", wAuthor.get()) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotSubject(JNIEnv *env, jobject thiz,
+                                                        jlong annotPtr, jstring subject) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return JNI_FALSE;
+    
+    WideStringArg wSubject(env, subject);
+    markAnnotEdited(annot);
+    return FPDFAnnot_SetStringValue(annot, "Subj", wSubject.get()) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotOpacity(JNIEnv *env, jobject thiz,
+                                                        jlong annotPtr, jfloat opacity) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return JNI_FALSE;
+    
+    // Clamp opacity to valid range [0.0, 1.0]
+    float clampedOpacity = opacity < 0.0f ? 0.0f : (opacity > 1.0f ? 1.0f : opacity);
+    markAnnotEdited(annot);
+    return FPDFAnnot_SetNumberValue(annot, "CA", clampedOpacity) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotQuadPoints(JNIEnv *env, jobject thiz,
+                                                           jlong annotPtr, jdoubleArray quadPoints) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot || !quadPoints) return JNI_FALSE;
+    
+    jsize len = env->GetArrayLength(quadPoints);
+    if (len % 8 != 0) return JNI_FALSE;  // Must be multiple of 8 (4 points * 2 coords)
+    
+    jdouble *pointsData = env->GetDoubleArrayElements(quadPoints, nullptr);
+    
+    markAnnotEdited(annot);
+
+    // Clear all existing attachment points before setting new ones
+    // This ensures we replace the entire set of quad points rather than appending
+    FPDFAnnot_SetAttachmentPoints(annot, 0, nullptr, 0);
+    
+    // Set new quad points
+    jsize numQuads = len / 8;
+    for (jsize i = 0; i < numQuads; i++) {
+        FS_QUADPOINTSF quad;
+        quad.x1 = (float) pointsData[i * 8 + 0];
+        quad.y1 = (float) pointsData[i * 8 + 1];
+        quad.x2 = (float) pointsData[i * 8 + 2];
+        quad.y2 = (float) pointsData[i * 8 + 3];
+        quad.x3 = (float) pointsData[i * 8 + 4];
+        quad.y3 = (float) pointsData[i * 8 + 5];
+        quad.x4 = (float) pointsData[i * 8 + 6];
+        quad.y4 = (float) pointsData[i * 8 + 7];
+        
+        if (!FPDFAnnot_AppendAttachmentPoints(annot, &quad)) {
+            env->ReleaseDoubleArrayElements(quadPoints, pointsData, 0);
+            return JNI_FALSE;
+        }
+    }
+    
+    env->ReleaseDoubleArrayElements(quadPoints, pointsData, 0);
+    return JNI_TRUE;
+}
+
+// --- Ink Annotation Functions ---
+
+// Points of ink reads and writes
+static LockedScratch<std::vector<FS_POINTF>> g_inkScratch;
+static_assert(sizeof(FS_POINTF) == 2 * sizeof(float), "FS_POINTF must be two packed floats");
+
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotInkStrokeCount(JNIEnv *env, jobject thiz, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return 0;
+    return (jint) FPDFAnnot_GetInkListCount(annot);
+}
+
+/**
+ * Read the whole InkList in one pass: fills offsets (strokeCount + 1 entries)
+ * with each stroke's first point index and returns all points as x/y floats.
+ */
+JNIEXPORT jfloatArray JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotInkPoints(JNIEnv *env, jobject thiz,
+                                                          jlong annotPtr, jintArray offsets) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot || !offsets) return nullptr;
+
+    jsize strokeCount = env->GetArrayLength(offsets) - 1;
+    if (strokeCount < 0 || (unsigned long) strokeCount != FPDFAnnot_GetInkListCount(annot)) return nullptr;
+
+    std::vector<jint> starts(strokeCount + 1);
+    size_t total = 0;
+    for (jsize i = 0; i < strokeCount; i++) {
+        starts[i] = (jint) total;
+        unsigned long pointCount = FPDFAnnot_GetInkListPath(annot, i, nullptr, 0);
+        g_inkScratch.reserve(total + pointCount);
+        if (pointCount > 0) FPDFAnnot_GetInkListPath(annot, i, g_inkScratch.data() + total, pointCount);
+        total += pointCount;
+    }
+    starts[strokeCount] = (jint) total;
+
+    // FS_POINTF is two packed floats, so the scratch buffer copies straight over
+    jfloatArray result = env->NewFloatArray((jsize) (total * 2));
+    if (!result) return nullptr;
+    if (total > 0) env->SetFloatArrayRegion(result, 0, (jsize) (total * 2), (const jfloat*) g_inkScratch.data());
+    env->SetIntArrayRegion(offsets, 0, strokeCount + 1, starts.data());
+    return result;
+}
+
+/**
+ * Replace the InkList with the strokes in points (x/y floats), split at the
+ * point indices in offsets (strokeCount + 1 entries, ending at the point count).
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotInkPoints(JNIEnv *env, jobject thiz, jlong annotPtr,
+                                                          jfloatArray points, jintArray offsets) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot || !points || !offsets) return JNI_FALSE;
+
+    jsize pointCount = env->GetArrayLength(points) / 2;
+    jsize offsetCount = env->GetArrayLength(offsets);
+    if (offsetCount < 2) return JNI_FALSE;
+    std::vector<jint> starts(offsetCount);
+    env->GetIntArrayRegion(offsets, 0, offsetCount, starts.data());
+    if (starts[0] != 0 || starts[offsetCount - 1] != pointCount) return JNI_FALSE;
+    for (jsize i = 1; i < offsetCount; i++) {
+        if (starts[i] <= starts[i - 1]) return JNI_FALSE;
+    }
+
+    g_inkScratch.reserve(pointCount);
+    env->GetFloatArrayRegion(points, 0, pointCount * 2, (jfloat*) g_inkScratch.data());
+
+    markAnnotEdited(annot);
+    FPDFAnnot_RemoveInkList(annot);
+    for (jsize i = 0; i + 1 < offsetCount; i++) {
+        if (FPDFAnnot_AddInkStroke(annot, g_inkScratch.data() + starts[i], starts[i + 1] - starts[i]) < 0) {
+            return JNI_FALSE;
+        }
+    }
+    return JNI_TRUE;
+}
+
+/**
+ * Append one stroke, count points from the x/y floats in points starting at
+ * point start, without touching the existing ones. Returns the stroke index or -1.
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeAppendAnnotInkStroke(JNIEnv *env, jobject thiz, jlong annotPtr,
+                                                             jfloatArray points, jint start, jint count) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot || !points || start < 0 || count <= 0) return -1;
+    if ((jlong) start + count > env->GetArrayLength(points) / 2) return -1;
+
+    g_inkScratch.reserve(count);
+    env->GetFloatArrayRegion(points, start * 2, count * 2, (jfloat*) g_inkScratch.data());
+
+    markAnnotEdited(annot);
+    return FPDFAnnot_AddInkStroke(annot, g_inkScratch.data(), count);
+}
+
+// --- Form Field Option Functions ---
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldOptionValue(JNIEnv *env, jobject thiz,
+                                                                 jlong formPtr, jlong annotPtr,
+                                                                 jint index) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return nullptr;
+    // Note: PDFium's FPDFAnnot API doesn't provide a separate function to get option values
+    // distinct from labels. In PDF forms, the export value often equals the label unless
+    // explicitly set differently in the PDF. For now, we return the label as the value,
+    // which matches the common case. A more complete implementation would need to access
+    // the underlying form field dictionary directly to distinguish between display labels
+    // and export values.
+    return newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDFAnnot_GetOptionLabel(formPtr ? (FPDF_FORMHANDLE)formPtr : nullptr, annot, index, (FPDF_WCHAR*) buffer, bytes);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetFormFieldOptionSelection(JNIEnv *env, jobject thiz,
+                                                                     jlong formPtr, jlong pagePtr,
+                                                                     jlong annotPtr, jint index,
+                                                                     jboolean selected) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!form || !page || !annot) return JNI_FALSE;
+    
+    markAnnotEdited(annot);
+    return FPDFAnnot_SetOptionSelected(form, annot, index, selected ? 1 : 0) ? JNI_TRUE : JNI_FALSE;
+}
+
+// --- Actions ---
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetActionType(JNIEnv *env, jobject thiz, jlong actionPtr) {
+    PdfiumLock lock;
+    FPDF_ACTION action = (FPDF_ACTION) actionPtr;
+    if (!action) return -1;
+    return FPDFAction_GetType(action);
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetActionDest(JNIEnv *env, jobject thiz,
+                                                      jlong docPtr, jlong actionPtr) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    FPDF_ACTION action = (FPDF_ACTION) actionPtr;
+    if (!doc || !action) return 0;
+    return (jlong) FPDFAction_GetDest(doc, action);
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetActionFilePath(JNIEnv *env, jobject thiz, jlong actionPtr) {
+    PdfiumLock lock;
+    FPDF_ACTION action = (FPDF_ACTION) actionPtr;
+    if (!action) return nullptr;
+
+    return newStringFromBytes(env, [&](void *buffer, unsigned long bytes) {
+        return FPDFAction_GetFilePath(action, buffer, bytes);
+    });
+}
+
+// --- Bookmarks ---
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFindBookmark(JNIEnv *env, jobject thiz,
+                                                     jlong docPtr, jstring title) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc || !title) return 0;
+    
+    WideStringArg wTitle(env, title);
+    return (jlong) FPDFBookmark_Find(doc, wTitle.get());
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetBookmarkDest(JNIEnv *env, jobject thiz,
+                                                        jlong docPtr, jlong bookmarkPtr) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    FPDF_BOOKMARK bookmark = (FPDF_BOOKMARK) bookmarkPtr;
+    if (!doc || !bookmark) return 0;
+    return (jlong) FPDFBookmark_GetDest(doc, bookmark);
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetBookmarkAction(JNIEnv *env, jobject thiz, jlong bookmarkPtr) {
+    PdfiumLock lock;
+    FPDF_BOOKMARK bookmark = (FPDF_BOOKMARK) bookmarkPtr;
+    if (!bookmark) return 0;
+    return (jlong) FPDFBookmark_GetAction(bookmark);
+}
+
+// --- Link Enumerate ---
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetLinkAction(JNIEnv *env, jobject thiz, jlong linkPtr) {
+    PdfiumLock lock;
+    FPDF_LINK link = (FPDF_LINK) linkPtr;
+    if (!link) return 0;
+    return (jlong) FPDFLink_GetAction(link);
+}
+
+// --- Text Rectangles ---
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeTextCountRects(JNIEnv *env, jobject thiz,
+                                                       jlong textPagePtr, jint startIndex, jint count) {
+    PdfiumLock lock;
+    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
+    if (!textPage) return 0;
+    return FPDFText_CountRects(textPage, startIndex, count);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeTextGetRect(JNIEnv *env, jobject thiz,
+                                                    jlong textPagePtr, jint index, jdoubleArray result) {
+    PdfiumLock lock;
+    FPDF_TEXTPAGE textPage = (FPDF_TEXTPAGE) textPagePtr;
+    if (!textPage) return JNI_FALSE;
+    
+    double left, top, right, bottom;
+    if (!FPDFText_GetRect(textPage, index, &left, &top, &right, &bottom)) return JNI_FALSE;
+    
+    jdouble *body = env->GetDoubleArrayElements(result, nullptr);
+    body[0] = left; body[1] = top; body[2] = right; body[3] = bottom;
+    env->ReleaseDoubleArrayElements(result, body, 0);
+    return JNI_TRUE;
+}
+
+// --- Attachment Operations ---
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeAddAttachment(JNIEnv *env, jobject thiz,
+                                                      jlong docPtr, jstring name) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc || !name) return 0;
+    
+    WideStringArg wName(env, name);
+    return (jlong) FPDFDoc_AddAttachment(doc, wName.get());
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeDeleteAttachment(JNIEnv *env, jobject thiz,
+                                                         jlong docPtr, jint index) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return JNI_FALSE;
+    return FPDFDoc_DeleteAttachment(doc, index) ? JNI_TRUE : JNI_FALSE;
+}
+
+// --- Page Object Colors (Get) ---
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetObjectStrokeColor(JNIEnv *env, jobject thiz,
+                                                             jlong pageObjPtr, jintArray result) {
+    PdfiumLock lock;
+    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
+    if (!pageObj) return JNI_FALSE;
+    
+    unsigned int r, g, b, a;
+    if (!FPDFPageObj_GetStrokeColor(pageObj, &r, &g, &b, &a)) return JNI_FALSE;
+    
+    jint *body = env->GetIntArrayElements(result, nullptr);
+    body[0] = r; body[1] = g; body[2] = b; body[3] = a;
+    env->ReleaseIntArrayElements(result, body, 0);
+    return JNI_TRUE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetObjectFillColor(JNIEnv *env, jobject thiz,
+                                                           jlong pageObjPtr, jintArray result) {
+    PdfiumLock lock;
+    FPDF_PAGEOBJECT pageObj = (FPDF_PAGEOBJECT) pageObjPtr;
+    if (!pageObj) return JNI_FALSE;
+    
+    unsigned int r, g, b, a;
+    if (!FPDFPageObj_GetFillColor(pageObj, &r, &g, &b, &a)) return JNI_FALSE;
+    
+    jint *body = env->GetIntArrayElements(result, nullptr);
+    body[0] = r; body[1] = g; body[2] = b; body[3] = a;
+    env->ReleaseIntArrayElements(result, body, 0);
+    return JNI_TRUE;
+}
+
+// --- Page Boxes (Bleed, Trim, Art) ---
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetPageBleedBox(JNIEnv *env, jobject thiz,
+                                                        jlong pagePtr, jfloat left, jfloat bottom,
+                                                        jfloat right, jfloat top) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (page) FPDFPage_SetBleedBox(page, left, bottom, right, top);
+}
+
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetPageTrimBox(JNIEnv *env, jobject thiz,
+                                                       jlong pagePtr, jfloat left, jfloat bottom,
+                                                       jfloat right, jfloat top) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (page) FPDFPage_SetTrimBox(page, left, bottom, right, top);
+}
+
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetPageArtBox(JNIEnv *env, jobject thiz,
+                                                      jlong pagePtr, jfloat left, jfloat bottom,
+                                                      jfloat right, jfloat top) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (page) FPDFPage_SetArtBox(page, left, bottom, right, top);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageBleedBox(JNIEnv *env, jobject thiz,
+                                                        jlong pagePtr, jfloatArray result) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return JNI_FALSE;
+    
+    float left, bottom, right, top;
+    if (!FPDFPage_GetBleedBox(page, &left, &bottom, &right, &top)) return JNI_FALSE;
+    
+    jfloat *body = env->GetFloatArrayElements(result, nullptr);
+    body[0] = left; body[1] = bottom; body[2] = right; body[3] = top;
+    env->ReleaseFloatArrayElements(result, body, 0);
+    return JNI_TRUE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageTrimBox(JNIEnv *env, jobject thiz,
+                                                       jlong pagePtr, jfloatArray result) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return JNI_FALSE;
+    
+    float left, bottom, right, top;
+    if (!FPDFPage_GetTrimBox(page, &left, &bottom, &right, &top)) return JNI_FALSE;
+    
+    jfloat *body = env->GetFloatArrayElements(result, nullptr);
+    body[0] = left; body[1] = bottom; body[2] = right; body[3] = top;
+    env->ReleaseFloatArrayElements(result, body, 0);
+    return JNI_TRUE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageArtBox(JNIEnv *env, jobject thiz,
+                                                      jlong pagePtr, jfloatArray result) {
+    PdfiumLock lock;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return JNI_FALSE;
+    
+    float left, bottom, right, top;
+    if (!FPDFPage_GetArtBox(page, &left, &bottom, &right, &top)) return JNI_FALSE;
+    
+    jfloat *body = env->GetFloatArrayElements(result, nullptr);
+    body[0] = left; body[1] = bottom; body[2] = right; body[3] = top;
+    env->ReleaseFloatArrayElements(result, body, 0);
+    return JNI_TRUE;
+}
+
+// --- StructTree Extended ---
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeStructElementCountChildren(JNIEnv *env, jobject thiz,
+                                                                   jlong structElemPtr) {
+    PdfiumLock lock;
+    FPDF_STRUCTELEMENT elem = (FPDF_STRUCTELEMENT) structElemPtr;
+    if (!elem) return 0;
+    return FPDF_StructElement_CountChildren(elem);
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeStructElementGetChildAtIndex(JNIEnv *env, jobject thiz,
+                                                                      jlong structElemPtr, jint index) {
+    PdfiumLock lock;
+    FPDF_STRUCTELEMENT elem = (FPDF_STRUCTELEMENT) structElemPtr;
+    if (!elem) return 0;
+    return (jlong) FPDF_StructElement_GetChildAtIndex(elem, index);
+}
+
+// --- Font Loading ---
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeLoadStandardFont(JNIEnv *env, jobject thiz,
+                                                         jlong docPtr, jstring fontName) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc || !fontName) return 0;
+    
+    const char *cFontName = env->GetStringUTFChars(fontName, nullptr);
+    FPDF_FONT font = FPDFText_LoadStandardFont(doc, cFontName);
+    env->ReleaseStringUTFChars(fontName, cFontName);
+    return (jlong) font;
+}
+
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeCloseFont(JNIEnv *env, jobject thiz, jlong fontPtr) {
+    PdfiumLock lock;
+    FPDF_FONT font = (FPDF_FONT) fontPtr;
+    if (font) FPDFFont_Close(font);
+}
+
+// --- Data Availability ---
+
+/**
+ * Create a progressive loader over a Java PdfRangeFetcher
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeCreateRangeLoader(JNIEnv *env, jobject thiz,
+                                                           jobject fetcher, jlong fileLength) {
+    PdfiumLock lock;
+    if (!fetcher || fileLength <= 0) return 0;
+
+    jclass fetcherClass = env->GetObjectClass(fetcher);
+    jmethodID fetchMethod = env->GetMethodID(fetcherClass, "fetch", "(JI)[B");
+    env->DeleteLocalRef(fetcherClass);
+    if (!fetchMethod) return 0;
+
+    RangeLoader *loader = new (std::nothrow) RangeLoader();
+    if (!loader) return 0;
+
+    env->GetJavaVM(&loader->vm);
+    loader->fetcher = env->NewGlobalRef(fetcher);
+    loader->fetchMethod = fetchMethod;
+    loader->fileLength = (size_t) fileLength;
+
+    loader->fileAvail.version = 1;
+    loader->fileAvail.IsDataAvail = RangeLoader::IsDataAvailImpl;
+    loader->fileAvail.owner = loader;
+
+    loader->hints.version = 1;
+    loader->hints.AddSegment = RangeLoader::AddSegmentImpl;
+    loader->hints.owner = loader;
+
+    loader->fileAccess.m_FileLen = (unsigned long) fileLength;
+    loader->fileAccess.m_GetBlock = RangeLoader::GetBlockImpl;
+    loader->fileAccess.m_Param = loader;
+
+    loader->avail = FPDFAvail_Create(&loader->fileAvail, &loader->fileAccess);
+    if (!loader->avail) {
+        LOGE("Failed to create FPDF_AVAIL");
+        destroyRangeLoader(loader);
+        return 0;
+    }
+    return (jlong) loader;
+}
+
+/**
+ * Destroy a progressive loader that never produced a document.
+ * Loaders owned by an open document are released by nativeCloseDocument.
+ */
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeDestroyRangeLoader(JNIEnv *env, jobject thiz,
+                                                            jlong loaderPtr) {
+    PdfiumLock lock;
+    destroyRangeLoader((RangeLoader*) loaderPtr);
+}
+
+/**
+ * Check whether the document trailer/linearization data has arrived.
+ * Returns PDF_DATA_ERROR, PDF_DATA_NOTAVAIL or PDF_DATA_AVAIL.
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeAvailIsDocAvail(JNIEnv *env, jobject thiz,
+                                                        jlong loaderPtr) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:availability");
+    RangeLoader *loader = (RangeLoader*) loaderPtr;
+    if (!loader || loader->fetchFailed) return PDF_DATA_ERROR;
+    return FPDFAvail_IsDocAvail(loader->avail, &loader->hints);
+}
+
+/**
+ * Check whether all objects of a page have arrived.
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeAvailIsPageAvail(JNIEnv *env, jobject thiz,
+                                                         jlong loaderPtr, jint pageIndex) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:availability");
+    RangeLoader *loader = (RangeLoader*) loaderPtr;
+    if (!loader || loader->fetchFailed) return PDF_DATA_ERROR;
+    return FPDFAvail_IsPageAvail(loader->avail, pageIndex, &loader->hints);
+}
+
+/**
+ * Check whether the AcroForm data has arrived.
+ * Returns one of the PDF_FORM_* codes.
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeAvailIsFormAvail(JNIEnv *env, jobject thiz,
+                                                         jlong loaderPtr) {
+    PdfiumLock lock;
+    RangeLoader *loader = (RangeLoader*) loaderPtr;
+    if (!loader || loader->fetchFailed) return PDF_FORM_ERROR;
+    return FPDFAvail_IsFormAvail(loader->avail, &loader->hints);
+}
+
+/**
+ * Download the segments hinted by the last availability check, or the next
+ * missing chunk if there were none. Returns false on a failed fetch or when
+ * nothing is left to download.
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeAvailFetchHints(JNIEnv *env, jobject thiz,
+                                                        jlong loaderPtr) {
+    RangeLoader *loader = (RangeLoader*) loaderPtr;
+    if (!loader) return JNI_FALSE;
+
+    std::vector<std::pair<size_t, size_t>> runs;
+    {
+        PdfiumLock lock;
+        runs = loader->takeMissingRuns();
+    }
+    if (runs.empty()) return JNI_FALSE;
+
+    // The network round trips run without the library lock so other documents
+    // keep rendering; the loader is only touched again once it is retaken
+    for (const auto &run : runs) {
+        jbyteArray data = loader->downloadChunks(env, run.first, run.second);
+        PdfiumLock lock;
+        if (!loader->storeChunks(env, run.first, run.second, data)) return JNI_FALSE;
+    }
+    return JNI_TRUE;
+}
+
+/**
+ * Load the document once it is available. On success the loader is owned by the
+ * document and released together with it.
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeAvailGetDocument(JNIEnv *env, jobject thiz,
+                                                         jlong loaderPtr, jstring password) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:openDocument");
+    RangeLoader *loader = (RangeLoader*) loaderPtr;
+    if (!loader) return 0;
+
+    const char *cPassword = nullptr;
+    if (password != nullptr) {
+        cPassword = env->GetStringUTFChars(password, nullptr);
+    }
+
+    FPDF_DOCUMENT doc = FPDFAvail_GetDocument(loader->avail, cPassword);
+
+    if (password != nullptr) {
+        env->ReleaseStringUTFChars(password, cPassword);
+    }
+
+    if (!doc) {
+        LOGE("Failed to load progressive document, error: %lu", FPDF_GetLastError());
+        return 0;
+    }
+
+    DocumentResources res;
+    res.rangeLoader = loader;
+    trackDocumentResources(doc, res);
+    LOGI("Document opened (progressive), size: %zu, fetched chunks: %zu/%zu",
+         loader->fileLength, loader->chunks.size(), loader->chunkCount());
+    return (jlong) doc;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeAvailGetFirstPageNum(JNIEnv *env, jobject thiz,
+                                                             jlong docPtr) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return 0;
+    return FPDFAvail_GetFirstPageNum(doc);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeIsLinearized(JNIEnv *env, jobject thiz, jlong loaderPtr) {
+    PdfiumLock lock;
+    RangeLoader *loader = (RangeLoader*) loaderPtr;
+    if (!loader) return JNI_FALSE;
+    return FPDFAvail_IsLinearized(loader->avail) == PDF_LINEARIZED ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Get Link Handle from Annotation
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetLinkFromAnnot(JNIEnv *env, jobject thiz,
+                                                         jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return 0;
+    
+    // Use proper PDFium API to get link from annotation
+    FPDF_LINK link = FPDFAnnot_GetLink(annot);
+    return (jlong) link;
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldDefaultValue(JNIEnv *env, jobject thiz,
+                                                                  jlong formPtr, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!form || !annot) return nullptr;
+    
+    // Note: PDFium doesn't provide a direct API to get the default value (DV entry).
+    // The current implementation returns the current field value as a fallback.
+    // To get the true default value, one would need to access the field dictionary directly.
+    return newStringFromWide(env, [&](void *buffer, unsigned long bytes) {
+        return FPDFAnnot_GetFormFieldValue(form, annot, (FPDF_WCHAR*) buffer, bytes);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeIsFormFieldRequired(JNIEnv *env, jobject thiz,
+                                                            jlong formPtr, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!form || !annot) return JNI_FALSE;
+    
+    // Check if the field has the required flag (Ff bit 2)
+    int flags = FPDFAnnot_GetFormFieldFlags(form, annot);
+    return (flags & 0x02) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeIsFormFieldReadOnly(JNIEnv *env, jobject thiz,
+                                                            jlong formPtr, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!form || !annot) return JNI_FALSE;
+    
+    // Check if the field has the read-only flag (Ff bit 1)
+    int flags = FPDFAnnot_GetFormFieldFlags(form, annot);
+    return (flags & 0x01) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldMaxLength(JNIEnv *env, jobject thiz,
+                                                              jlong formPtr, jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!form || !annot) return -1;
+    
+    // Get max length for text fields
+    return FPDFAnnot_GetFormFieldMaxLen(form, annot);
+}
+
+// --- Signature Field Support ---
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeIsSignatureField(JNIEnv *env, jobject thiz,
+                                                         jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return JNI_FALSE;
+    
+    // Check if annotation type is signature (FPDF_FORMFIELD_SIGNATURE = 7)
+    int type = FPDFAnnot_GetFormFieldType(nullptr, annot);
+    return (type == 7) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetSignatureStatus(JNIEnv *env, jobject thiz,
+                                                           jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return 3; // ERROR
+    
+    // PDFium doesn't provide signature validation APIs directly
+    // Return 0 (UNSIGNED) as default
+    // A proper implementation would need to check the signature dictionary
+    return 0;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetSignatureCount(JNIEnv *env, jobject thiz,
+                                                          jlong docPtr) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return -1;
+    
+    return FPDF_GetSignatureCount(doc);
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetSignatureAtIndex(JNIEnv *env, jobject thiz,
+                                                            jlong docPtr, jint index) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return 0;
+    
+    return (jlong) FPDF_GetSignatureObject(doc, index);
+}
+
+// --- Appearance Stream Support ---
+JNIEXPORT jbyteArray JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAnnotAppearanceStream(JNIEnv *env, jobject thiz,
+                                                                 jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return nullptr;
+    
+    // PDFium doesn't provide a direct API to get appearance stream content
+    // Return empty byte array
+    jbyteArray result = env->NewByteArray(0);
+    return result;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetAnnotAppearanceStream(JNIEnv *env, jobject thiz,
+                                                                 jlong annotPtr,
+                                                                 jbyteArray appearanceStream) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot || !appearanceStream) return JNI_FALSE;
+    
+    // PDFium doesn't provide a direct API to set appearance stream content
+    // Return false to indicate not supported
+    return JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGenerateAnnotDefaultAppearance(JNIEnv *env, jobject thiz,
+                                                                       jlong annotPtr) {
+    PdfiumLock lock;
+    FPDF_ANNOTATION annot = (FPDF_ANNOTATION) annotPtr;
+    if (!annot) return JNI_FALSE;
+    
+    // Generate default appearance for the annotation
+    markAnnotEdited(annot);
+    return FPDFAnnot_SetAP(annot, FPDF_ANNOT_APPEARANCEMODE_NORMAL, nullptr) ? JNI_TRUE : JNI_FALSE;
+}
+
+// --- XFA Form Support ---
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeHasXFAForms(JNIEnv *env, jobject thiz,
+                                                    jlong docPtr) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return JNI_FALSE;
+    
+    // Check if document has XFA forms by checking XFA packet count
+    int count = FPDF_GetXFAPacketCount(doc);
+    return (count > 0) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetXFAPacketCount(JNIEnv *env, jobject thiz,
+                                                          jlong docPtr) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return 0;
+    
+    return FPDF_GetXFAPacketCount(doc);
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetXFAPacketName(JNIEnv *env, jobject thiz,
+                                                         jlong docPtr, jint index) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return nullptr;
+
+    return newStringFromBytes(env, [&](void *buffer, unsigned long bytes) {
+        return FPDF_GetXFAPacketName(doc, index, buffer, bytes);
+    });
+}
+
+JNIEXPORT jbyteArray JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetXFAPacketContent(JNIEnv *env, jobject thiz,
+                                                           jlong docPtr, jint index) {
+    PdfiumLock lock;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return nullptr;
+    
+    // Get the buffer size needed
+    unsigned long bufSize = 0;
+    if (!FPDF_GetXFAPacketContent(doc, index, nullptr, 0, &bufSize) || bufSize == 0) {
+        return env->NewByteArray(0);
+    }
+    
+    // Packets can be megabytes, so they get a buffer of their own
+    std::vector<uint8_t> content(bufSize);
+    if (!FPDF_GetXFAPacketContent(doc, index, content.data(), bufSize, &bufSize)) {
+        return env->NewByteArray(0);
+    }
+    bufSize = std::min<unsigned long>(bufSize, content.size());
+    
+    jbyteArray result = env->NewByteArray(bufSize);
+    env->SetByteArrayRegion(result, 0, bufSize, (jbyte*) content.data());
+    return result;
+}
+
+// --- Appearance Settings ---
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetFormFieldHighlightColor(JNIEnv *env, jobject thiz,
+                                                                   jlong formPtr, jint r, jint g,
+                                                                   jint b, jint a) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    if (!form) return;
+    
+    // Set form field highlight color
+    FPDF_SetFormFieldHighlightColor(form, 0, (r << 16) | (g << 8) | b);
+    FPDF_SetFormFieldHighlightAlpha(form, a);
+}
+
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetFormFieldHighlightAlpha(JNIEnv *env, jobject thiz,
+                                                                   jlong formPtr, jint alpha) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    if (!form) return;
+    
+    FPDF_SetFormFieldHighlightAlpha(form, alpha);
+}
+
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeRemoveFormFieldHighlight(JNIEnv *env, jobject thiz,
+                                                                 jlong formPtr) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    if (!form) return;
+    
+    // Remove highlight by setting alpha to 0
+    FPDF_SetFormFieldHighlightAlpha(form, 0);
+}
+
+// ----------------------------------------------------------------------------
+// Shared-Memory Rendering (Multi-Process Render Pool)
+// ----------------------------------------------------------------------------
+
+/**
+ * Create an ashmem region for passing rendered RGBA pixels between processes
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeCreateSharedMemory(JNIEnv *env, jobject thiz,
+                                                            jstring name, jlong size) {
+    if (size <= 0) return -1;
+    const char *cName = env->GetStringUTFChars(name, nullptr);
+    int fd = ASharedMemory_create(cName, (size_t) size);
+    env->ReleaseStringUTFChars(name, cName);
+    if (fd < 0) LOGE("ASharedMemory_create failed for %lld bytes", (long long) size);
+    return fd;
+}
+
+/**
+ * Render a whole page as tightly packed RGBA_8888 into a shared memory region
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeRenderPageToSharedMemory(JNIEnv *env, jobject thiz,
+                                                                  jlong pagePtr, jint fd,
+                                                                  jint width, jint height,
+                                                                  jboolean renderAnnot) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:renderPage");
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page || width <= 0 || height <= 0) return JNI_FALSE;
+
+    size_t stride = (size_t) width * 4;
+    size_t length = stride * height;
+    if (ASharedMemory_getSize(fd) < length) {
+        LOGE("Shared memory too small for %dx%d render", width, height);
+        return JNI_FALSE;
+    }
+
+    void *pixels = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (pixels == MAP_FAILED) {
+        LOGE("mmap of shared memory failed, errno: %d", errno);
+        return JNI_FALSE;
+    }
+
+    FPDF_BITMAP fpdfBitmap = FPDFBitmap_CreateEx(width, height, FPDFBitmap_BGRA, pixels, (int) stride);
+    if (!fpdfBitmap) {
+        munmap(pixels, length);
+        return JNI_FALSE;
+    }
+
+    FPDFBitmap_FillRect(fpdfBitmap, 0, 0, width, height, 0xFFFFFFFF);
+
+    int flags = FPDF_REVERSE_BYTE_ORDER;
+    if (renderAnnot) {
+        flags |= FPDF_ANNOT;
+    }
+    {
+        RenderTimer timer(page);
+        FPDF_RenderPageBitmap(fpdfBitmap, page, 0, 0, width, height, 0, flags);
+    }
+
+    FPDFBitmap_Destroy(fpdfBitmap);
+    munmap(pixels, length);
+    return JNI_TRUE;
+}
+
+/**
+ * Copy tightly packed RGBA_8888 pixels from a shared memory region into a bitmap
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeCopySharedMemoryToBitmap(JNIEnv *env, jobject thiz,
+                                                                  jint fd, jobject bitmap) {
+    AndroidBitmapInfo info;
+    if (AndroidBitmap_getInfo(env, bitmap, &info) != ANDROID_BITMAP_RESULT_SUCCESS ||
+        info.format != ANDROID_BITMAP_FORMAT_RGBA_8888) {
+        return JNI_FALSE;
+    }
+
+    size_t rowBytes = (size_t) info.width * 4;
+    size_t length = rowBytes * info.height;
+    if (ASharedMemory_getSize(fd) < length) return JNI_FALSE;
+
+    void *shared = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    if (shared == MAP_FAILED) {
+        LOGE("mmap of shared memory failed, errno: %d", errno);
+        return JNI_FALSE;
+    }
+
+    void *pixels;
+    if (AndroidBitmap_lockPixels(env, bitmap, &pixels) != ANDROID_BITMAP_RESULT_SUCCESS) {
+        munmap(shared, length);
+        return JNI_FALSE;
+    }
+
+    if (info.stride == rowBytes) {
+        memcpy(pixels, shared, length);
+    } else {
+        for (uint32_t y = 0; y < info.height; y++) {
+            memcpy((char*) pixels + (size_t) y * info.stride, (char*) shared + y * rowBytes, rowBytes);
+        }
+    }
+
+    AndroidBitmap_unlockPixels(env, bitmap);
+    munmap(shared, length);
+    return JNI_TRUE;
+}
+
+// ----------------------------------------------------------------------------
+// Tiled Rendering
+// ----------------------------------------------------------------------------
+
+/**
+ * Fixed-capacity pool of tile-sized render targets, allocated up front.
+ *
+ * Heap pools hold PDFium-owned BGRA bitmaps; tiles are rendered into one and
+ * copied into the caller's Android bitmap, so no AndroidBitmap locking,
+ * FPDFBitmap allocation or full-surface clear happens per tile. Hardware pools
+ * hold CPU-writable AHardwareBuffers that are handed to Java as HardwareBuffer
+ * objects and stay leased until nativeReleaseTile.
+ */
+struct PooledTile {
+    FPDF_BITMAP bitmap = nullptr;           // Owned pixels, or wrapper over mappedAddress
+    AHardwareBuffer *hardwareBuffer = nullptr;
+    void *mappedAddress = nullptr;          // Address the wrapper was created over
+    int stride = 0;
+    bool leased = false;
+};
+
+struct TilePool {
+    int tileWidth;
+    int tileHeight;
+    bool hardware;
+    std::vector<PooledTile> tiles;
+};
+
+static void destroyTilePool(TilePool *pool) {
+    for (auto &tile : pool->tiles) {
+        if (tile.bitmap) FPDFBitmap_Destroy(tile.bitmap);
+        if (tile.hardwareBuffer) AHardwareBuffer_release(tile.hardwareBuffer);
+    }
+    delete pool;
+}
+
+static int acquireTile(TilePool *pool) {
+    for (size_t i = 0; i < pool->tiles.size(); i++) {
+        if (!pool->tiles[i].leased) {
+            pool->tiles[i].leased = true;
+            return (int) i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Lock a hardware tile for CPU writes and return a PDFium bitmap over it.
+ * The wrapper is reused while the buffer keeps mapping to the same address.
+ */
+static FPDF_BITMAP lockHardwareTile(TilePool *pool, PooledTile &tile) {
+    void *address = nullptr;
+    if (AHardwareBuffer_lock(tile.hardwareBuffer, AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN,
+                             -1, nullptr, &address) != 0 || !address) {
+        LOGE("AHardwareBuffer_lock failed");
+        return nullptr;
+    }
+    if (tile.bitmap && tile.mappedAddress != address) {
+        FPDFBitmap_Destroy(tile.bitmap);
+        tile.bitmap = nullptr;
+    }
+    if (!tile.bitmap) {
+        tile.bitmap = FPDFBitmap_CreateEx(pool->tileWidth, pool->tileHeight, FPDFBitmap_BGRA,
+                                          address, tile.stride);
+        tile.mappedAddress = address;
+    }
+    if (!tile.bitmap) AHardwareBuffer_unlock(tile.hardwareBuffer, nullptr);
+    return tile.bitmap;
+}
+
+/**
+ * Render the tile at (column, row) of the page scaled by zoom pixels per point.
+ * Only the tile itself is cleared; the matrix translates the page so the tile
+ * origin lands on (0, 0) and the clip keeps PDFium from touching anything else.
+ */
+static void renderTile(FPDF_PAGE page, FPDF_FORMHANDLE form, FPDF_BITMAP bitmap, int tileWidth,
+                       int tileHeight, float zoom, int column, int row, int flags) {
+    FPDFBitmap_FillRect(bitmap, 0, 0, tileWidth, tileHeight, 0xFFFFFFFF);
+    FS_MATRIX matrix = {zoom, 0, 0, zoom, -(float) column * tileWidth, -(float) row * tileHeight};
+    FS_RECTF clip = {0, 0, (float) tileWidth, (float) tileHeight};
+    {
+        RenderTimer timer(page);
+        FPDF_RenderPageBitmapWithMatrix(bitmap, page, &matrix, &clip, flags);
+    }
+    if (form) {
+        // FFLDraw has no matrix form; the same zoom and offset as a page size and origin
+        int sizeX = (int) (FPDF_GetPageWidthF(page) * zoom + 0.5f);
+        int sizeY = (int) (FPDF_GetPageHeightF(page) * zoom + 0.5f);
+        FPDF_FFLDraw(form, bitmap, page, -column * tileWidth, -row * tileHeight, sizeX, sizeY, 0, flags);
+    }
+}
+
+/**
+ * Create a tile pool with capacity targets of tileWidth x tileHeight pixels
+ */
+JNIEXPORT jlong JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeCreateTilePool(JNIEnv *env, jobject thiz,
+                                                        jint tileWidth, jint tileHeight,
+                                                        jint capacity, jboolean hardware) {
+    PdfiumLock lock;
+    if (tileWidth <= 0 || tileHeight <= 0 || capacity <= 0) return 0;
+
+    TilePool *pool = new TilePool{tileWidth, tileHeight, (bool) hardware, {}};
+    pool->tiles.resize(capacity);
+    for (auto &tile : pool->tiles) {
+        if (hardware) {
+            AHardwareBuffer_Desc desc = {};
+            desc.width = tileWidth;
+            desc.height = tileHeight;
+            desc.layers = 1;
+            desc.format = AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM;
+            desc.usage = AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN | AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE;
+            if (AHardwareBuffer_allocate(&desc, &tile.hardwareBuffer) != 0) {
+                LOGE("AHardwareBuffer_allocate failed for %dx%d tile", tileWidth, tileHeight);
+                destroyTilePool(pool);
+                return 0;
+            }
+            AHardwareBuffer_describe(tile.hardwareBuffer, &desc);
+            tile.stride = (int) desc.stride * 4;
+        } else {
+            tile.bitmap = FPDFBitmap_Create(tileWidth, tileHeight, 1);
+            if (!tile.bitmap) {
+                destroyTilePool(pool);
+                return 0;
+            }
+            tile.stride = FPDFBitmap_GetStride(tile.bitmap);
+        }
+    }
+    return (jlong) pool;
+}
+
+/**
+ * Destroy a tile pool. HardwareBuffer objects already handed out stay valid.
+ */
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeDestroyTilePool(JNIEnv *env, jobject thiz, jlong poolPtr) {
+    PdfiumLock lock;
+    TilePool *pool = (TilePool*) poolPtr;
+    if (pool) destroyTilePool(pool);
+}
+
+/**
+ * Render tiles (column/row pairs) into heap targets and copy each into the
+ * matching ARGB_8888 bitmap. Returns the number of tiles rendered.
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeRenderTilesToBitmaps(JNIEnv *env, jobject thiz,
+                                                              jlong pagePtr, jlong poolPtr,
+                                                              jfloat zoom, jintArray tiles,
+                                                              jobjectArray bitmaps,
+                                                              jboolean renderAnnot,
+                                                              jlong formHandlePtr) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:renderTiles");
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    TilePool *pool = (TilePool*) poolPtr;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formHandlePtr;
+    if (!page || !pool || pool->hardware || !tiles || !bitmaps || zoom <= 0) return 0;
+
+    jsize count = std::min(env->GetArrayLength(tiles) / 2, env->GetArrayLength(bitmaps));
+    std::vector<jint> coords(count * 2);
+    env->GetIntArrayRegion(tiles, 0, count * 2, coords.data());
+
+    int slot = acquireTile(pool);
+    if (slot < 0) return 0;
+    PooledTile &tile = pool->tiles[slot];
+
+    int flags = FPDF_REVERSE_BYTE_ORDER;
+    if (renderAnnot) {
+        flags |= FPDF_ANNOT;
+    }
+
+    const char *source = (const char*) FPDFBitmap_GetBuffer(tile.bitmap);
+    jint rendered = 0;
+    for (jsize i = 0; i < count; i++) {
+        jobject bitmap = env->GetObjectArrayElement(bitmaps, i);
+        if (!bitmap) continue;
+
+        AndroidBitmapInfo info;
+        void *pixels;
+        if (AndroidBitmap_getInfo(env, bitmap, &info) != ANDROID_BITMAP_RESULT_SUCCESS ||
+            info.format != ANDROID_BITMAP_FORMAT_RGBA_8888 ||
+            AndroidBitmap_lockPixels(env, bitmap, &pixels) != ANDROID_BITMAP_RESULT_SUCCESS) {
+            env->DeleteLocalRef(bitmap);
+            continue;
+        }
+
+        renderTile(page, form, tile.bitmap, pool->tileWidth, pool->tileHeight, zoom,
+                   coords[i * 2], coords[i * 2 + 1], flags);
+
+        size_t rowBytes = (size_t) std::min((int) info.width, pool->tileWidth) * 4;
+        int rows = std::min((int) info.height, pool->tileHeight);
+        for (int y = 0; y < rows; y++) {
+            memcpy((char*) pixels + (size_t) y * info.stride, source + (size_t) y * tile.stride, rowBytes);
+        }
+
+        AndroidBitmap_unlockPixels(env, bitmap);
+        env->DeleteLocalRef(bitmap);
+        rendered++;
+    }
+
+    tile.leased = false;
+    return rendered;
+}
+
+/**
+ * Render tiles (column/row pairs) into leased hardware targets. Returns one
+ * HardwareBuffer per tile rendered, stopping early if the pool runs out;
+ * the pool slot of each is written to outSlots for nativeReleaseTile.
+ */
+JNIEXPORT jobjectArray JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeRenderTilesToHardwareBuffers(JNIEnv *env, jobject thiz,
+                                                                      jlong pagePtr, jlong poolPtr,
+                                                                      jfloat zoom, jintArray tiles,
+                                                                      jintArray outSlots,
+                                                                      jboolean renderAnnot,
+                                                                      jlong formHandlePtr) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:renderTiles");
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    TilePool *pool = (TilePool*) poolPtr;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formHandlePtr;
+    if (!page || !pool || !pool->hardware || !tiles || !outSlots || zoom <= 0) return nullptr;
+
+    jsize count = std::min(env->GetArrayLength(tiles) / 2, env->GetArrayLength(outSlots));
+    std::vector<jint> coords(count * 2);
+    env->GetIntArrayRegion(tiles, 0, count * 2, coords.data());
+
+    int flags = FPDF_REVERSE_BYTE_ORDER;
+    if (renderAnnot) {
+        flags |= FPDF_ANNOT;
+    }
+
+    std::vector<jint> slots;
+    std::vector<jobject> buffers;
+    for (jsize i = 0; i < count; i++) {
+        int slot = acquireTile(pool);
+        if (slot < 0) break;
+        PooledTile &tile = pool->tiles[slot];
+
+        FPDF_BITMAP bitmap = lockHardwareTile(pool, tile);
+        if (!bitmap) {
+            tile.leased = false;
+            break;
+        }
+        renderTile(page, form, bitmap, pool->tileWidth, pool->tileHeight, zoom,
+                   coords[i * 2], coords[i * 2 + 1], flags);
+        AHardwareBuffer_unlock(tile.hardwareBuffer, nullptr);
+
+        jobject buffer = AHardwareBuffer_toHardwareBuffer(env, tile.hardwareBuffer);
+        if (!buffer) {
+            tile.leased = false;
+            break;
+        }
+        slots.push_back(slot);
+        buffers.push_back(buffer);
+    }
+
+    jclass bufferClass = env->FindClass("android/hardware/HardwareBuffer");
+    jobjectArray result = env->NewObjectArray((jsize) buffers.size(), bufferClass, nullptr);
+    env->DeleteLocalRef(bufferClass);
+    for (size_t i = 0; i < buffers.size(); i++) {
+        env->SetObjectArrayElement(result, (jsize) i, buffers[i]);
+        env->DeleteLocalRef(buffers[i]);
+    }
+    env->SetIntArrayRegion(outSlots, 0, (jsize) slots.size(), slots.data());
+    return result;
+}
+
+/**
+ * Return a leased hardware tile to its pool
+ */
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeReleaseTile(JNIEnv *env, jobject thiz,
+                                                     jlong poolPtr, jint slot) {
+    PdfiumLock lock;
+    TilePool *pool = (TilePool*) poolPtr;
+    if (!pool || slot < 0 || slot >= (jint) pool->tiles.size()) return;
+    pool->tiles[slot].leased = false;
+}
+
+// ----------------------------------------------------------------------------
+// Document Search
+// ----------------------------------------------------------------------------
+
+/**
+ * A page for one step of a multi-page walk. It goes through the document's
+ * page cache when that is on, so the walk reuses parsed pages and leaves them
+ * warm for later calls.
+ */
+struct PageScope {
+    FPDF_DOCUMENT doc;
+    PageCache *cache;
+    FPDF_PAGE page = nullptr;
+
+    PageScope(FPDF_DOCUMENT doc, PageCache *cache, int pageIndex) : doc(doc), cache(cache) {
+        if (cache) {
+            page = cache->acquire(pageIndex);
+        } else {
+            page = FPDF_LoadPage(doc, pageIndex);
+            if (page) recordPageLoad(doc, page, pageIndex);
+        }
+    }
+
+    ~PageScope() {
+        if (page && (!cache || !cache->release(page))) {
+            forgetPage(page);
+            FPDF_ClosePage(page);
+        }
+    }
+
+    PageScope(const PageScope &) = delete;
+    PageScope &operator=(const PageScope &) = delete;
+};
+
+/**
+ * A page and its text page for one step of a multi-page walk; the text page
+ * is cached alongside the page when text caching is on.
+ */
+struct PageTextScope {
+    PageScope pageScope;
+    FPDF_TEXTPAGE textPage = nullptr;
+    bool ownsTextPage = false;
+
+    PageTextScope(FPDF_DOCUMENT doc, PageCache *cache, int pageIndex) : pageScope(doc, cache, pageIndex) {
+        FPDF_PAGE page = pageScope.page;
+        if (!page) return;
+
+        textPage = cache ? cache->acquireText(page) : nullptr;
+        if (!textPage) {
+            textPage = FPDFText_LoadPage(page);
+            if (textPage) recordTextPageLoad(doc);
+            ownsTextPage = true;
+        }
+    }
+
+    ~PageTextScope() {
+        if (!textPage) return;
+        if (!ownsTextPage) pageScope.cache->releaseText(textPage);
+        else FPDFText_ClosePage(textPage);
+    }
+
+    PageTextScope(const PageTextScope &) = delete;
+    PageTextScope &operator=(const PageTextScope &) = delete;
+};
+
+static PageCache *walkCache(FPDF_DOCUMENT doc) {
+    PageCache *cache = getPageCache(doc, false);
+    return cache && cache->capacity > 0 ? cache : nullptr;
+}
+
+/**
+ * Search a range of pages with one JNI call.
+ *
+ * Pages and text pages go through the document's page cache when it is on, so
+ * repeated searches (and later rendering) reuse parsed pages. For every page
+ * with hits, the callback's onPage(int, int[], int[], int[], float[]) receives
+ * packed arrays: the start char index and char count of each hit, the offset
+ * of each hit's first rect (plus a final end offset), and the rects as
+ * left/top/right/bottom floats in page coordinates. Returning false from the
+ * callback stops the search. Returns the index of the first page not searched.
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSearchPages(JNIEnv *env, jobject thiz,
+                                                    jlong docPtr, jstring query,
+                                                    jboolean matchCase, jboolean matchWholeWord,
+                                                    jint startPage, jint endPage,
+                                                    jobject callback) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:searchPages");
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc || !query || !callback) return startPage;
+
+    jclass callbackClass = env->GetObjectClass(callback);
+    jmethodID onPage = env->GetMethodID(callbackClass, "onPage", "(I[I[I[I[F)Z");
+    env->DeleteLocalRef(callbackClass);
+    if (!onPage) return startPage;
+
+    WideStringArg wQuery(env, query);
+
+    unsigned long flags = 0;
+    if (matchCase) flags |= FPDF_MATCHCASE;
+    if (matchWholeWord) flags |= FPDF_MATCHWHOLEWORD;
+
+    endPage = std::min(endPage, (jint) FPDF_GetPageCount(doc));
+    PageCache *cache = walkCache(doc);
+
+    std::vector<jint> starts, counts, rectOffsets;
+    std::vector<jfloat> rects;
+
+    jint pageIndex = std::max(startPage, 0);
+    for (; pageIndex < endPage; pageIndex++) {
+        starts.clear();
+        counts.clear();
+        rectOffsets.clear();
+        rects.clear();
+
+        {
+            PageTextScope scope(doc, cache, pageIndex);
+            FPDF_TEXTPAGE textPage = scope.textPage;
+            FPDF_SCHHANDLE search = textPage ? FPDFText_FindStart(textPage, wQuery.get(), flags, 0) : nullptr;
+            if (search) {
+                while (FPDFText_FindNext(search)) {
+                    int start = FPDFText_GetSchResultIndex(search);
+                    int count = FPDFText_GetSchCount(search);
+                    starts.push_back(start);
+                    counts.push_back(count);
+                    rectOffsets.push_back((jint) (rects.size() / 4));
+
+                    int rectCount = FPDFText_CountRects(textPage, start, count);
+                    for (int r = 0; r < rectCount; r++) {
+                        double left, top, right, bottom;
+                        if (FPDFText_GetRect(textPage, r, &left, &top, &right, &bottom)) {
+                            rects.push_back((jfloat) left);
+                            rects.push_back((jfloat) top);
+                            rects.push_back((jfloat) right);
+                            rects.push_back((jfloat) bottom);
+                        }
+                    }
+                }
+                rectOffsets.push_back((jint) (rects.size() / 4));
+                FPDFText_FindClose(search);
+            }
+        }
+
+        if (starts.empty()) continue;
+
+        jsize hitCount = (jsize) starts.size();
+        jintArray jStarts = env->NewIntArray(hitCount);
+        jintArray jCounts = env->NewIntArray(hitCount);
+        jintArray jOffsets = env->NewIntArray(hitCount + 1);
+        jfloatArray jRects = env->NewFloatArray((jsize) rects.size());
+        env->SetIntArrayRegion(jStarts, 0, hitCount, starts.data());
+        env->SetIntArrayRegion(jCounts, 0, hitCount, counts.data());
+        env->SetIntArrayRegion(jOffsets, 0, hitCount + 1, rectOffsets.data());
+        env->SetFloatArrayRegion(jRects, 0, (jsize) rects.size(), rects.data());
+
+        jboolean proceed = env->CallBooleanMethod(callback, onPage, pageIndex,
+                                                  jStarts, jCounts, jOffsets, jRects);
+        env->DeleteLocalRef(jStarts);
+        env->DeleteLocalRef(jCounts);
+        env->DeleteLocalRef(jOffsets);
+        env->DeleteLocalRef(jRects);
+
+        if (env->ExceptionCheck() || !proceed) return pageIndex + 1;
+    }
+    return pageIndex;
+}
+
+// ----------------------------------------------------------------------------
+// Text Extraction
+// ----------------------------------------------------------------------------
+
+// UTF-8 output of fd extraction
+static LockedScratch<std::string> g_utf8Scratch;
+
+static void appendUtf8(std::string &out, const unsigned short *text, int length) {
+    for (int i = 0; i < length; i++) {
+        uint32_t c = text[i];
+        if (c >= 0xD800 && c <= 0xDBFF && i + 1 < length && text[i + 1] >= 0xDC00 && text[i + 1] <= 0xDFFF) {
+            c = 0x10000 + ((c - 0xD800) << 10) + (text[++i] - 0xDC00);
+        } else if (c >= 0xD800 && c <= 0xDFFF) {
+            c = 0xFFFD;
+        }
+        if (c < 0x80) {
+            out += (char) c;
+        } else if (c < 0x800) {
+            out += (char) (0xC0 | (c >> 6));
+            out += (char) (0x80 | (c & 0x3F));
+        } else if (c < 0x10000) {
+            out += (char) (0xE0 | (c >> 12));
+            out += (char) (0x80 | ((c >> 6) & 0x3F));
+            out += (char) (0x80 | (c & 0x3F));
+        } else {
+            out += (char) (0xF0 | (c >> 18));
+            out += (char) (0x80 | ((c >> 12) & 0x3F));
+            out += (char) (0x80 | ((c >> 6) & 0x3F));
+            out += (char) (0x80 | (c & 0x3F));
+        }
+    }
+}
+
+static bool writeFully(int fd, const char *data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= (size_t) written;
+    }
+    return true;
+}
+
+/**
+ * Extract the text of a range of pages with one JNI call.
+ *
+ * Pages walk through the page cache like nativeSearchPages, and text is read
+ * into one reused buffer. With outFd >= 0, each page is written to the fd as
+ * UTF-8 followed by a form feed; otherwise the callback's
+ * onPage(int, String) receives each page and can return false to stop.
+ * Returns the index of the first page not extracted.
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeExtractText(JNIEnv *env, jobject thiz,
+                                                    jlong docPtr, jint startPage, jint endPage,
+                                                    jint outFd, jobject callback) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:extractText");
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc || (outFd < 0 && !callback)) return startPage;
+
+    jmethodID onPage = nullptr;
+    if (outFd < 0) {
+        jclass callbackClass = env->GetObjectClass(callback);
+        onPage = env->GetMethodID(callbackClass, "onPage", "(ILjava/lang/String;)Z");
+        env->DeleteLocalRef(callbackClass);
+        if (!onPage) return startPage;
+    }
+
+    endPage = std::min(endPage, (jint) FPDF_GetPageCount(doc));
+    PageCache *cache = walkCache(doc);
+
+    jint pageIndex = std::max(startPage, 0);
+    for (; pageIndex < endPage; pageIndex++) {
+        int length = 0;
+        {
+            PageTextScope scope(doc, cache, pageIndex);
+            if (scope.textPage) {
+                length = readTextToScratch(scope.textPage, 0, FPDFText_CountChars(scope.textPage));
+            }
+        }
+
+        if (outFd >= 0) {
+            std::string &utf8 = g_utf8Scratch.get();
+            utf8.clear();
+            appendUtf8(utf8, g_textScratch.data(), length);
+            utf8 += '\f';
+            if (!writeFully(outFd, utf8.data(), utf8.size())) return pageIndex;
+            continue;
+        }
+
+        jstring text = length > 0 ? env->NewString((const jchar*) g_textScratch.data(), length)
+                                  : env->NewStringUTF("");
+        if (!text) return pageIndex;
+        jboolean proceed = env->CallBooleanMethod(callback, onPage, pageIndex, text);
+        env->DeleteLocalRef(text);
+        if (env->ExceptionCheck() || !proceed) return pageIndex + 1;
+    }
+    return pageIndex;
+}
+
+// ----------------------------------------------------------------------------
+// Form Data Snapshot
+// ----------------------------------------------------------------------------
+
+/**
+ * Little-endian writer for the packed form snapshot.
+ */
+struct SnapshotWriter {
+    std::vector<uint8_t> bytes;
+
+    void putInt(int32_t value) {
+        for (int i = 0; i < 4; i++) bytes.push_back((uint8_t) ((uint32_t) value >> (i * 8)));
+    }
+
+    // UTF-16 units as returned by PDFium, without the terminator
+    void putString(const unsigned short *chars, int length) {
+        putInt(length);
+        for (int i = 0; i < length; i++) {
+            bytes.push_back((uint8_t) chars[i]);
+            bytes.push_back((uint8_t) (chars[i] >> 8));
+        }
+    }
+
+    void putFloat(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        putInt((int32_t) bits);
+    }
+};
+
+/**
+ * Little-endian reader for the packed form import data. Reads past the end
+ * fail and leave the reader in a failed state.
+ */
+struct SnapshotReader {
+    const uint8_t *data;
+    size_t size;
+    size_t offset = 0;
+    bool failed = false;
+
+    int32_t getInt() {
+        if (offset + 4 > size) { failed = true; return 0; }
+        uint32_t value = 0;
+        for (int i = 0; i < 4; i++) value |= (uint32_t) data[offset + i] << (i * 8);
+        offset += 4;
+        return (int32_t) value;
+    }
+
+    float getFloat() {
+        uint32_t bits = (uint32_t) getInt();
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::u16string getString() {
+        int32_t length = getInt();
+        if (failed || length < 0 || offset + (size_t) length * 2 > size) { failed = true; return {}; }
+        std::u16string value(length, u'\0');
+        for (int32_t i = 0; i < length; i++) {
+            value[i] = (char16_t) (data[offset + i * 2] | (data[offset + i * 2 + 1] << 8));
+        }
+        offset += (size_t) length * 2;
+        return value;
+    }
+};
+
+// Reads a PDFium UTF-16 string through a (buffer, byte length) getter into g_textScratch
+static int readWideToScratch(const std::function<unsigned long(FPDF_WCHAR*, unsigned long)> &getter) {
+    unsigned long bytes = getter(nullptr, 0);
+    if (bytes <= 2) return 0;
+    g_textScratch.reserve(bytes / 2);
+    getter((FPDF_WCHAR*) g_textScratch.data(), bytes);
+    return (int) (bytes / 2) - 1;
+}
+
+static bool isWidget(FPDF_ANNOTATION annot) {
+    FPDF_ANNOTATION_SUBTYPE subtype = FPDFAnnot_GetSubtype(annot);
+    return subtype == FPDF_ANNOT_WIDGET || subtype == FPDF_ANNOT_XFAWIDGET;
+}
+
+static std::u16string readFieldName(FPDF_FORMHANDLE form, FPDF_ANNOTATION annot) {
+    int length = readWideToScratch([&](FPDF_WCHAR *buffer, unsigned long bytes) {
+        return FPDFAnnot_GetFormFieldName(form, annot, buffer, bytes);
+    });
+    return std::u16string((const char16_t*) g_textScratch.data(), length);
+}
+
+// One field record: int type, int flags, int maxLength, string name, string value,
+// int optionCount and per option string label plus int selected
+static void writeFieldRecord(SnapshotWriter &out, FPDF_FORMHANDLE form, FPDF_ANNOTATION annot) {
+    int type = FPDFAnnot_GetFormFieldType(form, annot);
+    out.putInt(type);
+    out.putInt(FPDFAnnot_GetFormFieldFlags(form, annot));
+    out.putInt(FPDFAnnot_GetFormFieldMaxLen(form, annot));
+
+    int length = readWideToScratch([&](FPDF_WCHAR *buffer, unsigned long bytes) {
+        return FPDFAnnot_GetFormFieldName(form, annot, buffer, bytes);
+    });
+    out.putString(g_textScratch.data(), length);
+    length = readWideToScratch([&](FPDF_WCHAR *buffer, unsigned long bytes) {
+        return FPDFAnnot_GetFormFieldValue(form, annot, buffer, bytes);
+    });
+    out.putString(g_textScratch.data(), length);
+
+    bool hasOptions = type == FPDF_FORMFIELD_COMBOBOX || type == FPDF_FORMFIELD_LISTBOX;
+    int optionCount = hasOptions ? std::max(FPDFAnnot_GetOptionCount(form, annot), 0) : 0;
+    out.putInt(optionCount);
+    for (int o = 0; o < optionCount; o++) {
+        length = readWideToScratch([&](FPDF_WCHAR *buffer, unsigned long bytes) {
+            return FPDFAnnot_GetOptionLabel(form, annot, o, buffer, bytes);
+        });
+        out.putString(g_textScratch.data(), length);
+        out.putInt(FPDFAnnot_IsOptionSelected(form, annot, o) ? 1 : 0);
+    }
+}
+
+static jbyteArray toByteArray(JNIEnv *env, const std::vector<uint8_t> &bytes) {
+    jbyteArray result = env->NewByteArray((jsize) bytes.size());
+    if (result) env->SetByteArrayRegion(result, 0, (jsize) bytes.size(), (const jbyte*) bytes.data());
+    return result;
+}
+
+/**
+ * Snapshot every form field in the document with one page walk.
+ *
+ * Layout (little-endian): int formType, int fieldCount, then per field
+ * int type, int flags, int maxLength, string name, string value, int optionCount and per option string label
+ * plus int selected. Strings are an int UTF-16 length followed by the units.
+ * Only widget annotations are included.
+ */
+JNIEXPORT jbyteArray JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeExportFormData(JNIEnv *env, jobject thiz,
+                                                       jlong formPtr, jlong docPtr) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:exportFormData");
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!form || !doc) return nullptr;
+
+    SnapshotWriter out;
+    out.putInt(FPDF_GetFormType(doc));
+    out.putInt(0);    // field count, patched below
+    int fieldCount = 0;
+
+    PageCache *cache = walkCache(doc);
+    int pageCount = FPDF_GetPageCount(doc);
+    for (int pageIndex = 0; pageIndex < pageCount; pageIndex++) {
+        PageScope scope(doc, cache, pageIndex);
+        if (!scope.page) continue;
+
+        int annotCount = FPDFPage_GetAnnotCount(scope.page);
+        for (int a = 0; a < annotCount; a++) {
+            FPDF_ANNOTATION annot = FPDFPage_GetAnnot(scope.page, a);
+            if (!annot) continue;
+            if (!isWidget(annot)) {
+                FPDFPage_CloseAnnot(annot);
+                continue;
+            }
+
+            writeFieldRecord(out, form, annot);
+            FPDFPage_CloseAnnot(annot);
+            fieldCount++;
+        }
+    }
+
+    for (int i = 0; i < 4; i++) out.bytes[4 + i] = (uint8_t) ((uint32_t) fieldCount >> (i * 8));
+    return toByteArray(env, out.bytes);
+}
+
+/**
+ * Apply field values to every widget in the document with one page walk.
+ *
+ * Layout (little-endian): int entryCount, then per entry string name,
+ * string value, int optionCount and per option int index plus int selected.
+ * A widget takes the entry with its fully qualified name; option selections
+ * apply to combo and list boxes only. Returns the number of widgets updated,
+ * or -1 if the data is malformed.
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeImportFormData(JNIEnv *env, jobject thiz,
+                                                       jlong formPtr, jlong docPtr,
+                                                       jbyteArray data) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:importFormData");
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!form || !doc || !data) return -1;
+
+    struct Entry {
+        std::u16string value;
+        std::vector<std::pair<int, bool>> options;
+    };
+
+    std::vector<uint8_t> bytes(env->GetArrayLength(data));
+    env->GetByteArrayRegion(data, 0, (jsize) bytes.size(), (jbyte*) bytes.data());
+    SnapshotReader in{bytes.data(), bytes.size()};
+
+    std::map<std::u16string, Entry> entries;
+    int entryCount = in.getInt();
+    for (int i = 0; i < entryCount && !in.failed; i++) {
+        std::u16string name = in.getString();
+        Entry entry;
+        entry.value = in.getString();
+        int optionCount = in.getInt();
+        for (int o = 0; o < optionCount && !in.failed; o++) {
+            int index = in.getInt();
+            entry.options.emplace_back(index, in.getInt() != 0);
+        }
+        entries.emplace(std::move(name), std::move(entry));    // first entry for a name wins
+    }
+    if (in.failed || entryCount < 0) return -1;
+    if (entries.empty()) return 0;
+
+    int updated = 0;
+    PageCache *cache = walkCache(doc);
+    int pageCount = FPDF_GetPageCount(doc);
+    for (int pageIndex = 0; pageIndex < pageCount; pageIndex++) {
+        PageScope scope(doc, cache, pageIndex);
+        if (!scope.page) continue;
+
+        bool pageEdited = false;
+        int annotCount = FPDFPage_GetAnnotCount(scope.page);
+        for (int a = 0; a < annotCount; a++) {
+            FPDF_ANNOTATION annot = FPDFPage_GetAnnot(scope.page, a);
+            if (!annot) continue;
+            if (isWidget(annot)) {
+                auto it = entries.find(readFieldName(form, annot));
+                if (it != entries.end()) {
+                    FPDFAnnot_SetStringValue(annot, "V", (FPDF_WIDESTRING) it->second.value.c_str());
+                    int type = FPDFAnnot_GetFormFieldType(form, annot);
+                    if (type == FPDF_FORMFIELD_COMBOBOX || type == FPDF_FORMFIELD_LISTBOX) {
+                        for (const auto &option : it->second.options) {
+                            FPDFAnnot_SetOptionSelected(form, annot, option.first, option.second ? 1 : 0);
+                        }
+                    }
+                    pageEdited = true;
+                    updated++;
+                }
+            }
+            FPDFPage_CloseAnnot(annot);
+        }
+        if (pageEdited) markPageEdited(scope.page);
+    }
+    return updated;
+}
+
+// ----------------------------------------------------------------------------
+// Form Field Index
+// ----------------------------------------------------------------------------
+
+static uint32_t pageRevision(const DocumentRevisions &revisions, int pageIndex) {
+    auto it = revisions.pages.find(pageIndex);
+    return it != revisions.pages.end() ? it->second : 0;
+}
+
+/**
+ * (Re)index the widgets of one page. They are inserted at their document
+ * position, so a field's widgets stay in page order when a page in the
+ * middle is re-indexed.
+ */
+static void indexFormPage(FormFieldIndex &index, FPDF_FORMHANDLE form, FPDF_DOCUMENT doc,
+                          PageCache *cache, int pageIndex) {
+    for (const auto &name : index.pageNames[pageIndex]) {
+        auto it = index.fields.find(name);
+        if (it == index.fields.end()) continue;
+        auto &widgets = it->second;
+        widgets.erase(std::remove_if(widgets.begin(), widgets.end(),
+                                     [pageIndex](const FieldWidget &w) { return w.page == pageIndex; }),
+                      widgets.end());
+        if (widgets.empty()) index.fields.erase(it);
+    }
+    std::vector<std::u16string> &names = index.pageNames[pageIndex];
+    names.clear();
+    index.pageRevisions[pageIndex] = pageRevision(getDocumentRevisions(doc), pageIndex);
+
+    PageScope scope(doc, cache, pageIndex);
+    if (!scope.page) return;
+    int annotCount = FPDFPage_GetAnnotCount(scope.page);
+    for (int a = 0; a < annotCount; a++) {
+        FPDF_ANNOTATION annot = FPDFPage_GetAnnot(scope.page, a);
+        if (!annot) continue;
+        if (isWidget(annot)) {
+            std::u16string name = readFieldName(form, annot);
+            auto &widgets = index.fields[name];
+            FieldWidget widget = {pageIndex, a};
+            auto pos = std::lower_bound(widgets.begin(), widgets.end(), widget,
+                                        [](const FieldWidget &l, const FieldWidget &r) {
+                                            return l.page != r.page ? l.page < r.page : l.annot < r.annot;
+                                        });
+            // Widgets of this page come in annot order, so an earlier one sits just before
+            if (pos == widgets.begin() || (pos - 1)->page != pageIndex) names.push_back(name);
+            widgets.insert(pos, widget);
+        }
+        FPDFPage_CloseAnnot(annot);
+    }
+}
+
+static FormFieldIndex &getFormFieldIndex(FPDF_FORMHANDLE form, FPDF_DOCUMENT doc) {
+    FormFieldIndex &index = g_formFieldIndexes[doc];
+    const DocumentRevisions &revisions = getDocumentRevisions(doc);
+    PageCache *cache = walkCache(doc);
+
+    if (!index.built || index.structure != revisions.structure) {
+        index = FormFieldIndex();
+        int pageCount = FPDF_GetPageCount(doc);
+        for (int pageIndex = 0; pageIndex < pageCount; pageIndex++) {
+            indexFormPage(index, form, doc, cache, pageIndex);
+        }
+        index.built = true;
+        index.structure = revisions.structure;
+        return index;
+    }
+
+    // Only pages that were edited since they were indexed
+    std::vector<int> stale;
+    for (const auto &pair : revisions.pages) {
+        if (pair.second != index.pageRevisions[pair.first]) stale.push_back(pair.first);
+    }
+    for (int pageIndex : stale) indexFormPage(index, form, doc, cache, pageIndex);
+    return index;
+}
+
+static std::u16string toU16String(JNIEnv *env, jstring value) {
+    jsize length = env->GetStringLength(value);
+    std::u16string result(length, u'\0');
+    env->GetStringRegion(value, 0, length, (jchar*) &result[0]);
+    return result;
+}
+
+/**
+ * Pages and annotation indices of the widgets of a field, packed as
+ * page/annot pairs, or null if no widget has that name.
+ */
+JNIEXPORT jintArray JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeFindFormField(JNIEnv *env, jobject thiz,
+                                                      jlong formPtr, jlong docPtr, jstring name) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!form || !doc || !name) return nullptr;
+
+    FormFieldIndex &index = getFormFieldIndex(form, doc);
+    auto it = index.fields.find(toU16String(env, name));
+    if (it == index.fields.end()) return nullptr;
+
+    std::vector<jint> packed;
+    for (const auto &widget : it->second) {
+        packed.push_back(widget.page);
+        packed.push_back(widget.annot);
+    }
+    jintArray result = env->NewIntArray((jsize) packed.size());
+    if (result) env->SetIntArrayRegion(result, 0, (jsize) packed.size(), packed.data());
+    return result;
+}
+
+/**
+ * One field record (see writeFieldRecord) for the first widget of a field,
+ * or null if no widget has that name.
+ */
+JNIEXPORT jbyteArray JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetFormFieldDataByName(JNIEnv *env, jobject thiz,
+                                                               jlong formPtr, jlong docPtr, jstring name) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!form || !doc || !name) return nullptr;
+
+    FormFieldIndex &index = getFormFieldIndex(form, doc);
+    auto it = index.fields.find(toU16String(env, name));
+    if (it == index.fields.end()) return nullptr;
+
+    const FieldWidget &widget = it->second.front();
+    PageScope scope(doc, walkCache(doc), widget.page);
+    FPDF_ANNOTATION annot = scope.page ? FPDFPage_GetAnnot(scope.page, widget.annot) : nullptr;
+    if (!annot) return nullptr;
+
+    SnapshotWriter out;
+    writeFieldRecord(out, form, annot);
+    FPDFPage_CloseAnnot(annot);
+    return toByteArray(env, out.bytes);
+}
+
+/**
+ * Set the value of every widget of a field. Returns the number of widgets
+ * updated.
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeSetFormFieldValueByName(JNIEnv *env, jobject thiz,
+                                                                jlong formPtr, jlong docPtr,
+                                                                jstring name, jstring value) {
+    PdfiumLock lock;
+    FPDF_FORMHANDLE form = (FPDF_FORMHANDLE) formPtr;
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!form || !doc || !name || !value) return 0;
+
+    FormFieldIndex &index = getFormFieldIndex(form, doc);
+    auto it = index.fields.find(toU16String(env, name));
+    if (it == index.fields.end()) return 0;
+
+    std::u16string wValue = toU16String(env, value);
+    PageCache *cache = walkCache(doc);
+    // Copied, since the edits below make the next lookup re-index these pages
+    std::vector<FieldWidget> widgets = it->second;
+    int updated = 0;
+    for (const auto &widget : widgets) {
+        PageScope scope(doc, cache, widget.page);
+        FPDF_ANNOTATION annot = scope.page ? FPDFPage_GetAnnot(scope.page, widget.annot) : nullptr;
+        if (!annot) continue;
+        if (FPDFAnnot_SetStringValue(annot, "V", (FPDF_WIDESTRING) wValue.c_str())) updated++;
+        FPDFPage_CloseAnnot(annot);
+        markPageEdited(scope.page);
+    }
+    return updated;
+}
+
+// ----------------------------------------------------------------------------
+// Annotation Batch Read
+// ----------------------------------------------------------------------------
+
+// Property groups, matching AnnotationBatchReader on the Kotlin side
+static const int ANNOT_FIELD_RECT = 1 << 0;
+static const int ANNOT_FIELD_COLOR = 1 << 1;
+static const int ANNOT_FIELD_INTERIOR_COLOR = 1 << 2;
+static const int ANNOT_FIELD_FLAGS = 1 << 3;
+static const int ANNOT_FIELD_OPACITY = 1 << 4;
+static const int ANNOT_FIELD_CONTENTS = 1 << 5;
+static const int ANNOT_FIELD_AUTHOR = 1 << 6;
+static const int ANNOT_FIELD_SUBJECT = 1 << 7;
+static const int ANNOT_FIELD_DATES = 1 << 8;
+static const int ANNOT_FIELD_QUAD_POINTS = 1 << 9;
+static const int ANNOT_FIELD_INK_LIST = 1 << 10;
+
+static void writeAnnotString(SnapshotWriter &out, FPDF_ANNOTATION annot, const char *key) {
+    int length = readWideToScratch([&](FPDF_WCHAR *buffer, unsigned long bytes) {
+        return FPDFAnnot_GetStringValue(annot, key, buffer, bytes);
+    });
+    out.putString(g_textScratch.data(), length);
+}
+
+// int present, then r, g, b, a
+static void writeAnnotColor(SnapshotWriter &out, FPDF_ANNOTATION annot, FPDFANNOT_COLORTYPE type) {
+    unsigned int r, g, b, a;
+    bool present = FPDFAnnot_GetColor(annot, type, &r, &g, &b, &a);
+    out.putInt(present ? 1 : 0);
+    if (!present) return;
+    out.putInt(r); out.putInt(g); out.putInt(b); out.putInt(a);
+}
+
+/**
+ * Every annotation of a page in one call: int count, int mask, then per
+ * annotation int subtype followed by the groups selected in mask, in bit order.
+ * Strings are an int UTF-16 length plus the units, quad points an int count
+ * plus 8 floats each, the ink list an int stroke count plus per stroke an int
+ * point count and x/y floats.
+ */
+JNIEXPORT jbyteArray JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetAllAnnotations(JNIEnv *env, jobject thiz,
+                                                          jlong pagePtr, jint mask) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:GetAllAnnotations");
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page) return nullptr;
+
+    int count = std::max(FPDFPage_GetAnnotCount(page), 0);
+    SnapshotWriter out;
+    out.putInt(count);
+    out.putInt(mask);
+
+    for (int i = 0; i < count; i++) {
+        FPDF_ANNOTATION annot = FPDFPage_GetAnnot(page, i);
+        // Keep indices aligned with FPDFPage_GetAnnot even if one fails to load
+        out.putInt(annot ? FPDFAnnot_GetSubtype(annot) : FPDF_ANNOT_UNKNOWN);
+
+        if (mask & ANNOT_FIELD_RECT) {
+            FS_RECTF rect = {0, 0, 0, 0};
+            if (annot) FPDFAnnot_GetRect(annot, &rect);
+            out.putFloat(rect.left);
+            out.putFloat(rect.top);
+            out.putFloat(rect.right);
+            out.putFloat(rect.bottom);
+        }
+        if (!annot) {
+            // Absent groups decode as empty values
+            for (int bit = ANNOT_FIELD_COLOR; bit <= ANNOT_FIELD_INK_LIST; bit <<= 1) {
+                if (!(mask & bit)) continue;
+                if (bit == ANNOT_FIELD_OPACITY) out.putFloat(1.0f);
+                else if (bit == ANNOT_FIELD_DATES) { out.putInt(0); out.putInt(0); }
+                else out.putInt(0);
+            }
+            continue;
+        }
+
+        if (mask & ANNOT_FIELD_COLOR) writeAnnotColor(out, annot, FPDFANNOT_COLORTYPE_Color);
+        if (mask & ANNOT_FIELD_INTERIOR_COLOR) writeAnnotColor(out, annot, FPDFANNOT_COLORTYPE_InteriorColor);
+        if (mask & ANNOT_FIELD_FLAGS) out.putInt(FPDFAnnot_GetFlags(annot));
+        if (mask & ANNOT_FIELD_OPACITY) {
+            float opacity;
+            out.putFloat(FPDFAnnot_GetNumberValue(annot, "CA", &opacity) ? opacity : 1.0f);
+        }
+        if (mask & ANNOT_FIELD_CONTENTS) writeAnnotString(out, annot, "Contents");
+        if (mask & ANNOT_FIELD_AUTHOR) writeAnnotString(out, annot, "T");
+        if (mask & ANNOT_FIELD_SUBJECT) writeAnnotString(out, annot, "Subj");
+        if (mask & ANNOT_FIELD_DATES) {
+            writeAnnotString(out, annot, "CreationDate");
+            writeAnnotString(out, annot, "M");
+        }
+        if (mask & ANNOT_FIELD_QUAD_POINTS) {
+            int quadCount = FPDFAnnot_HasAttachmentPoints(annot)
+                    ? (int) FPDFAnnot_CountAttachmentPoints(annot) : 0;
+            out.putInt(quadCount);
+            for (int q = 0; q < quadCount; q++) {
+                FS_QUADPOINTSF quad = {0, 0, 0, 0, 0, 0, 0, 0};
+                FPDFAnnot_GetAttachmentPoints(annot, q, &quad);
+                out.putFloat(quad.x1); out.putFloat(quad.y1);
+                out.putFloat(quad.x2); out.putFloat(quad.y2);
+                out.putFloat(quad.x3); out.putFloat(quad.y3);
+                out.putFloat(quad.x4); out.putFloat(quad.y4);
+            }
+        }
+        if (mask & ANNOT_FIELD_INK_LIST) {
+            int strokeCount = (int) FPDFAnnot_GetInkListCount(annot);
+            out.putInt(strokeCount);
+            for (int stroke = 0; stroke < strokeCount; stroke++) {
+                unsigned long pointCount = FPDFAnnot_GetInkListPath(annot, stroke, nullptr, 0);
+                g_inkScratch.reserve(pointCount);
+                if (pointCount > 0) FPDFAnnot_GetInkListPath(annot, stroke, g_inkScratch.data(), pointCount);
+                out.putInt((int) pointCount);
+                for (unsigned long p = 0; p < pointCount; p++) {
+                    out.putFloat(g_inkScratch[p].x);
+                    out.putFloat(g_inkScratch[p].y);
+                }
+            }
+        }
+        FPDFPage_CloseAnnot(annot);
+    }
+    return toByteArray(env, out.bytes);
+}
+
+// ----------------------------------------------------------------------------
+// Annotation Transactions
+// ----------------------------------------------------------------------------
+
+static const int ANNOT_OP_CREATE = 0;
+static const int ANNOT_OP_UPDATE = 1;
+static const int ANNOT_OP_REMOVE = 2;
+
+// Which annotations of a batch get their appearance streams reset
+static const int ANNOT_APPEARANCE_CREATED = 1 << 0;
+static const int ANNOT_APPEARANCE_UPDATED = 1 << 1;
+
+// Fields whose change makes an existing appearance stream wrong
+static const int ANNOT_APPEARANCE_FIELDS = ANNOT_FIELD_RECT | ANNOT_FIELD_COLOR |
+                                           ANNOT_FIELD_INTERIOR_COLOR | ANNOT_FIELD_OPACITY |
+                                           ANNOT_FIELD_QUAD_POINTS | ANNOT_FIELD_INK_LIST;
+
+/**
+ * Whether PDFium draws annot from its properties once /AP is removed. Other
+ * subtypes would be left without an appearance.
+ */
+static bool regeneratesAppearance(FPDF_ANNOTATION annot) {
+    switch (FPDFAnnot_GetSubtype(annot)) {
+        case FPDF_ANNOT_SQUARE:
+        case FPDF_ANNOT_CIRCLE:
+        case FPDF_ANNOT_LINE:
+        case FPDF_ANNOT_INK:
+        case FPDF_ANNOT_HIGHLIGHT:
+        case FPDF_ANNOT_UNDERLINE:
+        case FPDF_ANNOT_STRIKEOUT:
+        case FPDF_ANNOT_SQUIGGLY:
+        case FPDF_ANNOT_TEXT:
+        case FPDF_ANNOT_POPUP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void setAnnotString(FPDF_ANNOTATION annot, const char *key, const std::u16string &value) {
+    FPDFAnnot_SetStringValue(annot, key, (FPDF_WIDESTRING) value.c_str());
+}
+
+static void readAnnotColor(SnapshotReader &in, FPDF_ANNOTATION annot, FPDFANNOT_COLORTYPE type) {
+    int r = in.getInt(), g = in.getInt(), b = in.getInt(), a = in.getInt();
+    if (annot && !in.failed) FPDFAnnot_SetColor(annot, type, r, g, b, a);
+}
+
+/**
+ * Applies the property groups of one operation, laid out like a record of
+ * nativeGetAllAnnotations but with colors always present. Returns false if
+ * the data ran out. A null annot only skips over the fields.
+ */
+static bool applyAnnotFields(SnapshotReader &in, FPDF_ANNOTATION annot, int fields) {
+    if (fields & ANNOT_FIELD_RECT) {
+        FS_RECTF rect;
+        rect.left = in.getFloat();
+        rect.top = in.getFloat();
+        rect.right = in.getFloat();
+        rect.bottom = in.getFloat();
+        if (annot && !in.failed) FPDFAnnot_SetRect(annot, &rect);
+    }
+    if (fields & ANNOT_FIELD_COLOR) readAnnotColor(in, annot, FPDFANNOT_COLORTYPE_Color);
+    if (fields & ANNOT_FIELD_INTERIOR_COLOR) readAnnotColor(in, annot, FPDFANNOT_COLORTYPE_InteriorColor);
+    if (fields & ANNOT_FIELD_FLAGS) {
+        int flags = in.getInt();
+        if (annot && !in.failed) FPDFAnnot_SetFlags(annot, flags);
+    }
+    if (fields & ANNOT_FIELD_OPACITY) {
+        float opacity = in.getFloat();
+        opacity = opacity < 0.0f ? 0.0f : (opacity > 1.0f ? 1.0f : opacity);
+        if (annot && !in.failed) FPDFAnnot_SetNumberValue(annot, "CA", opacity);
+    }
+    if (fields & ANNOT_FIELD_CONTENTS) setAnnotString(annot, "Contents", in.getString());
+    if (fields & ANNOT_FIELD_AUTHOR) setAnnotString(annot, "T", in.getString());
+    if (fields & ANNOT_FIELD_SUBJECT) setAnnotString(annot, "Subj", in.getString());
+    if (fields & ANNOT_FIELD_DATES) {
+        // Empty dates leave the existing entry alone
+        std::u16string created = in.getString();
+        std::u16string modified = in.getString();
+        if (!created.empty()) setAnnotString(annot, "CreationDate", created);
+        if (!modified.empty()) setAnnotString(annot, "M", modified);
+    }
+    if (fields & ANNOT_FIELD_QUAD_POINTS) {
+        int quadCount = in.getInt();
+        if (in.failed || quadCount < 0) return false;
+        // There's no call to drop quad points, so existing ones are overwritten in place
+        size_t existing = annot ? FPDFAnnot_CountAttachmentPoints(annot) : 0;
+        for (int q = 0; q < quadCount; q++) {
+            FS_QUADPOINTSF quad;
+            quad.x1 = in.getFloat(); quad.y1 = in.getFloat();
+            quad.x2 = in.getFloat(); quad.y2 = in.getFloat();
+            quad.x3 = in.getFloat(); quad.y3 = in.getFloat();
+            quad.x4 = in.getFloat(); quad.y4 = in.getFloat();
+            if (in.failed) return false;
+            if (!annot) continue;
+            if ((size_t) q < existing) FPDFAnnot_SetAttachmentPoints(annot, q, &quad);
+            else FPDFAnnot_AppendAttachmentPoints(annot, &quad);
+        }
+    }
+    if (fields & ANNOT_FIELD_INK_LIST) {
+        int strokeCount = in.getInt();
+        if (in.failed || strokeCount < 0) return false;
+        if (annot) FPDFAnnot_RemoveInkList(annot);
+        for (int stroke = 0; stroke < strokeCount; stroke++) {
+            int pointCount = in.getInt();
+            if (in.failed || pointCount < 0 || in.offset + (size_t) pointCount * 8 > in.size) return false;
+            g_inkScratch.reserve(pointCount);
+            for (int p = 0; p < pointCount; p++) {
+                g_inkScratch[p].x = in.getFloat();
+                g_inkScratch[p].y = in.getFloat();
+            }
+            if (annot && pointCount > 0) FPDFAnnot_AddInkStroke(annot, g_inkScratch.data(), pointCount);
+        }
+    }
+    return !in.failed;
+}
+
+/**
+ * Applies a queued batch of annotation edits in order: int opCount, then per
+ * operation int kind, int subtype (create) or annotation index (update and
+ * remove), int fields and the property groups selected in fields. At the end
+ * the appearance streams selected by appearanceFlags are reset once so PDFium
+ * regenerates them: created annotations for ANNOT_APPEARANCE_CREATED, and
+ * updated ones whose geometry or color changed for ANNOT_APPEARANCE_UPDATED.
+ * Only subtypes PDFium can redraw are reset. Returns the operations applied,
+ * or -1 if the data is malformed; operations before the malformed one stay
+ * applied.
+ */
+JNIEXPORT jint JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeApplyAnnotationEdits(JNIEnv *env, jobject thiz,
+                                                             jlong pagePtr, jbyteArray data,
+                                                             jint appearanceFlags) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:ApplyAnnotationEdits");
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!page || !data) return -1;
+
+    jsize size = env->GetArrayLength(data);
+    std::vector<uint8_t> bytes(size);
+    env->GetByteArrayRegion(data, 0, size, (jbyte*) bytes.data());
+    SnapshotReader in{bytes.data(), bytes.size()};
+
+    int opCount = in.getInt();
+    if (in.failed || opCount < 0) return -1;
+
+    // Created and updated annotations stay open until the end of the pass so
+    // their appearance streams are reset once, after all of their edits
+    std::vector<std::pair<FPDF_ANNOTATION, bool>> touched;
+    int applied = 0;
+    bool malformed = false;
+    for (int op = 0; op < opCount && !malformed; op++) {
+        int kind = in.getInt();
+        int target = in.getInt();
+        int fields = in.getInt();
+        if (in.failed) { malformed = true; break; }
+
+        if (kind == ANNOT_OP_REMOVE) {
+            if (FPDFPage_RemoveAnnot(page, target)) applied++;
+            continue;
+        }
+        FPDF_ANNOTATION annot = nullptr;
+        if (kind == ANNOT_OP_CREATE) annot = FPDFPage_CreateAnnot(page, target);
+        else if (kind == ANNOT_OP_UPDATE) annot = FPDFPage_GetAnnot(page, target);
+        else { malformed = true; break; }
+
+        // An operation that can't be applied still consumes its fields
+        malformed = !applyAnnotFields(in, annot, fields);
+        if (!annot) continue;
+        if (!malformed) applied++;
+        bool reset = kind == ANNOT_OP_CREATE
+                ? (appearanceFlags & ANNOT_APPEARANCE_CREATED) != 0
+                : (appearanceFlags & ANNOT_APPEARANCE_UPDATED) && (fields & ANNOT_APPEARANCE_FIELDS);
+        touched.emplace_back(annot, reset);
+    }
+
+    for (const auto &entry : touched) {
+        if (entry.second && !malformed && regeneratesAppearance(entry.first)) {
+            FPDFAnnot_SetAP(entry.first, FPDF_ANNOT_APPEARANCEMODE_NORMAL, nullptr);
+        }
+        FPDFPage_CloseAnnot(entry.first);
+    }
+    if (applied > 0) markPageEdited(page);
+    return malformed ? -1 : applied;
+}
+
+// ----------------------------------------------------------------------------
+// Thumbnails
+// ----------------------------------------------------------------------------
+
+enum {
+    THUMBNAIL_FAILED = 0,
+    THUMBNAIL_EMBEDDED = 1,
+    THUMBNAIL_RENDERED = 2
+};
+
+/**
+ * Scale a thumbnail image into a 32bpp target by averaging the source pixels
+ * under each target pixel. The source may be Gray, BGR, BGRx or BGRA; the
+ * target is RGBA when rgba is set (unconverted Android bitmaps) and BGRx
+ * otherwise.
+ */
+static bool scaleThumbnail(FPDF_BITMAP source, FPDF_BITMAP target, bool rgba) {
+    int srcWidth = FPDFBitmap_GetWidth(source);
+    int srcHeight = FPDFBitmap_GetHeight(source);
+    int srcStride = FPDFBitmap_GetStride(source);
+    int format = FPDFBitmap_GetFormat(source);
+    const uint8_t *src = (const uint8_t*) FPDFBitmap_GetBuffer(source);
+    int dstWidth = FPDFBitmap_GetWidth(target);
+    int dstHeight = FPDFBitmap_GetHeight(target);
+    int dstStride = FPDFBitmap_GetStride(target);
+    uint8_t *dst = (uint8_t*) FPDFBitmap_GetBuffer(target);
+    if (!src || !dst || srcWidth <= 0 || srcHeight <= 0) return false;
+
+    int bpp;
+    switch (format) {
+        case FPDFBitmap_Gray: bpp = 1; break;
+        case FPDFBitmap_BGR: bpp = 3; break;
+        case FPDFBitmap_BGRx:
+        case FPDFBitmap_BGRA: bpp = 4; break;
+        default: return false;
+    }
+
+    for (int y = 0; y < dstHeight; y++) {
+        int y0 = (int) ((int64_t) y * srcHeight / dstHeight);
+        int y1 = std::max(y0 + 1, (int) ((int64_t) (y + 1) * srcHeight / dstHeight));
+        uint8_t *out = dst + (size_t) y * dstStride;
+        for (int x = 0; x < dstWidth; x++) {
+            int x0 = (int) ((int64_t) x * srcWidth / dstWidth);
+            int x1 = std::max(x0 + 1, (int) ((int64_t) (x + 1) * srcWidth / dstWidth));
+            uint32_t b = 0, g = 0, r = 0;
+            for (int sy = y0; sy < y1; sy++) {
+                const uint8_t *p = src + (size_t) sy * srcStride + (size_t) x0 * bpp;
+                for (int sx = x0; sx < x1; sx++, p += bpp) {
+                    if (bpp == 1) {
+                        b += p[0]; g += p[0]; r += p[0];
+                    } else {
+                        b += p[0]; g += p[1]; r += p[2];
+                    }
+                }
+            }
+            uint32_t n = (uint32_t) ((y1 - y0) * (x1 - x0));
+            uint8_t *px = out + (size_t) x * 4;
+            px[0] = (uint8_t) ((rgba ? r : b) / n);
+            px[1] = (uint8_t) (g / n);
+            px[2] = (uint8_t) ((rgba ? b : r) / n);
+            px[3] = 0xFF;
+        }
+    }
+    return true;
+}
+
+/**
+ * Fill thumbnail bitmaps for a batch of pages with one JNI call.
+ *
+ * For each page the embedded /Thumb image is used when preferEmbedded is set
+ * and the page has one, scaled into the bitmap; otherwise the page is rendered
+ * without annotations or form fields. Bitmaps may be RGBA_8888, RGB_565 or
+ * A_8. Pages are loaded outside the page cache so a thumbnail strip doesn't
+ * evict the pages being viewed. sources receives THUMBNAIL_EMBEDDED,
+ * THUMBNAIL_RENDERED or THUMBNAIL_FAILED per page.
+ */
+JNIEXPORT void JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeRenderThumbnails(JNIEnv *env, jobject thiz,
+                                                         jlong docPtr, jintArray pages,
+                                                         jobjectArray bitmaps,
+                                                         jboolean preferEmbedded,
+                                                         jintArray sources) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:renderThumbnails");
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc || !pages || !bitmaps || !sources) return;
+
+    jsize count = env->GetArrayLength(pages);
+    if (env->GetArrayLength(bitmaps) < count || env->GetArrayLength(sources) < count) return;
+    std::vector<jint> indices(count);
+    env->GetIntArrayRegion(pages, 0, count, indices.data());
+    std::vector<jint> results(count, THUMBNAIL_FAILED);
+    int pageCount = FPDF_GetPageCount(doc);
+
+    for (jsize i = 0; i < count; i++) {
+        if (indices[i] < 0 || indices[i] >= pageCount) continue;
+        jobject bitmap = env->GetObjectArrayElement(bitmaps, i);
+        if (!bitmap) continue;
+
+        {
+            PageScope scope(doc, nullptr, indices[i]);
+            BitmapTarget target;
+            if (scope.page && target.open(env, bitmap, true, false)) {
+                FPDF_BITMAP thumbnail = preferEmbedded ? FPDFPage_GetThumbnailAsBitmap(scope.page) : nullptr;
+                if (thumbnail) {
+                    if (scaleThumbnail(thumbnail, target.fpdfBitmap, !target.converted())) {
+                        results[i] = THUMBNAIL_EMBEDDED;
+                    }
+                    FPDFBitmap_Destroy(thumbnail);
+                }
+                if (results[i] == THUMBNAIL_FAILED) {
+                    FPDFBitmap_FillRect(target.fpdfBitmap, 0, 0, target.info.width, target.info.height,
+                                        0xFFFFFFFF);
+                    // No annotations or forms, and no image cache growth across
+                    // a long strip of pages
+                    int flags = FPDF_REVERSE_BYTE_ORDER | FPDF_RENDER_LIMITEDIMAGECACHE;
+                    RenderTimer timer(scope.page);
+                    FPDF_RenderPageBitmap(target.fpdfBitmap, scope.page, 0, 0, target.info.width,
+                                          target.info.height, 0, target.renderFlags(flags));
+                    results[i] = THUMBNAIL_RENDERED;
+                }
+                target.commit();
+            }
+            target.close(env, bitmap);
+        }
+        env->DeleteLocalRef(bitmap);
+    }
+    env->SetIntArrayRegion(sources, 0, count, results.data());
+}
+
+// ----------------------------------------------------------------------------
+// Outline
+// ----------------------------------------------------------------------------
+
+// Outline levels past this are dropped; real outlines stay far below it
+static const int kOutlineMaxDepth = 64;
+
+// Ints per node in the nativeGetOutline buffer
+static const int kOutlineRecordInts = 6;
+
+/**
+ * Flatten the whole outline in one depth-first walk into a direct ByteBuffer
+ * (native order):
+ *   int count, titleUnits, reserved, reserved
+ *   int[count * 6]     nodes in preorder as parent/depth/pageIndex/titleStart/titleLength/end
+ *   jchar[titleUnits]  all titles back to back, UTF-16
+ * parent is -1 for top-level nodes and pageIndex -1 for nodes without a
+ * destination. end is the index just past the node's last descendant, so the
+ * next sibling of node i is end[i] and its children start at i + 1.
+ * A bookmark reached twice ends its sibling chain, so looping outlines terminate.
+ */
+JNIEXPORT jobject JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetOutline(JNIEnv *env, jobject thiz, jlong docPtr) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:getOutline");
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    if (!doc) return nullptr;
+
+    struct Level {
+        FPDF_BOOKMARK next;
+        jint parent;
+    };
+
+    std::vector<jint> nodes;
+    std::vector<jchar> titles;
+    std::unordered_set<FPDF_BOOKMARK> visited;
+    std::vector<Level> levels;
+    levels.push_back({FPDFBookmark_GetFirstChild(doc, nullptr), -1});
+
+    while (!levels.empty()) {
+        Level &level = levels.back();
+        if (!level.next) {
+            if (level.parent >= 0) nodes[level.parent * kOutlineRecordInts + 5] = (jint) (nodes.size() / kOutlineRecordInts);
+            levels.pop_back();
+            continue;
+        }
+
+        FPDF_BOOKMARK bookmark = level.next;
+        jint parent = level.parent;
+        if (!visited.insert(bookmark).second) {
+            level.next = nullptr;
+            continue;
+        }
+        level.next = FPDFBookmark_GetNextSibling(doc, bookmark);
+
+        jint index = (jint) (nodes.size() / kOutlineRecordInts);
+        jint depth = (jint) levels.size() - 1;
+
+        // Titles are read straight into the shared buffer, terminator trimmed off
+        jint titleStart = (jint) titles.size();
+        jint titleLength = 0;
+        unsigned long bytes = FPDFBookmark_GetTitle(bookmark, nullptr, 0);
+        if (bytes > 2) {
+            titles.resize(titleStart + bytes / 2);
+            unsigned long written = FPDFBookmark_GetTitle(bookmark, titles.data() + titleStart, bytes);
+            if (written > 2 && written <= bytes) titleLength = (jint) (written / 2) - 1;
+            titles.resize(titleStart + titleLength);
+        }
+
+        nodes.insert(nodes.end(), {parent, depth, (jint) bookmarkPageIndex(doc, bookmark),
+                                   titleStart, titleLength, index + 1});
+
+        FPDF_BOOKMARK child = FPDFBookmark_GetFirstChild(doc, bookmark);
+        if (child && depth + 1 < kOutlineMaxDepth) levels.push_back({child, index});
+    }
+
+    jint count = (jint) (nodes.size() / kOutlineRecordInts);
+    size_t size = 16 + nodes.size() * 4 + titles.size() * 2;
+
+    jclass bufferClass = env->FindClass("java/nio/ByteBuffer");
+    jmethodID allocateDirect = env->GetStaticMethodID(bufferClass, "allocateDirect", "(I)Ljava/nio/ByteBuffer;");
+    jobject buffer = env->CallStaticObjectMethod(bufferClass, allocateDirect, (jint) size);
+    env->DeleteLocalRef(bufferClass);
+    if (env->ExceptionCheck() || !buffer) return nullptr;
+
+    auto *out = static_cast<uint8_t *>(env->GetDirectBufferAddress(buffer));
+    if (!out) return nullptr;
+    jint header[4] = {count, (jint) titles.size(), 0, 0};
+    memcpy(out, header, sizeof(header));
+    if (!nodes.empty()) memcpy(out + 16, nodes.data(), nodes.size() * 4);
+    if (!titles.empty()) memcpy(out + 16 + nodes.size() * 4, titles.data(), titles.size() * 2);
+    return buffer;
+}
+
+// ----------------------------------------------------------------------------
+// Link Map
+// ----------------------------------------------------------------------------
+
+static const int kLinkKindAnnotation = 0;
+static const int kLinkKindWeb = 1;
+
+// Ints per link in the nativeGetPageLinks buffer
+static const int kLinkRecordInts = 8;
+
+struct LinkMapBuilder {
+    std::vector<jint> links;
+    std::vector<jfloat> bounds;
+    std::vector<jfloat> rects;
+    std::string targets;
+
+    // Normalized so that left <= right and bottom <= top, as page coordinates go
+    void addRect(float left, float top, float right, float bottom) {
+        rects.insert(rects.end(), {std::min(left, right), std::max(top, bottom),
+                                   std::max(left, right), std::min(top, bottom)});
+    }
+
+    // Record a link whose hit rects were added since rectStart
+    void addLink(int kind, int pageIndex, int actionType, size_t rectStart, size_t targetStart) {
+        jint rectCount = (jint) ((rects.size() - rectStart) / 4);
+        float l = 0, t = 0, r = 0, b = 0;
+        for (size_t i = rectStart; i < rects.size(); i += 4) {
+            bool first = i == rectStart;
+            l = first ? rects[i] : std::min(l, rects[i]);
+            t = first ? rects[i + 1] : std::max(t, rects[i + 1]);
+            r = first ? rects[i + 2] : std::max(r, rects[i + 2]);
+            b = first ? rects[i + 3] : std::min(b, rects[i + 3]);
+        }
+        bounds.insert(bounds.end(), {l, t, r, b});
+        links.insert(links.end(), {kind, pageIndex, actionType, (jint) (rectStart / 4), rectCount,
+                                   (jint) targetStart, (jint) (targets.size() - targetStart), 0});
+    }
+
+    // Append a NUL-terminated byte string from a two-call getter, terminator dropped
+    void appendTarget(const std::function<unsigned long(void*, unsigned long)> &getter) {
+        unsigned long bytes = getter(nullptr, 0);
+        if (bytes <= 1) return;
+        size_t start = targets.size();
+        targets.resize(start + bytes);
+        unsigned long written = getter(&targets[start], bytes);
+        targets.resize(written >= 1 && written <= bytes ? start + written - 1 : start);
+    }
+};
+
+// Annotation links in page order, hit rects from QuadPoints when present
+static void collectAnnotationLinks(LinkMapBuilder &out, FPDF_DOCUMENT doc, FPDF_PAGE page) {
+    int pos = 0;
+    FPDF_LINK link = nullptr;
+    while (FPDFLink_Enumerate(page, &pos, &link)) {
+        if (!link) continue;
+        size_t rectStart = out.rects.size();
+        size_t targetStart = out.targets.size();
+        FS_RECTF annotRect;
+        bool hasAnnotRect = FPDFLink_GetAnnotRect(link, &annotRect);
+
+        int quadCount = std::max(FPDFLink_CountQuadPoints(link), 0);
+        for (int q = 0; q < quadCount; q++) {
+            FS_QUADPOINTSF quad;
+            if (!FPDFLink_GetQuadPoints(link, q, &quad)) continue;
+            out.addRect(std::min(std::min(quad.x1, quad.x2), std::min(quad.x3, quad.x4)),
+                        std::max(std::max(quad.y1, quad.y2), std::max(quad.y3, quad.y4)),
+                        std::max(std::max(quad.x1, quad.x2), std::max(quad.x3, quad.x4)),
+                        std::min(std::min(quad.y1, quad.y2), std::min(quad.y3, quad.y4)));
+        }
+        if (out.rects.size() == rectStart) {
+            if (!hasAnnotRect) continue;
+            out.addRect(annotRect.left, annotRect.top, annotRect.right, annotRect.bottom);
+        }
+
+        FPDF_ACTION action = FPDFLink_GetAction(link);
+        int actionType = action ? (int) FPDFAction_GetType(action) : PDFACTION_UNSUPPORTED;
+        if (actionType == PDFACTION_URI) {
+            out.appendTarget([&](void *buffer, unsigned long bytes) {
+                return FPDFAction_GetURIPath(doc, action, buffer, bytes);
+            });
+        } else if (actionType == PDFACTION_REMOTEGOTO || actionType == PDFACTION_LAUNCH) {
+            out.appendTarget([&](void *buffer, unsigned long bytes) {
+                return FPDFAction_GetFilePath(action, buffer, bytes);
+            });
+        }
+        // A /Dest without an action still navigates within the document
+        int pageIndex = linkPageIndex(doc, link);
+        if (!action && pageIndex >= 0) actionType = PDFACTION_GOTO;
+        out.addLink(kLinkKindAnnotation, pageIndex, actionType, rectStart, targetStart);
+
+        // Bounds stay the annotation /Rect even when QuadPoints narrow the hit areas
+        if (hasAnnotRect) {
+            float *bounds = &out.bounds[out.bounds.size() - 4];
+            bounds[0] = std::min(annotRect.left, annotRect.right);
+            bounds[1] = std::max(annotRect.top, annotRect.bottom);
+            bounds[2] = std::max(annotRect.left, annotRect.right);
+            bounds[3] = std::min(annotRect.top, annotRect.bottom);
+        }
+    }
+}
+
+// URLs detected in the page text
+static void collectWebLinks(LinkMapBuilder &out, FPDF_PAGE page) {
+    FPDF_TEXTPAGE textPage = FPDFText_LoadPage(page);
+    if (!textPage) return;
+    FPDF_PAGELINK pageLinks = FPDFLink_LoadWebLinks(textPage);
+    if (pageLinks) {
+        std::vector<unsigned short> url;
+        int count = FPDFLink_CountWebLinks(pageLinks);
+        for (int i = 0; i < count; i++) {
+            size_t rectStart = out.rects.size();
+            int rectCount = FPDFLink_CountRects(pageLinks, i);
+            for (int r = 0; r < rectCount; r++) {
+                double left = 0, top = 0, right = 0, bottom = 0;
+                if (!FPDFLink_GetRect(pageLinks, i, r, &left, &top, &right, &bottom)) continue;
+                out.addRect((float) left, (float) top, (float) right, (float) bottom);
+            }
+            if (out.rects.size() == rectStart) continue;
+
+            size_t targetStart = out.targets.size();
+            int units = FPDFLink_GetURL(pageLinks, i, nullptr, 0);
+            if (units > 1) {
+                if (url.size() < (size_t) units) url.resize(units);
+                int written = FPDFLink_GetURL(pageLinks, i, url.data(), units);
+                if (written > 1 && written <= units) appendUtf8(out.targets, url.data(), written - 1);
+            }
+            out.addLink(kLinkKindWeb, -1, PDFACTION_URI, rectStart, targetStart);
+        }
+        FPDFLink_CloseWebLinks(pageLinks);
+    }
+    FPDFText_ClosePage(textPage);
+}
+
+/**
+ * Gather every link on a page in one call into a direct ByteBuffer (native order):
+ *   int linkCount, rectCount, targetBytes, reserved
+ *   int[linkCount * 8]     links as kind/pageIndex/actionType/rectStart/rectCount/targetStart/targetLength/reserved
+ *   float[linkCount * 4]   link bounds as left/top/right/bottom
+ *   float[rectCount * 4]   hit rects as left/top/right/bottom
+ *   byte[targetBytes]      URIs and file paths back to back, UTF-8
+ * Annotation links (kind 0) come first in page order, then, with
+ * includeWebLinks, URLs detected in the text (kind 1). Coordinates are page
+ * coordinates with top >= bottom. The target is the URI for URI actions and
+ * the file path for remote GoTo and launch actions.
+ */
+JNIEXPORT jobject JNICALL
+Java_com_hyntix_pdfium_PdfiumCore_nativeGetPageLinks(JNIEnv *env, jobject thiz,
+                                                     jlong docPtr, jlong pagePtr,
+                                                     jboolean includeWebLinks) {
+    PdfiumLock lock;
+    TraceSection trace("PDFium:getPageLinks");
+    FPDF_DOCUMENT doc = (FPDF_DOCUMENT) docPtr;
+    FPDF_PAGE page = (FPDF_PAGE) pagePtr;
+    if (!doc || !page) return nullptr;
+
+    LinkMapBuilder out;
+    collectAnnotationLinks(out, doc, page);
+    if (includeWebLinks) collectWebLinks(out, page);
+
+    size_t linkCount = out.links.size() / kLinkRecordInts;
+    size_t rectCount = out.rects.size() / 4;
+    size_t size = 16 + out.links.size() * 4 + out.bounds.size() * 4 + out.rects.size() * 4 + out.targets.size();
+
+    jclass bufferClass = env->FindClass("java/nio/ByteBuffer");
+    jmethodID allocateDirect = env->GetStaticMethodID(bufferClass, "allocateDirect", "(I)Ljava/nio/ByteBuffer;");
+    jobject buffer = env->CallStaticObjectMethod(bufferClass, allocateDirect, (jint) size);
+    env->DeleteLocalRef(bufferClass);
+    if (env->ExceptionCheck() || !buffer) return nullptr;
+
+    auto *dst = static_cast<uint8_t *>(env->GetDirectBufferAddress(buffer));
+    if (!dst) return nullptr;
+    jint header[4] = {(jint) linkCount, (jint) rectCount, (jint) out.targets.size(), 0};
+    auto put = [&dst](const void *data, size_t bytes) {
+        if (bytes) memcpy(dst, data, bytes);
+        dst += bytes;
+    };
+    put(header, sizeof(header));
+    put(out.links.data(), out.links.size() * 4);
+    put(out.bounds.data(), out.bounds.size() * 4);
+    put(out.rects.data(), out.rects.size() * 4);
+    put(out.targets.data(), out.targets.size());
+    return buffer;
 }
 
 } // extern "C"
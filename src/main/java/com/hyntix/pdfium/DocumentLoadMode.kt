@@ -0,0 +1,18 @@
+package com.hyntix.pdfium
+
+/**
+ * Strategy used to load a document from a file descriptor or path.
+ */
+enum class DocumentLoadMode {
+    /**
+     * Read blocks on demand through FPDF_LoadCustomDocument.
+     * Memory use stays proportional to what PDFium parses, not to file size.
+     */
+    STREAMING,
+
+    /**
+     * Copy the whole file into native memory before parsing.
+     * Useful when the underlying file may change or disappear while the document is open.
+     */
+    IN_MEMORY
+}
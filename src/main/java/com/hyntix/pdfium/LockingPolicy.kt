@@ -0,0 +1,23 @@
+package com.hyntix.pdfium
+
+/**
+ * How the native layer serializes access to PDFium within a process.
+ *
+ * PDFium is not thread-safe, even across unrelated documents.
+ *
+ * @see PdfiumCore.setLockingPolicy
+ */
+enum class LockingPolicy {
+    /**
+     * Every native call holds a process-wide lock. Safe to use from any number
+     * of threads; PDFium work in the process runs one call at a time.
+     */
+    SERIALIZED,
+
+    /**
+     * No process-wide lock. Only valid when a single thread uses PDFium in this
+     * process, e.g. in a dedicated render worker process. Other processes have
+     * their own PDFium instance and never contend.
+     */
+    SINGLE_THREADED
+}
@@ -0,0 +1,28 @@
+package com.hyntix.pdfium
+
+/**
+ * Counters of a document's native page cache.
+ *
+ * @property hits Page loads served from the cache
+ * @property misses Page loads that had to parse the page
+ * @property evictions Pages closed to stay within capacity
+ * @property bytesHeld Estimated memory held by cached pages
+ * @property cachedPages Number of pages currently cached, open or not
+ * @property capacityBytes Configured budget; 0 when caching is disabled
+ *
+ * @see PdfDocument.configurePageCache
+ */
+data class PageCacheStats(
+    val hits: Long,
+    val misses: Long,
+    val evictions: Long,
+    val bytesHeld: Long,
+    val cachedPages: Int,
+    val capacityBytes: Long
+) {
+    /**
+     * Fraction of page loads served from the cache, or 0 before any load.
+     */
+    val hitRate: Double
+        get() = if (hits + misses == 0L) 0.0 else hits.toDouble() / (hits + misses)
+}
@@ -0,0 +1,65 @@
+package com.hyntix.pdfium
+
+import android.graphics.Bitmap
+
+/**
+ * Reusable small bitmaps for [PdfDocument.generateThumbnails].
+ *
+ * Thumbnails of a document mostly share a handful of sizes, so a strip that
+ * releases thumbnails once they are drawn (or scrolled away) keeps decoding
+ * into the same few bitmaps instead of allocating one per page. Released
+ * bitmaps beyond [maxBytes] are dropped. The pool is thread-safe.
+ *
+ * @param maxBytes Bytes of free bitmaps kept for reuse
+ */
+class PdfBitmapPool(private val maxBytes: Long = DEFAULT_MAX_BYTES) {
+
+    companion object {
+        const val DEFAULT_MAX_BYTES = 4L * 1024 * 1024
+    }
+
+    private data class Key(val width: Int, val height: Int, val config: Bitmap.Config)
+
+    private val free = HashMap<Key, ArrayDeque<Bitmap>>()
+    private var freeBytes = 0L
+
+    init {
+        require(maxBytes >= 0) { "maxBytes must not be negative" }
+    }
+
+    /**
+     * A mutable bitmap of the given size and config, reused if one is free.
+     * Its previous contents are not cleared.
+     */
+    @Synchronized
+    fun acquire(width: Int, height: Int, config: Bitmap.Config): Bitmap {
+        val bitmap = free[Key(width, height, config)]?.removeLastOrNull()
+        if (bitmap != null) {
+            freeBytes -= bitmap.allocationByteCount
+            return bitmap
+        }
+        return Bitmap.createBitmap(width, height, config)
+    }
+
+    /**
+     * Return [bitmap] for reuse. Recycled, immutable and hardware bitmaps are
+     * ignored. The caller must not use it afterwards.
+     */
+    @Synchronized
+    fun release(bitmap: Bitmap) {
+        val config = bitmap.config ?: return
+        if (bitmap.isRecycled || !bitmap.isMutable || config == Bitmap.Config.HARDWARE) return
+        if (freeBytes + bitmap.allocationByteCount > maxBytes) return
+        free.getOrPut(Key(bitmap.width, bitmap.height, config)) { ArrayDeque() }.addLast(bitmap)
+        freeBytes += bitmap.allocationByteCount
+    }
+
+    /**
+     * Drop all free bitmaps.
+     */
+    @Synchronized
+    fun clear() {
+        free.clear()
+        freeBytes = 0
+    }
+}
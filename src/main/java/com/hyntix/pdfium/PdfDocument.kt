@@ -1,6 +1,9 @@
 package com.hyntix.pdfium
 
+import android.graphics.Bitmap
+import com.hyntix.pdfium.render.PdfRenderCache
 import java.io.Closeable
+import java.security.MessageDigest
 
 /**
  * Represents an opened PDF document.
@@ -10,11 +13,52 @@ import java.io.Closeable
  */
 class PdfDocument internal constructor(
     private val core: PdfiumCore,
-    private val docPtr: Long
+    private val docPtr: Long,
+    private val rangeLoaderPtr: Long = 0L
 ) : Closeable {
     
+    companion object {
+        /** Pages searched per native call by [searchDocument]. */
+        const val SEARCH_BATCH_PAGES = 8
+
+        /** Pages extracted per native call by [extractText]. */
+        const val TEXT_BATCH_PAGES = 8
+
+        /** Thumbnails filled per native call by [generateThumbnails]. */
+        const val THUMBNAIL_BATCH_PAGES = 16
+
+        /** Bytes handed to the output per write by [save] and [saveInPlace]. */
+        const val DEFAULT_SAVE_BLOCK_SIZE = 64 * 1024
+    }
+    
+    @Volatile
     private var isClosed = false
     
+    /**
+     * Whether this document is loaded progressively from a [PdfRangeFetcher].
+     */
+    val isProgressive: Boolean get() = rangeLoaderPtr != 0L
+    
+    /**
+     * Whether the progressively loaded file is linearized ("fast web view").
+     * Always false for documents opened from local data.
+     */
+    val isLinearized: Boolean
+        get() {
+            checkNotClosed()
+            return isProgressive && core.isLinearized(rangeLoaderPtr)
+        }
+    
+    /**
+     * Index of the page whose data arrives first; 0 unless the file is linearized
+     * with a different first page.
+     */
+    val firstAvailablePageIndex: Int
+        get() {
+            checkNotClosed()
+            return core.getFirstAvailablePageIndex(docPtr)
+        }
+    
     /**
      * Total number of pages in the document.
      */
@@ -74,6 +118,31 @@ class PdfDocument internal constructor(
         return core.getMetaText(docPtr, tag)
     }
     
+    /**
+     * Hex-encoded trailer file identifier (permanent part followed by the changing
+     * part), or null if the document has no `/ID`. The changing part is updated
+     * whenever the file is saved, so this identifies one version of the file.
+     */
+    val fileIdentifier: String?
+        get() {
+            checkNotClosed()
+            val permanent = core.getFileIdentifier(docPtr, 0) ?: return null
+            val changing = core.getFileIdentifier(docPtr, 1) ?: ByteArray(0)
+            return (permanent + changing).joinToString("") { "%02x".format(it) }
+        }
+
+    /**
+     * Hex SHA-1 of the source length and its first and last 64 KB, for keying
+     * caches of documents without a [fileIdentifier]. Null for new documents
+     * and progressive opens, which never hold the whole source.
+     */
+    val sourceFingerprint: String?
+        get() {
+            checkNotClosed()
+            val sample = core.getSourceSample(docPtr) ?: return null
+            return MessageDigest.getInstance("SHA-1").digest(sample).joinToString("") { "%02x".format(it) }
+        }
+    
     /**
      * Check if the document has been closed.
      */
@@ -82,6 +151,7 @@ class PdfDocument internal constructor(
     /**
      * Close the document and release native resources.
      */
+    @Synchronized
     override fun close() {
         if (!isClosed) {
             core.closeDocument(docPtr)
@@ -102,14 +172,39 @@ class PdfDocument internal constructor(
         check(!isClosed) { "Document has been closed" }
     }
     
+    /**
+     * Check, without downloading, whether all data for a page has arrived.
+     * Always true for documents opened from local data.
+     */
+    fun isPageAvailable(index: Int): Boolean {
+        checkNotClosed()
+        return !isProgressive || core.isPageAvailable(rangeLoaderPtr, index)
+    }
+    
+    /**
+     * Fetch any missing data for a page from the [PdfRangeFetcher].
+     * Blocks until the page is complete; called automatically by [openPage].
+     *
+     * @return false if a fetch failed
+     */
+    fun ensurePageAvailable(index: Int): Boolean {
+        checkNotClosed()
+        return !isProgressive || core.ensurePageAvailable(rangeLoaderPtr, index)
+    }
+    
     /**
      * Open a page at the specified index.
      * Use this to access page content, dimensions, and render it.
      */
+    @Synchronized
     fun openPage(index: Int): PdfPage {
         checkNotClosed()
         require(index in 0 until pageCount) { "Page index $index out of bounds" }
         
+        if (!ensurePageAvailable(index)) {
+            throw IllegalStateException("Failed to fetch data for page $index")
+        }
+        
         val pagePtr = core.loadPage(docPtr, index)
         if (pagePtr == 0L) {
             throw IllegalStateException("Failed to load page $index")
@@ -139,23 +234,307 @@ class PdfDocument internal constructor(
     
     /**
      * Get page size without keeping the page open.
-     * Useful when only dimensions are needed.
+     * Useful when only dimensions are needed; the page content is not parsed.
      */
     fun getPageSize(index: Int): Pair<Double, Double> {
         checkNotClosed()
         require(index in 0 until pageCount) { "Page index $index out of bounds" }
+        return core.getPageSizeByIndex(docPtr, index)
+    }
+
+    /**
+     * Configure the native page cache for this document.
+     *
+     * Closed pages stay parsed until evicted, so reopening a recently used page
+     * with [openPage] takes a lease on the cached handle instead of parsing it
+     * again. Eviction is least-recently-used once the estimated size exceeds
+     * [maxBytes]. Pages currently open are never evicted. The default is 8 MiB
+     * without text pages.
+     *
+     * @param maxBytes Estimated memory budget; 0 disables caching
+     * @param cacheTextPages Also keep text pages loaded with cached pages
+     */
+    fun configurePageCache(maxBytes: Long, cacheTextPages: Boolean = false) {
+        checkNotClosed()
+        require(maxBytes >= 0) { "maxBytes must not be negative" }
+        core.configurePageCache(docPtr, maxBytes, cacheTextPages)
+    }
+
+    /**
+     * Instrumentation counters for this document.
+     */
+    val stats: PdfiumStats
+        get() {
+            checkNotClosed()
+            return core.getStats(docPtr)
+        }
+
+    /**
+     * Current page cache counters.
+     */
+    val pageCacheStats: PageCacheStats
+        get() {
+            checkNotClosed()
+            return core.getPageCacheStats(docPtr)
+        }
+
+    /**
+     * Search every page in [pageRange] in native code, delivering hits page by page.
+     *
+     * Pages are walked in batches of [SEARCH_BATCH_PAGES] per native call, with the
+     * document lock released between batches so rendering and other calls can
+     * interleave. [onPage] is called on the calling thread for each page with at
+     * least one hit, in page order, so the first results can be shown before the
+     * search finishes. Enabling text caching with [configurePageCache] makes
+     * repeated searches reuse parsed text pages.
+     *
+     * @param query Text to search for
+     * @param matchCase Whether to match case
+     * @param matchWholeWord Whether to match whole words
+     * @param pageRange Pages to search
+     * @param cancellationSignal Stops the search at the next page when cancelled
+     * @param onPage Receives each page's hits; return false to stop the search
+     * @return false if the search was cancelled, stopped or a page could not be fetched
+     */
+    fun searchDocument(
+        query: String,
+        matchCase: Boolean = false,
+        matchWholeWord: Boolean = false,
+        pageRange: IntRange = 0 until pageCount,
+        cancellationSignal: android.os.CancellationSignal? = null,
+        onPage: (PdfSearchBatch) -> Boolean
+    ): Boolean {
+        if (query.isEmpty()) return true
+        var stopped = false
+        val callback = PdfSearchCallback { pageIndex, starts, counts, rectOffsets, rects ->
+            stopped = !onPage(PdfSearchBatch(pageIndex, starts, counts, rectOffsets, rects)) ||
+                cancellationSignal?.isCanceled == true
+            !stopped
+        }
         
-        val pagePtr = core.loadPage(docPtr, index)
-        return if (pagePtr != 0L) {
-            val width = core.getPageWidth(pagePtr)
-            val height = core.getPageHeight(pagePtr)
-            core.closePage(pagePtr)
-            Pair(width, height)
-        } else {
-            Pair(595.0, 842.0) // Default A4
+        val end = minOf(pageRange.last + 1, pageCount)
+        var next = maxOf(pageRange.first, 0)
+        while (next < end) {
+            if (cancellationSignal?.isCanceled == true) return false
+            val batchEnd = minOf(next + SEARCH_BATCH_PAGES, end)
+            for (i in next until batchEnd) {
+                if (!ensurePageAvailable(i)) return false
+            }
+            val searched = synchronized(this) {
+                checkNotClosed()
+                core.searchPages(docPtr, query, matchCase, matchWholeWord, next, batchEnd, callback)
+            }
+            if (stopped || searched <= next) return false
+            next = searched
+        }
+        return true
+    }
+    
+    /**
+     * Search the whole document and return the hits of every page that has any.
+     *
+     * @see searchDocument
+     */
+    fun searchDocument(
+        query: String,
+        matchCase: Boolean = false,
+        matchWholeWord: Boolean = false
+    ): List<PdfSearchBatch> {
+        val results = ArrayList<PdfSearchBatch>()
+        searchDocument(query, matchCase, matchWholeWord) { results.add(it) }
+        return results
+    }
+    
+    /**
+     * Extract the full text of every page in [pageRange], page by page.
+     *
+     * Loading, layout and UTF-16 conversion run in native code into one reused
+     * buffer, [TEXT_BATCH_PAGES] pages per call, with the document lock released
+     * between batches. Pages go through the page cache like [searchDocument].
+     * [sink] is called on the calling thread in page order.
+     *
+     * @return false if cancelled, stopped by [sink] or a page could not be fetched
+     */
+    fun extractText(
+        pageRange: IntRange = 0 until pageCount,
+        cancellationSignal: android.os.CancellationSignal? = null,
+        sink: PdfTextSink
+    ): Boolean {
+        var stopped = false
+        val callback = PdfTextSink { pageIndex, text ->
+            stopped = !sink.onPage(pageIndex, text) || cancellationSignal?.isCanceled == true
+            !stopped
+        }
+        return extractTextBatches(pageRange, cancellationSignal, -1, callback) && !stopped
+    }
+
+    /**
+     * Write the text of every page in [pageRange] to [output] as UTF-8, each page
+     * followed by a form feed (`\u000C`). The text never crosses into the JVM.
+     *
+     * @return false if cancelled, a page could not be fetched or a write failed
+     */
+    fun extractText(
+        output: android.os.ParcelFileDescriptor,
+        pageRange: IntRange = 0 until pageCount,
+        cancellationSignal: android.os.CancellationSignal? = null
+    ): Boolean = extractTextBatches(pageRange, cancellationSignal, output.fd, null)
+
+    private fun extractTextBatches(
+        pageRange: IntRange,
+        cancellationSignal: android.os.CancellationSignal?,
+        outFd: Int,
+        sink: PdfTextSink?
+    ): Boolean {
+        val end = minOf(pageRange.last + 1, pageCount)
+        var next = maxOf(pageRange.first, 0)
+        while (next < end) {
+            if (cancellationSignal?.isCanceled == true) return false
+            val batchEnd = minOf(next + TEXT_BATCH_PAGES, end)
+            for (i in next until batchEnd) {
+                if (!ensurePageAvailable(i)) return false
+            }
+            val extracted = synchronized(this) {
+                checkNotClosed()
+                core.extractTextPages(docPtr, next, batchEnd, outFd, sink)
+            }
+            // Short of the batch end means stopped by the sink or a failed write
+            if (extracted < batchEnd) return false
+            next = extracted
+        }
+        return true
+    }
+    
+    /**
+     * Produce a thumbnail of every page in [pageRange], no larger than [maxEdge]
+     * pixels on either side, without opening the pages as [PdfPage]s.
+     *
+     * A page's embedded `/Thumb` image is used when it has one and
+     * [preferEmbedded] is set; otherwise the page is rendered at thumbnail size
+     * without annotations or form fields. Pages are filled natively in batches
+     * of [THUMBNAIL_BATCH_PAGES], with the document lock released between
+     * batches, and stay out of the page cache.
+     *
+     * Without a [cache], thumbnails are taken from [pool] when given and belong
+     * to the sink, which can hand them back with [PdfBitmapPool.release]. With
+     * a [cache], thumbnails are looked up there first and stored there after
+     * generation; they are then shared with the cache like
+     * [PdfRenderCache.getOrRender] results and must not be modified or recycled.
+     *
+     * @param config Bitmap config; RGB_565 halves the memory of ARGB_8888
+     * @param documentKey Stable document identity for reusing disk cache entries,
+     *        see [PdfRenderCache.getOrRender]; without one thumbnails are only
+     *        cached in memory
+     * @param cancellationSignal Optional signal to stop between batches
+     * @return false if cancelled, stopped by the sink, or a page could not be
+     *         loaded; pages that fail to render are skipped and also return false
+     */
+    fun generateThumbnails(
+        pageRange: IntRange = 0 until pageCount,
+        maxEdge: Int,
+        config: Bitmap.Config = Bitmap.Config.RGB_565,
+        preferEmbedded: Boolean = true,
+        pool: PdfBitmapPool? = null,
+        cache: PdfRenderCache? = null,
+        documentKey: String? = null,
+        cancellationSignal: android.os.CancellationSignal? = null,
+        sink: PdfThumbnailSink
+    ): Boolean {
+        require(maxEdge > 0) { "maxEdge must be positive" }
+        var complete = true
+        val end = minOf(pageRange.last + 1, pageCount)
+        var next = maxOf(pageRange.first, 0)
+        while (next < end) {
+            if (cancellationSignal?.isCanceled == true) return false
+            val batchEnd = minOf(next + THUMBNAIL_BATCH_PAGES, end)
+
+            val pages = ArrayList<Int>(batchEnd - next)
+            val bitmaps = ArrayList<Bitmap>(batchEnd - next)
+            val revisions = ArrayList<LongArray>(batchEnd - next)
+            for (i in next until batchEnd) {
+                if (!ensurePageAvailable(i)) {
+                    bitmaps.forEach { pool?.release(it) }
+                    return false
+                }
+                val (width, height) = thumbnailSize(i, maxEdge)
+                val revision = synchronized(this) {
+                    checkNotClosed()
+                    core.getPageRevision(docPtr, i)
+                }
+                val cached = cache?.getThumbnail(documentKey, i, revision, width, height, config, preferEmbedded)
+                if (cached != null) {
+                    // Pages before this one must reach the sink first
+                    val failed = fillThumbnails(pages, bitmaps, revisions, preferEmbedded, pool, cache, documentKey, sink)
+                    if (failed < 0) return false
+                    complete = complete && failed == 0
+                    if (!sink.onThumbnail(i, cached, PdfThumbnailSource.CACHED)) return false
+                    continue
+                }
+                pages.add(i)
+                revisions.add(revision)
+                bitmaps.add(
+                    if (cache == null && pool != null) pool.acquire(width, height, config)
+                    else Bitmap.createBitmap(width, height, config)
+                )
+            }
+            val failed = fillThumbnails(pages, bitmaps, revisions, preferEmbedded, pool, cache, documentKey, sink)
+            if (failed < 0) return false
+            complete = complete && failed == 0
+            next = batchEnd
         }
+        return complete
     }
 
+    // Fill and deliver pending thumbnails, then clear the lists. Returns the
+    // pages that failed, or -1 if the sink stopped.
+    private fun fillThumbnails(
+        pages: MutableList<Int>,
+        bitmaps: MutableList<Bitmap>,
+        revisions: MutableList<LongArray>,
+        preferEmbedded: Boolean,
+        pool: PdfBitmapPool?,
+        cache: PdfRenderCache?,
+        documentKey: String?,
+        sink: PdfThumbnailSink
+    ): Int {
+        if (pages.isEmpty()) return 0
+        val sources = IntArray(pages.size)
+        synchronized(this) {
+            checkNotClosed()
+            core.renderThumbnails(docPtr, pages.toIntArray(), bitmaps.toTypedArray(), preferEmbedded, sources)
+        }
+        var stopped = false
+        var failed = 0
+        for (i in pages.indices) {
+            val bitmap = bitmaps[i]
+            val source = when (sources[i]) {
+                PdfiumCore.THUMBNAIL_EMBEDDED -> PdfThumbnailSource.EMBEDDED
+                PdfiumCore.THUMBNAIL_RENDERED -> PdfThumbnailSource.RENDERED
+                else -> null
+            }
+            if (stopped || source == null) {
+                if (source == null) failed++
+                if (cache == null) pool?.release(bitmap) else bitmap.recycle()
+                continue
+            }
+            val delivered = cache?.putThumbnail(documentKey, pages[i], revisions[i], preferEmbedded, bitmap) ?: bitmap
+            stopped = !sink.onThumbnail(pages[i], delivered, source)
+        }
+        pages.clear()
+        bitmaps.clear()
+        revisions.clear()
+        return if (stopped) -1 else failed
+    }
+
+    // Thumbnail bitmap size for a page, keeping its aspect ratio
+    private fun thumbnailSize(pageIndex: Int, maxEdge: Int): Pair<Int, Int> {
+        val (width, height) = getPageSize(pageIndex)
+        val longest = maxOf(width, height)
+        if (longest <= 0.0) return maxEdge to maxEdge
+        val scale = maxEdge / longest
+        return maxOf(1, Math.round(width * scale).toInt()) to maxOf(1, Math.round(height * scale).toInt())
+    }
+    
     /**
      * Get page label (actual page number as displayed in PDF)
      * Returns empty string if no label is defined for the page
@@ -170,35 +549,25 @@ class PdfDocument internal constructor(
 
     /**
      * Get the Table of Contents (Bookmarks) of the document.
+     *
+     * Built from [getOutline], so the whole tree costs one native call plus one
+     * page label lookup per distinct destination page.
      */
     fun getTableOfContents(): List<PdfBookmark> {
         checkNotClosed()
-        val bookmarks = ArrayList<PdfBookmark>()
-        val firstPtr = core.getFirstChildBookmark(docPtr, 0)
-        if (firstPtr != 0L) {
-            recursiveGetBookmarks(bookmarks, firstPtr)
-        }
-        return bookmarks
+        return getOutline().toBookmarks { core.getPageLabel(docPtr, it) }
     }
 
-    private fun recursiveGetBookmarks(tree: MutableList<PdfBookmark>, bookmarkPtr: Long) {
-        var currentPtr = bookmarkPtr
-        while (currentPtr != 0L) {
-            val title = core.getBookmarkTitle(currentPtr)
-            val pageIndex = core.getBookmarkDestIndex(docPtr, currentPtr)
-            val children = ArrayList<PdfBookmark>()
-            
-            // Get the page label for this bookmark's destination page
-            val pageLabel = if (pageIndex >= 0) core.getPageLabel(docPtr, pageIndex.toInt()) else ""
-            
-            val childPtr = core.getFirstChildBookmark(docPtr, currentPtr)
-            if (childPtr != 0L) {
-                recursiveGetBookmarks(children, childPtr)
-            }
-            
-            tree.add(PdfBookmark(title, pageIndex, children, pageLabel))
-            currentPtr = core.getNextSiblingBookmark(docPtr, currentPtr)
-        }
+    /**
+     * Get the outline (bookmark tree) as a lazily expanded snapshot.
+     *
+     * The whole tree is read in one native walk; [PdfOutline.Node] children are
+     * only materialized when read, so large outlines can back a collapsible
+     * TOC view without building every node up front.
+     */
+    fun getOutline(): PdfOutline {
+        checkNotClosed()
+        return core.getOutline(docPtr)?.let { PdfOutline(it) } ?: PdfOutline.empty()
     }
 
     /**
@@ -212,6 +581,62 @@ class PdfDocument internal constructor(
         return core.saveDocument(docPtr, path)
     }
 
+    /**
+     * Save the document to [output], starting at its current position.
+     *
+     * @param mode Full rewrite, incremental update or security removal
+     * @param blockSize Bytes buffered natively per write
+     * @return True if successful
+     */
+    fun save(
+        output: android.os.ParcelFileDescriptor,
+        mode: PdfSaveMode = PdfSaveMode.FULL,
+        blockSize: Int = DEFAULT_SAVE_BLOCK_SIZE
+    ): Boolean {
+        require(blockSize > 0) { "blockSize must be positive" }
+        checkNotClosed()
+        return core.saveDocument(docPtr, output.fd, mode.flags, blockSize)
+    }
+
+    /**
+     * Save the document to [output] in blocks of [blockSize] bytes. The stream is not closed.
+     *
+     * @param mode Full rewrite, incremental update or security removal
+     * @return True if successful
+     * @throws java.io.IOException if the stream fails
+     */
+    fun save(
+        output: java.io.OutputStream,
+        mode: PdfSaveMode = PdfSaveMode.FULL,
+        blockSize: Int = DEFAULT_SAVE_BLOCK_SIZE
+    ): Boolean {
+        require(blockSize > 0) { "blockSize must be positive" }
+        checkNotClosed()
+        return core.saveDocument(docPtr, output, mode.flags, blockSize)
+    }
+
+    /**
+     * Append the changes to the file this document was opened from as an
+     * incremental update, leaving the existing bytes, and any signatures over
+     * them, untouched. Only the changes are written, so a small edit to a large
+     * file saves quickly.
+     *
+     * [target] must be opened read-write on the same file, unmodified or as
+     * the last [saveInPlace] left it. Each update holds every change since the
+     * document was opened, so saving in place again replaces the previous
+     * update rather than appending another. Not available for progressively
+     * loaded documents.
+     *
+     * @return The number of bytes written after the original content, or -1 if
+     * [target] doesn't match or the write failed, in which case the file is
+     * left as it was before the call, including any earlier in-place update
+     */
+    fun saveInPlace(target: android.os.ParcelFileDescriptor, blockSize: Int = DEFAULT_SAVE_BLOCK_SIZE): Long {
+        require(blockSize > 0) { "blockSize must be positive" }
+        checkNotClosed()
+        return core.saveDocumentInPlace(docPtr, target.fd, blockSize)
+    }
+
     /**
      * Add a new blank page to the document.
      * 
@@ -243,6 +668,82 @@ class PdfDocument internal constructor(
         return core.importPages(docPtr, sourceDoc.getPointer(), pageRange, insertIndex)
     }
 
+    /**
+     * Import pages from another document by index, in the given order.
+     *
+     * @param sourceDoc Source document to import from
+     * @param pageIndices 0-based source page indices; may repeat or reorder pages
+     * @param insertIndex Index to insert pages at, default is end of document.
+     * @return True if successful
+     */
+    fun importPages(sourceDoc: PdfDocument, pageIndices: IntArray, insertIndex: Int = pageCount): Boolean {
+        checkNotClosed()
+        val sourcePages = sourceDoc.pageCount
+        require(pageIndices.all { it in 0 until sourcePages }) { "Page index out of range [0, $sourcePages)" }
+        require(insertIndex in 0..pageCount) { "Insert index $insertIndex out of range [0, $pageCount]" }
+        return core.importPagesByIndex(docPtr, sourceDoc.getPointer(), pageIndices, insertIndex)
+    }
+
+    /**
+     * Build a new document with [columns] x [rows] pages of this one on each
+     * output page, using FPDF_ImportNPagesToOne. Content stays vector.
+     *
+     * @param outputWidth Output page width in points
+     * @param outputHeight Output page height in points
+     * @return The new document, or null if failed; the caller closes it
+     */
+    fun importNPagesToOne(outputWidth: Float, outputHeight: Float, columns: Int, rows: Int): PdfDocument? {
+        require(columns > 0 && rows > 0) { "columns and rows must be positive" }
+        checkNotClosed()
+        val newDocPtr = core.importNPagesToOne(docPtr, outputWidth, outputHeight, columns, rows)
+        return if (newDocPtr != 0L) PdfDocument(core, newDocPtr) else null
+    }
+
+    /**
+     * Impose pages of this document onto sheets of a new document.
+     *
+     * All sheets are built in one native pass from form XObjects, one per
+     * source page, so content stays vector and a page shown in several slots
+     * is copied once.
+     *
+     * @param imposition Sheet size and page placement
+     * @param pageIndices Source pages in reading order, or null for all pages
+     * @return The new document, or null if failed; the caller closes it
+     */
+    fun impose(imposition: com.hyntix.pdfium.merge.PdfImposition, pageIndices: IntArray? = null): PdfDocument? {
+        checkNotClosed()
+        val count = pageCount
+        val pages = pageIndices ?: IntArray(count) { it }
+        require(pages.all { it in 0 until count }) { "Page index out of range [0, $count)" }
+        val sizes = pages.map { index ->
+            core.getPageSizeByIndex(docPtr, index).let { it.first.toFloat() to it.second.toFloat() }
+        }
+        val sheets = imposition.layout(pages, sizes)
+
+        val slotCount = sheets.sumOf { it.size }
+        val slots = IntArray(slotCount * 2)
+        val matrices = FloatArray(slotCount * 6)
+        var next = 0
+        sheets.forEachIndexed { sheetIndex, sheet ->
+            for (slot in sheet) {
+                slots[next * 2] = sheetIndex
+                slots[next * 2 + 1] = slot.pageIndex
+                slot.matrix.copyInto(matrices, next * 6)
+                next++
+            }
+        }
+
+        val output = core.newDocument() ?: return null
+        val added = core.imposePages(
+            output.docPtr, docPtr, imposition.sheetWidth, imposition.sheetHeight, sheets.size, slots, matrices
+        )
+        if (added < 0) {
+            output.close()
+            return null
+        }
+        return output
+    }
+
     // --- Attachments ---
     
     /**
@@ -321,6 +822,7 @@ class PdfDocument internal constructor(
      */
     fun initForm(): com.hyntix.pdfium.form.PdfForm? {
         checkNotClosed()
+        if (isProgressive && !core.ensureFormAvailable(rangeLoaderPtr)) return null
         val formPtr = core.initFormFillEnvironment(docPtr)
         return if (formPtr != 0L) {
             com.hyntix.pdfium.form.PdfForm(core, docPtr, formPtr)
@@ -413,11 +915,17 @@ class PdfDocument internal constructor(
      */
     fun validateFormField(fieldName: String): com.hyntix.pdfium.form.FieldValidationResult {
         checkNotClosed()
-        val snapshot = getFormData() ?: return com.hyntix.pdfium.form.FieldValidationResult(
+        val form = initForm() ?: return com.hyntix.pdfium.form.FieldValidationResult(
             fieldName = fieldName,
             isValid = false,
             errors = listOf("No form data available")
         )
+        // Only the named field is read, through the field-name index
+        val snapshot = try {
+            com.hyntix.pdfium.form.FormDataSnapshot(form.getFormType(), listOfNotNull(form.getFieldData(fieldName)))
+        } finally {
+            form.close()
+        }
         val validator = com.hyntix.pdfium.form.FormValidator(snapshot)
         return validator.validateField(fieldName)
     }
@@ -4,9 +4,29 @@ import android.graphics.RectF
 
 /**
  * Represents a link on a PDF page.
+ *
+ * Links from [PdfPage.getLinkMap] also carry the action type, the hit
+ * areas and, for remote GoTo and launch actions, the target file path.
  */
 data class PdfLink(
     val rect: RectF,
     val destPageIndex: Int,
-    val uri: String? = null
-)
+    val uri: String? = null,
+    /** One of the `ACTION_*` constants. */
+    val actionType: Int = ACTION_UNSUPPORTED,
+    /** True for a URL detected in the page text rather than a link annotation. */
+    val isWebLink: Boolean = false,
+    /** Areas that respond to taps; the QuadPoints of the annotation when it has any. */
+    val rects: List<RectF> = listOf(rect),
+    /** Target file of a remote GoTo or launch action. */
+    val filePath: String? = null
+) {
+    companion object {
+        const val ACTION_UNSUPPORTED = 0
+        const val ACTION_GOTO = 1
+        const val ACTION_REMOTE_GOTO = 2
+        const val ACTION_URI = 3
+        const val ACTION_LAUNCH = 4
+        const val ACTION_EMBEDDED_GOTO = 5
+    }
+}
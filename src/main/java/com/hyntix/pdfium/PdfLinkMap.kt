@@ -0,0 +1,169 @@
+package com.hyntix.pdfium
+
+import android.graphics.RectF
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Snapshot of every link on a page with a grid index for hit testing.
+ *
+ * Annotation links, their actions and, optionally, web links detected in the
+ * text are read in one native call by [PdfPage.getLinkMap]. [hitTest] runs
+ * entirely on the JVM, so it can be called on every touch event. The map is
+ * not updated by later annotation edits; read a new one after changing links.
+ *
+ * Coordinates are page coordinates in points, with y growing upwards
+ * (`top >= bottom`). Use [PdfPage.mapDeviceToPage] to convert touch points.
+ */
+class PdfLinkMap internal constructor(buffer: ByteBuffer) {
+
+    /** Annotation links in page order, followed by web links. */
+    val links: List<PdfLink>
+
+    // Hit rects as left/top/right/bottom and the link each belongs to
+    private val rects: FloatArray
+    private val rectLinks: IntArray
+
+    // Uniform grid over the union of all hit rects, cells in CSR layout
+    private val minX: Float
+    private val minY: Float
+    private val cellWidth: Float
+    private val cellHeight: Float
+    private val columns: Int
+    private val rows: Int
+    private val cellStarts: IntArray
+    private val cellRects: IntArray
+
+    init {
+        buffer.order(ByteOrder.nativeOrder())
+        val linkCount = buffer.getInt(0)
+        val rectCount = buffer.getInt(4)
+        val targetBytes = buffer.getInt(8)
+        buffer.position(16)
+
+        val records = IntArray(linkCount * RECORD_INTS).also { buffer.asIntBuffer().get(it) }
+        buffer.position(buffer.position() + records.size * 4)
+        val bounds = FloatArray(linkCount * 4).also { buffer.asFloatBuffer().get(it) }
+        buffer.position(buffer.position() + bounds.size * 4)
+        rects = FloatArray(rectCount * 4).also { buffer.asFloatBuffer().get(it) }
+        buffer.position(buffer.position() + rects.size * 4)
+        val targets = ByteArray(targetBytes).also { buffer.get(it) }
+
+        rectLinks = IntArray(rectCount)
+        links = List(linkCount) { i ->
+            val base = i * RECORD_INTS
+            val rectStart = records[base + 3]
+            val linkRects = List(records[base + 4]) { r ->
+                rectLinks[rectStart + r] = i
+                rectAt(rectStart + r)
+            }
+            val actionType = records[base + 2]
+            val target = if (records[base + 6] > 0) {
+                String(targets, records[base + 5], records[base + 6], Charsets.UTF_8)
+            } else {
+                null
+            }
+            val isFile = actionType == PdfLink.ACTION_REMOTE_GOTO || actionType == PdfLink.ACTION_LAUNCH
+            PdfLink(
+                rect = RectF(bounds[i * 4], bounds[i * 4 + 1], bounds[i * 4 + 2], bounds[i * 4 + 3]),
+                destPageIndex = records[base + 1],
+                uri = if (actionType == PdfLink.ACTION_URI) target else null,
+                actionType = actionType,
+                isWebLink = records[base] == KIND_WEB,
+                rects = linkRects,
+                filePath = if (isFile) target else null
+            )
+        }
+
+        var left = Float.MAX_VALUE
+        var bottom = Float.MAX_VALUE
+        var right = -Float.MAX_VALUE
+        var top = -Float.MAX_VALUE
+        for (r in 0 until rectCount) {
+            left = minOf(left, rects[r * 4])
+            top = maxOf(top, rects[r * 4 + 1])
+            right = maxOf(right, rects[r * 4 + 2])
+            bottom = minOf(bottom, rects[r * 4 + 3])
+        }
+        // About one rect per cell, capped so sparse pages keep a small grid
+        val side = Math.ceil(Math.sqrt(rectCount.toDouble())).toInt().coerceIn(1, MAX_GRID_SIDE)
+        columns = side
+        rows = side
+        minX = if (rectCount > 0) left else 0f
+        minY = if (rectCount > 0) bottom else 0f
+        cellWidth = if (rectCount > 0) maxOf((right - left) / side, MIN_CELL_SIZE) else 1f
+        cellHeight = if (rectCount > 0) maxOf((top - bottom) / side, MIN_CELL_SIZE) else 1f
+
+        val cellCounts = IntArray(columns * rows + 1)
+        forEachCell(rectCount) { _, cell -> cellCounts[cell + 1]++ }
+        for (c in 1 until cellCounts.size) cellCounts[c] += cellCounts[c - 1]
+        cellStarts = cellCounts.copyOf()
+        cellRects = IntArray(cellStarts.last())
+        val fill = cellStarts.copyOf()
+        forEachCell(rectCount) { rect, cell -> cellRects[fill[cell]++] = rect }
+    }
+
+    /** Number of links. */
+    val size: Int get() = links.size
+
+    /**
+     * Topmost link under ([x], [y]), or null.
+     *
+     * Annotation links win over web links. Among annotation links the later
+     * one in page order wins, as it is drawn on top.
+     *
+     * @param tolerance Extra margin in points around each hit rect, for fingers
+     */
+    fun hitTest(x: Float, y: Float, tolerance: Float = 0f): PdfLink? {
+        if (rectLinks.isEmpty()) return null
+        val firstColumn = columnOf(x - tolerance)
+        val lastColumn = columnOf(x + tolerance)
+        val firstRow = rowOf(y - tolerance)
+        val lastRow = rowOf(y + tolerance)
+
+        var best = -1
+        for (row in firstRow..lastRow) {
+            for (column in firstColumn..lastColumn) {
+                val cell = row * columns + column
+                for (k in cellStarts[cell] until cellStarts[cell + 1]) {
+                    val r = cellRects[k]
+                    if (x < rects[r * 4] - tolerance || x > rects[r * 4 + 2] + tolerance) continue
+                    if (y > rects[r * 4 + 1] + tolerance || y < rects[r * 4 + 3] - tolerance) continue
+                    val link = rectLinks[r]
+                    if (best < 0 || ranksAbove(link, best)) best = link
+                }
+            }
+        }
+        return if (best >= 0) links[best] else null
+    }
+
+    private fun ranksAbove(link: Int, other: Int): Boolean {
+        val webLink = links[link].isWebLink
+        val otherWebLink = links[other].isWebLink
+        if (webLink != otherWebLink) return !webLink
+        return link > other
+    }
+
+    private fun rectAt(r: Int) = RectF(rects[r * 4], rects[r * 4 + 1], rects[r * 4 + 2], rects[r * 4 + 3])
+
+    private fun columnOf(x: Float): Int = ((x - minX) / cellWidth).toInt().coerceIn(0, columns - 1)
+
+    private fun rowOf(y: Float): Int = ((y - minY) / cellHeight).toInt().coerceIn(0, rows - 1)
+
+    private inline fun forEachCell(rectCount: Int, action: (rect: Int, cell: Int) -> Unit) {
+        for (r in 0 until rectCount) {
+            for (row in rowOf(rects[r * 4 + 3])..rowOf(rects[r * 4 + 1])) {
+                for (column in columnOf(rects[r * 4])..columnOf(rects[r * 4 + 2])) {
+                    action(r, row * columns + column)
+                }
+            }
+        }
+    }
+
+    private companion object {
+        const val RECORD_INTS = 8
+        const val KIND_WEB = 1
+        const val MAX_GRID_SIDE = 16
+        const val MIN_CELL_SIZE = 1f
+    }
+}
@@ -0,0 +1,46 @@
+package com.hyntix.pdfium
+
+import java.io.Closeable
+import java.nio.ByteBuffer
+
+/**
+ * A native memory block that can be filled from Kotlin and then handed to
+ * [PdfiumCore.openDocument] without any further copy.
+ *
+ * Use [PdfiumCore.allocateBuffer] to create instances. Write the PDF bytes into
+ * [buffer]; the bytes from 0 until `buffer.limit()` are used as the document.
+ * Once a document has been opened over it, the document owns the memory and frees
+ * it on close. [buffer] must not be touched after that. If no document is opened,
+ * call [close] to free the memory.
+ */
+class PdfNativeBuffer internal constructor(
+    private val core: PdfiumCore,
+    private var bufferPtr: Long,
+    /** Direct view over the native memory. */
+    val buffer: ByteBuffer
+) : Closeable {
+
+    /**
+     * Whether the memory has been freed or handed to a document.
+     */
+    val isReleased: Boolean get() = bufferPtr == 0L
+
+    internal fun getPointer(): Long {
+        check(!isReleased) { "Buffer has been released" }
+        return bufferPtr
+    }
+
+    /**
+     * Mark the memory as owned by a document.
+     */
+    internal fun transferOwnership() {
+        bufferPtr = 0L
+    }
+
+    override fun close() {
+        if (!isReleased) {
+            core.freeBuffer(bufferPtr)
+            bufferPtr = 0L
+        }
+    }
+}
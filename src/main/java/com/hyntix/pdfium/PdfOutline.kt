@@ -0,0 +1,141 @@
+package com.hyntix.pdfium
+
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Snapshot of the document outline (bookmark tree), read in one native call
+ * by [PdfDocument.getOutline].
+ *
+ * Nodes are stored flat in preorder and [Node] objects are only created for
+ * the levels that are actually visited, so a collapsed 20k-entry outline
+ * costs a few arrays and no per-node objects. Nothing here calls into
+ * PDFium; the outline stays usable after the document is closed.
+ */
+class PdfOutline internal constructor(buffer: ByteBuffer) {
+
+    /** Total number of nodes at all levels. */
+    val size: Int
+
+    private val records: IntArray
+    private val titles: String
+
+    init {
+        buffer.order(ByteOrder.nativeOrder())
+        size = buffer.getInt(0)
+        val titleUnits = buffer.getInt(4)
+        buffer.position(16)
+
+        records = IntArray(size * RECORD_INTS).also { buffer.asIntBuffer().get(it) }
+        buffer.position(buffer.position() + records.size * 4)
+        val chars = CharArray(titleUnits).also { buffer.asCharBuffer().get(it) }
+        titles = String(chars)
+    }
+
+    /** Top-level nodes. */
+    val roots: List<Node> by lazy { nodesIn(0, size) }
+
+    /** True if the document has no outline. */
+    fun isEmpty(): Boolean = size == 0
+
+    /**
+     * Node at preorder position [index]. Positions are stable for the
+     * lifetime of this snapshot; node 0 is the first top-level entry.
+     */
+    fun getNode(index: Int): Node {
+        require(index in 0 until size) { "Node index $index out of range [0, $size)" }
+        return Node(index)
+    }
+
+    /**
+     * Converts the outline into the eager [PdfBookmark] tree.
+     *
+     * @param pageLabel Label for a destination page; only called for pages that
+     *   outline entries actually point at, once per page
+     */
+    fun toBookmarks(pageLabel: (Int) -> String = { "" }): List<PdfBookmark> {
+        val labels = HashMap<Int, String>()
+        fun build(start: Int, end: Int): List<PdfBookmark> {
+            val result = ArrayList<PdfBookmark>()
+            var i = start
+            while (i < end) {
+                val page = field(i, PAGE)
+                val label = if (page >= 0) labels.getOrPut(page) { pageLabel(page) } else ""
+                result.add(PdfBookmark(titleOf(i), page.toLong(), build(i + 1, field(i, END)), label))
+                i = field(i, END)
+            }
+            return result
+        }
+        return build(0, size)
+    }
+
+    private fun field(index: Int, offset: Int): Int = records[index * RECORD_INTS + offset]
+
+    private fun titleOf(index: Int): String {
+        val start = field(index, TITLE_START)
+        return titles.substring(start, start + field(index, TITLE_LENGTH))
+    }
+
+    private fun nodesIn(start: Int, end: Int): List<Node> {
+        val result = ArrayList<Node>()
+        var i = start
+        while (i < end) {
+            result.add(Node(i))
+            i = field(i, END)
+        }
+        return result
+    }
+
+    /**
+     * One outline entry. Children are resolved the first time [children] is read.
+     */
+    inner class Node internal constructor(
+        /** Preorder position in the outline. */
+        val index: Int
+    ) {
+        /** Entry title. */
+        val title: String get() = titleOf(index)
+
+        /** Destination page, or -1 if the entry has no destination. */
+        val pageIndex: Int get() = field(index, PAGE)
+
+        /** Nesting level; 0 for top-level entries. */
+        val depth: Int get() = field(index, DEPTH)
+
+        /** Enclosing entry, or null at the top level. */
+        val parent: Node? get() = field(index, PARENT).let { if (it >= 0) Node(it) else null }
+
+        /** True if the entry has at least one child, without building the child list. */
+        val hasChildren: Boolean get() = field(index, END) > index + 1
+
+        /** Number of entries below this one at all levels. */
+        val descendantCount: Int get() = field(index, END) - index - 1
+
+        /** Direct children, in document order. */
+        val children: List<Node> by lazy { nodesIn(index + 1, field(index, END)) }
+
+        fun hasDestination(): Boolean = pageIndex >= 0
+
+        override fun equals(other: Any?): Boolean =
+            other is Node && other.index == index && other.outline() === this@PdfOutline
+
+        override fun hashCode(): Int = index
+
+        override fun toString(): String = "Node(index=$index, title=$title, pageIndex=$pageIndex)"
+
+        private fun outline(): PdfOutline = this@PdfOutline
+    }
+
+    internal companion object {
+        private const val RECORD_INTS = 6
+        private const val PARENT = 0
+        private const val DEPTH = 1
+        private const val PAGE = 2
+        private const val TITLE_START = 3
+        private const val TITLE_LENGTH = 4
+        private const val END = 5
+
+        /** Outline of a document without bookmarks. */
+        fun empty(): PdfOutline = PdfOutline(ByteBuffer.allocate(16))
+    }
+}
@@ -1,6 +1,9 @@
 package com.hyntix.pdfium
 
 import android.graphics.Bitmap
+import com.hyntix.pdfium.annotation.AnnotationBatchReader
+import com.hyntix.pdfium.annotation.AnnotationTransaction
+import com.hyntix.pdfium.annotation.PageAnnotation
 import java.io.Closeable
 import kotlin.math.min
 import kotlin.math.max
@@ -18,8 +21,11 @@ class PdfPage internal constructor(
     val index: Int
 ) : Closeable {
 
+    @Volatile
     private var isClosed = false
 
+    private var renderSession: PdfRenderSession? = null
+
 
     /**
      * Page width in points (1/72 inch).
@@ -40,23 +46,241 @@ class PdfPage internal constructor(
     /**
      * Render the page to an Android Bitmap.
      * 
-     * @param bitmap The target bitmap. Must be mutable and configured as ARGB_8888.
+     * @param bitmap The target bitmap. Must be mutable and configured as ARGB_8888,
+     *        RGB_565 or ALPHA_8. ALPHA_8 receives a grayscale render as ink coverage
+     *        (opaque where the page is black), to be drawn with a paint color.
      * @param startX X-coordinate of the upper-left corner of the drawing area.
      * @param startY Y-coordinate of the upper-left corner of the drawing area.
      * @param drawWidth Width of the drawing area.
      * @param drawHeight Height of the drawing area.
      * @param renderAnnot Whether to render annotations.
+     * @param form Form whose fields are drawn over the content in the same pass,
+     *        or null for content only.
+     * @param clip Part of the bitmap to render, in bitmap pixels, or null for all
+     *        of it. Pixels outside it are left as they are, so after a form edit
+     *        only the [pollFormDirtyRects] need to be re-rendered.
      */
+    @Synchronized
     fun render(
         bitmap: Bitmap,
         startX: Int = 0,
         startY: Int = 0,
         drawWidth: Int = bitmap.width,
         drawHeight: Int = bitmap.height,
-        renderAnnot: Boolean = true
+        renderAnnot: Boolean = true,
+        form: com.hyntix.pdfium.form.PdfForm? = null,
+        clip: android.graphics.Rect? = null
     ) {
         checkNotClosed()
-        core.renderPageBitmap(pagePtr, bitmap, startX, startY, drawWidth, drawHeight, renderAnnot)
+        closeRenderSession()
+        if (form == null && clip == null) {
+            core.renderPageBitmap(pagePtr, bitmap, startX, startY, drawWidth, drawHeight, renderAnnot)
+            return
+        }
+        val clipRect = clip?.let { intArrayOf(it.left, it.top, it.right, it.bottom) }
+        core.renderPageWithForm(
+            pagePtr, formPointer(form), bitmap, startX, startY, drawWidth, drawHeight, 0, renderAnnot, clipRect
+        )
+    }
+
+    /**
+     * Bounds of the form field that has focus, in the pixels of a render with the
+     * given drawing area. Use it as the `clip` of [render] after a keystroke or
+     * click sent to [form] to redraw just that field.
+     *
+     * @return The bounds, or null if no field on this page has focus
+     */
+    fun getFocusedFieldBounds(
+        form: com.hyntix.pdfium.form.PdfForm,
+        startX: Int,
+        startY: Int,
+        drawWidth: Int,
+        drawHeight: Int,
+        rotate: Int = 0
+    ): android.graphics.Rect? {
+        checkNotClosed()
+        val out = IntArray(4)
+        val formPtr = formPointer(form)
+        if (!core.getFocusedFieldDeviceRect(formPtr, pagePtr, startX, startY, drawWidth, drawHeight, rotate, out)) {
+            return null
+        }
+        return android.graphics.Rect(out[0], out[1], out[2], out[3])
+    }
+
+    /**
+     * Take the areas the form layer has asked to repaint since the last call,
+     * mapped to the pixels of a render with the given drawing area.
+     *
+     * PDFium reports them while handling input sent through [com.hyntix.pdfium.form.PdfForm]:
+     * a keystroke in a text field queues that field's rect, a click on a check
+     * box queues the box. Re-render each one with the `clip` of [render] instead
+     * of redrawing the page.
+     *
+     * @return Dirty rects, empty if nothing changed
+     */
+    fun pollFormDirtyRects(
+        startX: Int,
+        startY: Int,
+        drawWidth: Int,
+        drawHeight: Int,
+        rotate: Int = 0
+    ): List<android.graphics.Rect> {
+        checkNotClosed()
+        val packed = core.pollFormDirtyRects(pagePtr, startX, startY, drawWidth, drawHeight, rotate)
+            ?: return emptyList()
+        return List(packed.size / 4) {
+            android.graphics.Rect(packed[it * 4], packed[it * 4 + 1], packed[it * 4 + 2], packed[it * 4 + 3])
+        }
+    }
+
+    private fun formPointer(form: com.hyntix.pdfium.form.PdfForm?): Long {
+        if (form == null) return 0L
+        check(!form.isClosed()) { "Form has been closed" }
+        return form.formPtr
+    }
+
+    /**
+     * Start a progressive render of the page into [bitmap].
+     *
+     * Drive it with [PdfRenderSession.step] once per frame and stop it with
+     * [PdfRenderSession.cancel], for example when the page scrolls out of view.
+     * A page has at most one session: starting another one, rendering the page in
+     * any other way, or closing the page closes the current session.
+     *
+     * @param bitmap The target bitmap. Must be mutable and configured as ARGB_8888,
+     *        RGB_565 or ALPHA_8 (see [render]). It stays locked until the session is closed.
+     * @param startX X-coordinate of the upper-left corner of the drawing area.
+     * @param startY Y-coordinate of the upper-left corner of the drawing area.
+     * @param drawWidth Width of the drawing area.
+     * @param drawHeight Height of the drawing area.
+     * @param rotate Page orientation: 0 (normal), 1 (90° clockwise), 2 (180°), 3 (90° counter-clockwise).
+     * @param renderAnnot Whether to render annotations.
+     * @param form Form whose fields are drawn once the content is done, or null.
+     *        It must stay open until the session is closed.
+     */
+    @Synchronized
+    fun startRender(
+        bitmap: Bitmap,
+        startX: Int = 0,
+        startY: Int = 0,
+        drawWidth: Int = bitmap.width,
+        drawHeight: Int = bitmap.height,
+        rotate: Int = 0,
+        renderAnnot: Boolean = true,
+        form: com.hyntix.pdfium.form.PdfForm? = null
+    ): PdfRenderSession {
+        checkNotClosed()
+        closeRenderSession()
+        val sessionPtr = core.openRenderSession(
+            bitmap, pagePtr, startX, startY, drawWidth, drawHeight, rotate, renderAnnot, formPointer(form)
+        )
+        if (sessionPtr == 0L) {
+            throw IllegalStateException("Failed to start render session")
+        }
+        return PdfRenderSession(core, sessionPtr, this).also { renderSession = it }
+    }
+
+    @Synchronized
+    internal fun onRenderSessionClosed(session: PdfRenderSession) {
+        if (renderSession === session) renderSession = null
+    }
+
+    // PDFium keeps one progressive renderer per page, and any other render replaces it
+    private fun closeRenderSession() {
+        renderSession?.close()
+        renderSession = null
+    }
+
+    /**
+     * Render a set of tiles of the page at [zoom] into caller-owned bitmaps.
+     *
+     * The page is divided into a grid of `pool.tileWidth x pool.tileHeight` tiles
+     * of the page scaled by [zoom] pixels per point. Each tile is rendered into a
+     * pooled target and copied into the bitmap at the same position in [bitmaps].
+     * Bitmaps must be ARGB_8888; a smaller bitmap receives the top-left part of
+     * its tile.
+     *
+     * @param pool Heap-backed tile pool
+     * @param zoom Scale in pixels per point (1/72 inch)
+     * @param tiles Tiles to render
+     * @param bitmaps One target bitmap per tile
+     * @param renderAnnot Whether to render annotations
+     * @param form Form whose fields are drawn into each tile, or null
+     * @return Number of tiles rendered
+     */
+    @Synchronized
+    fun renderTiles(
+        pool: PdfTilePool,
+        zoom: Float,
+        tiles: List<PdfTile>,
+        bitmaps: List<Bitmap>,
+        renderAnnot: Boolean = true,
+        form: com.hyntix.pdfium.form.PdfForm? = null
+    ): Int {
+        checkNotClosed()
+        closeRenderSession()
+        require(!pool.usesHardwareBuffers) { "Pool renders into HardwareBuffers" }
+        require(tiles.size == bitmaps.size) { "Expected one bitmap per tile" }
+        require(zoom > 0f) { "Zoom must be positive" }
+        val coords = tileCoordinates(tiles)
+        return pool.withPointer { poolPtr ->
+            core.renderTilesToBitmaps(pagePtr, poolPtr, zoom, coords, bitmaps.toTypedArray(), renderAnnot, formPointer(form))
+        }
+    }
+
+    /**
+     * Render a set of tiles of the page at [zoom] into pooled `HardwareBuffer`s.
+     *
+     * Tiles stay leased from [pool] until closed. Rendering stops early when the
+     * pool has no free targets left, so the result may be shorter than [tiles];
+     * it is in the same order.
+     *
+     * @param pool Tile pool created with `useHardwareBuffers = true`
+     * @param zoom Scale in pixels per point (1/72 inch)
+     * @param tiles Tiles to render
+     * @param renderAnnot Whether to render annotations
+     * @param form Form whose fields are drawn into each tile, or null
+     * @return Rendered tiles, to be closed by the caller
+     */
+    @Synchronized
+    fun renderTilesToHardwareBuffers(
+        pool: PdfTilePool,
+        zoom: Float,
+        tiles: List<PdfTile>,
+        renderAnnot: Boolean = true,
+        form: com.hyntix.pdfium.form.PdfForm? = null
+    ): List<PdfRenderedTile> {
+        checkNotClosed()
+        closeRenderSession()
+        require(pool.usesHardwareBuffers) { "Pool renders into heap bitmaps" }
+        require(zoom > 0f) { "Zoom must be positive" }
+        val coords = tileCoordinates(tiles)
+        val slots = IntArray(tiles.size)
+        return pool.withPointer { poolPtr ->
+            val buffers = core.renderTilesToHardwareBuffers(pagePtr, poolPtr, zoom, coords, slots, renderAnnot, formPointer(form))
+                ?: return@withPointer emptyList()
+            buffers.mapIndexed { i, buffer -> PdfRenderedTile(pool, slots[i], tiles[i], buffer) }
+        }
+    }
+
+    private fun tileCoordinates(tiles: List<PdfTile>): IntArray {
+        val coords = IntArray(tiles.size * 2)
+        tiles.forEachIndexed { i, tile ->
+            coords[i * 2] = tile.column
+            coords[i * 2 + 1] = tile.row
+        }
+        return coords
+    }
+
+    /**
+     * Render the whole page as packed RGBA_8888 into an ashmem region.
+     * Used by render worker processes; see [com.hyntix.pdfium.render.PdfRenderPool].
+     */
+    @Synchronized
+    internal fun renderToSharedMemory(fd: Int, width: Int, height: Int, renderAnnot: Boolean): Boolean {
+        checkNotClosed()
+        closeRenderSession()
+        return core.renderPageToSharedMemory(pagePtr, fd, width, height, renderAnnot)
     }
 
     /**
@@ -76,62 +300,45 @@ class PdfPage internal constructor(
     /**
      * Get all annotations on the page.
      */
-    fun getAnnotations(): List<PdfAnnotation> {
+    fun getAnnotations(): List<PdfAnnotation> =
+        getAllAnnotations(PageAnnotation.FIELD_RECT).map { PdfAnnotation(it.rect, it.subtype) }
+
+    /**
+     * Read every annotation on the page in a single native call.
+     *
+     * @param fields Property groups to read, a combination of the
+     * [PageAnnotation] `FIELD_*` constants. Groups left out keep their defaults.
+     */
+    fun getAllAnnotations(fields: Int = PageAnnotation.FIELD_ALL): List<PageAnnotation> {
         checkNotClosed()
-        val count = core.getAnnotCount(pagePtr)
-        val annotations = ArrayList<PdfAnnotation>(count)
-        
-        for (i in 0 until count) {
-            val annotPtr = core.getAnnot(pagePtr, i)
-            if (annotPtr != 0L) {
-                val subtype = core.getAnnotSubtype(annotPtr)
-                val rectArray = core.getAnnotRect(annotPtr)
-                val rect = android.graphics.RectF(
-                    rectArray[0].toFloat(),
-                    rectArray[1].toFloat(),
-                    rectArray[2].toFloat(),
-                    rectArray[3].toFloat()
-                )
-                annotations.add(PdfAnnotation(rect, subtype))
-                core.closeAnnot(annotPtr)
-            }
-        }
-        return annotations
+        val bytes = core.getAllAnnotations(pagePtr, fields) ?: return emptyList()
+        return AnnotationBatchReader.decode(bytes)
     }
 
     /**
      * Get all links on the page.
      */
-    fun getLinks(): List<PdfLink> {
-        checkNotClosed()
-        val count = core.getAnnotCount(pagePtr)
-        val links = ArrayList<PdfLink>()
-
-        for (i in 0 until count) {
-            val annotPtr = core.getAnnot(pagePtr, i)
-            if (annotPtr != 0L) {
-                val subtype = core.getAnnotSubtype(annotPtr)
-                if (subtype == 2) { // FPDF_ANNOT_LINK
-                    val rectArray = core.getAnnotRect(annotPtr)
-                    val rect = android.graphics.RectF(
-                        rectArray[0].toFloat(), rectArray[1].toFloat(),
-                        rectArray[2].toFloat(), rectArray[3].toFloat()
-                    )
-
-                    val linkPtr = core.getLinkFromAnnot(annotPtr)
-                    val destIndex = core.getLinkDestIndex(docPtr, linkPtr)
-                    val uri = core.getLinkURI(docPtr, linkPtr)
+    fun getLinks(): List<PdfLink> = getLinkMap(includeWebLinks = false).links
 
-                    links.add(PdfLink(rect, destIndex, uri))
-                }
-                core.closeAnnot(annotPtr)
-            }
-        }
-        return links
+    /**
+     * Read every link on the page in a single native call and index it for hit testing.
+     *
+     * Keep the returned map for the lifetime of the page view and call
+     * [PdfLinkMap.hitTest] on touch events; no native call is made per tap.
+     *
+     * @param includeWebLinks Also include URLs detected in the page text
+     */
+    fun getLinkMap(includeWebLinks: Boolean = true): PdfLinkMap {
+        checkNotClosed()
+        val buffer = core.getPageLinks(docPtr, pagePtr, includeWebLinks)
+            ?: java.nio.ByteBuffer.allocate(16)
+        return PdfLinkMap(buffer)
     }
 
     /**
      * Get a link at the specified coordinates.
+     *
+     * Each call crosses into native code; for repeated hit tests use [getLinkMap].
      */
     fun getLinkAt(x: Double, y: Double): PdfLink? {
         checkNotClosed()
@@ -152,8 +359,10 @@ class PdfPage internal constructor(
     /**
      * Close the page and release native resources.
      */
+    @Synchronized
     override fun close() {
         if (!isClosed) {
+            closeRenderSession()
             core.closePage(pagePtr)
             isClosed = true
         }
@@ -288,46 +497,31 @@ class PdfPage internal constructor(
         checkNotClosed()
         if (formPtr == 0L) return null
         
-        val count = core.getFormFieldCount(formPtr, pagePtr)
-        
-        for (i in 0 until count) {
-            val annotPtr = core.getFormFieldAtIndex(formPtr, pagePtr, i)
-            if (annotPtr != 0L) {
-                val typeValue = core.getFormFieldType(formPtr, annotPtr)
-                val type = com.hyntix.pdfium.form.FormFieldType.fromValue(typeValue)
-                
-                // Only process actual form fields (not all annotations)
-                if (type != com.hyntix.pdfium.form.FormFieldType.UNKNOWN) {
-                    val fieldName = core.getFormFieldName(formPtr, annotPtr)
-                    
-                    if (fieldName == name) {
-                        // Found the field - get its details
-                        val value = core.getFormFieldValue(formPtr, annotPtr)
-                        val rectArray = core.getAnnotRect(annotPtr)
-                        val rect = android.graphics.RectF(
-                            rectArray[0].toFloat(),
-                            rectArray[1].toFloat(),
-                            rectArray[2].toFloat(),
-                            rectArray[3].toFloat()
-                        )
-                        
-                        return com.hyntix.pdfium.form.FormField(
-                            name = fieldName,
-                            type = type,
-                            value = value,
-                            pageIndex = index,
-                            rect = rect,
-                            annotPtr = annotPtr
-                        )
-                    } else {
-                        // Not the field we're looking for, close it
-                        core.closeAnnot(annotPtr)
-                    }
-                } else {
-                    // Not a form field, close it
-                    core.closeAnnot(annotPtr)
-                }
-            }
+        // The document's field-name index says which annotations to look at
+        val widgets = core.findFormField(formPtr, docPtr, name) ?: return null
+        for (w in widgets.indices step 2) {
+            if (widgets[w] != index) continue
+            val annotPtr = core.getFormFieldAtIndex(formPtr, pagePtr, widgets[w + 1])
+            if (annotPtr == 0L) continue
+            
+            val type = com.hyntix.pdfium.form.FormFieldType.fromValue(core.getFormFieldType(formPtr, annotPtr))
+            val value = core.getFormFieldValue(formPtr, annotPtr)
+            val rectArray = core.getAnnotRect(annotPtr)
+            val rect = android.graphics.RectF(
+                rectArray[0].toFloat(),
+                rectArray[1].toFloat(),
+                rectArray[2].toFloat(),
+                rectArray[3].toFloat()
+            )
+            
+            return com.hyntix.pdfium.form.FormField(
+                name = name,
+                type = type,
+                value = value,
+                pageIndex = index,
+                rect = rect,
+                annotPtr = annotPtr
+            )
         }
         
         return null
@@ -392,11 +586,50 @@ class PdfPage internal constructor(
         return options
     }
 
+    /**
+     * Document serial and edit revision of this page; see [PdfiumCore.getPageRevision].
+     */
+    internal fun getRevision(): LongArray {
+        checkNotClosed()
+        return core.getPageRevision(docPtr, index)
+    }
+
     internal fun getPointer(): Long {
         checkNotClosed()
         return pagePtr
     }
 
+    // =========================================================================
+    // Page Content API
+    // =========================================================================
+
+    /**
+     * Place [images] on this page, in order, on top of the existing content.
+     *
+     * All images are inserted in one native call and the page content stream
+     * is regenerated once at the end. Insertion stops at the first image that
+     * can't be read; the images before it stay on the page.
+     *
+     * @return Number of images placed
+     */
+    fun insertImages(images: List<PdfPageImage>): Int {
+        checkNotClosed()
+        if (images.isEmpty()) return 0
+        val bitmaps = Array(images.size) { images[it].bitmap }
+        val fds = IntArray(images.size) { images[it].jpeg?.fd ?: -1 }
+        val matrices = FloatArray(images.size * 6)
+        images.forEachIndexed { i, image -> image.matrix.copyInto(matrices, i * 6) }
+        return core.insertImages(docPtr, pagePtr, bitmaps, fds, matrices)
+    }
+
+    /**
+     * Place one image on this page. Prefer [insertImages] for several images,
+     * which regenerates the page content only once.
+     *
+     * @return True if the image was placed
+     */
+    fun insertImage(image: PdfPageImage): Boolean = insertImages(listOf(image)) == 1
+
     // =========================================================================
     // Annotation API
     // =========================================================================
@@ -422,38 +655,9 @@ class PdfPage internal constructor(
             return false
         }
         
-        // Create the annotation
-        val annotPtr = core.createAnnot(pagePtr, 9) // FPDF_ANNOT_HIGHLIGHT = 9
-        if (annotPtr == 0L) return false
-        
-        try {
-            // Set quad points
-            val allPoints = DoubleArray(quadPoints.size * 8)
-            quadPoints.forEachIndexed { index, points ->
-                System.arraycopy(points, 0, allPoints, index * 8, 8)
-            }
-            core.setAnnotQuadPoints(annotPtr, allPoints)
-            
-            // Set color (FPDFANNOT_COLORTYPE_Color = 0)
-            core.setAnnotColor(annotPtr, 0, color.red, color.green, color.blue, color.alpha)
-            
-            // Set opacity
-            core.setAnnotOpacity(annotPtr, color.alpha / 255.0f)
-            
-            // Set contents if provided
-            if (contents.isNotEmpty()) {
-                core.setAnnotContents(annotPtr, contents)
-            }
-            
-            // Set author if provided
-            if (author.isNotEmpty()) {
-                core.setAnnotAuthor(annotPtr, author)
-            }
-            
-            return true
-        } finally {
-            core.closeAnnot(annotPtr)
-        }
+        return beginAnnotationTransaction()
+            .create(com.hyntix.pdfium.annotation.AnnotationType.HIGHLIGHT, markupChanges(quadPoints, contents, author, color))
+            .commit(regenerateAppearances = false) == 1
     }
 
     /**
@@ -477,38 +681,9 @@ class PdfPage internal constructor(
             return false
         }
         
-        // Create the annotation
-        val annotPtr = core.createAnnot(pagePtr, 10) // FPDF_ANNOT_UNDERLINE = 10
-        if (annotPtr == 0L) return false
-        
-        try {
-            // Set quad points
-            val allPoints = DoubleArray(quadPoints.size * 8)
-            quadPoints.forEachIndexed { index, points ->
-                System.arraycopy(points, 0, allPoints, index * 8, 8)
-            }
-            core.setAnnotQuadPoints(annotPtr, allPoints)
-            
-            // Set color
-            core.setAnnotColor(annotPtr, 0, color.red, color.green, color.blue, color.alpha)
-            
-            // Set opacity
-            core.setAnnotOpacity(annotPtr, color.alpha / 255.0f)
-            
-            // Set contents if provided
-            if (contents.isNotEmpty()) {
-                core.setAnnotContents(annotPtr, contents)
-            }
-            
-            // Set author if provided
-            if (author.isNotEmpty()) {
-                core.setAnnotAuthor(annotPtr, author)
-            }
-            
-            return true
-        } finally {
-            core.closeAnnot(annotPtr)
-        }
+        return beginAnnotationTransaction()
+            .create(com.hyntix.pdfium.annotation.AnnotationType.UNDERLINE, markupChanges(quadPoints, contents, author, color))
+            .commit(regenerateAppearances = false) == 1
     }
 
     /**
@@ -532,38 +707,9 @@ class PdfPage internal constructor(
             return false
         }
         
-        // Create the annotation
-        val annotPtr = core.createAnnot(pagePtr, 12) // FPDF_ANNOT_STRIKEOUT = 12
-        if (annotPtr == 0L) return false
-        
-        try {
-            // Set quad points
-            val allPoints = DoubleArray(quadPoints.size * 8)
-            quadPoints.forEachIndexed { index, points ->
-                System.arraycopy(points, 0, allPoints, index * 8, 8)
-            }
-            core.setAnnotQuadPoints(annotPtr, allPoints)
-            
-            // Set color
-            core.setAnnotColor(annotPtr, 0, color.red, color.green, color.blue, color.alpha)
-            
-            // Set opacity
-            core.setAnnotOpacity(annotPtr, color.alpha / 255.0f)
-            
-            // Set contents if provided
-            if (contents.isNotEmpty()) {
-                core.setAnnotContents(annotPtr, contents)
-            }
-            
-            // Set author if provided
-            if (author.isNotEmpty()) {
-                core.setAnnotAuthor(annotPtr, author)
-            }
-            
-            return true
-        } finally {
-            core.closeAnnot(annotPtr)
-        }
+        return beginAnnotationTransaction()
+            .create(com.hyntix.pdfium.annotation.AnnotationType.STRIKEOUT, markupChanges(quadPoints, contents, author, color))
+            .commit(regenerateAppearances = false) == 1
     }
 
     /**
@@ -587,45 +733,98 @@ class PdfPage internal constructor(
             return false
         }
         
-        // Create the annotation
-        val annotPtr = core.createAnnot(pagePtr, 15) // FPDF_ANNOT_INK = 15
+        return beginAnnotationTransaction()
+            .createInk(inkList, contents, author, color)
+            .commit(regenerateAppearances = false) == 1
+    }
+
+    /**
+     * Read the strokes of an ink annotation as flat arrays.
+     *
+     * @param index The 0-based index of the annotation
+     * @return The strokes, or null if the annotation has none
+     */
+    fun getInkStrokes(index: Int): com.hyntix.pdfium.annotation.InkStrokes? {
+        checkNotClosed()
+        val annotPtr = core.getAnnot(pagePtr, index)
+        if (annotPtr == 0L) return null
+
+        return try {
+            core.getAnnotInk(annotPtr)
+        } finally {
+            core.closeAnnot(annotPtr)
+        }
+    }
+
+    /**
+     * Replace the strokes of an ink annotation.
+     *
+     * @param index The 0-based index of the annotation
+     * @param ink The new strokes
+     * @return True if the strokes were written
+     */
+    fun setInkStrokes(index: Int, ink: com.hyntix.pdfium.annotation.InkStrokes): Boolean {
+        checkNotClosed()
+        val annotPtr = core.getAnnot(pagePtr, index)
         if (annotPtr == 0L) return false
-        
-        try {
-            // Convert InkPath list to array of DoubleArray
-            val inkArray = Array(inkList.size) { i ->
-                val path = inkList[i]
-                val points = path.points
-                DoubleArray(points.size * 2) { j ->
-                    if (j % 2 == 0) points[j / 2][0] else points[j / 2][1]
-                }
-            }
-            
-            // Set ink list
-            core.setAnnotInkList(annotPtr, inkArray)
-            
-            // Set color
-            core.setAnnotColor(annotPtr, 0, color.red, color.green, color.blue, color.alpha)
-            
-            // Set opacity
-            core.setAnnotOpacity(annotPtr, color.alpha / 255.0f)
-            
-            // Set contents if provided
-            if (contents.isNotEmpty()) {
-                core.setAnnotContents(annotPtr, contents)
-            }
-            
-            // Set author if provided
-            if (author.isNotEmpty()) {
-                core.setAnnotAuthor(annotPtr, author)
-            }
-            
-            return true
+
+        return try {
+            core.setAnnotInk(annotPtr, ink)
         } finally {
             core.closeAnnot(annotPtr)
         }
     }
 
+    /**
+     * Append one stroke to an ink annotation, leaving the existing strokes
+     * untouched. Meant for live inking, where rewriting the InkList per
+     * stroke gets slow.
+     *
+     * @param index The 0-based index of the annotation
+     * @param points x/y pairs; may be a reused buffer larger than the stroke
+     * @param start Index of the first point of the stroke in [points]
+     * @param count Number of points in the stroke
+     * @return The index of the new stroke, or -1 on failure
+     */
+    fun appendInkStroke(index: Int, points: FloatArray, start: Int = 0, count: Int = points.size / 2): Int {
+        checkNotClosed()
+        val annotPtr = core.getAnnot(pagePtr, index)
+        if (annotPtr == 0L) return -1
+
+        return try {
+            core.appendAnnotInkStroke(annotPtr, points, start, count)
+        } finally {
+            core.closeAnnot(annotPtr)
+        }
+    }
+
+    private fun markupChanges(
+        quadPoints: List<DoubleArray>,
+        contents: String,
+        author: String,
+        color: com.hyntix.pdfium.annotation.AnnotationColor
+    ) = com.hyntix.pdfium.annotation.AnnotationChanges(
+        color = color,
+        opacity = color.alpha / 255.0f,
+        contents = contents.ifEmpty { null },
+        author = author.ifEmpty { null },
+        quadPoints = quadPoints
+    )
+
+    /**
+     * Start a batch of annotation edits that is applied in one native pass.
+     * See [AnnotationTransaction] for the ordering of queued operations.
+     */
+    fun beginAnnotationTransaction(): AnnotationTransaction {
+        checkNotClosed()
+        return AnnotationTransaction(this)
+    }
+
+    internal fun applyAnnotationEdits(data: ByteArray, appearanceFlags: Int): Int {
+        checkNotClosed()
+        return core.applyAnnotationEdits(pagePtr, data, appearanceFlags)
+    }
+
     /**
      * Remove an annotation from the page by index.
      * 
@@ -0,0 +1,59 @@
+package com.hyntix.pdfium
+
+import android.graphics.Bitmap
+import android.os.ParcelFileDescriptor
+
+/**
+ * An image to place on a page with [PdfPage.insertImages].
+ *
+ * Bitmaps are converted natively and stored losslessly, so their content is
+ * read at insert time and they can be recycled afterwards. JPEGs are copied
+ * into the document as they are, with no decode or re-encode; the descriptor
+ * is read from offset 0 at insert time and is not closed.
+ *
+ * @property matrix Six floats a, b, c, d, e, f mapping the unit square of the
+ *   image to page space, as in a PDF `cm` operator
+ */
+class PdfPageImage private constructor(
+    internal val bitmap: Bitmap?,
+    internal val jpeg: ParcelFileDescriptor?,
+    val matrix: FloatArray
+) {
+    init {
+        require(matrix.size == 6) { "Matrix must have six elements" }
+        bitmap?.let {
+            require(it.config in SUPPORTED_CONFIGS) { "Unsupported bitmap config ${it.config}" }
+            require(!it.isRecycled) { "Bitmap is recycled" }
+        }
+    }
+
+    companion object {
+        private val SUPPORTED_CONFIGS = setOf(Bitmap.Config.ARGB_8888, Bitmap.Config.RGB_565, Bitmap.Config.ALPHA_8)
+
+        /**
+         * [bitmap] stretched over the rectangle at ([left], [bottom]) of size
+         * [width] x [height], in page points. ARGB_8888, RGB_565 and ALPHA_8
+         * bitmaps are supported; ALPHA_8 is drawn as a black mask.
+         */
+        fun bitmap(bitmap: Bitmap, left: Float, bottom: Float, width: Float, height: Float) =
+            PdfPageImage(bitmap, null, rectMatrix(left, bottom, width, height))
+
+        /** [bitmap] placed by an explicit [matrix]. */
+        fun bitmap(bitmap: Bitmap, matrix: FloatArray) = PdfPageImage(bitmap, null, matrix.copyOf())
+
+        /**
+         * The JPEG behind [descriptor] stretched over the rectangle at
+         * ([left], [bottom]) of size [width] x [height], in page points.
+         */
+        fun jpeg(descriptor: ParcelFileDescriptor, left: Float, bottom: Float, width: Float, height: Float) =
+            PdfPageImage(null, descriptor, rectMatrix(left, bottom, width, height))
+
+        /** The JPEG behind [descriptor] placed by an explicit [matrix]. */
+        fun jpeg(descriptor: ParcelFileDescriptor, matrix: FloatArray) = PdfPageImage(null, descriptor, matrix.copyOf())
+
+        private fun rectMatrix(left: Float, bottom: Float, width: Float, height: Float): FloatArray {
+            require(width > 0f && height > 0f) { "Image size must be positive" }
+            return floatArrayOf(width, 0f, 0f, height, left, bottom)
+        }
+    }
+}
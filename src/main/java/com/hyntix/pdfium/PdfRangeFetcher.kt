@@ -0,0 +1,19 @@
+package com.hyntix.pdfium
+
+/**
+ * Supplies byte ranges of a remote PDF for progressive loading.
+ *
+ * Implementations typically issue HTTP range requests against object storage.
+ * Calls are made synchronously on the thread that opens the document or
+ * accesses a page that has not fully arrived yet.
+ *
+ * @see PdfiumCore.openDocument
+ */
+fun interface PdfRangeFetcher {
+    /**
+     * Fetch [size] bytes starting at [position].
+     *
+     * @return Exactly [size] bytes, or null if the range could not be fetched
+     */
+    fun fetch(position: Long, size: Int): ByteArray?
+}
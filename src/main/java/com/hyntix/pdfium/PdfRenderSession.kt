@@ -0,0 +1,104 @@
+package com.hyntix.pdfium
+
+import java.io.Closeable
+
+/**
+ * A progressive render of a page into a bitmap, advanced in time slices.
+ *
+ * Each [step] renders until its time budget runs out, then returns, keeping the
+ * bitmap locked and PDFium's renderer state so the next step resumes where this
+ * one stopped. That lets a render thread interleave a heavy vector page with
+ * other work, one frame at a time. [cancel] can be called from any thread and
+ * stops a step in progress at PDFium's next pause check.
+ *
+ * Create instances using [PdfPage.startRender]. Always call [close] when done to
+ * unlock the bitmap; its pixels are only complete once [status] is [Status.DONE].
+ */
+class PdfRenderSession internal constructor(
+    private val core: PdfiumCore,
+    private val sessionPtr: Long,
+    private val page: PdfPage
+) : Closeable {
+
+    enum class Status {
+        /** More steps are needed. */
+        IN_PROGRESS,
+        /** The page is fully rendered. */
+        DONE,
+        /** [cancel] was called before the render finished. */
+        CANCELLED,
+        /** PDFium reported an error. */
+        FAILED
+    }
+
+    companion object {
+        /** About half a 60 Hz frame. */
+        const val DEFAULT_STEP_BUDGET_NANOS = 8_000_000L
+    }
+
+    // Guards the native session between cancel() and close(); step() holds the
+    // session monitor for its whole duration, so cancel() cannot use it.
+    private val cancelLock = Any()
+
+    @Volatile
+    private var isClosed = false
+
+    @Volatile
+    private var isCancelled = false
+
+    @Volatile
+    var status: Status = Status.IN_PROGRESS
+        private set
+
+    /**
+     * Render for up to [budgetNanos].
+     *
+     * PDFium checks the deadline between page objects, so a single step can run
+     * somewhat over budget on pages with very large objects.
+     *
+     * @return Status after this step
+     */
+    @Synchronized
+    fun step(budgetNanos: Long = DEFAULT_STEP_BUDGET_NANOS): Status {
+        if (isClosed || status != Status.IN_PROGRESS) return status
+        val result = core.renderSessionStep(sessionPtr, budgetNanos)
+        status = when {
+            result == PdfiumCore.RENDER_DONE -> Status.DONE
+            result == PdfiumCore.RENDER_FAILED -> Status.FAILED
+            isCancelled -> Status.CANCELLED
+            else -> Status.IN_PROGRESS
+        }
+        return status
+    }
+
+    /**
+     * Stop the render. A step in progress returns [Status.CANCELLED] shortly
+     * after. Safe to call from any thread.
+     */
+    fun cancel() {
+        isCancelled = true
+        synchronized(cancelLock) {
+            if (!isClosed) core.cancelRenderSession(sessionPtr)
+        }
+    }
+
+    /**
+     * Check if the session has been closed.
+     */
+    fun isClosed(): Boolean = isClosed
+
+    override fun close() {
+        if (isClosed) return
+        // Stop any step in progress so we do not wait out its budget
+        if (status == Status.IN_PROGRESS) cancel()
+        synchronized(this) {
+            synchronized(cancelLock) {
+                if (isClosed) return
+                isClosed = true
+                if (status == Status.IN_PROGRESS) status = Status.CANCELLED
+                core.closeRenderSession(sessionPtr)
+            }
+        }
+        page.onRenderSessionClosed(this)
+    }
+}
@@ -0,0 +1,22 @@
+package com.hyntix.pdfium
+
+/**
+ * How [PdfDocument.save] writes a document. Values map to the FPDF_SaveAsCopy flags.
+ */
+enum class PdfSaveMode(internal val flags: Int) {
+    /**
+     * Rewrite the whole document.
+     */
+    FULL(0),
+
+    /**
+     * Write the source file unchanged followed by an update section holding
+     * only the changes (FPDF_INCREMENTAL). Existing signatures stay valid.
+     */
+    INCREMENTAL(1),
+
+    /**
+     * Rewrite the whole document without its encryption (FPDF_REMOVE_SECURITY).
+     */
+    REMOVE_SECURITY(3)
+}
@@ -0,0 +1,55 @@
+package com.hyntix.pdfium
+
+import android.graphics.RectF
+
+/**
+ * All search hits on one page, in the packed form they come back from native code.
+ *
+ * Hit `i` covers [count]`(i)` characters starting at [startIndex]`(i)`, highlighted
+ * by rects `rectOffsets[i] until rectOffsets[i + 1]`. Rects are stored as
+ * left, top, right, bottom in page coordinates (points, origin bottom-left).
+ */
+class PdfSearchBatch internal constructor(
+    val pageIndex: Int,
+    private val starts: IntArray,
+    private val counts: IntArray,
+    private val rectOffsets: IntArray,
+    /** Packed left/top/right/bottom of every hit's rects. */
+    val rects: FloatArray
+) {
+    /** Number of hits on the page. */
+    val hitCount: Int get() = starts.size
+
+    /** Index of the first character of hit [hit]. */
+    fun startIndex(hit: Int): Int = starts[hit]
+
+    /** Number of characters in hit [hit]. */
+    fun count(hit: Int): Int = counts[hit]
+
+    /** Number of rects highlighting hit [hit]. */
+    fun rectCount(hit: Int): Int = rectOffsets[hit + 1] - rectOffsets[hit]
+
+    /**
+     * Rects highlighting hit [hit].
+     */
+    fun rectsOf(hit: Int): List<RectF> {
+        val rectList = ArrayList<RectF>(rectCount(hit))
+        for (r in rectOffsets[hit] until rectOffsets[hit + 1]) {
+            rectList.add(RectF(rects[r * 4], rects[r * 4 + 1], rects[r * 4 + 2], rects[r * 4 + 3]))
+        }
+        return rectList
+    }
+
+    /**
+     * Hits as [PdfTextSearchMatch]es, as returned by [PdfTextPage.search].
+     */
+    fun toMatches(): List<PdfTextSearchMatch> = List(hitCount) { PdfTextSearchMatch(starts[it], counts[it]) }
+}
+
+/**
+ * Receives packed per-page hits from native code.
+ */
+internal fun interface PdfSearchCallback {
+    /** @return false to stop the search */
+    fun onPage(pageIndex: Int, starts: IntArray, counts: IntArray, rectOffsets: IntArray, rects: FloatArray): Boolean
+}
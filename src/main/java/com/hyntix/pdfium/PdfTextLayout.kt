@@ -0,0 +1,207 @@
+package com.hyntix.pdfium
+
+import android.graphics.RectF
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Snapshot of a text page's layout for hit-testing and selection on the JVM.
+ *
+ * Text, char boxes, font sizes and line rects are read in one native call by
+ * [PdfTextPage.getLayout]; nothing here calls into PDFium, so the layout stays
+ * usable after the text page is closed.
+ *
+ * Coordinates are page coordinates in points, with y growing upwards
+ * (`top >= bottom`). Char indices match [PdfTextPage] indices.
+ */
+class PdfTextLayout internal constructor(buffer: ByteBuffer) {
+
+    /** Number of chars, including the line breaks PDFium inserts. */
+    val charCount: Int
+
+    /** Number of text lines. */
+    val lineCount: Int
+
+    /** Page text, one UTF-16 unit per char index. */
+    val text: String
+
+    private val boxes: FloatArray
+    private val fontSizes: FloatArray
+    private val lines: IntArray
+    private val rects: FloatArray
+
+    init {
+        buffer.order(ByteOrder.nativeOrder())
+        charCount = buffer.getInt(0)
+        lineCount = buffer.getInt(4)
+        val rectCount = buffer.getInt(8)
+        buffer.position(16)
+
+        boxes = FloatArray(charCount * 4).also { buffer.asFloatBuffer().get(it) }
+        buffer.position(buffer.position() + boxes.size * 4)
+        fontSizes = FloatArray(charCount).also { buffer.asFloatBuffer().get(it) }
+        buffer.position(buffer.position() + fontSizes.size * 4)
+        lines = IntArray(lineCount * 4).also { buffer.asIntBuffer().get(it) }
+        buffer.position(buffer.position() + lines.size * 4)
+        rects = FloatArray(rectCount * 4).also { buffer.asFloatBuffer().get(it) }
+        buffer.position(buffer.position() + rects.size * 4)
+        val chars = CharArray(charCount).also { buffer.asCharBuffer().get(it) }
+        text = String(chars)
+    }
+
+    /**
+     * Bounding box of the char at [index].
+     */
+    fun getCharBox(index: Int): RectF {
+        checkCharIndex(index)
+        return RectF(boxes[index * 4], boxes[index * 4 + 1], boxes[index * 4 + 2], boxes[index * 4 + 3])
+    }
+
+    /**
+     * Font size in points of the char at [index].
+     */
+    fun getFontSize(index: Int): Float {
+        checkCharIndex(index)
+        return fontSizes[index]
+    }
+
+    /**
+     * Index of the first char of [line].
+     */
+    fun getLineStart(line: Int): Int {
+        checkLineIndex(line)
+        return lines[line * 4]
+    }
+
+    /**
+     * Number of chars in [line], excluding the trailing line break.
+     */
+    fun getLineCharCount(line: Int): Int {
+        checkLineIndex(line)
+        return lines[line * 4 + 1]
+    }
+
+    /**
+     * Rects PDFium reports for [line]; one per run of text on that line.
+     */
+    fun getLineRects(line: Int): List<RectF> {
+        checkLineIndex(line)
+        val start = lines[line * 4 + 2]
+        return List(lines[line * 4 + 3]) { i -> rectAt(rects, start + i) }
+    }
+
+    /**
+     * Line containing the char at [index], or -1 for a line break char.
+     */
+    fun getLineForChar(index: Int): Int {
+        checkCharIndex(index)
+        var low = 0
+        var high = lineCount - 1
+        while (low <= high) {
+            val mid = (low + high) ushr 1
+            val start = lines[mid * 4]
+            when {
+                index < start -> high = mid - 1
+                index >= start + lines[mid * 4 + 1] -> low = mid + 1
+                else -> return mid
+            }
+        }
+        return -1
+    }
+
+    /**
+     * Char at a page point, like [PdfTextPage.getIndexAtPos] but without a native
+     * call. Among chars whose box, grown by [tolerance], contains the point, the
+     * one with the nearest center wins.
+     *
+     * @return The char index, or -1 if no char is close enough
+     */
+    fun getCharIndexAt(x: Float, y: Float, tolerance: Float = 0f): Int {
+        var best = -1
+        var bestDistance = Float.MAX_VALUE
+        for (line in 0 until lineCount) {
+            if (!lineContains(line, x, y, tolerance)) continue
+            val start = lines[line * 4]
+            for (i in start until start + lines[line * 4 + 1]) {
+                val left = boxes[i * 4] - tolerance
+                val top = boxes[i * 4 + 1] + tolerance
+                val right = boxes[i * 4 + 2] + tolerance
+                val bottom = boxes[i * 4 + 3] - tolerance
+                if (x < left || x > right || y < bottom || y > top) continue
+                val dx = x - (left + right) / 2
+                val dy = y - (top + bottom) / 2
+                val distance = dx * dx + dy * dy
+                if (distance < bestDistance) {
+                    bestDistance = distance
+                    best = i
+                }
+            }
+        }
+        return best
+    }
+
+    /**
+     * Range of the word around the char at [index]. A word is a run of letters
+     * and digits; any other char is a word of its own.
+     */
+    fun getWordRange(index: Int): IntRange {
+        checkCharIndex(index)
+        if (!Character.isLetterOrDigit(text[index])) return index..index
+        var start = index
+        var end = index
+        while (start > 0 && Character.isLetterOrDigit(text[start - 1])) start--
+        while (end < charCount - 1 && Character.isLetterOrDigit(text[end + 1])) end++
+        return start..end
+    }
+
+    /**
+     * Highlight rects for a char range: one rect per line, covering the boxes of
+     * the selected chars on that line.
+     */
+    fun getSelectionRects(startIndex: Int, count: Int): List<RectF> {
+        val end = minOf(startIndex + count, charCount)
+        val start = maxOf(startIndex, 0)
+        val result = ArrayList<RectF>()
+        for (line in 0 until lineCount) {
+            val lineStart = lines[line * 4]
+            val from = maxOf(start, lineStart)
+            val to = minOf(end, lineStart + lines[line * 4 + 1])
+            if (from >= to) continue
+
+            val rect = RectF(Float.MAX_VALUE, -Float.MAX_VALUE, -Float.MAX_VALUE, Float.MAX_VALUE)
+            for (i in from until to) {
+                val left = boxes[i * 4]
+                val right = boxes[i * 4 + 2]
+                if (right <= left) continue    // no ink, e.g. generated spaces
+                rect.left = minOf(rect.left, left)
+                rect.top = maxOf(rect.top, boxes[i * 4 + 1])
+                rect.right = maxOf(rect.right, right)
+                rect.bottom = minOf(rect.bottom, boxes[i * 4 + 3])
+            }
+            if (rect.left <= rect.right) result.add(rect)
+        }
+        return result
+    }
+
+    private fun lineContains(line: Int, x: Float, y: Float, tolerance: Float): Boolean {
+        val start = lines[line * 4 + 2]
+        for (r in start until start + lines[line * 4 + 3]) {
+            if (x >= rects[r * 4] - tolerance && x <= rects[r * 4 + 2] + tolerance &&
+                y <= rects[r * 4 + 1] + tolerance && y >= rects[r * 4 + 3] - tolerance) {
+                return true
+            }
+        }
+        return false
+    }
+
+    private fun rectAt(values: FloatArray, i: Int) =
+        RectF(values[i * 4], values[i * 4 + 1], values[i * 4 + 2], values[i * 4 + 3])
+
+    private fun checkCharIndex(index: Int) {
+        if (index < 0 || index >= charCount) throw IndexOutOfBoundsException("Char index $index out of 0..<$charCount")
+    }
+
+    private fun checkLineIndex(line: Int) {
+        if (line < 0 || line >= lineCount) throw IndexOutOfBoundsException("Line $line out of 0..<$lineCount")
+    }
+}
@@ -16,6 +16,7 @@ class PdfTextPage internal constructor(
     internal val textPagePtr: Long
 ) : Closeable {
 
+    @Volatile
     private var isClosed = false
 
     /**
@@ -96,6 +97,25 @@ class PdfTextPage internal constructor(
         return matches
     }
 
+    /**
+     * Text with one char per char index, and packed left/top/right/bottom boxes
+     * of every char, read in a single native call.
+     */
+    internal fun getTextWithCharBoxes(): Pair<String, FloatArray> {
+        checkNotClosed()
+        return core.getTextWithCharBoxes(textPagePtr)
+    }
+
+    /**
+     * Read the whole page layout (text, char boxes, font sizes and line rects)
+     * in one native call, for hit-testing and selection without further JNI.
+     */
+    fun getLayout(): PdfTextLayout {
+        checkNotClosed()
+        val buffer = core.getTextLayout(textPagePtr) ?: throw IllegalStateException("Failed to read text layout")
+        return PdfTextLayout(buffer)
+    }
+
     /**
      * Get the bounding rectangles for a range of text.
      * Handles multi-line text by returning multiple rectangles.
@@ -118,6 +138,7 @@ class PdfTextPage internal constructor(
         }
         return rects
     }
+    @Synchronized
     override fun close() {
         if (!isClosed) {
             core.closeTextPage(textPagePtr)
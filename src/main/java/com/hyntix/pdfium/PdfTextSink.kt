@@ -0,0 +1,14 @@
+package com.hyntix.pdfium
+
+/**
+ * Receives the text of each page from [PdfDocument.extractText] and
+ * [PdfiumCore.extractText], called from native code on the calling thread.
+ */
+fun interface PdfTextSink {
+    /**
+     * @param pageIndex 0-based page index
+     * @param text Full text of the page
+     * @return false to stop the extraction
+     */
+    fun onPage(pageIndex: Int, text: String): Boolean
+}
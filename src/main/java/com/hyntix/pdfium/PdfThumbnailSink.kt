@@ -0,0 +1,31 @@
+package com.hyntix.pdfium
+
+import android.graphics.Bitmap
+
+/**
+ * Where a thumbnail from [PdfDocument.generateThumbnails] came from.
+ */
+enum class PdfThumbnailSource {
+    /** Scaled from the page's embedded `/Thumb` image. */
+    EMBEDDED,
+
+    /** Rendered at thumbnail size, without annotations or form fields. */
+    RENDERED,
+
+    /** Taken from the [com.hyntix.pdfium.render.PdfRenderCache]. */
+    CACHED
+}
+
+/**
+ * Receives each thumbnail from [PdfDocument.generateThumbnails], on the calling
+ * thread and in page order.
+ */
+fun interface PdfThumbnailSink {
+    /**
+     * @param pageIndex 0-based page index
+     * @param bitmap The thumbnail; see [PdfDocument.generateThumbnails] for who owns it
+     * @param source How the thumbnail was produced
+     * @return false to stop generating
+     */
+    fun onThumbnail(pageIndex: Int, bitmap: Bitmap, source: PdfThumbnailSource): Boolean
+}
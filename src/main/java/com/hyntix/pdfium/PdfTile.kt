@@ -0,0 +1,43 @@
+package com.hyntix.pdfium
+
+import android.hardware.HardwareBuffer
+import java.io.Closeable
+
+/**
+ * Position of a tile in the grid a page is cut into at a given zoom.
+ *
+ * Tile (0, 0) is the top-left corner of the page. Its pixel origin is
+ * (`column * tileWidth`, `row * tileHeight`) of the page rendered at that zoom.
+ */
+data class PdfTile(
+    val column: Int,
+    val row: Int
+)
+
+/**
+ * A tile rendered into a pooled `HardwareBuffer` by [PdfPage.renderTilesToHardwareBuffers].
+ *
+ * The buffer belongs to its [PdfTilePool] and is reused for later tiles once this
+ * is closed. Wrap it with `Bitmap.wrapHardwareBuffer` (API 29+) or sample it
+ * directly from GL/Vulkan, and call [close] when it is no longer displayed.
+ */
+class PdfRenderedTile internal constructor(
+    private val pool: PdfTilePool,
+    private val slot: Int,
+    val tile: PdfTile,
+    /** RGBA_8888 pixels of the tile. */
+    val hardwareBuffer: HardwareBuffer
+) : Closeable {
+
+    @Volatile
+    private var isClosed = false
+
+    @Synchronized
+    override fun close() {
+        if (!isClosed) {
+            isClosed = true
+            hardwareBuffer.close()
+            pool.release(slot)
+        }
+    }
+}
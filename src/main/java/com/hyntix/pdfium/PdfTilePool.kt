@@ -0,0 +1,64 @@
+package com.hyntix.pdfium
+
+import java.io.Closeable
+
+/**
+ * Pre-allocated, fixed-size tile render targets for [PdfPage.renderTiles] and
+ * [PdfPage.renderTilesToHardwareBuffers].
+ *
+ * Rendering through a pool avoids the per-call bitmap setup and full-surface clear
+ * of [PdfPage.render]: each tile is rendered with a translation matrix and a clip
+ * into a target that already exists, and only the tile itself is cleared. A pool
+ * can be shared by all pages and documents of a [PdfiumCore].
+ *
+ * Create instances using [PdfiumCore.createTilePool] and [close] them when done.
+ */
+class PdfTilePool internal constructor(
+    private val core: PdfiumCore,
+    private val poolPtr: Long,
+    /** Tile width in pixels. */
+    val tileWidth: Int,
+    /** Tile height in pixels. */
+    val tileHeight: Int,
+    /** Number of render targets in the pool. */
+    val capacity: Int,
+    /** Whether tiles are rendered into `HardwareBuffer`s rather than heap bitmaps. */
+    val usesHardwareBuffers: Boolean
+) : Closeable {
+
+    companion object {
+        const val DEFAULT_TILE_SIZE = 256
+        const val DEFAULT_CAPACITY = 16
+    }
+
+    @Volatile
+    private var isClosed = false
+
+    fun isClosed(): Boolean = isClosed
+
+    /**
+     * Run [block] with the native pool, keeping [close] from running concurrently.
+     */
+    @Synchronized
+    internal fun <T> withPointer(block: (Long) -> T): T {
+        check(!isClosed) { "Tile pool is closed" }
+        return block(poolPtr)
+    }
+
+    @Synchronized
+    internal fun release(slot: Int) {
+        if (!isClosed) core.releaseTile(poolPtr, slot)
+    }
+
+    /**
+     * Free the render targets. `HardwareBuffer`s of tiles still open stay valid
+     * until those tiles are closed.
+     */
+    @Synchronized
+    override fun close() {
+        if (!isClosed) {
+            isClosed = true
+            core.destroyTilePool(poolPtr)
+        }
+    }
+}
@@ -1,5 +1,14 @@
 package com.hyntix.pdfium
 
+import android.os.CancellationSignal
+import android.os.ParcelFileDescriptor
+import com.hyntix.pdfium.annotation.InkStrokes
+import java.io.File
+import java.io.FileNotFoundException
+import java.io.InputStream
+import java.nio.ByteBuffer
+import java.nio.channels.Channels
+
 /**
  * Core PDFium interface for low-level operations.
  * 
@@ -28,14 +37,34 @@ class PdfiumCore {
         const val RENDER_TOBECONTINUED = 1
         const val RENDER_DONE = 2
         const val RENDER_FAILED = 3
+        
+        // Data availability status codes from fpdf_dataavail.h
+        const val PDF_DATA_ERROR = -1
+        const val PDF_DATA_NOTAVAIL = 0
+        const val PDF_DATA_AVAIL = 1
+        const val PDF_FORM_ERROR = -1
+        const val PDF_FORM_NOTAVAIL = 0
+        const val PDF_FORM_AVAIL = 1
+        const val PDF_FORM_NOTEXIST = 2
+
+        // Every download round fetches at least one new chunk, so this only
+        // trips on files that keep reporting NOTAVAIL with nothing to fetch
+        private const val MAX_AVAILABILITY_ROUNDS = 100_000
+        
+        // Thumbnail sources reported by nativeRenderThumbnails
+        internal const val THUMBNAIL_FAILED = 0
+        internal const val THUMBNAIL_EMBEDDED = 1
+        internal const val THUMBNAIL_RENDERED = 2
     }
     
+    @Volatile
     private var isInitialized = false
     
     /**
      * Initialize the PDFium library.
      * Must be called before any other operations.
      */
+    @Synchronized
     fun initLibrary() {
         if (!isInitialized) {
             nativeInitLibrary()
@@ -47,6 +76,7 @@ class PdfiumCore {
      * Destroy the PDFium library.
      * Call when completely done with PDFium.
      */
+    @Synchronized
     fun destroyLibrary() {
         if (isInitialized) {
             nativeDestroyLibrary()
@@ -54,6 +84,42 @@ class PdfiumCore {
         }
     }
     
+    /**
+     * Choose how native calls are serialized in this process.
+     * Applies to every PdfiumCore instance; [LockingPolicy.SERIALIZED] is the default.
+     * Set this before any document is opened.
+     */
+    fun setLockingPolicy(policy: LockingPolicy) {
+        nativeSetLockingEnabled(policy == LockingPolicy.SERIALIZED)
+    }
+    
+    /**
+     * Instrumentation counters for the whole process.
+     * Per-document counters are available from [PdfDocument.stats].
+     */
+    fun stats(): PdfiumStats = getStats(0L)
+    
+    /**
+     * Reset load and render counters, e.g. between benchmark phases.
+     */
+    fun resetStats() = nativeResetStats()
+    
+    internal fun getStats(docPtr: Long): PdfiumStats {
+        val result = LongArray(PdfiumStats.SIZE)
+        nativeGetStats(docPtr, result)
+        return PdfiumStats.fromArray(result)
+    }
+    
+    /**
+     * Edit revision of a page: [0] is a per-process document serial, [1] changes
+     * whenever the page or the document's page list is edited.
+     */
+    internal fun getPageRevision(docPtr: Long, pageIndex: Int): LongArray {
+        val result = LongArray(2)
+        nativeGetPageRevision(docPtr, pageIndex, result)
+        return result
+    }
+    
     /**
      * Get the last error code.
      */
@@ -64,12 +130,23 @@ class PdfiumCore {
     /**
      * Open a PDF document from a file descriptor.
      * 
+     * In [DocumentLoadMode.STREAMING] mode the descriptor is duplicated internally,
+     * so the caller may close [fd] once this returns.
+     *
      * @param fd File descriptor of the PDF file
      * @param password Optional password for encrypted PDFs
+     * @param loadMode How the file contents are loaded, streaming by default
      * @return PdfDocument or null if failed
      */
-    fun openDocument(fd: Int, password: String? = null): PdfDocument? {
-        val docPtr = nativeOpenDocument(fd, password)
+    fun openDocument(
+        fd: Int,
+        password: String? = null,
+        loadMode: DocumentLoadMode = DocumentLoadMode.STREAMING
+    ): PdfDocument? {
+        val docPtr = when (loadMode) {
+            DocumentLoadMode.STREAMING -> nativeOpenCustomDocument(fd, password)
+            DocumentLoadMode.IN_MEMORY -> nativeOpenDocument(fd, password)
+        }
         return if (docPtr != 0L) PdfDocument(this, docPtr) else null
     }
     
@@ -85,18 +162,174 @@ class PdfiumCore {
         return if (docPtr != 0L) PdfDocument(this, docPtr) else null
     }
     
+    /**
+     * Open a PDF document directly over a direct [ByteBuffer], without copying it.
+     *
+     * The bytes from `position` until `limit` are used. The buffer is kept alive
+     * until the document is closed and must not be modified in the meantime.
+     *
+     * @param buffer Direct buffer holding the PDF bytes
+     * @param password Optional password for encrypted PDFs
+     * @return PdfDocument or null if failed
+     */
+    fun openDocument(buffer: ByteBuffer, password: String? = null): PdfDocument? {
+        require(buffer.isDirect) { "Buffer must be a direct ByteBuffer" }
+        val docPtr = nativeOpenDirectBufferDocument(buffer, buffer.position(), buffer.remaining(), password)
+        return if (docPtr != 0L) PdfDocument(this, docPtr) else null
+    }
+    
+    /**
+     * Open a PDF document over a [PdfNativeBuffer], handing its memory to the document.
+     *
+     * On success the document frees the memory when closed; on failure the
+     * caller still owns [buffer] and must close it.
+     *
+     * @param buffer Native buffer holding the PDF bytes from 0 until `buffer.buffer.limit()`
+     * @param password Optional password for encrypted PDFs
+     * @return PdfDocument or null if failed
+     */
+    fun openDocument(buffer: PdfNativeBuffer, password: String? = null): PdfDocument? {
+        val docPtr = nativeOpenOwnedBufferDocument(buffer.getPointer(), buffer.buffer.limit(), password)
+        if (docPtr == 0L) return null
+        buffer.transferOwnership()
+        return PdfDocument(this, docPtr)
+    }
+    
+    /**
+     * Open a PDF document from a stream of known length, such as a network response.
+     *
+     * The stream is read straight into native memory that the document then owns,
+     * so peak memory during the open is the file size.
+     *
+     * @param input Stream positioned at the start of the PDF; not closed by this call
+     * @param length Number of bytes to read
+     * @param password Optional password for encrypted PDFs
+     * @return PdfDocument or null if failed or the stream ended early
+     */
+    fun openDocument(input: InputStream, length: Int, password: String? = null): PdfDocument? {
+        val nativeBuffer = allocateBuffer(length) ?: return null
+        val channel = Channels.newChannel(input)
+        val target = nativeBuffer.buffer
+        while (target.hasRemaining()) {
+            if (channel.read(target) < 0) {
+                nativeBuffer.close()
+                return null
+            }
+        }
+        target.flip()
+        
+        val document = openDocument(nativeBuffer, password)
+        if (document == null) nativeBuffer.close()
+        return document
+    }
+    
+    /**
+     * Allocate native memory to be filled and then opened with
+     * [openDocument] without a further copy.
+     *
+     * @param size Buffer size in bytes
+     * @return PdfNativeBuffer or null if the allocation failed
+     */
+    fun allocateBuffer(size: Int): PdfNativeBuffer? {
+        require(size > 0) { "Buffer size must be positive" }
+        val bufferPtr = nativeAllocateBuffer(size)
+        if (bufferPtr == 0L) return null
+        val buffer = nativeWrapBuffer(bufferPtr, size)
+        if (buffer == null) {
+            nativeFreeBuffer(bufferPtr)
+            return null
+        }
+        return PdfNativeBuffer(this, bufferPtr, buffer)
+    }
+    
+    internal fun freeBuffer(bufferPtr: Long) = nativeFreeBuffer(bufferPtr)
+    
     /**
      * Open a PDF document from a file path.
      *
      * @param path File path to the PDF
      * @param password Optional password for encrypted PDFs
+     * @param loadMode How the file contents are loaded, streaming by default
      * @return PdfDocument or null if failed
      */
-    fun openDocument(path: String, password: String? = null): PdfDocument? {
-        val docPtr = nativeOpenDocumentPath(path, password)
+    fun openDocument(
+        path: String,
+        password: String? = null,
+        loadMode: DocumentLoadMode = DocumentLoadMode.STREAMING
+    ): PdfDocument? {
+        val docPtr = when (loadMode) {
+            DocumentLoadMode.STREAMING -> nativeOpenDocumentPath(path, password)
+            DocumentLoadMode.IN_MEMORY -> try {
+                ParcelFileDescriptor.open(File(path), ParcelFileDescriptor.MODE_READ_ONLY)
+                    .use { pfd -> nativeOpenDocument(pfd.fd, password) }
+            } catch (e: FileNotFoundException) {
+                0L
+            }
+        }
         return if (docPtr != 0L) PdfDocument(this, docPtr) else null
     }
 
+    /**
+     * Open a PDF document progressively from a range-request data source.
+     *
+     * Only the data needed to parse the document structure is fetched before this
+     * returns. For linearized files that is the linearization dictionary, the hint
+     * tables and the first page; remaining pages are fetched when first opened
+     * (see [PdfDocument.ensurePageAvailable]).
+     *
+     * @param fetcher Source of byte ranges, called on the calling thread
+     * @param fileLength Total size of the PDF in bytes
+     * @param password Optional password for encrypted PDFs
+     * @return PdfDocument or null if failed
+     */
+    fun openDocument(
+        fetcher: PdfRangeFetcher,
+        fileLength: Long,
+        password: String? = null
+    ): PdfDocument? {
+        val loaderPtr = nativeCreateRangeLoader(fetcher, fileLength)
+        if (loaderPtr == 0L) return null
+        
+        if (!awaitAvailable(loaderPtr) { nativeAvailIsDocAvail(loaderPtr) }) {
+            nativeDestroyRangeLoader(loaderPtr)
+            return null
+        }
+        
+        val docPtr = nativeAvailGetDocument(loaderPtr, password)
+        if (docPtr == 0L) {
+            nativeDestroyRangeLoader(loaderPtr)
+            return null
+        }
+        return PdfDocument(this, docPtr, loaderPtr)
+    }
+    
+    /**
+     * Alternate availability checks and hinted downloads until [check] reports
+     * the data as present. Returns false on error, failed fetch, or when the
+     * data is still unavailable after [MAX_AVAILABILITY_ROUNDS] downloads.
+     */
+    private inline fun awaitAvailable(loaderPtr: Long, check: () -> Int): Boolean {
+        repeat(MAX_AVAILABILITY_ROUNDS) {
+            when (check()) {
+                PDF_DATA_AVAIL, PDF_FORM_NOTEXIST -> return true
+                PDF_DATA_NOTAVAIL -> if (!nativeAvailFetchHints(loaderPtr)) return false
+                else -> return false
+            }
+        }
+        return false
+    }
+    
+    internal fun isPageAvailable(loaderPtr: Long, pageIndex: Int): Boolean =
+        nativeAvailIsPageAvail(loaderPtr, pageIndex) == PDF_DATA_AVAIL
+    
+    internal fun ensurePageAvailable(loaderPtr: Long, pageIndex: Int): Boolean =
+        awaitAvailable(loaderPtr) { nativeAvailIsPageAvail(loaderPtr, pageIndex) }
+    
+    internal fun ensureFormAvailable(loaderPtr: Long): Boolean =
+        awaitAvailable(loaderPtr) { nativeAvailIsFormAvail(loaderPtr) }
+    
+    internal fun getFirstAvailablePageIndex(docPtr: Long): Int = nativeAvailGetFirstPageNum(docPtr)
+
     /**
      * Create a new empty PDF document.
      * 
@@ -111,6 +344,18 @@ class PdfiumCore {
         return nativeSaveDocument(docPtr, path)
     }
 
+    internal fun saveDocument(docPtr: Long, fd: Int, flags: Int, blockSize: Int): Boolean {
+        return nativeSaveDocumentToFd(docPtr, fd, flags, blockSize)
+    }
+
+    internal fun saveDocument(docPtr: Long, output: java.io.OutputStream, flags: Int, blockSize: Int): Boolean {
+        return nativeSaveDocumentToStream(docPtr, output, flags, blockSize)
+    }
+
+    internal fun saveDocumentInPlace(docPtr: Long, fd: Int, blockSize: Int): Long {
+        return nativeSaveDocumentInPlace(docPtr, fd, blockSize)
+    }
+
     internal fun newPage(docPtr: Long, index: Int, width: Double, height: Double): Long {
         return nativeNewPage(docPtr, index, width, height)
     }
@@ -127,6 +372,16 @@ class PdfiumCore {
     fun getMetaText(docPtr: Long, tag: String): String {
         return nativeGetMetaText(docPtr, tag) ?: ""
     }
+    
+    /**
+     * Get a file identifier from the document trailer.
+     *
+     * @param idType 0 for the permanent identifier, 1 for the changing one
+     * @return Identifier bytes, or null if the document has none
+     */
+    fun getFileIdentifier(docPtr: Long, idType: Int): ByteArray? = nativeGetFileIdentifier(docPtr, idType)
+
+    internal fun getSourceSample(docPtr: Long): ByteArray? = nativeGetSourceSample(docPtr)
 
     /**
      * Get page label (actual page number as displayed in PDF)
@@ -153,6 +408,22 @@ class PdfiumCore {
         return nativeGetPageHeight(pagePtr)
     }
 
+    internal fun configurePageCache(docPtr: Long, maxBytes: Long, cacheTextPages: Boolean) =
+        nativeConfigurePageCache(docPtr, maxBytes, cacheTextPages)
+
+    internal fun getPageCacheStats(docPtr: Long): PageCacheStats {
+        val result = LongArray(6)
+        nativeGetPageCacheStats(docPtr, result)
+        return PageCacheStats(
+            hits = result[0],
+            misses = result[1],
+            evictions = result[2],
+            bytesHeld = result[3],
+            cachedPages = result[4].toInt(),
+            capacityBytes = result[5]
+        )
+    }
+
     /**
      * Get page size by index WITHOUT loading the page.
      * Much faster than loadPage+getWidth/getHeight for bulk size queries.
@@ -209,6 +480,23 @@ class PdfiumCore {
         return result
     }
 
+    /**
+     * Text of a page with one char per char index, plus packed
+     * left/top/right/bottom boxes of every char.
+     */
+    internal fun getTextWithCharBoxes(textPagePtr: Long): Pair<String, FloatArray> {
+        val boxes = FloatArray(getTextCount(textPagePtr).coerceAtLeast(0) * 4)
+        val text = nativeGetTextWithCharBoxes(textPagePtr, boxes) ?: ""
+        return text to boxes
+    }
+
+    /**
+     * Whole page layout packed into one direct buffer; see [PdfTextLayout].
+     */
+    internal fun getTextLayout(textPagePtr: Long): java.nio.ByteBuffer? {
+        return nativeGetTextLayout(textPagePtr)
+    }
+
     internal fun getCharIndexAtPos(textPagePtr: Long, x: Double, y: Double, xTolerance: Double, yTolerance: Double): Int {
         return nativeGetCharIndexAtPos(textPagePtr, x, y, xTolerance, yTolerance)
     }
@@ -255,6 +543,13 @@ class PdfiumCore {
         return nativeGetBookmarkDestIndex(docPtr, bookmarkPtr)
     }
 
+    /**
+     * Whole outline flattened into one direct buffer; see [PdfOutline].
+     */
+    internal fun getOutline(docPtr: Long): java.nio.ByteBuffer? {
+        return nativeGetOutline(docPtr)
+    }
+
     // Link Operations
     internal fun getLinkAtPoint(pagePtr: Long, x: Double, y: Double): Long {
         return nativeGetLinkAtPoint(pagePtr, x, y)
@@ -274,6 +569,13 @@ class PdfiumCore {
         return result
     }
 
+    /**
+     * Every link on a page packed into one direct buffer; see [PdfLinkMap].
+     */
+    internal fun getPageLinks(docPtr: Long, pagePtr: Long, includeWebLinks: Boolean): java.nio.ByteBuffer? {
+        return nativeGetPageLinks(docPtr, pagePtr, includeWebLinks)
+    }
+
     // Annotation Operations
     internal fun getAnnotCount(pagePtr: Long): Int {
         return nativeGetAnnotCount(pagePtr)
@@ -300,25 +602,56 @@ class PdfiumCore {
     // Native methods
     private external fun nativeInitLibrary()
     private external fun nativeDestroyLibrary()
+    private external fun nativeSetLockingEnabled(enabled: Boolean)
+    private external fun nativeGetStats(docPtr: Long, result: LongArray)
+    private external fun nativeResetStats()
+    private external fun nativeGetPageRevision(docPtr: Long, pageIndex: Int, result: LongArray)
     private external fun nativeGetLastError(): Int
     private external fun nativeOpenDocument(fd: Int, password: String?): Long
     private external fun nativeOpenMemDocument(data: ByteArray, password: String?): Long
     private external fun nativeOpenDocumentPath(path: String, password: String?): Long
+    private external fun nativeOpenCustomDocument(fd: Int, password: String?): Long
+    private external fun nativeOpenDirectBufferDocument(buffer: ByteBuffer, offset: Int, length: Int, password: String?): Long
+    private external fun nativeOpenOwnedBufferDocument(bufferPtr: Long, length: Int, password: String?): Long
+    private external fun nativeAllocateBuffer(size: Int): Long
+    private external fun nativeWrapBuffer(bufferPtr: Long, size: Int): ByteBuffer?
+    private external fun nativeFreeBuffer(bufferPtr: Long)
     private external fun nativeCloseDocument(docPtr: Long)
     private external fun nativeGetPageCount(docPtr: Long): Int
     private external fun nativeGetMetaText(docPtr: Long, tag: String): String?
+    private external fun nativeGetFileIdentifier(docPtr: Long, idType: Int): ByteArray?
+    private external fun nativeGetSourceSample(docPtr: Long): ByteArray?
     private external fun nativeGetPageLabel(docPtr: Long, pageIndex: Int): String?
     
     // Creation & Saving Native methods
     private external fun nativeNewDocument(): Long
     private external fun nativeNewPage(docPtr: Long, index: Int, width: Double, height: Double): Long
     private external fun nativeSaveDocument(docPtr: Long, path: String): Boolean 
+    private external fun nativeSaveDocumentToFd(docPtr: Long, fd: Int, flags: Int, blockSize: Int): Boolean
+    private external fun nativeSaveDocumentToStream(docPtr: Long, output: java.io.OutputStream, flags: Int, blockSize: Int): Boolean
+    private external fun nativeSaveDocumentInPlace(docPtr: Long, fd: Int, blockSize: Int): Long
     
     // Form Filling Native methods
     private external fun nativeInitFormFillEnvironment(docPtr: Long): Long
     private external fun nativeExitFormFillEnvironment(formHandlePtr: Long)
     private external fun nativeFORMOnAfterLoadPage(pagePtr: Long, formHandlePtr: Long)
     private external fun nativeFORMOnBeforeClosePage(pagePtr: Long, formHandlePtr: Long)
+    private external fun nativeRenderPageWithForm(
+        pagePtr: Long,
+        formHandlePtr: Long,
+        bitmap: android.graphics.Bitmap,
+        startX: Int,
+        startY: Int,
+        drawWidth: Int,
+        drawHeight: Int,
+        rotate: Int,
+        renderAnnot: Boolean,
+        clip: IntArray?
+    )
+    private external fun nativeGetFocusedFieldDeviceRect(
+        formHandlePtr: Long, pagePtr: Long, startX: Int, startY: Int,
+        sizeX: Int, sizeY: Int, rotate: Int, out: IntArray
+    ): Boolean
     private external fun nativeFPDFFFLDraw(
         formHandlePtr: Long, 
         bitmap: Any, 
@@ -348,6 +681,29 @@ class PdfiumCore {
         nativeFORMOnBeforeClosePage(pagePtr, formHandlePtr)
     }
 
+    /**
+     * Render the page and, when [formHandlePtr] is non-zero, its form layer into
+     * [bitmap] with one lock of its pixels. [clip] limits the render to
+     * left, top, right, bottom in bitmap pixels.
+     */
+    internal fun renderPageWithForm(
+        pagePtr: Long,
+        formHandlePtr: Long,
+        bitmap: android.graphics.Bitmap,
+        startX: Int,
+        startY: Int,
+        drawWidth: Int,
+        drawHeight: Int,
+        rotate: Int,
+        renderAnnot: Boolean,
+        clip: IntArray?
+    ) = nativeRenderPageWithForm(pagePtr, formHandlePtr, bitmap, startX, startY, drawWidth, drawHeight, rotate, renderAnnot, clip)
+
+    internal fun getFocusedFieldDeviceRect(
+        formHandlePtr: Long, pagePtr: Long, startX: Int, startY: Int,
+        sizeX: Int, sizeY: Int, rotate: Int, out: IntArray
+    ): Boolean = nativeGetFocusedFieldDeviceRect(formHandlePtr, pagePtr, startX, startY, sizeX, sizeY, rotate, out)
+
     internal fun renderFormBitmap(
         formHandlePtr: Long,
         bitmap: Any,
@@ -414,6 +770,8 @@ class PdfiumCore {
     // Page Native methods
     private external fun nativeLoadPage(docPtr: Long, pageIndex: Int): Long
     private external fun nativeClosePage(pagePtr: Long)
+    private external fun nativeConfigurePageCache(docPtr: Long, capacityBytes: Long, cacheTextPages: Boolean)
+    private external fun nativeGetPageCacheStats(docPtr: Long, result: LongArray)
     private external fun nativeGetPageWidth(pagePtr: Long): Double
     private external fun nativeGetPageHeight(pagePtr: Long): Double
     private external fun nativeGetPageSizeByIndex(docPtr: Long, pageIndex: Int): DoubleArray?
@@ -473,6 +831,8 @@ class PdfiumCore {
     private external fun nativeTextCountChars(textPagePtr: Long): Int
     private external fun nativeGetText(textPagePtr: Long, startIndex: Int, count: Int): String?
     private external fun nativeGetCharBox(textPagePtr: Long, index: Int, result: DoubleArray)
+    private external fun nativeGetTextWithCharBoxes(textPagePtr: Long, boxes: FloatArray): String?
+    private external fun nativeGetTextLayout(textPagePtr: Long): java.nio.ByteBuffer?
     private external fun nativeGetCharIndexAtPos(textPagePtr: Long, x: Double, y: Double, xTolerance: Double, yTolerance: Double): Int
     
     // Search Native methods
@@ -488,12 +848,14 @@ class PdfiumCore {
     private external fun nativeGetNextSiblingBookmark(docPtr: Long, bookmarkPtr: Long): Long
     private external fun nativeGetBookmarkTitle(bookmarkPtr: Long): String?
     private external fun nativeGetBookmarkDestIndex(docPtr: Long, bookmarkPtr: Long): Long
+    private external fun nativeGetOutline(docPtr: Long): java.nio.ByteBuffer?
     
     // Link Native methods
     private external fun nativeGetLinkAtPoint(pagePtr: Long, x: Double, y: Double): Long
     private external fun nativeGetLinkDestIndex(docPtr: Long, linkPtr: Long): Int
     private external fun nativeGetLinkURI(docPtr: Long, linkPtr: Long): String?
     private external fun nativeGetLinkRect(linkPtr: Long, result: DoubleArray)
+    private external fun nativeGetPageLinks(docPtr: Long, pagePtr: Long, includeWebLinks: Boolean): java.nio.ByteBuffer?
 
     // Annotation Native methods
     private external fun nativeGetAnnotCount(pagePtr: Long): Int
@@ -582,6 +944,9 @@ class PdfiumCore {
     private external fun nativePathSetDrawMode(pathObjPtr: Long, fillMode: Int, stroke: Boolean): Boolean
     private external fun nativePathSetStrokeWidth(pathObjPtr: Long, width: Float): Boolean
     private external fun nativeNewImageObj(docPtr: Long): Long
+    private external fun nativeImageObjSetBitmap(imageObjPtr: Long, bitmap: android.graphics.Bitmap): Boolean
+    private external fun nativeImageObjLoadJpeg(imageObjPtr: Long, fd: Int): Boolean
+    private external fun nativeInsertImages(docPtr: Long, pagePtr: Long, bitmaps: Array<android.graphics.Bitmap?>, fds: IntArray, matrices: FloatArray): Int
     private external fun nativeInsertObject(pagePtr: Long, pageObjPtr: Long)
     private external fun nativeRemoveObject(pagePtr: Long, pageObjPtr: Long): Boolean
     private external fun nativeSetObjectFillColor(pageObjPtr: Long, r: Int, g: Int, b: Int, a: Int)
@@ -590,6 +955,12 @@ class PdfiumCore {
 
     // Phase 9: Document Utilities
     private external fun nativeImportPages(destDocPtr: Long, srcDocPtr: Long, pageRange: String?, insertIndex: Int): Boolean
+    private external fun nativeImportPagesByIndex(destDocPtr: Long, srcDocPtr: Long, pageIndices: IntArray?, insertIndex: Int): Boolean
+    private external fun nativeImportNPagesToOne(srcDocPtr: Long, outputWidth: Float, outputHeight: Float, numX: Int, numY: Int): Long
+    private external fun nativeNewXObjectFromPage(destDocPtr: Long, srcDocPtr: Long, srcPageIndex: Int): Long
+    private external fun nativeCloseXObject(xobjectPtr: Long)
+    private external fun nativeNewFormObjectFromXObject(xobjectPtr: Long): Long
+    private external fun nativeImposePages(destDocPtr: Long, srcDocPtr: Long, sheetWidth: Float, sheetHeight: Float, sheetCount: Int, slots: IntArray, matrices: FloatArray): Int
     private external fun nativeCopyViewerPreferences(destDocPtr: Long, srcDocPtr: Long): Boolean
     private external fun nativeFlattenPage(pagePtr: Long, flags: Int): Int
     private external fun nativeSetPageMediaBox(pagePtr: Long, left: Float, bottom: Float, right: Float, top: Float): Boolean
@@ -639,6 +1010,10 @@ class PdfiumCore {
     fun pathLineTo(pathObjPtr: Long, x: Float, y: Float): Boolean = nativePathLineTo(pathObjPtr, x, y)
     fun pathClose(pathObjPtr: Long): Boolean = nativePathClose(pathObjPtr)
     fun newImageObject(docPtr: Long): Long = nativeNewImageObj(docPtr)
+    fun setImageObjectBitmap(imageObjPtr: Long, bitmap: android.graphics.Bitmap): Boolean = nativeImageObjSetBitmap(imageObjPtr, bitmap)
+    fun loadImageObjectJpeg(imageObjPtr: Long, fd: Int): Boolean = nativeImageObjLoadJpeg(imageObjPtr, fd)
+    internal fun insertImages(docPtr: Long, pagePtr: Long, bitmaps: Array<android.graphics.Bitmap?>, fds: IntArray, matrices: FloatArray): Int =
+        nativeInsertImages(docPtr, pagePtr, bitmaps, fds, matrices)
     fun insertObject(pagePtr: Long, pageObjPtr: Long) = nativeInsertObject(pagePtr, pageObjPtr)
     fun removeObject(pagePtr: Long, pageObjPtr: Long): Boolean = nativeRemoveObject(pagePtr, pageObjPtr)
     fun setObjectFillColor(pageObjPtr: Long, r: Int, g: Int, b: Int, a: Int) = nativeSetObjectFillColor(pageObjPtr, r, g, b, a)
@@ -647,6 +1022,13 @@ class PdfiumCore {
 
     // Document Utilities
     fun importPages(destDocPtr: Long, srcDocPtr: Long, pageRange: String?, insertIndex: Int): Boolean = nativeImportPages(destDocPtr, srcDocPtr, pageRange, insertIndex)
+    fun importPagesByIndex(destDocPtr: Long, srcDocPtr: Long, pageIndices: IntArray?, insertIndex: Int): Boolean = nativeImportPagesByIndex(destDocPtr, srcDocPtr, pageIndices, insertIndex)
+    fun importNPagesToOne(srcDocPtr: Long, outputWidth: Float, outputHeight: Float, numX: Int, numY: Int): Long = nativeImportNPagesToOne(srcDocPtr, outputWidth, outputHeight, numX, numY)
+    fun newXObjectFromPage(destDocPtr: Long, srcDocPtr: Long, srcPageIndex: Int): Long = nativeNewXObjectFromPage(destDocPtr, srcDocPtr, srcPageIndex)
+    fun closeXObject(xobjectPtr: Long) = nativeCloseXObject(xobjectPtr)
+    fun newFormObjectFromXObject(xobjectPtr: Long): Long = nativeNewFormObjectFromXObject(xobjectPtr)
+    internal fun imposePages(destDocPtr: Long, srcDocPtr: Long, sheetWidth: Float, sheetHeight: Float, sheetCount: Int, slots: IntArray, matrices: FloatArray): Int =
+        nativeImposePages(destDocPtr, srcDocPtr, sheetWidth, sheetHeight, sheetCount, slots, matrices)
     fun copyViewerPreferences(destDocPtr: Long, srcDocPtr: Long): Boolean = nativeCopyViewerPreferences(destDocPtr, srcDocPtr)
     fun flattenPage(pagePtr: Long, flags: Int = 0): Int = nativeFlattenPage(pagePtr, flags)
     fun getPageRotation(pagePtr: Long): Int = nativeGetPageRotation(pagePtr)
@@ -703,6 +1085,7 @@ class PdfiumCore {
 
     /**
      * Start progressive rendering of a page to a bitmap.
+     * Renders in one go; use [PdfPage.startRender] for time-sliced, cancellable rendering.
      * @return Render status: RENDER_READY(0), RENDER_TOBECONTINUED(1), RENDER_DONE(2), RENDER_FAILED(3)
      */
     fun renderPageBitmapStart(
@@ -721,6 +1104,23 @@ class PdfiumCore {
      */
     fun renderPageClose(pagePtr: Long) = nativeRenderPageClose(pagePtr)
 
+    // Render Sessions
+    private external fun nativeOpenRenderSession(
+        bitmap: Any, pagePtr: Long, startX: Int, startY: Int,
+        drawWidth: Int, drawHeight: Int, rotate: Int, renderAnnot: Boolean, formHandlePtr: Long
+    ): Long
+    private external fun nativeRenderSessionStep(sessionPtr: Long, budgetNanos: Long): Int
+    private external fun nativeCancelRenderSession(sessionPtr: Long)
+    private external fun nativeCloseRenderSession(sessionPtr: Long)
+
+    internal fun openRenderSession(
+        bitmap: android.graphics.Bitmap, pagePtr: Long, startX: Int, startY: Int,
+        drawWidth: Int, drawHeight: Int, rotate: Int, renderAnnot: Boolean, formHandlePtr: Long = 0L
+    ): Long = nativeOpenRenderSession(bitmap, pagePtr, startX, startY, drawWidth, drawHeight, rotate, renderAnnot, formHandlePtr)
+    internal fun renderSessionStep(sessionPtr: Long, budgetNanos: Long): Int = nativeRenderSessionStep(sessionPtr, budgetNanos)
+    internal fun cancelRenderSession(sessionPtr: Long) = nativeCancelRenderSession(sessionPtr)
+    internal fun closeRenderSession(sessionPtr: Long) = nativeCloseRenderSession(sessionPtr)
+
     // =========================================================================
     // COMPLETE IMPLEMENTATION - ALL REMAINING FEATURES
     // =========================================================================
@@ -738,6 +1138,9 @@ class PdfiumCore {
     private external fun nativeFormUndo(formPtr: Long, pagePtr: Long): Boolean
     private external fun nativeFormRedo(formPtr: Long, pagePtr: Long): Boolean
     private external fun nativeFormSelectAllText(formPtr: Long, pagePtr: Long)
+    private external fun nativePollFormDirtyRects(
+        pagePtr: Long, startX: Int, startY: Int, sizeX: Int, sizeY: Int, rotate: Int
+    ): IntArray?
 
     fun formOnMouseMove(formPtr: Long, pagePtr: Long, modifier: Int, x: Double, y: Double) = nativeFormOnMouseMove(formPtr, pagePtr, modifier, x, y)
     fun formOnLButtonDown(formPtr: Long, pagePtr: Long, modifier: Int, x: Double, y: Double) = nativeFormOnLButtonDown(formPtr, pagePtr, modifier, x, y)
@@ -746,6 +1149,8 @@ class PdfiumCore {
     fun formOnKeyUp(formPtr: Long, pagePtr: Long, keyCode: Int, modifier: Int) = nativeFormOnKeyUp(formPtr, pagePtr, keyCode, modifier)
     fun formOnChar(formPtr: Long, pagePtr: Long, charCode: Int, modifier: Int) = nativeFormOnChar(formPtr, pagePtr, charCode, modifier)
     fun formOnFocus(formPtr: Long, pagePtr: Long, modifier: Int, x: Double, y: Double) = nativeFormOnFocus(formPtr, pagePtr, modifier, x, y)
+    internal fun pollFormDirtyRects(pagePtr: Long, startX: Int, startY: Int, sizeX: Int, sizeY: Int, rotate: Int) =
+        nativePollFormDirtyRects(pagePtr, startX, startY, sizeX, sizeY, rotate)
     fun formCanUndo(formPtr: Long, pagePtr: Long) = nativeFormCanUndo(formPtr, pagePtr)
     fun formCanRedo(formPtr: Long, pagePtr: Long) = nativeFormCanRedo(formPtr, pagePtr)
     fun formUndo(formPtr: Long, pagePtr: Long) = nativeFormUndo(formPtr, pagePtr)
@@ -775,6 +1180,19 @@ class PdfiumCore {
     fun getAnnotCreationDate(annotPtr: Long) = nativeGetAnnotCreationDate(annotPtr) ?: ""
     fun getAnnotOpacity(annotPtr: Long) = nativeGetAnnotOpacity(annotPtr)
     fun getAnnotQuadPoints(annotPtr: Long) = nativeGetAnnotQuadPoints(annotPtr)
+
+    // --- Annotation Batch Read ---
+    private external fun nativeGetAllAnnotations(pagePtr: Long, mask: Int): ByteArray?
+
+    /** Packed properties of every annotation on a page; decoded by [com.hyntix.pdfium.PdfPage.getAllAnnotations]. */
+    internal fun getAllAnnotations(pagePtr: Long, mask: Int) = nativeGetAllAnnotations(pagePtr, mask)
+
+    // --- Annotation Transactions ---
+    private external fun nativeApplyAnnotationEdits(pagePtr: Long, data: ByteArray, appearanceFlags: Int): Int
+
+    /** Apply a packed batch from [com.hyntix.pdfium.annotation.AnnotationTransaction]; returns the operations applied, or -1. */
+    internal fun applyAnnotationEdits(pagePtr: Long, data: ByteArray, appearanceFlags: Int) =
+        nativeApplyAnnotationEdits(pagePtr, data, appearanceFlags)
     
     // --- Annotation Setters ---
     private external fun nativeSetAnnotAuthor(annotPtr: Long, author: String): Boolean
@@ -788,11 +1206,33 @@ class PdfiumCore {
     fun setAnnotQuadPoints(annotPtr: Long, quadPoints: DoubleArray) = nativeSetAnnotQuadPoints(annotPtr, quadPoints)
     
     // --- Ink Annotation Functions ---
-    private external fun nativeGetAnnotInkList(annotPtr: Long): Array<DoubleArray>?
-    private external fun nativeSetAnnotInkList(annotPtr: Long, inkList: Array<DoubleArray>): Boolean
+    private external fun nativeGetAnnotInkStrokeCount(annotPtr: Long): Int
+    private external fun nativeGetAnnotInkPoints(annotPtr: Long, offsets: IntArray): FloatArray?
+    private external fun nativeSetAnnotInkPoints(annotPtr: Long, points: FloatArray, offsets: IntArray): Boolean
+    private external fun nativeAppendAnnotInkStroke(annotPtr: Long, points: FloatArray, start: Int, count: Int): Int
     
-    fun getAnnotInkList(annotPtr: Long) = nativeGetAnnotInkList(annotPtr)
-    fun setAnnotInkList(annotPtr: Long, inkList: Array<DoubleArray>) = nativeSetAnnotInkList(annotPtr, inkList)
+    /** The whole InkList in one flat read, or null if the annotation has no strokes. */
+    fun getAnnotInk(annotPtr: Long): InkStrokes? {
+        val strokeCount = nativeGetAnnotInkStrokeCount(annotPtr)
+        if (strokeCount == 0) return null
+        val offsets = IntArray(strokeCount + 1)
+        val points = nativeGetAnnotInkPoints(annotPtr, offsets) ?: return null
+        return InkStrokes(points, offsets)
+    }
+    /** Replace the InkList; fails if there are no strokes or one is empty. */
+    fun setAnnotInk(annotPtr: Long, ink: InkStrokes) =
+        ink.strokeCount > 0 && nativeSetAnnotInkPoints(annotPtr, ink.points, ink.offsets)
+    /** Append [count] x/y points from [points], starting at point [start], as one stroke; returns its index or -1. */
+    fun appendAnnotInkStroke(annotPtr: Long, points: FloatArray, start: Int = 0, count: Int = points.size / 2) =
+        nativeAppendAnnotInkStroke(annotPtr, points, start, count)
+    fun getAnnotInkList(annotPtr: Long): Array<DoubleArray>? {
+        val ink = getAnnotInk(annotPtr) ?: return null
+        return Array(ink.strokeCount) { stroke ->
+            DoubleArray(ink.getPointCount(stroke) * 2) { ink.points[ink.offsets[stroke] * 2 + it].toDouble() }
+        }
+    }
+    fun setAnnotInkList(annotPtr: Long, inkList: Array<DoubleArray>) =
+        setAnnotInk(annotPtr, InkStrokes.fromArrays(inkList))
     
     // --- Form Field Options ---
     private external fun nativeGetFormFieldOptionValue(formPtr: Long, annotPtr: Long, index: Int): String?
@@ -892,18 +1332,39 @@ class PdfiumCore {
     fun closeFont(fontPtr: Long) = nativeCloseFont(fontPtr)
 
     // --- Data Availability ---
-    private external fun nativeIsLinearized(availPtr: Long): Boolean
-
-    fun isLinearized(availPtr: Long) = nativeIsLinearized(availPtr)
+    private external fun nativeCreateRangeLoader(fetcher: PdfRangeFetcher, fileLength: Long): Long
+    private external fun nativeDestroyRangeLoader(loaderPtr: Long)
+    private external fun nativeAvailIsDocAvail(loaderPtr: Long): Int
+    private external fun nativeAvailIsPageAvail(loaderPtr: Long, pageIndex: Int): Int
+    private external fun nativeAvailIsFormAvail(loaderPtr: Long): Int
+    private external fun nativeAvailFetchHints(loaderPtr: Long): Boolean
+    private external fun nativeAvailGetDocument(loaderPtr: Long, password: String?): Long
+    private external fun nativeAvailGetFirstPageNum(docPtr: Long): Int
+    private external fun nativeIsLinearized(loaderPtr: Long): Boolean
+
+    fun isLinearized(loaderPtr: Long) = nativeIsLinearized(loaderPtr)
     
     // --- Form Data Export/Import ---
-    private external fun nativeExportFormData(formPtr: Long, docPtr: Long): Array<String>?
+    private external fun nativeExportFormData(formPtr: Long, docPtr: Long): ByteArray?
+    private external fun nativeImportFormData(formPtr: Long, docPtr: Long, data: ByteArray): Int
+    private external fun nativeFindFormField(formPtr: Long, docPtr: Long, name: String): IntArray?
+    private external fun nativeGetFormFieldDataByName(formPtr: Long, docPtr: Long, name: String): ByteArray?
+    private external fun nativeSetFormFieldValueByName(formPtr: Long, docPtr: Long, name: String, value: String): Int
     private external fun nativeGetFormFieldDefaultValue(formPtr: Long, annotPtr: Long): String?
     private external fun nativeIsFormFieldRequired(formPtr: Long, annotPtr: Long): Boolean
     private external fun nativeIsFormFieldReadOnly(formPtr: Long, annotPtr: Long): Boolean
     private external fun nativeGetFormFieldMaxLength(formPtr: Long, annotPtr: Long): Int
     
+    /** Packed snapshot of every form field; decoded by [com.hyntix.pdfium.form.PdfForm.exportFormData]. */
     fun exportFormData(formPtr: Long, docPtr: Long) = nativeExportFormData(formPtr, docPtr)
+    /** Apply packed field values in one page walk; returns the widgets updated, or -1. */
+    fun importFormData(formPtr: Long, docPtr: Long, data: ByteArray) = nativeImportFormData(formPtr, docPtr, data)
+    /** Widgets of a field as page/annot index pairs, from the native field-name index. */
+    internal fun findFormField(formPtr: Long, docPtr: Long, name: String) = nativeFindFormField(formPtr, docPtr, name)
+    internal fun getFormFieldDataByName(formPtr: Long, docPtr: Long, name: String) =
+        nativeGetFormFieldDataByName(formPtr, docPtr, name)
+    internal fun setFormFieldValueByName(formPtr: Long, docPtr: Long, name: String, value: String) =
+        nativeSetFormFieldValueByName(formPtr, docPtr, name, value)
     fun getFormFieldDefaultValue(formPtr: Long, annotPtr: Long) = nativeGetFormFieldDefaultValue(formPtr, annotPtr)
     fun isFormFieldRequired(formPtr: Long, annotPtr: Long) = nativeIsFormFieldRequired(formPtr, annotPtr)
     fun isFormFieldReadOnly(formPtr: Long, annotPtr: Long) = nativeIsFormFieldReadOnly(formPtr, annotPtr)
@@ -948,6 +1409,136 @@ class PdfiumCore {
     fun setFormFieldHighlightColor(formPtr: Long, r: Int, g: Int, b: Int, a: Int) = nativeSetFormFieldHighlightColor(formPtr, r, g, b, a)
     fun setFormFieldHighlightAlpha(formPtr: Long, alpha: Int) = nativeSetFormFieldHighlightAlpha(formPtr, alpha)
     fun removeFormFieldHighlight(formPtr: Long) = nativeRemoveFormFieldHighlight(formPtr)
+    
+    // --- Shared-Memory Rendering ---
+    private external fun nativeCreateSharedMemory(name: String, size: Long): Int
+    private external fun nativeRenderPageToSharedMemory(pagePtr: Long, fd: Int, width: Int, height: Int, renderAnnot: Boolean): Boolean
+    private external fun nativeCopySharedMemoryToBitmap(fd: Int, bitmap: android.graphics.Bitmap): Boolean
+    
+    internal fun createSharedMemory(name: String, size: Long) = nativeCreateSharedMemory(name, size)
+    internal fun renderPageToSharedMemory(pagePtr: Long, fd: Int, width: Int, height: Int, renderAnnot: Boolean) =
+        nativeRenderPageToSharedMemory(pagePtr, fd, width, height, renderAnnot)
+    internal fun copySharedMemoryToBitmap(fd: Int, bitmap: android.graphics.Bitmap) = nativeCopySharedMemoryToBitmap(fd, bitmap)
+    
+    // --- Document Search ---
+    private external fun nativeSearchPages(
+        docPtr: Long, query: String, matchCase: Boolean, matchWholeWord: Boolean,
+        startPage: Int, endPage: Int, callback: PdfSearchCallback
+    ): Int
+    
+    internal fun searchPages(
+        docPtr: Long, query: String, matchCase: Boolean, matchWholeWord: Boolean,
+        startPage: Int, endPage: Int, callback: PdfSearchCallback
+    ): Int = nativeSearchPages(docPtr, query, matchCase, matchWholeWord, startPage, endPage, callback)
+    
+    // --- Text Extraction ---
+    private external fun nativeExtractText(docPtr: Long, startPage: Int, endPage: Int, outFd: Int, sink: PdfTextSink?): Int
+    
+    internal fun extractTextPages(docPtr: Long, startPage: Int, endPage: Int, outFd: Int, sink: PdfTextSink?): Int =
+        nativeExtractText(docPtr, startPage, endPage, outFd, sink)
+    
+    /**
+     * Extract the text of a document straight from a file descriptor, without
+     * keeping the document open afterwards. Pages are loaded, laid out and
+     * converted in native code in batches; see [PdfDocument.extractText].
+     *
+     * To spread a large document over several processes, use
+     * [com.hyntix.pdfium.render.PdfRenderPool.extractText].
+     *
+     * @param fd Descriptor of the PDF file; it is not closed
+     * @param pageRange Pages to extract, or null for all
+     * @param password Optional password for encrypted PDFs
+     * @param cancellationSignal Optional signal to stop between pages
+     * @param sink Receives each page in order
+     * @return true if every requested page was delivered
+     */
+    fun extractText(
+        fd: Int,
+        pageRange: IntRange? = null,
+        password: String? = null,
+        cancellationSignal: CancellationSignal? = null,
+        sink: PdfTextSink
+    ): Boolean {
+        val document = openDocument(fd, password) ?: return false
+        return document.use { it.extractText(pageRange ?: 0 until it.pageCount, cancellationSignal, sink) }
+    }
+    
+    /**
+     * Extract the text of a document from [fd] into [output] as UTF-8, each page
+     * followed by a form feed (`\u000C`).
+     *
+     * @return true if every requested page was written
+     * @see extractText
+     */
+    fun extractText(
+        fd: Int,
+        output: ParcelFileDescriptor,
+        pageRange: IntRange? = null,
+        password: String? = null,
+        cancellationSignal: CancellationSignal? = null
+    ): Boolean {
+        val document = openDocument(fd, password) ?: return false
+        return document.use { it.extractText(output, pageRange ?: 0 until it.pageCount, cancellationSignal) }
+    }
+    
+    // --- Tiled Rendering ---
+    private external fun nativeCreateTilePool(tileWidth: Int, tileHeight: Int, capacity: Int, hardware: Boolean): Long
+    private external fun nativeDestroyTilePool(poolPtr: Long)
+    private external fun nativeRenderTilesToBitmaps(pagePtr: Long, poolPtr: Long, zoom: Float, tiles: IntArray, bitmaps: Array<android.graphics.Bitmap>, renderAnnot: Boolean, formHandlePtr: Long): Int
+    private external fun nativeRenderTilesToHardwareBuffers(pagePtr: Long, poolPtr: Long, zoom: Float, tiles: IntArray, outSlots: IntArray, renderAnnot: Boolean, formHandlePtr: Long): Array<android.hardware.HardwareBuffer>?
+    private external fun nativeReleaseTile(poolPtr: Long, slot: Int)
+    
+    /**
+     * Create a pool of pre-allocated tile render targets for [PdfPage.renderTiles].
+     *
+     * @param tileWidth Tile width in pixels
+     * @param tileHeight Tile height in pixels
+     * @param capacity Number of targets to allocate up front
+     * @param useHardwareBuffers Back the pool with `HardwareBuffer`s for
+     *        [PdfPage.renderTilesToHardwareBuffers] instead of heap bitmaps
+     * @return PdfTilePool or null if the allocation failed
+     */
+    fun createTilePool(
+        tileWidth: Int = PdfTilePool.DEFAULT_TILE_SIZE,
+        tileHeight: Int = PdfTilePool.DEFAULT_TILE_SIZE,
+        capacity: Int = PdfTilePool.DEFAULT_CAPACITY,
+        useHardwareBuffers: Boolean = false
+    ): PdfTilePool? {
+        require(tileWidth > 0 && tileHeight > 0) { "Tile size must be positive" }
+        require(capacity > 0) { "Capacity must be positive" }
+        val poolPtr = nativeCreateTilePool(tileWidth, tileHeight, capacity, useHardwareBuffers)
+        if (poolPtr == 0L) return null
+        return PdfTilePool(this, poolPtr, tileWidth, tileHeight, capacity, useHardwareBuffers)
+    }
+    
+    internal fun destroyTilePool(poolPtr: Long) = nativeDestroyTilePool(poolPtr)
+    internal fun renderTilesToBitmaps(pagePtr: Long, poolPtr: Long, zoom: Float, tiles: IntArray, bitmaps: Array<android.graphics.Bitmap>, renderAnnot: Boolean, formHandlePtr: Long = 0L) =
+        nativeRenderTilesToBitmaps(pagePtr, poolPtr, zoom, tiles, bitmaps, renderAnnot, formHandlePtr)
+    internal fun renderTilesToHardwareBuffers(pagePtr: Long, poolPtr: Long, zoom: Float, tiles: IntArray, outSlots: IntArray, renderAnnot: Boolean, formHandlePtr: Long = 0L) =
+        nativeRenderTilesToHardwareBuffers(pagePtr, poolPtr, zoom, tiles, outSlots, renderAnnot, formHandlePtr)
+    internal fun releaseTile(poolPtr: Long, slot: Int) = nativeReleaseTile(poolPtr, slot)
+    
+    // --- Thumbnails ---
+    private external fun nativeRenderThumbnails(
+        docPtr: Long,
+        pages: IntArray,
+        bitmaps: Array<android.graphics.Bitmap>,
+        preferEmbedded: Boolean,
+        sources: IntArray
+    )
+    
+    /**
+     * Fill [bitmaps] with thumbnails of [pages] in one native call. [sources]
+     * receives [THUMBNAIL_EMBEDDED], [THUMBNAIL_RENDERED] or [THUMBNAIL_FAILED]
+     * per page.
+     */
+    internal fun renderThumbnails(
+        docPtr: Long,
+        pages: IntArray,
+        bitmaps: Array<android.graphics.Bitmap>,
+        preferEmbedded: Boolean,
+        sources: IntArray
+    ) = nativeRenderThumbnails(docPtr, pages, bitmaps, preferEmbedded, sources)
 }
 
 /**
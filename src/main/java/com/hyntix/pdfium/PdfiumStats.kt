@@ -0,0 +1,87 @@
+package com.hyntix.pdfium
+
+/**
+ * Instrumentation counters reported by the native layer, either for one document
+ * ([PdfDocument.stats]) or for the whole process ([PdfiumCore.stats]).
+ *
+ * Load and render counters accumulate until [PdfiumCore.resetStats]. Byte counts
+ * reflect memory held right now.
+ *
+ * @property documentsOpen Documents currently open from data: files, streams, buffers or ranges
+ * @property bufferBytesHeld Native memory held by document data (in-memory copies,
+ *   pinned buffers and downloaded ranges)
+ * @property pageCacheBytesHeld Estimated memory held by cached pages
+ * @property pagesLoaded Pages parsed with FPDF_LoadPage; page cache hits are not counted
+ * @property textPagesLoaded Text pages built with FPDFText_LoadPage
+ * @property render Timing of full page renders
+ */
+data class PdfiumStats(
+    val documentsOpen: Int,
+    val bufferBytesHeld: Long,
+    val pageCacheBytesHeld: Long,
+    val pagesLoaded: Long,
+    val textPagesLoaded: Long,
+    val render: RenderStats
+) {
+    internal companion object {
+        const val SIZE = 7 + RenderStats.BUCKET_COUNT
+
+        fun fromArray(values: LongArray) = PdfiumStats(
+            documentsOpen = values[0].toInt(),
+            bufferBytesHeld = values[1],
+            pageCacheBytesHeld = values[2],
+            pagesLoaded = values[3],
+            textPagesLoaded = values[4],
+            render = RenderStats(
+                count = values[5],
+                totalNanos = values[6],
+                histogram = values.copyOfRange(7, SIZE).toList()
+            )
+        )
+    }
+}
+
+/**
+ * Render time histogram.
+ *
+ * @property count Number of renders
+ * @property totalNanos Total time spent rendering
+ * @property histogram Render counts per bucket; bucket `i` holds renders shorter than
+ *   [BUCKET_UPPER_BOUNDS_MS]`[i]` (and not in an earlier bucket), the last bucket holds the rest
+ */
+data class RenderStats(
+    val count: Long,
+    val totalNanos: Long,
+    val histogram: List<Long>
+) {
+    companion object {
+        /** Upper bounds of the histogram buckets in milliseconds. */
+        val BUCKET_UPPER_BOUNDS_MS = listOf(1L, 2L, 4L, 8L, 16L, 32L, 64L, 128L, 256L)
+
+        internal const val BUCKET_COUNT = 10
+    }
+
+    /**
+     * Mean render time in milliseconds, or 0 before any render.
+     */
+    val averageMillis: Double
+        get() = if (count == 0L) 0.0 else totalNanos / 1_000_000.0 / count
+
+    /**
+     * Upper bound of the bucket containing the given percentile, in milliseconds.
+     * Returns [Long.MAX_VALUE] if it falls in the open-ended last bucket.
+     *
+     * @param percentile Value in 0..100
+     */
+    fun percentileUpperBoundMillis(percentile: Double): Long {
+        require(percentile in 0.0..100.0) { "Percentile must be in 0..100" }
+        if (count == 0L) return 0L
+        val target = kotlin.math.ceil(count * percentile / 100.0).toLong().coerceAtLeast(1L)
+        var seen = 0L
+        histogram.forEachIndexed { i, bucket ->
+            seen += bucket
+            if (seen >= target) return BUCKET_UPPER_BOUNDS_MS.getOrElse(i) { Long.MAX_VALUE }
+        }
+        return Long.MAX_VALUE
+    }
+}
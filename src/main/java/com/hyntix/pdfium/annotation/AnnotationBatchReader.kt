@@ -0,0 +1,74 @@
+package com.hyntix.pdfium.annotation
+
+import android.graphics.RectF
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Decodes the packed little-endian result of `nativeGetAllAnnotations`:
+ * count, mask, then per annotation its subtype followed by the property
+ * groups selected in mask in bit order (see [PageAnnotation.FIELD_RECT] and
+ * the following constants).
+ */
+internal object AnnotationBatchReader {
+
+    fun decode(bytes: ByteArray): List<PageAnnotation> {
+        val buffer = ByteBuffer.wrap(bytes).order(ByteOrder.LITTLE_ENDIAN)
+        val count = buffer.int
+        val mask = buffer.int
+        return List(count) { index -> buffer.getAnnotation(index, mask) }
+    }
+
+    private fun ByteBuffer.getAnnotation(index: Int, mask: Int): PageAnnotation {
+        val subtype = int
+        val rect = if (mask has PageAnnotation.FIELD_RECT) RectF(float, float, float, float) else RectF()
+        val color = if (mask has PageAnnotation.FIELD_COLOR) getColor() else null
+        val interiorColor = if (mask has PageAnnotation.FIELD_INTERIOR_COLOR) getColor() else null
+        val flags = if (mask has PageAnnotation.FIELD_FLAGS) int else 0
+        val opacity = if (mask has PageAnnotation.FIELD_OPACITY) float else 1.0f
+        val contents = if (mask has PageAnnotation.FIELD_CONTENTS) getUtf16() else ""
+        val author = if (mask has PageAnnotation.FIELD_AUTHOR) getUtf16() else ""
+        val subject = if (mask has PageAnnotation.FIELD_SUBJECT) getUtf16() else ""
+        val creationDate = if (mask has PageAnnotation.FIELD_DATES) getUtf16() else ""
+        val modificationDate = if (mask has PageAnnotation.FIELD_DATES) getUtf16() else ""
+        val quadPoints = if (mask has PageAnnotation.FIELD_QUAD_POINTS) {
+            List(int) { DoubleArray(8) { float.toDouble() } }
+        } else {
+            emptyList()
+        }
+        val inkList = if (mask has PageAnnotation.FIELD_INK_LIST) {
+            List(int) { InkPath(List(int) { doubleArrayOf(float.toDouble(), float.toDouble()) }) }
+        } else {
+            emptyList()
+        }
+        return PageAnnotation(
+            index = index,
+            subtype = subtype,
+            rect = rect,
+            contents = contents,
+            author = author,
+            subject = subject,
+            creationDate = creationDate,
+            modificationDate = modificationDate,
+            color = color ?: AnnotationColor(0, 0, 0, 255),
+            interiorColor = interiorColor,
+            opacity = opacity,
+            flags = flags,
+            quadPoints = quadPoints,
+            inkList = inkList
+        )
+    }
+
+    private infix fun Int.has(field: Int) = this and field != 0
+
+    private fun ByteBuffer.getColor(): AnnotationColor? {
+        if (int == 0) return null
+        return AnnotationColor(int, int, int, int)
+    }
+
+    private fun ByteBuffer.getUtf16(): String {
+        val length = int
+        val chars = CharArray(length) { char }
+        return String(chars)
+    }
+}
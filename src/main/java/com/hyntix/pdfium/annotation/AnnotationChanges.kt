@@ -0,0 +1,58 @@
+package com.hyntix.pdfium.annotation
+
+import android.graphics.RectF
+
+/**
+ * Properties to set on an annotation in an [AnnotationTransaction]. Null
+ * properties are left as they are.
+ *
+ * @property rect Bounding rectangle in page coordinates
+ * @property color Stroke color
+ * @property interiorColor Interior (fill) color
+ * @property flags Annotation flags
+ * @property opacity Opacity (0.0 to 1.0)
+ * @property contents Text contents or comment
+ * @property author Author of the annotation
+ * @property subject Subject of the annotation
+ * @property creationDate Creation date in PDF date format
+ * @property modificationDate Modification date in PDF date format
+ * @property quadPoints Quad points, 8 values per region
+ * @property inkList Ink strokes, replacing any existing ones
+ */
+data class AnnotationChanges(
+    val rect: RectF? = null,
+    val color: AnnotationColor? = null,
+    val interiorColor: AnnotationColor? = null,
+    val flags: Int? = null,
+    val opacity: Float? = null,
+    val contents: String? = null,
+    val author: String? = null,
+    val subject: String? = null,
+    val creationDate: String? = null,
+    val modificationDate: String? = null,
+    val quadPoints: List<DoubleArray>? = null,
+    val inkList: List<InkPath>? = null
+) {
+    init {
+        require(quadPoints == null || quadPoints.all { it.size == 8 }) { "Each quad point set needs 8 values" }
+        require(inkList == null || inkList.all { it.isValid() }) { "Ink paths need [x, y] points" }
+    }
+
+    /** The [PageAnnotation] `FIELD_*` groups these changes set. */
+    internal val fields: Int
+        get() {
+            var fields = 0
+            if (rect != null) fields = fields or PageAnnotation.FIELD_RECT
+            if (color != null) fields = fields or PageAnnotation.FIELD_COLOR
+            if (interiorColor != null) fields = fields or PageAnnotation.FIELD_INTERIOR_COLOR
+            if (flags != null) fields = fields or PageAnnotation.FIELD_FLAGS
+            if (opacity != null) fields = fields or PageAnnotation.FIELD_OPACITY
+            if (contents != null) fields = fields or PageAnnotation.FIELD_CONTENTS
+            if (author != null) fields = fields or PageAnnotation.FIELD_AUTHOR
+            if (subject != null) fields = fields or PageAnnotation.FIELD_SUBJECT
+            if (creationDate != null || modificationDate != null) fields = fields or PageAnnotation.FIELD_DATES
+            if (quadPoints != null) fields = fields or PageAnnotation.FIELD_QUAD_POINTS
+            if (inkList != null) fields = fields or PageAnnotation.FIELD_INK_LIST
+            return fields
+        }
+}
@@ -0,0 +1,206 @@
+package com.hyntix.pdfium.annotation
+
+import com.hyntix.pdfium.PdfPage
+import java.io.ByteArrayOutputStream
+
+/**
+ * Queues annotation creates, updates and removes for one page and applies
+ * them in a single native pass on [commit].
+ *
+ * Update and remove indices refer to the page as it was when the transaction
+ * was started. On commit updates run first, then creates, which append to the
+ * page, then removes from the highest index down, so queued indices never
+ * shift under each other. Appearance streams are regenerated once per
+ * annotation at the end instead of after every edit.
+ *
+ * Obtained from [PdfPage.beginAnnotationTransaction]. Not thread-safe.
+ */
+class AnnotationTransaction internal constructor(private val page: PdfPage) {
+
+    private class Create(val type: AnnotationType, val changes: AnnotationChanges)
+    private class Update(val index: Int, val changes: AnnotationChanges)
+
+    private val creates = ArrayList<Create>()
+    private val updates = ArrayList<Update>()
+    private val removes = sortedSetOf<Int>(reverseOrder())
+
+    /** Number of queued operations. */
+    val size: Int
+        get() = creates.size + updates.size + removes.size
+
+    /**
+     * Queue a new annotation of [type] with the given properties.
+     */
+    fun create(type: AnnotationType, changes: AnnotationChanges): AnnotationTransaction {
+        require(type != AnnotationType.UNKNOWN) { "Annotation type must be known" }
+        creates.add(Create(type, changes))
+        return this
+    }
+
+    /**
+     * Queue a highlight, with the same defaults as [PdfPage.createHighlightAnnotation].
+     */
+    fun createHighlight(
+        quadPoints: List<DoubleArray>,
+        contents: String = "",
+        author: String = "",
+        color: AnnotationColor = AnnotationColor(255, 255, 0, 128)
+    ): AnnotationTransaction {
+        require(quadPoints.isNotEmpty()) { "Highlights need quad points" }
+        return create(
+            AnnotationType.HIGHLIGHT,
+            AnnotationChanges(
+                color = color,
+                opacity = color.alpha / 255.0f,
+                contents = contents.ifEmpty { null },
+                author = author.ifEmpty { null },
+                quadPoints = quadPoints
+            )
+        )
+    }
+
+    /**
+     * Queue an ink annotation, with the same defaults as [PdfPage.createInkAnnotation].
+     */
+    fun createInk(
+        inkList: List<InkPath>,
+        contents: String = "",
+        author: String = "",
+        color: AnnotationColor = AnnotationColor(0, 0, 0, 255)
+    ): AnnotationTransaction {
+        require(inkList.isNotEmpty()) { "Ink annotations need at least one path" }
+        return create(
+            AnnotationType.INK,
+            AnnotationChanges(
+                color = color,
+                opacity = color.alpha / 255.0f,
+                contents = contents.ifEmpty { null },
+                author = author.ifEmpty { null },
+                inkList = inkList
+            )
+        )
+    }
+
+    /**
+     * Queue changes to the annotation at [index].
+     */
+    fun update(index: Int, changes: AnnotationChanges): AnnotationTransaction {
+        require(index >= 0) { "Index must not be negative" }
+        updates.add(Update(index, changes))
+        return this
+    }
+
+    /**
+     * Queue removal of the annotation at [index]. Updates queued for it are dropped.
+     */
+    fun remove(index: Int): AnnotationTransaction {
+        require(index >= 0) { "Index must not be negative" }
+        removes.add(index)
+        return this
+    }
+
+    /**
+     * Apply every queued operation and clear the queue.
+     *
+     * Appearance streams are only reset for subtypes PDFium can redraw from
+     * their properties: square, circle, line, ink, text markup, text and popup.
+     *
+     * @param regenerateAppearances Reset the appearance streams of created
+     * annotations so PDFium regenerates them from their properties
+     * @param regenerateUpdatedAppearances Also reset them for updated
+     * annotations whose rect, colors, opacity, quad points or ink changed.
+     * Off by default so edits to existing annotations keep their appearance.
+     * @return The number of operations applied, or -1 if the page rejected the batch
+     */
+    fun commit(regenerateAppearances: Boolean = true, regenerateUpdatedAppearances: Boolean = false): Int {
+        if (size == 0) return 0
+        var appearanceFlags = 0
+        if (regenerateAppearances) appearanceFlags = appearanceFlags or APPEARANCE_CREATED
+        if (regenerateUpdatedAppearances) appearanceFlags = appearanceFlags or APPEARANCE_UPDATED
+        val result = page.applyAnnotationEdits(encode(), appearanceFlags)
+        creates.clear()
+        updates.clear()
+        removes.clear()
+        return result
+    }
+
+    /**
+     * opCount, then per operation kind, subtype or index, fields and the
+     * groups selected in fields, laid out like [AnnotationBatchReader] records
+     * with colors always present.
+     */
+    private fun encode(): ByteArray {
+        val live = updates.filter { it.index !in removes }
+        val out = ByteArrayOutputStream()
+        out.putInt(live.size + creates.size + removes.size)
+        live.forEach { out.putOperation(OP_UPDATE, it.index, it.changes) }
+        creates.forEach { out.putOperation(OP_CREATE, it.type.value, it.changes) }
+        removes.forEach { index ->
+            out.putInt(OP_REMOVE)
+            out.putInt(index)
+            out.putInt(0)
+        }
+        return out.toByteArray()
+    }
+
+    private fun ByteArrayOutputStream.putOperation(kind: Int, target: Int, changes: AnnotationChanges) {
+        val fields = changes.fields
+        putInt(kind)
+        putInt(target)
+        putInt(fields)
+        changes.rect?.let {
+            putFloat(it.left)
+            putFloat(it.top)
+            putFloat(it.right)
+            putFloat(it.bottom)
+        }
+        changes.color?.let { color -> color.toIntArray().forEach { putInt(it) } }
+        changes.interiorColor?.let { color -> color.toIntArray().forEach { putInt(it) } }
+        changes.flags?.let { putInt(it) }
+        changes.opacity?.let { putFloat(it) }
+        changes.contents?.let { putUtf16(it) }
+        changes.author?.let { putUtf16(it) }
+        changes.subject?.let { putUtf16(it) }
+        if (fields and PageAnnotation.FIELD_DATES != 0) {
+            putUtf16(changes.creationDate ?: "")
+            putUtf16(changes.modificationDate ?: "")
+        }
+        changes.quadPoints?.let { quads ->
+            putInt(quads.size)
+            quads.forEach { quad -> quad.forEach { putFloat(it.toFloat()) } }
+        }
+        changes.inkList?.let { strokes ->
+            putInt(strokes.size)
+            strokes.forEach { stroke ->
+                putInt(stroke.points.size)
+                stroke.points.forEach { point ->
+                    putFloat(point[0].toFloat())
+                    putFloat(point[1].toFloat())
+                }
+            }
+        }
+    }
+
+    private fun ByteArrayOutputStream.putInt(value: Int) {
+        for (i in 0 until 4) write(value ushr (i * 8))
+    }
+
+    private fun ByteArrayOutputStream.putFloat(value: Float) = putInt(value.toRawBits())
+
+    private fun ByteArrayOutputStream.putUtf16(value: String) {
+        putInt(value.length)
+        for (c in value) {
+            write(c.code)
+            write(c.code ushr 8)
+        }
+    }
+
+    private companion object {
+        const val OP_CREATE = 0
+        const val OP_UPDATE = 1
+        const val OP_REMOVE = 2
+
+        const val APPEARANCE_CREATED = 1
+        const val APPEARANCE_UPDATED = 2
+    }
+}
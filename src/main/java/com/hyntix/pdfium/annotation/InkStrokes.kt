@@ -0,0 +1,58 @@
+package com.hyntix.pdfium.annotation
+
+/**
+ * Flat ink strokes: every point in one array plus the index of each stroke's
+ * first point, so large ink lists don't allocate an array per stroke.
+ *
+ * @property points x/y pairs of all strokes, back to back
+ * @property offsets First point index of each stroke, followed by the total point count
+ */
+class InkStrokes(val points: FloatArray, val offsets: IntArray) {
+    init {
+        require(points.size % 2 == 0) { "Points must be x/y pairs" }
+        require(offsets.isNotEmpty() && offsets[0] == 0 && offsets.last() == points.size / 2) {
+            "Offsets must start at 0 and end at the point count"
+        }
+    }
+
+    /** Number of strokes. */
+    val strokeCount: Int
+        get() = offsets.size - 1
+
+    /** Number of points in [stroke]. */
+    fun getPointCount(stroke: Int): Int = offsets[stroke + 1] - offsets[stroke]
+
+    /** X coordinate of point [point] of [stroke]. */
+    fun getX(stroke: Int, point: Int): Float = points[(offsets[stroke] + point) * 2]
+
+    /** Y coordinate of point [point] of [stroke]. */
+    fun getY(stroke: Int, point: Int): Float = points[(offsets[stroke] + point) * 2 + 1]
+
+    /**
+     * The strokes as [InkPath]s.
+     */
+    fun toInkPaths(): List<InkPath> = List(strokeCount) { stroke ->
+        InkPath(List(getPointCount(stroke)) { point ->
+            doubleArrayOf(getX(stroke, point).toDouble(), getY(stroke, point).toDouble())
+        })
+    }
+
+    companion object {
+        /**
+         * Flatten per-stroke x/y arrays, dropping empty strokes.
+         */
+        fun fromArrays(strokes: Array<DoubleArray>): InkStrokes {
+            val kept = strokes.filter { it.size >= 2 }
+            val offsets = IntArray(kept.size + 1)
+            kept.forEachIndexed { i, stroke -> offsets[i + 1] = offsets[i] + stroke.size / 2 }
+            val points = FloatArray(offsets.last() * 2)
+            kept.forEachIndexed { i, stroke ->
+                for (j in 0 until offsets[i + 1] - offsets[i]) {
+                    points[(offsets[i] + j) * 2] = stroke[j * 2].toFloat()
+                    points[(offsets[i] + j) * 2 + 1] = stroke[j * 2 + 1].toFloat()
+                }
+            }
+            return InkStrokes(points, offsets)
+        }
+    }
+}
@@ -0,0 +1,80 @@
+package com.hyntix.pdfium.annotation
+
+import android.graphics.RectF
+
+/**
+ * An annotation read from a page by [com.hyntix.pdfium.PdfPage.getAllAnnotations].
+ *
+ * Only the property groups requested in the read mask are filled in; the
+ * others keep their defaults.
+ *
+ * @property index Index of the annotation on its page
+ * @property subtype Raw FPDF_ANNOT_* subtype, kept for values [type] doesn't model
+ * @property interiorColor Interior (fill) color, or null if the annotation has none
+ * @property quadPoints Quad points, 8 values per region
+ * @property inkList Ink strokes
+ */
+class PageAnnotation(
+    val index: Int,
+    val subtype: Int,
+    override val rect: RectF = RectF(),
+    override var contents: String = "",
+    override var author: String = "",
+    override var subject: String = "",
+    override val creationDate: String = "",
+    override var modificationDate: String = "",
+    override var color: AnnotationColor = AnnotationColor(0, 0, 0, 255),
+    val interiorColor: AnnotationColor? = null,
+    override var opacity: Float = 1.0f,
+    override var flags: Int = 0,
+    val quadPoints: List<DoubleArray> = emptyList(),
+    val inkList: List<InkPath> = emptyList()
+) : PdfAnnotationBase() {
+
+    override val type: AnnotationType = AnnotationType.fromValue(subtype)
+
+    /**
+     * This annotation as a markup model, or null if it isn't a highlight,
+     * underline or strikeout.
+     */
+    fun toMarkupAnnotation(): MarkupAnnotation? = when (type) {
+        AnnotationType.HIGHLIGHT -> HighlightAnnotation(contents, author, color, quadPoints)
+        AnnotationType.UNDERLINE -> UnderlineAnnotation(contents, author, color, quadPoints)
+        AnnotationType.STRIKEOUT -> StrikeoutAnnotation(contents, author, color, quadPoints)
+        else -> null
+    }
+
+    /**
+     * This annotation as an ink model, or null if it isn't an ink annotation.
+     */
+    fun toInkAnnotation(): InkAnnotation? =
+        if (type == AnnotationType.INK) InkAnnotation(contents, author, color, inkList) else null
+
+    companion object {
+        /** Bounding rectangle */
+        const val FIELD_RECT = 1 shl 0
+        /** Stroke color */
+        const val FIELD_COLOR = 1 shl 1
+        /** Interior color */
+        const val FIELD_INTERIOR_COLOR = 1 shl 2
+        /** Annotation flags */
+        const val FIELD_FLAGS = 1 shl 3
+        /** Opacity (CA) */
+        const val FIELD_OPACITY = 1 shl 4
+        /** Contents */
+        const val FIELD_CONTENTS = 1 shl 5
+        /** Author (T) */
+        const val FIELD_AUTHOR = 1 shl 6
+        /** Subject */
+        const val FIELD_SUBJECT = 1 shl 7
+        /** Creation and modification dates */
+        const val FIELD_DATES = 1 shl 8
+        /** Quad points */
+        const val FIELD_QUAD_POINTS = 1 shl 9
+        /** Ink list */
+        const val FIELD_INK_LIST = 1 shl 10
+
+        /** Every property group */
+        const val FIELD_ALL = (1 shl 11) - 1
+    }
+}
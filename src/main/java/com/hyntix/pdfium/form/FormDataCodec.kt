@@ -0,0 +1,99 @@
+package com.hyntix.pdfium.form
+
+import java.io.ByteArrayOutputStream
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Packed little-endian format exchanged with `nativeExportFormData` and
+ * `nativeImportFormData`. Strings are an int UTF-16 length followed by the units.
+ */
+internal object FormDataCodec {
+
+    private const val FLAG_READ_ONLY = 0x01
+    private const val FLAG_REQUIRED = 0x02
+
+    /**
+     * Decode an export: formType, fieldCount, then per field type, flags,
+     * maxLength, name, value and the options as label plus selected flag.
+     */
+    fun decodeSnapshot(bytes: ByteArray): FormDataSnapshot {
+        val buffer = ByteBuffer.wrap(bytes).order(ByteOrder.LITTLE_ENDIAN)
+        val formType = buffer.int
+        val fieldCount = buffer.int
+        val fields = ArrayList<FormFieldData>(fieldCount)
+        repeat(fieldCount) { fields.add(buffer.getField()) }
+        return FormDataSnapshot(formType, fields)
+    }
+
+    /**
+     * Decode a single field record, laid out like one field of a snapshot.
+     */
+    fun decodeField(bytes: ByteArray): FormFieldData =
+        ByteBuffer.wrap(bytes).order(ByteOrder.LITTLE_ENDIAN).getField()
+
+    /**
+     * Encode values to apply: entryCount, then per field name, value and the
+     * options as index plus selected flag. The first field with a name wins.
+     */
+    fun encodeImport(snapshot: FormDataSnapshot): ByteArray {
+        val out = ByteArrayOutputStream()
+        out.putInt(snapshot.fields.size)
+        snapshot.fields.forEach { field ->
+            out.putUtf16(field.name)
+            out.putUtf16(field.value)
+            val options = if (field.type == FormFieldType.COMBOBOX || field.type == FormFieldType.LISTBOX) {
+                field.options
+            } else {
+                emptyList()
+            }
+            out.putInt(options.size)
+            options.forEach { option ->
+                out.putInt(option.index)
+                out.putInt(if (option.isSelected) 1 else 0)
+            }
+        }
+        return out.toByteArray()
+    }
+
+    private fun ByteBuffer.getField(): FormFieldData {
+        val type = FormFieldType.fromValue(int)
+        val flags = int
+        val maxLength = int
+        val name = getUtf16()
+        val value = getUtf16()
+        val options = List(int) { index ->
+            val label = getUtf16()
+            // Export values aren't exposed by PDFium; the label doubles as the value
+            FormFieldOption(label, label, int != 0, index)
+        }
+        return FormFieldData(
+            name = name,
+            type = type,
+            value = value,
+            defaultValue = value,
+            isRequired = flags and FLAG_REQUIRED != 0,
+            isReadOnly = flags and FLAG_READ_ONLY != 0,
+            maxLength = maxLength,
+            options = options
+        )
+    }
+
+    private fun ByteBuffer.getUtf16(): String {
+        val length = int
+        val chars = CharArray(length) { char }
+        return String(chars)
+    }
+
+    private fun ByteArrayOutputStream.putInt(value: Int) {
+        for (i in 0 until 4) write(value ushr (i * 8))
+    }
+
+    private fun ByteArrayOutputStream.putUtf16(value: String) {
+        putInt(value.length)
+        for (c in value) {
+            write(c.code)
+            write(c.code ushr 8)
+        }
+    }
+}
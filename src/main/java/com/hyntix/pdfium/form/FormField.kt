@@ -75,3 +75,14 @@ data class FormFieldOption(
     val isSelected: Boolean = false,
     val index: Int = 0
 )
+
+/**
+ * Location of one widget of a form field.
+ *
+ * @property pageIndex The 0-based index of the page holding the widget
+ * @property annotIndex The index of the widget among the page's annotations
+ */
+data class FormFieldWidget(
+    val pageIndex: Int,
+    val annotIndex: Int
+)
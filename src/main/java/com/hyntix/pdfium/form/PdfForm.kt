@@ -65,6 +65,45 @@ class PdfForm(
         return page.setFormFieldValue(formPtr, field, value)
     }
     
+    /**
+     * Find the widgets of a field anywhere in the document.
+     *
+     * Lookups go through a native field-name index that is built on first use
+     * and then kept current page by page, so they don't scale with document size.
+     *
+     * @param name The fully qualified name of the form field
+     * @return Widget locations, empty if no field has that name
+     */
+    fun findWidgets(name: String): List<FormFieldWidget> {
+        checkNotClosed()
+        val packed = core.findFormField(formPtr, docPtr, name) ?: return emptyList()
+        return List(packed.size / 2) { FormFieldWidget(packed[it * 2], packed[it * 2 + 1]) }
+    }
+    
+    /**
+     * Read a field by name without loading the pages of other fields.
+     *
+     * @param name The fully qualified name of the form field
+     * @return The data of the field's first widget, or null if not found
+     */
+    fun getFieldData(name: String): FormFieldData? {
+        checkNotClosed()
+        val packed = core.getFormFieldDataByName(formPtr, docPtr, name) ?: return null
+        return FormDataCodec.decodeField(packed)
+    }
+    
+    /**
+     * Set the value of every widget of a field by name.
+     *
+     * @param name The fully qualified name of the form field
+     * @param value The new value
+     * @return True if at least one widget was updated
+     */
+    fun setFieldValue(name: String, value: String): Boolean {
+        checkNotClosed()
+        return core.setFormFieldValueByName(formPtr, docPtr, name, value) > 0
+    }
+    
     /**
      * Get all options for a combo box or list box field.
      * 
@@ -110,6 +149,71 @@ class PdfForm(
         return options.filter { it.isSelected }.map { it.index }
     }
     
+    // --- Input ---
+    // Coordinates are in page space (points, origin at the bottom left); map
+    // touches with PdfPage.mapDeviceToPage. Afterwards, PdfPage.pollFormDirtyRects
+    // returns what needs to be redrawn.
+    
+    /**
+     * Send a press at ([x], [y]) on [page] to the form, e.g. to focus a field.
+     *
+     * @return True if the form handled it
+     */
+    fun onLButtonDown(page: PdfPage, x: Double, y: Double, modifier: Int = 0): Boolean {
+        checkNotClosed()
+        return core.formOnLButtonDown(formPtr, page.getPointer(), modifier, x, y)
+    }
+    
+    /**
+     * Send a release at ([x], [y]) on [page] to the form, e.g. to toggle a check box.
+     *
+     * @return True if the form handled it
+     */
+    fun onLButtonUp(page: PdfPage, x: Double, y: Double, modifier: Int = 0): Boolean {
+        checkNotClosed()
+        return core.formOnLButtonUp(formPtr, page.getPointer(), modifier, x, y)
+    }
+    
+    /**
+     * Send a pointer move over [page] to the form.
+     *
+     * @return True if the form handled it
+     */
+    fun onMouseMove(page: PdfPage, x: Double, y: Double, modifier: Int = 0): Boolean {
+        checkNotClosed()
+        return core.formOnMouseMove(formPtr, page.getPointer(), modifier, x, y)
+    }
+    
+    /**
+     * Send a key press (an FWL_VKEY code) to the focused field on [page].
+     *
+     * @return True if the form handled it
+     */
+    fun onKeyDown(page: PdfPage, keyCode: Int, modifier: Int = 0): Boolean {
+        checkNotClosed()
+        return core.formOnKeyDown(formPtr, page.getPointer(), keyCode, modifier)
+    }
+    
+    /**
+     * Send a key release (an FWL_VKEY code) to the focused field on [page].
+     *
+     * @return True if the form handled it
+     */
+    fun onKeyUp(page: PdfPage, keyCode: Int, modifier: Int = 0): Boolean {
+        checkNotClosed()
+        return core.formOnKeyUp(formPtr, page.getPointer(), keyCode, modifier)
+    }
+    
+    /**
+     * Type a character (UTF-16 code unit) into the focused field on [page].
+     *
+     * @return True if the form handled it
+     */
+    fun onChar(page: PdfPage, charCode: Int, modifier: Int = 0): Boolean {
+        checkNotClosed()
+        return core.formOnChar(formPtr, page.getPointer(), charCode, modifier)
+    }
+    
     /**
      * Close the form and release native resources.
      */
@@ -130,67 +234,16 @@ class PdfForm(
     /**
      * Export all form data as a snapshot.
      *
+     * The whole document is walked in one native call that returns every
+     * widget's name, type, value, flags and options packed together.
+     *
      * @return FormDataSnapshot containing all form fields
      */
     fun exportFormData(): FormDataSnapshot {
         checkNotClosed()
-        val fields = mutableListOf<FormFieldData>()
-        
-        // Iterate through all pages to collect form fields
-        val pageCount = core.getPageCount(docPtr)
-        for (pageIndex in 0 until pageCount) {
-            val pagePtr = core.loadPage(docPtr, pageIndex)
-            if (pagePtr != 0L) {
-                try {
-                    val fieldCount = core.getFormFieldCount(formPtr, pagePtr)
-                    for (i in 0 until fieldCount) {
-                        val annotPtr = core.getFormFieldAtIndex(formPtr, pagePtr, i)
-                        if (annotPtr != 0L) {
-                            val name = core.getFormFieldName(formPtr, annotPtr) ?: ""
-                            val type = FormFieldType.fromValue(core.getFormFieldType(formPtr, annotPtr))
-                            val value = core.getFormFieldValue(formPtr, annotPtr) ?: ""
-                            val defaultValue = core.getFormFieldDefaultValue(formPtr, annotPtr) ?: ""
-                            val isRequired = core.isFormFieldRequired(formPtr, annotPtr)
-                            val isReadOnly = core.isFormFieldReadOnly(formPtr, annotPtr)
-                            val maxLength = core.getFormFieldMaxLength(formPtr, annotPtr)
-                            
-                            // Get options for combo box and list box fields
-                            val options = if (type == FormFieldType.COMBOBOX || type == FormFieldType.LISTBOX) {
-                                val optionCount = core.getFormFieldOptionCount(formPtr, annotPtr)
-                                (0 until optionCount).mapNotNull { idx ->
-                                    val label = core.getFormFieldOptionLabel(formPtr, annotPtr, idx)
-                                    val optValue = core.getFormFieldOptionValue(formPtr, annotPtr, idx)
-                                    val isSelected = core.isFormFieldOptionSelected(formPtr, annotPtr, idx)
-                                    if (label != null && optValue != null) {
-                                        FormFieldOption(label, optValue, isSelected, idx)
-                                    } else null
-                                }
-                            } else {
-                                emptyList()
-                            }
-                            
-                            fields.add(
-                                FormFieldData(
-                                    name = name,
-                                    type = type,
-                                    value = value,
-                                    defaultValue = defaultValue,
-                                    isRequired = isRequired,
-                                    isReadOnly = isReadOnly,
-                                    maxLength = maxLength,
-                                    options = options
-                                )
-                            )
-                        }
-                    }
-                } finally {
-                    core.closePage(pagePtr)
-                }
-            }
-        }
-        
-        val formType = core.getFormType(docPtr)
-        return FormDataSnapshot(formType, fields)
+        val packed = core.exportFormData(formPtr, docPtr)
+            ?: return FormDataSnapshot(core.getFormType(docPtr), emptyList())
+        return FormDataCodec.decodeSnapshot(packed)
     }
     
     /**
@@ -231,51 +284,15 @@ class PdfForm(
     /**
      * Restore form data from a snapshot.
      *
+     * Values and option selections are applied to every widget with a matching
+     * name in one native page walk.
+     *
      * @param snapshot FormDataSnapshot to restore
      * @return True if restoration was successful
      */
     fun restoreFromSnapshot(snapshot: FormDataSnapshot): Boolean {
         checkNotClosed()
-        
-        try {
-            val pageCount = core.getPageCount(docPtr)
-            for (pageIndex in 0 until pageCount) {
-                val pagePtr = core.loadPage(docPtr, pageIndex)
-                if (pagePtr != 0L) {
-                    try {
-                        val fieldCount = core.getFormFieldCount(formPtr, pagePtr)
-                        for (i in 0 until fieldCount) {
-                            val annotPtr = core.getFormFieldAtIndex(formPtr, pagePtr, i)
-                            if (annotPtr != 0L) {
-                                val name = core.getFormFieldName(formPtr, annotPtr)
-                                val fieldData = snapshot.fields.find { it.name == name }
-                                
-                                if (fieldData != null) {
-                                    // Set the field value
-                                    core.setFormFieldValue(formPtr, pagePtr, annotPtr, fieldData.value)
-                                    
-                                    // For combo box and list box, set selected options
-                                    if (fieldData.type == FormFieldType.COMBOBOX || 
-                                        fieldData.type == FormFieldType.LISTBOX) {
-                                        fieldData.options.forEach { option ->
-                                            core.setFormFieldOptionSelection(
-                                                formPtr, pagePtr, annotPtr, 
-                                                option.index, option.isSelected
-                                            )
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    } finally {
-                        core.closePage(pagePtr)
-                    }
-                }
-            }
-            return true
-        } catch (e: Exception) {
-            return false
-        }
+        return core.importFormData(formPtr, docPtr, FormDataCodec.encodeImport(snapshot)) >= 0
     }
     
     // --- Appearance Settings ---
@@ -0,0 +1,174 @@
+package com.hyntix.pdfium.merge
+
+/**
+ * One source page placed on a sheet.
+ *
+ * @property pageIndex 0-based source page, or -1 for a blank slot
+ * @property matrix Six floats a, b, c, d, e, f mapping source page space to sheet
+ *   space, as in a PDF `cm` operator
+ */
+class PdfSheetSlot(val pageIndex: Int, val matrix: FloatArray) {
+    init {
+        require(matrix.size == 6) { "Matrix must have six elements" }
+    }
+
+    companion object {
+        /**
+         * Slot that scales a [pageWidth] x [pageHeight] page, turned clockwise by
+         * [rotation] degrees, to fit the cell at ([left], [bottom]) of size
+         * [width] x [height], centered and keeping its aspect ratio.
+         */
+        fun fit(
+            pageIndex: Int,
+            pageWidth: Float,
+            pageHeight: Float,
+            left: Float,
+            bottom: Float,
+            width: Float,
+            height: Float,
+            rotation: Int = 0
+        ): PdfSheetSlot {
+            require(rotation % 90 == 0) { "Rotation must be a multiple of 90" }
+            require(pageWidth > 0f && pageHeight > 0f) { "Page size must be positive" }
+            val turn = ((rotation / 90) % 4 + 4) % 4
+            val turnedWidth = if (turn % 2 == 0) pageWidth else pageHeight
+            val turnedHeight = if (turn % 2 == 0) pageHeight else pageWidth
+            val s = minOf(width / turnedWidth, height / turnedHeight)
+            val cx = left + width / 2
+            val cy = bottom + height / 2
+            val matrix = when (turn) {
+                0 -> floatArrayOf(s, 0f, 0f, s, cx - s * pageWidth / 2, cy - s * pageHeight / 2)
+                1 -> floatArrayOf(0f, -s, s, 0f, cx - s * pageHeight / 2, cy + s * pageWidth / 2)
+                2 -> floatArrayOf(-s, 0f, 0f, -s, cx + s * pageWidth / 2, cy + s * pageHeight / 2)
+                else -> floatArrayOf(0f, s, -s, 0f, cx + s * pageHeight / 2, cy - s * pageWidth / 2)
+            }
+            return PdfSheetSlot(pageIndex, matrix)
+        }
+    }
+}
+
+/**
+ * Placement of source pages onto output sheets, applied by
+ * [com.hyntix.pdfium.PdfDocument.impose].
+ *
+ * Sheets are built from form XObjects, so page content stays vector and each
+ * source page is parsed once however many slots show it. Sizes passed to
+ * [layout] come from `getPageSize` and do not undo a page's /Rotate; pages with
+ * a /Rotate entry are placed as their unrotated content.
+ */
+abstract class PdfImposition(val sheetWidth: Float, val sheetHeight: Float) {
+
+    init {
+        require(sheetWidth > 0f && sheetHeight > 0f) { "Sheet size must be positive" }
+    }
+
+    /**
+     * Lay out [pages] onto sheets.
+     *
+     * @param pages Source page indices in reading order
+     * @param sizes Width and height of each entry of [pages], in points
+     * @return Slots of each sheet, in sheet order
+     */
+    abstract fun layout(pages: IntArray, sizes: List<Pair<Float, Float>>): List<List<PdfSheetSlot>>
+
+    companion object {
+        /**
+         * [columns] x [rows] pages per sheet, left to right, then top to bottom;
+         * 2 x 2 on a letter sheet gives 4-up handouts.
+         *
+         * @param margin Space around the grid, in points
+         * @param gutter Space between cells, in points
+         */
+        fun grid(
+            sheetWidth: Float,
+            sheetHeight: Float,
+            columns: Int,
+            rows: Int,
+            margin: Float = 0f,
+            gutter: Float = 0f
+        ): PdfImposition = object : PdfImposition(sheetWidth, sheetHeight) {
+            init {
+                require(columns > 0 && rows > 0) { "Grid needs at least one column and row" }
+            }
+
+            override fun layout(pages: IntArray, sizes: List<Pair<Float, Float>>): List<List<PdfSheetSlot>> {
+                val cellWidth = (sheetWidth - 2 * margin - (columns - 1) * gutter) / columns
+                val cellHeight = (sheetHeight - 2 * margin - (rows - 1) * gutter) / rows
+                require(cellWidth > 0f && cellHeight > 0f) { "Margin and gutter leave no room for pages" }
+                val perSheet = columns * rows
+                return (pages.indices step perSheet).map { first ->
+                    (first until minOf(first + perSheet, pages.size)).map { i ->
+                        val column = (i - first) % columns
+                        val row = (i - first) / columns
+                        PdfSheetSlot.fit(
+                            pages[i], sizes[i].first, sizes[i].second,
+                            left = margin + column * (cellWidth + gutter),
+                            bottom = sheetHeight - margin - (row + 1) * cellHeight - row * gutter,
+                            width = cellWidth,
+                            height = cellHeight
+                        )
+                    }
+                }
+            }
+        }
+
+        /**
+         * Saddle-stitched booklet: two pages side by side per sheet side, in
+         * the order that reads correctly once the printed sheets are folded and
+         * nested. Output pages alternate front and back of each physical sheet,
+         * for duplex printing flipped on the short edge. The page count is
+         * padded with blanks to a multiple of four.
+         *
+         * @param sheetWidth Width of one sheet side, holding two pages
+         * @param margin Space around the pages, in points
+         * @param gutter Space between the two pages, in points
+         */
+        fun booklet(
+            sheetWidth: Float,
+            sheetHeight: Float,
+            margin: Float = 0f,
+            gutter: Float = 0f
+        ): PdfImposition = object : PdfImposition(sheetWidth, sheetHeight) {
+            override fun layout(pages: IntArray, sizes: List<Pair<Float, Float>>): List<List<PdfSheetSlot>> {
+                val cellWidth = (sheetWidth - 2 * margin - gutter) / 2
+                val cellHeight = sheetHeight - 2 * margin
+                require(cellWidth > 0f && cellHeight > 0f) { "Margin and gutter leave no room for pages" }
+                val padded = (pages.size + 3) / 4 * 4
+
+                fun slot(position: Int, right: Boolean): PdfSheetSlot? {
+                    if (position >= pages.size) return null
+                    return PdfSheetSlot.fit(
+                        pages[position], sizes[position].first, sizes[position].second,
+                        left = if (right) margin + cellWidth + gutter else margin,
+                        bottom = margin,
+                        width = cellWidth,
+                        height = cellHeight
+                    )
+                }
+
+                return (0 until padded / 2).map { side ->
+                    val sheet = side / 2
+                    val (left, right) = if (side % 2 == 0) {
+                        padded - 1 - 2 * sheet to 2 * sheet
+                    } else {
+                        2 * sheet + 1 to padded - 2 - 2 * sheet
+                    }
+                    listOfNotNull(slot(left, false), slot(right, true))
+                }
+            }
+        }
+
+        /**
+         * Explicit slots for every sheet, for layouts such as step-and-repeat
+         * or work-and-turn. Page indices in [sheets] are source page indices;
+         * the pages passed to [layout] are ignored.
+         */
+        fun custom(
+            sheetWidth: Float,
+            sheetHeight: Float,
+            sheets: List<List<PdfSheetSlot>>
+        ): PdfImposition = object : PdfImposition(sheetWidth, sheetHeight) {
+            override fun layout(pages: IntArray, sizes: List<Pair<Float, Float>>) = sheets
+        }
+    }
+}
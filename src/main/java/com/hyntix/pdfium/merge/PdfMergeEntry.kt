@@ -0,0 +1,32 @@
+package com.hyntix.pdfium.merge
+
+/**
+ * One line of a merge manifest: pages of [source] inserted at [insertIndex].
+ *
+ * Entries are applied in manifest order, so [insertIndex] refers to the
+ * document as assembled by the entries before this one.
+ *
+ * @property source Document to import from
+ * @property pageIndices 0-based source pages in import order, or null for all pages
+ * @property insertIndex Position in the destination, or [APPEND] for the end
+ */
+class PdfMergeEntry(
+    val source: PdfMergeSource,
+    val pageIndices: IntArray? = null,
+    val insertIndex: Int = APPEND
+) {
+    init {
+        require(insertIndex >= 0 || insertIndex == APPEND) { "insertIndex must be >= 0 or APPEND" }
+    }
+
+    companion object {
+        /** Insert after the last page assembled so far. */
+        const val APPEND = -1
+
+        /** Pages [first] to [last] inclusive of [source], 0-based. */
+        fun range(source: PdfMergeSource, first: Int, last: Int, insertIndex: Int = APPEND): PdfMergeEntry {
+            require(first in 0..last) { "Invalid page range $first..$last" }
+            return PdfMergeEntry(source, IntArray(last - first + 1) { first + it }, insertIndex)
+        }
+    }
+}
@@ -0,0 +1,56 @@
+package com.hyntix.pdfium.merge
+
+/**
+ * Progress callback of a [PdfMerger] run, invoked on the merging thread after
+ * every entry.
+ */
+fun interface PdfMergeListener {
+    /**
+     * @param entriesDone Entries imported so far
+     * @param entryCount Entries in the manifest
+     * @param pagesImported Pages imported so far
+     */
+    fun onProgress(entriesDone: Int, entryCount: Int, pagesImported: Int)
+}
+
+/**
+ * Outcome and resource statistics of a [PdfMerger] run.
+ *
+ * Memory figures are sampled after each source is opened and after each
+ * entry is imported, so short spikes inside PDFium calls are not seen.
+ *
+ * @property status How the run ended
+ * @property failedEntry Index of the entry that failed, or -1
+ * @property pagesImported Pages in the assembled document from this run
+ * @property sourcesOpened Sources opened during the run
+ * @property peakOpenSources Most sources open at once
+ * @property peakNativeHeapGrowthBytes Largest native heap growth over the start of the run
+ * @property peakBufferBytesHeld Largest native memory held for document data, process wide
+ *   (see [com.hyntix.pdfium.PdfiumStats.bufferBytesHeld])
+ * @property importNanos Time spent opening sources and importing
+ * @property saveNanos Time spent writing the output, 0 when not saved
+ */
+data class PdfMergeResult(
+    val status: Status,
+    val failedEntry: Int,
+    val pagesImported: Int,
+    val sourcesOpened: Int,
+    val peakOpenSources: Int,
+    val peakNativeHeapGrowthBytes: Long,
+    val peakBufferBytesHeld: Long,
+    val importNanos: Long,
+    val saveNanos: Long
+) {
+    enum class Status {
+        /** Every entry was imported and the output, if any, written. */
+        COMPLETED,
+
+        /** The cancellation signal fired; nothing was written. */
+        CANCELLED,
+
+        /** A source could not be opened or imported, or the output could not be written. */
+        FAILED
+    }
+
+    val isSuccessful: Boolean get() = status == Status.COMPLETED
+}
@@ -0,0 +1,57 @@
+package com.hyntix.pdfium.merge
+
+import android.os.ParcelFileDescriptor
+import com.hyntix.pdfium.DocumentLoadMode
+import com.hyntix.pdfium.PdfDocument
+import com.hyntix.pdfium.PdfiumCore
+import java.io.File
+import java.nio.ByteBuffer
+
+/**
+ * A document that pages are imported from in a [PdfMerger] run.
+ *
+ * Sources are opened on first use and closed right after the last entry that
+ * reads from them, so only the sources still needed are open at any time.
+ * Files and descriptors are opened in [DocumentLoadMode.STREAMING] mode and
+ * buffers without a copy, so an open source holds little more than its parsed
+ * structure. Use the same instance in several entries to open it only once.
+ */
+class PdfMergeSource private constructor(
+    private val description: String,
+    private val ownsDocument: Boolean,
+    private val opener: (PdfiumCore) -> PdfDocument?
+) {
+
+    internal fun open(core: PdfiumCore): PdfDocument? = opener(core)
+
+    /** Close [document] if it was opened by this source. */
+    internal fun release(document: PdfDocument) {
+        if (ownsDocument) document.close()
+    }
+
+    override fun toString(): String = "PdfMergeSource($description)"
+
+    companion object {
+        /** A PDF file, read on demand. */
+        fun file(file: File, password: String? = null) = PdfMergeSource(file.path, true) { core ->
+            core.openDocument(file.path, password, DocumentLoadMode.STREAMING)
+        }
+
+        /** A PDF behind a descriptor, read on demand. The descriptor is duplicated, not closed. */
+        fun descriptor(descriptor: ParcelFileDescriptor, password: String? = null) =
+            PdfMergeSource("fd ${descriptor.fd}", true) { core ->
+                core.openDocument(descriptor.fd, password, DocumentLoadMode.STREAMING)
+            }
+
+        /** PDF bytes in a direct buffer, parsed in place. */
+        fun buffer(buffer: ByteBuffer, password: String? = null): PdfMergeSource {
+            require(buffer.isDirect) { "Buffer must be a direct ByteBuffer" }
+            return PdfMergeSource("buffer of ${buffer.remaining()} bytes", true) { core ->
+                core.openDocument(buffer, password)
+            }
+        }
+
+        /** A document the caller already has open. It is not closed by the merge. */
+        fun document(document: PdfDocument) = PdfMergeSource("open document", false) { document }
+    }
+}
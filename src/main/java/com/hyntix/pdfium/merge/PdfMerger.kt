@@ -0,0 +1,169 @@
+package com.hyntix.pdfium.merge
+
+import android.os.CancellationSignal
+import android.os.Debug
+import android.os.ParcelFileDescriptor
+import com.hyntix.pdfium.PdfDocument
+import com.hyntix.pdfium.PdfiumCore
+import java.io.OutputStream
+import java.util.IdentityHashMap
+
+/**
+ * Assembles a document from pages of many sources, following a manifest of
+ * [PdfMergeEntry] lines.
+ *
+ * Sources are opened lazily and closed as soon as their last entry has been
+ * imported, pages are copied with FPDF_ImportPagesByIndex, and [merge] writes
+ * the result through the buffered fd or stream writer without holding a second
+ * copy of it. Peak memory is therefore the assembled document plus the sources
+ * still in use, not every source at once.
+ *
+ * PDFium calls are serialized by the library lock, so entries are imported one
+ * after another on the calling thread; run merges off the main thread.
+ */
+class PdfMerger(private val core: PdfiumCore) {
+
+    /**
+     * Assemble [entries] into a new document and save it to [output].
+     *
+     * @return The run outcome; nothing useful is written unless it is [PdfMergeResult.Status.COMPLETED]
+     */
+    fun merge(
+        entries: List<PdfMergeEntry>,
+        output: ParcelFileDescriptor,
+        listener: PdfMergeListener? = null,
+        cancellationSignal: CancellationSignal? = null,
+        blockSize: Int = PdfDocument.DEFAULT_SAVE_BLOCK_SIZE
+    ): PdfMergeResult = mergeAndSave(entries, listener, cancellationSignal) { document ->
+        document.save(output, blockSize = blockSize)
+    }
+
+    /**
+     * Assemble [entries] into a new document and write it to [output]. The stream is not closed.
+     *
+     * @return The run outcome; nothing useful is written unless it is [PdfMergeResult.Status.COMPLETED]
+     * @throws java.io.IOException if the stream fails
+     */
+    fun merge(
+        entries: List<PdfMergeEntry>,
+        output: OutputStream,
+        listener: PdfMergeListener? = null,
+        cancellationSignal: CancellationSignal? = null,
+        blockSize: Int = PdfDocument.DEFAULT_SAVE_BLOCK_SIZE
+    ): PdfMergeResult = mergeAndSave(entries, listener, cancellationSignal) { document ->
+        document.save(output, blockSize = blockSize)
+    }
+
+    /**
+     * Import [entries] into [destination], which the caller keeps open and saves.
+     *
+     * On failure or cancellation the entries imported so far stay in [destination].
+     */
+    fun importInto(
+        destination: PdfDocument,
+        entries: List<PdfMergeEntry>,
+        listener: PdfMergeListener? = null,
+        cancellationSignal: CancellationSignal? = null
+    ): PdfMergeResult {
+        val startTime = System.nanoTime()
+        val baseHeap = Debug.getNativeHeapAllocatedSize()
+        var peakHeap = 0L
+        var peakBuffers = 0L
+        fun sample() {
+            peakHeap = maxOf(peakHeap, Debug.getNativeHeapAllocatedSize() - baseHeap)
+            peakBuffers = maxOf(peakBuffers, core.stats().bufferBytesHeld)
+        }
+
+        // Each source is released right after the last entry that reads it
+        val lastUse = IdentityHashMap<PdfMergeSource, Int>()
+        entries.forEachIndexed { i, entry -> lastUse[entry.source] = i }
+        val open = IdentityHashMap<PdfMergeSource, PdfDocument>()
+
+        var status = PdfMergeResult.Status.COMPLETED
+        var failedEntry = -1
+        var pagesImported = 0
+        var sourcesOpened = 0
+        var peakOpenSources = 0
+        try {
+            for ((i, entry) in entries.withIndex()) {
+                if (cancellationSignal?.isCanceled == true) {
+                    status = PdfMergeResult.Status.CANCELLED
+                    break
+                }
+
+                val source = open[entry.source] ?: entry.source.open(core)?.also {
+                    open[entry.source] = it
+                    sourcesOpened++
+                    peakOpenSources = maxOf(peakOpenSources, open.size)
+                    sample()
+                }
+                val imported = source?.let { importEntry(destination, it, entry) } ?: -1
+                if (imported < 0) {
+                    status = PdfMergeResult.Status.FAILED
+                    failedEntry = i
+                    break
+                }
+                pagesImported += imported
+
+                if (lastUse[entry.source] == i) open.remove(entry.source)?.let { entry.source.release(it) }
+                sample()
+                listener?.onProgress(i + 1, entries.size, pagesImported)
+            }
+        } finally {
+            open.forEach { (source, document) -> source.release(document) }
+        }
+
+        return PdfMergeResult(
+            status = status,
+            failedEntry = failedEntry,
+            pagesImported = pagesImported,
+            sourcesOpened = sourcesOpened,
+            peakOpenSources = peakOpenSources,
+            peakNativeHeapGrowthBytes = maxOf(peakHeap, 0L),
+            peakBufferBytesHeld = peakBuffers,
+            importNanos = System.nanoTime() - startTime,
+            saveNanos = 0L
+        )
+    }
+
+    /**
+     * Import one entry. Returns the number of pages imported, or -1 if the
+     * entry doesn't fit the source or destination, or the import failed.
+     */
+    private fun importEntry(destination: PdfDocument, source: PdfDocument, entry: PdfMergeEntry): Int {
+        val sourcePages = source.pageCount
+        val pages = entry.pageIndices ?: IntArray(sourcePages) { it }
+        if (pages.any { it !in 0 until sourcePages }) return -1
+
+        val destinationPages = destination.pageCount
+        val insertIndex = if (entry.insertIndex == PdfMergeEntry.APPEND) destinationPages else entry.insertIndex
+        if (insertIndex > destinationPages) return -1
+        if (pages.isEmpty()) return 0
+
+        return if (destination.importPages(source, pages, insertIndex)) pages.size else -1
+    }
+
+    private inline fun mergeAndSave(
+        entries: List<PdfMergeEntry>,
+        listener: PdfMergeListener?,
+        cancellationSignal: CancellationSignal?,
+        save: (PdfDocument) -> Boolean
+    ): PdfMergeResult {
+        val destination = core.newDocument() ?: return PdfMergeResult(
+            PdfMergeResult.Status.FAILED, -1, 0, 0, 0, 0L, 0L, 0L, 0L
+        )
+        return destination.use { document ->
+            val result = importInto(document, entries, listener, cancellationSignal)
+            if (!result.isSuccessful) return@use result
+
+            val saveStart = System.nanoTime()
+            val saved = save(document)
+            val saveNanos = System.nanoTime() - saveStart
+            if (saved) {
+                result.copy(saveNanos = saveNanos)
+            } else {
+                result.copy(status = PdfMergeResult.Status.FAILED, saveNanos = saveNanos)
+            }
+        }
+    }
+}
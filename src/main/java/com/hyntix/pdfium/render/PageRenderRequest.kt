@@ -0,0 +1,20 @@
+package com.hyntix.pdfium.render
+
+/**
+ * A page to render through [PdfRenderPool].
+ *
+ * @property pageIndex Zero-based page index
+ * @property width Output bitmap width in pixels
+ * @property height Output bitmap height in pixels
+ * @property renderAnnot Whether to render annotations
+ */
+data class PageRenderRequest(
+    val pageIndex: Int,
+    val width: Int,
+    val height: Int,
+    val renderAnnot: Boolean = true
+) {
+    init {
+        require(width > 0 && height > 0) { "Render size must be positive" }
+    }
+}
@@ -0,0 +1,308 @@
+package com.hyntix.pdfium.render
+
+import android.app.ActivityManager
+import android.content.ComponentCallbacks2
+import android.content.Context
+import android.content.res.Configuration
+import android.graphics.Bitmap
+import android.graphics.BitmapFactory
+import android.util.LruCache
+import com.hyntix.pdfium.PdfPage
+import java.io.Closeable
+import java.io.File
+import java.io.FileOutputStream
+import java.io.IOException
+import java.security.MessageDigest
+
+/**
+ * Two-level cache of rendered pages, so showing a recent page again costs a blit
+ * instead of a full rasterization.
+ *
+ * Entries are keyed by document, page, output size, viewport and annotation flag,
+ * plus the page's edit revision. Thumbnails from
+ * [com.hyntix.pdfium.PdfDocument.generateThumbnails] are kept apart from full renders. Content generation, flattening, rotation,
+ * annotation changes and form input made through this library bump that
+ * revision, so edited pages miss the cache and stale entries age out.
+ *
+ * Level one is an in-memory LRU of bitmaps, 1/8 of the app's memory class by
+ * default, optionally moved to hardware bitmaps to keep pixels off the Java heap.
+ * It is trimmed in response to [onTrimMemory]. Level two is an optional on-disk
+ * LRU of PNG-encoded renders. It survives the in-memory level and, with a stable
+ * `documentKey`, process restarts. Revisions restart with every open, so only
+ * renders of unedited pages of documents given a `documentKey` go to disk;
+ * everything else is cached in memory only.
+ *
+ * Returned bitmaps are shared with the cache: draw them, but do not modify or
+ * recycle them. The cache is thread-safe.
+ *
+ * @param context Any context; the application context is retained
+ * @param maxMemoryBytes Capacity of the in-memory level
+ * @param diskCacheDir Directory for the on-disk level, or null to disable it
+ * @param maxDiskBytes Capacity of the on-disk level
+ * @param useHardwareBitmaps Store in-memory entries as [Bitmap.Config.HARDWARE]
+ */
+class PdfRenderCache(
+    context: Context,
+    maxMemoryBytes: Int = defaultMemoryBytes(context),
+    private val diskCacheDir: File? = null,
+    private val maxDiskBytes: Long = DEFAULT_DISK_BYTES,
+    private val useHardwareBitmaps: Boolean = false
+) : ComponentCallbacks2, Closeable {
+
+    companion object {
+        const val DEFAULT_DISK_BYTES = 64L * 1024 * 1024
+
+        /**
+         * 1/8 of the per-app heap limit reported by [ActivityManager.getMemoryClass].
+         */
+        fun defaultMemoryBytes(context: Context): Int {
+            val activityManager = context.getSystemService(Context.ACTIVITY_SERVICE) as ActivityManager
+            return activityManager.memoryClass * 1024 * 1024 / 8
+        }
+    }
+
+    /**
+     * Without a caller's [documentKey], documents are told apart by their
+     * native serial, which restarts in every process.
+     */
+    private data class Key(
+        val documentKey: String?,
+        val documentSerial: Long,
+        val pageIndex: Int,
+        val revision: Long,
+        val width: Int,
+        val height: Int,
+        val startX: Int,
+        val startY: Int,
+        val drawWidth: Int,
+        val drawHeight: Int,
+        val renderAnnot: Boolean,
+        val thumbnail: Boolean = false,
+        val config: Bitmap.Config = Bitmap.Config.ARGB_8888,
+        val preferEmbedded: Boolean = false
+    ) {
+        /**
+         * Serials and revisions are per process and per open, so only unedited
+         * pages of documents with a stable key mean anything to a later session.
+         */
+        val persistable: Boolean get() = documentKey != null && revision == 0L
+
+        fun fileName(): String {
+            val digest = MessageDigest.getInstance("SHA-1").digest(toString().toByteArray())
+            return digest.joinToString("") { "%02x".format(it) } + ".png"
+        }
+    }
+
+    private val appContext = context.applicationContext
+
+    private val memory = object : LruCache<Key, Bitmap>(maxMemoryBytes) {
+        override fun sizeOf(key: Key, value: Bitmap): Int = value.allocationByteCount
+    }
+
+    private val diskLock = Any()
+
+    @Volatile
+    private var isClosed = false
+
+    init {
+        require(maxMemoryBytes > 0) { "maxMemoryBytes must be positive" }
+        diskCacheDir?.mkdirs()
+        appContext.registerComponentCallbacks(this)
+    }
+
+    /**
+     * Return the cached render of [page], rendering and caching it on a miss.
+     * Parameters match [PdfPage.render], with the output bitmap size given as
+     * [width] and [height].
+     *
+     * @param documentKey Stable identity of the document, such as its path and
+     *        modification time. Without one, entries are only valid until close
+     *        and are kept in memory only.
+     */
+    fun getOrRender(
+        page: PdfPage,
+        width: Int,
+        height: Int,
+        startX: Int = 0,
+        startY: Int = 0,
+        drawWidth: Int = width,
+        drawHeight: Int = height,
+        renderAnnot: Boolean = true,
+        documentKey: String? = null
+    ): Bitmap {
+        check(!isClosed) { "Render cache is closed" }
+        require(width > 0 && height > 0) { "Bitmap size must be positive" }
+
+        val revision = page.getRevision()
+        val key = Key(
+            documentKey, if (documentKey == null) revision[0] else 0L, page.index, revision[1],
+            width, height, startX, startY, drawWidth, drawHeight, renderAnnot
+        )
+
+        memory.get(key)?.let { return it }
+
+        readFromDisk(key)?.let { bitmap ->
+            return toStored(bitmap).also { memory.put(key, it) }
+        }
+
+        val bitmap = Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888)
+        page.render(bitmap, startX, startY, drawWidth, drawHeight, renderAnnot)
+        writeToDisk(key, bitmap)
+        return toStored(bitmap).also { memory.put(key, it) }
+    }
+
+    /**
+     * Cached thumbnail of a page for [com.hyntix.pdfium.PdfDocument.generateThumbnails].
+     * Entries are kept per [config] and [preferEmbedded], since both change
+     * the pixels.
+     *
+     * @param revision Document serial and page revision, see [PdfPage.getRevision]
+     */
+    internal fun getThumbnail(
+        documentKey: String?,
+        pageIndex: Int,
+        revision: LongArray,
+        width: Int,
+        height: Int,
+        config: Bitmap.Config,
+        preferEmbedded: Boolean
+    ): Bitmap? {
+        check(!isClosed) { "Render cache is closed" }
+        val key = thumbnailKey(documentKey, pageIndex, revision, width, height, config, preferEmbedded)
+        memory.get(key)?.let { return it }
+        return readFromDisk(key, config)?.let { bitmap ->
+            toStored(bitmap).also { memory.put(key, it) }
+        }
+    }
+
+    /**
+     * Store a generated thumbnail, keyed by its config and [preferEmbedded].
+     * The cache takes ownership of [bitmap]; the returned bitmap is the one it
+     * keeps, which may differ when hardware bitmaps are in use.
+     */
+    internal fun putThumbnail(
+        documentKey: String?,
+        pageIndex: Int,
+        revision: LongArray,
+        preferEmbedded: Boolean,
+        bitmap: Bitmap
+    ): Bitmap {
+        check(!isClosed) { "Render cache is closed" }
+        val key = thumbnailKey(
+            documentKey, pageIndex, revision, bitmap.width, bitmap.height, bitmap.config, preferEmbedded
+        )
+        writeToDisk(key, bitmap)
+        return toStored(bitmap).also { memory.put(key, it) }
+    }
+
+    private fun thumbnailKey(
+        documentKey: String?,
+        pageIndex: Int,
+        revision: LongArray,
+        width: Int,
+        height: Int,
+        config: Bitmap.Config,
+        preferEmbedded: Boolean
+    ) = Key(
+        documentKey, if (documentKey == null) revision[0] else 0L, pageIndex, revision[1],
+        width, height, 0, 0, width, height, renderAnnot = false, thumbnail = true,
+        config = config, preferEmbedded = preferEmbedded
+    )
+
+    /**
+     * Bytes held by the in-memory level.
+     */
+    val memoryBytes: Int get() = memory.size()
+
+    /**
+     * Drop all in-memory and on-disk entries.
+     */
+    fun clear() {
+        memory.evictAll()
+        synchronized(diskLock) {
+            diskCacheDir?.listFiles()?.forEach { it.delete() }
+        }
+    }
+
+    override fun onTrimMemory(level: Int) {
+        @Suppress("DEPRECATION")
+        when {
+            level >= ComponentCallbacks2.TRIM_MEMORY_BACKGROUND -> memory.evictAll()
+            level >= ComponentCallbacks2.TRIM_MEMORY_RUNNING_LOW -> memory.trimToSize(memory.maxSize() / 2)
+        }
+    }
+
+    @Deprecated("Deprecated in Java")
+    override fun onLowMemory() {
+        memory.evictAll()
+    }
+
+    override fun onConfigurationChanged(newConfig: Configuration) {}
+
+    /**
+     * Unregister from memory callbacks and drop the in-memory level. Disk entries
+     * are kept.
+     */
+    override fun close() {
+        if (isClosed) return
+        isClosed = true
+        appContext.unregisterComponentCallbacks(this)
+        memory.evictAll()
+    }
+
+    private fun toStored(bitmap: Bitmap): Bitmap {
+        if (!useHardwareBitmaps) return bitmap
+        val hardware = bitmap.copy(Bitmap.Config.HARDWARE, false) ?: return bitmap
+        bitmap.recycle()
+        return hardware
+    }
+
+    private fun readFromDisk(key: Key, config: Bitmap.Config = Bitmap.Config.ARGB_8888): Bitmap? {
+        val dir = diskCacheDir ?: return null
+        if (!key.persistable) return null
+        synchronized(diskLock) {
+            val file = File(dir, key.fileName())
+            if (!file.exists()) return null
+            val options = BitmapFactory.Options().apply {
+                inPreferredConfig = config
+                inMutable = false
+            }
+            val bitmap = BitmapFactory.decodeFile(file.path, options)
+            if (bitmap == null) {
+                file.delete()
+                return null
+            }
+            file.setLastModified(System.currentTimeMillis())
+            return bitmap
+        }
+    }
+
+    private fun writeToDisk(key: Key, bitmap: Bitmap) {
+        val dir = diskCacheDir ?: return
+        if (!key.persistable) return
+        synchronized(diskLock) {
+            val file = File(dir, key.fileName())
+            val temp = File(dir, file.name + ".tmp")
+            try {
+                FileOutputStream(temp).use { bitmap.compress(Bitmap.CompressFormat.PNG, 100, it) }
+                if (!temp.renameTo(file)) temp.delete()
+            } catch (e: IOException) {
+                temp.delete()
+                return
+            }
+            trimDisk(dir)
+        }
+    }
+
+    private fun trimDisk(dir: File) {
+        val files = dir.listFiles() ?: return
+        var total = files.sumOf { it.length() }
+        if (total <= maxDiskBytes) return
+        files.sortBy { it.lastModified() }
+        for (file in files) {
+            if (total <= maxDiskBytes) break
+            total -= file.length()
+            file.delete()
+        }
+    }
+}
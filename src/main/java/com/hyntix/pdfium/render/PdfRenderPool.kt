@@ -0,0 +1,371 @@
+package com.hyntix.pdfium.render
+
+import android.content.ComponentName
+import android.content.Context
+import android.content.Intent
+import android.content.ServiceConnection
+import android.graphics.Bitmap
+import android.os.IBinder
+import android.os.Looper
+import android.os.Parcel
+import android.os.ParcelFileDescriptor
+import android.os.RemoteException
+import com.hyntix.pdfium.PdfiumCore
+import java.io.Closeable
+import java.io.IOException
+import java.util.concurrent.ConcurrentLinkedDeque
+import java.util.concurrent.ConcurrentLinkedQueue
+import java.util.concurrent.CountDownLatch
+import java.util.concurrent.TimeUnit
+import kotlin.concurrent.thread
+
+/**
+ * Renders pages in parallel across several isolated worker processes.
+ *
+ * PDFium serializes all work inside one process, so a single process can only use
+ * one core for rendering. The pool binds up to [MAX_WORKERS] [PdfRenderService]
+ * processes. Each one opens the same document through the fd-based streaming path
+ * and renders pages into its own ashmem region, which the pool copies into a
+ * [Bitmap].
+ *
+ * Pages are first split into contiguous ranges, one per worker. A worker that
+ * finishes its range steals from the end of the longest remaining range. If a
+ * worker process dies, its remaining pages go to the others the same way.
+ *
+ * Each worker holds one open document at a time, so [renderPages] and
+ * [extractText] calls on the same pool run one after another; a call made
+ * while another is in progress blocks until it finishes.
+ *
+ * @param context Any context; the application context is retained
+ * @param workerCount Number of worker processes, 1..[MAX_WORKERS]
+ */
+class PdfRenderPool(
+    context: Context,
+    workerCount: Int = defaultWorkerCount()
+) : Closeable {
+
+    companion object {
+        /** Number of worker services declared in the library manifest. */
+        const val MAX_WORKERS = 4
+
+        private const val CONNECT_TIMEOUT_MS = 10_000L
+
+        /** Pages per TEXT transaction, small enough to stay under the binder buffer limit. */
+        private const val TEXT_BATCH_PAGES = 4
+
+        private val WORKER_CLASSES = arrayOf(
+            PdfRenderService.Worker0::class.java,
+            PdfRenderService.Worker1::class.java,
+            PdfRenderService.Worker2::class.java,
+            PdfRenderService.Worker3::class.java
+        )
+
+        /**
+         * Roughly one worker per big core. Cluster layout isn't exposed to apps,
+         * so this assumes half of the cores are big ones.
+         */
+        fun defaultWorkerCount(): Int =
+            (Runtime.getRuntime().availableProcessors() / 2).coerceIn(1, MAX_WORKERS)
+    }
+
+    private val appContext = context.applicationContext
+    private val core = PdfiumCore()
+    private val connections: List<WorkerConnection>
+
+    // Held by renderPages and extractText for their whole run
+    private val callLock = Any()
+
+    @Volatile
+    private var isClosed = false
+
+    init {
+        require(workerCount in 1..MAX_WORKERS) { "workerCount must be in 1..$MAX_WORKERS" }
+        connections = List(workerCount) { index ->
+            WorkerConnection().also { connection ->
+                appContext.bindService(
+                    Intent(appContext, WORKER_CLASSES[index]),
+                    connection,
+                    Context.BIND_AUTO_CREATE
+                )
+            }
+        }
+    }
+
+    /**
+     * Render pages of a document, blocking until every page has been rendered or
+     * no worker is left. Must not be called on the main thread, since worker
+     * connections are established on it.
+     *
+     * [onPageRendered] is called from the pool's worker threads, possibly
+     * concurrently and in any page order. The bitmap belongs to the callee.
+     *
+     * @param document Descriptor of the PDF file; it is not closed
+     * @param requests Pages to render
+     * @param password Optional password for encrypted PDFs
+     * @param onPageRendered Receives each rendered page
+     * @return Requests that could not be rendered (empty on full success)
+     */
+    fun renderPages(
+        document: ParcelFileDescriptor,
+        requests: List<PageRenderRequest>,
+        password: String? = null,
+        onPageRendered: (PageRenderRequest, Bitmap) -> Unit
+    ): List<PageRenderRequest> {
+        check(!isClosed) { "Render pool has been closed" }
+        check(Looper.myLooper() != Looper.getMainLooper()) { "renderPages must not be called on the main thread" }
+        if (requests.isEmpty()) return emptyList()
+
+        // Workers hold one open document each, so calls take turns
+        synchronized(callLock) {
+            val workers = connections.mapNotNull { it.await(CONNECT_TIMEOUT_MS) }
+            if (workers.isEmpty()) return requests
+
+            // Contiguous ranges keep each worker on nearby pages
+            val queues = List(workers.size) { ConcurrentLinkedDeque<PageRenderRequest>() }
+            requests.forEachIndexed { i, request ->
+                queues[(i.toLong() * workers.size / requests.size).toInt()].add(request)
+            }
+
+            val bufferSize = requests.maxOf { it.width.toLong() * it.height * 4 }
+            val failed = ConcurrentLinkedQueue<PageRenderRequest>()
+
+            val threads = workers.mapIndexed { index, binder ->
+                thread(name = "PdfRenderPool-$index") {
+                    runWorker(index, binder, queues, document, password, bufferSize, failed, onPageRendered)
+                }
+            }
+            threads.forEach { it.join() }
+
+            // Anything still queued had no live worker left to take it
+            queues.forEach { failed.addAll(it) }
+            return failed.toList()
+        }
+    }
+
+    /**
+     * Extract the text of a document across the worker processes, blocking until
+     * every page has been extracted or no worker is left. Must not be called on
+     * the main thread.
+     *
+     * Pages are split into batches of a few pages, distributed and stolen like
+     * [renderPages]. [onPage] is called from the pool's worker threads, possibly
+     * concurrently and in any page order.
+     *
+     * @param document Descriptor of the PDF file; it is not closed
+     * @param pageRange Pages to extract, or null for all
+     * @param password Optional password for encrypted PDFs
+     * @param onPage Receives each page's text
+     * @return Pages that could not be extracted (empty on full success)
+     * @throws IOException if no worker could open the document, so its pages are unknown
+     */
+    fun extractText(
+        document: ParcelFileDescriptor,
+        pageRange: IntRange? = null,
+        password: String? = null,
+        onPage: (pageIndex: Int, text: String) -> Unit
+    ): List<Int> {
+        check(!isClosed) { "Render pool has been closed" }
+        check(Looper.myLooper() != Looper.getMainLooper()) { "extractText must not be called on the main thread" }
+
+        // Workers hold one open document each, so calls take turns
+        synchronized(callLock) {
+            val workers = connections.mapNotNull { it.await(CONNECT_TIMEOUT_MS) }
+            var pageCount = -1
+            val opened = workers.filter { binder ->
+                val count = openRemote(binder, document, null, password)
+                if (count >= 0) pageCount = count
+                count >= 0
+            }
+            if (opened.isEmpty()) throw IOException("No render worker could open the document")
+
+            val first = maxOf(pageRange?.first ?: 0, 0)
+            val end = minOf(pageRange?.let { it.last + 1 } ?: pageCount, pageCount)
+            val batches = (first until end step TEXT_BATCH_PAGES).map { it until minOf(it + TEXT_BATCH_PAGES, end) }
+
+            val queues = List(opened.size) { ConcurrentLinkedDeque<IntRange>() }
+            batches.forEachIndexed { i, batch ->
+                queues[(i.toLong() * opened.size / batches.size).toInt()].add(batch)
+            }
+            val failed = ConcurrentLinkedQueue<Int>()
+
+            val threads = opened.mapIndexed { index, binder ->
+                thread(name = "PdfRenderPool-text-$index") {
+                    try {
+                        while (true) {
+                            val batch = queues[index].pollFirst() ?: steal(queues, index) ?: break
+                            val texts = try {
+                                textRemote(binder, batch)
+                            } catch (e: RemoteException) {
+                                queues[index].addFirst(batch)
+                                return@thread
+                            }
+                            if (texts == null) {
+                                failed.addAll(batch)
+                                continue
+                            }
+                            texts.forEachIndexed { i, text -> onPage(batch.first + i, text) }
+                            for (page in batch.first + texts.size..batch.last) failed.add(page)
+                        }
+                    } finally {
+                        closeRemote(binder)
+                    }
+                }
+            }
+            threads.forEach { it.join() }
+
+            queues.forEach { queue -> queue.forEach { failed.addAll(it) } }
+            return failed.sorted()
+        }
+    }
+
+    private fun runWorker(
+        index: Int,
+        binder: IBinder,
+        queues: List<ConcurrentLinkedDeque<PageRenderRequest>>,
+        document: ParcelFileDescriptor,
+        password: String?,
+        bufferSize: Long,
+        failed: ConcurrentLinkedQueue<PageRenderRequest>,
+        onPageRendered: (PageRenderRequest, Bitmap) -> Unit
+    ) {
+        val shmFd = core.createSharedMemory("pdfium-render-$index", bufferSize)
+        if (shmFd < 0) return
+
+        ParcelFileDescriptor.adoptFd(shmFd).use { sharedMemory ->
+            if (openRemote(binder, document, sharedMemory, password) < 0) return
+
+            try {
+                while (true) {
+                    val request = queues[index].pollFirst() ?: steal(queues, index) ?: break
+                    val rendered = try {
+                        renderRemote(binder, request)
+                    } catch (e: RemoteException) {
+                        // Worker died; leave the page for the others to steal
+                        queues[index].addFirst(request)
+                        return
+                    }
+
+                    val bitmap = if (rendered) {
+                        Bitmap.createBitmap(request.width, request.height, Bitmap.Config.ARGB_8888)
+                    } else {
+                        null
+                    }
+                    if (bitmap != null && core.copySharedMemoryToBitmap(sharedMemory.fd, bitmap)) {
+                        onPageRendered(request, bitmap)
+                    } else {
+                        bitmap?.recycle()
+                        failed.add(request)
+                    }
+                }
+            } finally {
+                closeRemote(binder)
+            }
+        }
+    }
+
+    private fun <T> steal(queues: List<ConcurrentLinkedDeque<T>>, thief: Int): T? {
+        while (true) {
+            val victim = queues.indices
+                .filter { it != thief }
+                .maxByOrNull { queues[it].size }
+                ?: return null
+            if (queues[victim].isEmpty()) return null
+            queues[victim].pollLast()?.let { return it }
+        }
+    }
+
+    // Page count, or -1 if the worker could not open the document
+    private fun openRemote(
+        binder: IBinder,
+        document: ParcelFileDescriptor,
+        sharedMemory: ParcelFileDescriptor?,
+        password: String?
+    ): Int = try {
+        transact(binder, RenderWorkerProtocol.OPEN, { data ->
+            data.writeFileDescriptor(document.fileDescriptor)
+            data.writeInt(if (sharedMemory != null) 1 else 0)
+            sharedMemory?.let { data.writeFileDescriptor(it.fileDescriptor) }
+            data.writeString(password)
+        }) { reply -> reply.readInt() }
+    } catch (e: RemoteException) {
+        -1
+    }
+
+    @Throws(RemoteException::class)
+    private fun renderRemote(binder: IBinder, request: PageRenderRequest): Boolean =
+        transact(binder, RenderWorkerProtocol.RENDER, { data ->
+            data.writeInt(request.pageIndex)
+            data.writeInt(request.width)
+            data.writeInt(request.height)
+            data.writeInt(if (request.renderAnnot) 1 else 0)
+        }) { reply -> reply.readInt() != 0 }
+
+    @Throws(RemoteException::class)
+    private fun textRemote(binder: IBinder, pages: IntRange): List<String>? =
+        transact(binder, RenderWorkerProtocol.TEXT, { data ->
+            data.writeInt(pages.first)
+            data.writeInt(pages.last - pages.first + 1)
+        }) { reply ->
+            val count = reply.readInt()
+            if (count < 0) null else List(count) { reply.readString() ?: "" }
+        }
+
+    private fun closeRemote(binder: IBinder) {
+        try {
+            transact(binder, RenderWorkerProtocol.CLOSE, {}) { }
+        } catch (e: RemoteException) {
+            // Worker already gone; nothing to release
+        }
+    }
+
+    @Throws(RemoteException::class)
+    private fun <T> transact(
+        binder: IBinder,
+        code: Int,
+        write: (Parcel) -> Unit,
+        read: (Parcel) -> T
+    ): T {
+        val data = Parcel.obtain()
+        val reply = Parcel.obtain()
+        try {
+            data.writeInterfaceToken(RenderWorkerProtocol.DESCRIPTOR)
+            write(data)
+            binder.transact(code, data, reply, 0)
+            return read(reply)
+        } finally {
+            data.recycle()
+            reply.recycle()
+        }
+    }
+
+    /**
+     * Unbind all worker processes. Renders in progress fail over to returning
+     * their remaining requests.
+     */
+    override fun close() {
+        if (isClosed) return
+        isClosed = true
+        connections.forEach { appContext.unbindService(it) }
+    }
+
+    private class WorkerConnection : ServiceConnection {
+        private val connected = CountDownLatch(1)
+
+        @Volatile
+        private var binder: IBinder? = null
+
+        fun await(timeoutMs: Long): IBinder? {
+            connected.await(timeoutMs, TimeUnit.MILLISECONDS)
+            return binder?.takeIf { it.isBinderAlive }
+        }
+
+        override fun onServiceConnected(name: ComponentName, service: IBinder) {
+            binder = service
+            connected.countDown()
+        }
+
+        override fun onServiceDisconnected(name: ComponentName) {
+            binder = null
+        }
+    }
+}
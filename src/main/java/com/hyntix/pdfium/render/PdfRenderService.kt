@@ -0,0 +1,129 @@
+package com.hyntix.pdfium.render
+
+import android.app.Service
+import android.content.Intent
+import android.os.Binder
+import android.os.IBinder
+import android.os.Parcel
+import android.os.ParcelFileDescriptor
+import com.hyntix.pdfium.PdfDocument
+import com.hyntix.pdfium.PdfiumCore
+
+/**
+ * Render worker hosting its own PDFium instance in an isolated process.
+ *
+ * Each [Worker0]..[Worker3] subclass is declared in the library manifest with its
+ * own `android:process`, so [PdfRenderPool] can render with several PDFium
+ * instances in parallel. Not meant to be bound directly.
+ */
+open class PdfRenderService : Service() {
+
+    class Worker0 : PdfRenderService()
+    class Worker1 : PdfRenderService()
+    class Worker2 : PdfRenderService()
+    class Worker3 : PdfRenderService()
+
+    private val core = PdfiumCore()
+    private var document: PdfDocument? = null
+    private var sharedMemory: ParcelFileDescriptor? = null
+
+    private val binder = object : Binder() {
+        override fun onTransact(code: Int, data: Parcel, reply: Parcel?, flags: Int): Boolean {
+            when (code) {
+                RenderWorkerProtocol.OPEN -> {
+                    data.enforceInterface(RenderWorkerProtocol.DESCRIPTOR)
+                    val documentFd = data.readFileDescriptor()
+                    val sharedMemoryFd = if (data.readInt() != 0) data.readFileDescriptor() else null
+                    val password = data.readString()
+                    reply?.writeInt(openDocument(documentFd, sharedMemoryFd, password))
+                    return true
+                }
+                RenderWorkerProtocol.RENDER -> {
+                    data.enforceInterface(RenderWorkerProtocol.DESCRIPTOR)
+                    val rendered = renderPage(data.readInt(), data.readInt(), data.readInt(), data.readInt() != 0)
+                    reply?.writeInt(if (rendered) 1 else 0)
+                    return true
+                }
+                RenderWorkerProtocol.TEXT -> {
+                    data.enforceInterface(RenderWorkerProtocol.DESCRIPTOR)
+                    val texts = extractText(data.readInt(), data.readInt())
+                    reply?.writeInt(texts?.size ?: -1)
+                    texts?.forEach { reply?.writeString(it) }
+                    return true
+                }
+                RenderWorkerProtocol.CLOSE -> {
+                    data.enforceInterface(RenderWorkerProtocol.DESCRIPTOR)
+                    closeDocument()
+                    return true
+                }
+            }
+            return super.onTransact(code, data, reply, flags)
+        }
+    }
+
+    override fun onCreate() {
+        super.onCreate()
+        core.initLibrary()
+    }
+
+    override fun onBind(intent: Intent): IBinder = binder
+
+    override fun onDestroy() {
+        closeDocument()
+        core.destroyLibrary()
+        super.onDestroy()
+    }
+
+    @Synchronized
+    private fun openDocument(
+        documentFd: ParcelFileDescriptor?,
+        sharedMemoryFd: ParcelFileDescriptor?,
+        password: String?
+    ): Int {
+        closeDocument()
+        if (documentFd == null) {
+            sharedMemoryFd?.close()
+            return -1
+        }
+
+        // The streaming open keeps its own duplicate of the descriptor
+        val opened = documentFd.use { core.openDocument(it.fd, password) }
+        if (opened == null) {
+            sharedMemoryFd?.close()
+            return -1
+        }
+        document = opened
+        sharedMemory = sharedMemoryFd
+        return opened.pageCount
+    }
+
+    @Synchronized
+    private fun renderPage(pageIndex: Int, width: Int, height: Int, renderAnnot: Boolean): Boolean {
+        val doc = document ?: return false
+        val shm = sharedMemory ?: return false
+        return try {
+            doc.openPage(pageIndex).use { page ->
+                page.renderToSharedMemory(shm.fd, width, height, renderAnnot)
+            }
+        } catch (e: RuntimeException) {
+            // Out-of-range index or a page PDFium could not load
+            false
+        }
+    }
+
+    @Synchronized
+    private fun extractText(firstPage: Int, count: Int): List<String>? {
+        val doc = document ?: return null
+        val texts = ArrayList<String>(count)
+        val completed = doc.extractText(firstPage until firstPage + count) { _, text -> texts.add(text) }
+        return if (completed) texts else null
+    }
+
+    @Synchronized
+    private fun closeDocument() {
+        document?.close()
+        document = null
+        sharedMemory?.close()
+        sharedMemory = null
+    }
+}
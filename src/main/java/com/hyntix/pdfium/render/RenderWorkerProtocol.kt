@@ -0,0 +1,21 @@
+package com.hyntix.pdfium.render
+
+import android.os.IBinder
+
+/**
+ * Binder transactions between [PdfRenderPool] and [PdfRenderService].
+ *
+ * - OPEN: document fd, hasSharedMemory (0/1), shared memory fd if present,
+ *   password (nullable) -> page count, or -1
+ * - RENDER: page index, width, height, renderAnnot (0/1) -> 1 on success, 0 on failure
+ * - TEXT: first page, page count -> number of pages n (or -1), then n page texts
+ * - CLOSE: no arguments, no reply
+ */
+internal object RenderWorkerProtocol {
+    const val DESCRIPTOR = "com.hyntix.pdfium.render.PdfRenderService"
+
+    const val OPEN = IBinder.FIRST_CALL_TRANSACTION
+    const val RENDER = IBinder.FIRST_CALL_TRANSACTION + 1
+    const val CLOSE = IBinder.FIRST_CALL_TRANSACTION + 2
+    const val TEXT = IBinder.FIRST_CALL_TRANSACTION + 3
+}
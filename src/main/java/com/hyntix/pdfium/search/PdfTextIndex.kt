@@ -0,0 +1,405 @@
+package com.hyntix.pdfium.search
+
+import android.graphics.RectF
+import android.os.CancellationSignal
+import com.hyntix.pdfium.PdfDocument
+import java.io.BufferedOutputStream
+import java.io.Closeable
+import java.io.DataOutputStream
+import java.io.File
+import java.io.FileOutputStream
+import java.io.IOException
+import java.io.RandomAccessFile
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+import java.nio.channels.FileChannel
+
+/**
+ * One match of a [PdfTextIndex] query.
+ *
+ * @property pageIndex Page of the match
+ * @property startIndex Char index of the first matched character on the page
+ * @property count Number of characters from the first to the last matched word
+ * @property rects Boxes of the matched words in page coordinates
+ */
+data class PdfIndexHit(
+    val pageIndex: Int,
+    val startIndex: Int,
+    val count: Int,
+    val rects: List<RectF>
+)
+
+/**
+ * Memory-mapped inverted index of a document's words, answering repeat searches
+ * without loading any page.
+ *
+ * Text is split into words at every character that is not a letter or digit,
+ * and words are lowercased. Each word occurrence stores its page, position,
+ * char range and bounding box, so hits map straight to highlight rects.
+ *
+ * File layout (little-endian):
+ * - Header: magic `PDFTIDX1`, version, page count, term count, posting count
+ * - Term table, sorted by term: string offset and length (in chars) into the
+ *   string pool, first posting and posting count
+ * - Postings, grouped by term in page order: page, word ordinal on the page,
+ *   char index, char count, and the box as left/top/right/bottom in half points
+ * - String pool of UTF-16 terms
+ *
+ * Build one with [build], or let [PdfTextIndexStore] manage them per document.
+ */
+class PdfTextIndex private constructor(
+    private var channel: FileChannel?,
+    @Volatile private var mapped: ByteBuffer?,
+    /** Number of pages in the indexed document. */
+    val pageCount: Int,
+    /** Number of distinct words. */
+    val termCount: Int,
+    private val postingCount: Int
+) : Closeable {
+
+    companion object {
+        private val MAGIC = "PDFTIDX1".toByteArray(Charsets.US_ASCII)
+        private const val VERSION = 1
+        private const val HEADER_SIZE = 24
+        private const val TERM_SIZE = 16
+        private const val POSTING_SIZE = 24
+        private const val BOX_SCALE = 2f
+
+        /**
+         * Extract the text of every page once and write an index to [file].
+         * Long-running; call it off the main thread.
+         *
+         * @return The opened index, or null if cancelled or the file could not be written
+         */
+        fun build(document: PdfDocument, file: File, cancellationSignal: CancellationSignal? = null): PdfTextIndex? {
+            val postings = PostingWriter()
+            val terms = HashMap<String, IntList>()
+            val pageCount = document.pageCount
+
+            for (pageIndex in 0 until pageCount) {
+                if (cancellationSignal?.isCanceled == true) return null
+                val (text, boxes) = document.openPage(pageIndex).use { page ->
+                    page.openTextPage().use { it.getTextWithCharBoxes() }
+                }
+                var ordinal = 0
+                forEachWord(text) { start, end ->
+                    val posting = postings.add(pageIndex, ordinal++, start, end - start, boxes)
+                    terms.getOrPut(normalize(text, start, end)) { IntList() }.add(posting)
+                }
+            }
+
+            val temp = File(file.path + ".tmp")
+            try {
+                write(temp, pageCount, terms, postings)
+                if (!temp.renameTo(file)) throw IOException("Cannot move index into place")
+            } catch (e: IOException) {
+                temp.delete()
+                return null
+            }
+            return open(file)
+        }
+
+        /**
+         * Map an index file written by [build]. Every offset and count in the
+         * file is checked against its size, so a truncated or corrupt file is
+         * rejected here rather than failing later searches.
+         *
+         * @return The index, or null if the file is missing or not a valid index
+         */
+        fun open(file: File): PdfTextIndex? {
+            if (!file.isFile || file.length() < HEADER_SIZE || file.length() > Int.MAX_VALUE) return null
+            val channel = try {
+                RandomAccessFile(file, "r").channel
+            } catch (e: IOException) {
+                return null
+            }
+            val index = try {
+                val buffer = channel.map(FileChannel.MapMode.READ_ONLY, 0, channel.size())
+                buffer.order(ByteOrder.LITTLE_ENDIAN)
+                if (isValid(buffer)) {
+                    PdfTextIndex(channel, buffer, buffer.getInt(12), buffer.getInt(16), buffer.getInt(20))
+                } else {
+                    null
+                }
+            } catch (e: IOException) {
+                null
+            }
+            if (index == null) channel.close()
+            return index
+        }
+
+        private fun isValid(buffer: ByteBuffer): Boolean {
+            val size = buffer.capacity().toLong()
+            val magic = ByteArray(MAGIC.size)
+            buffer.get(magic)
+            if (!magic.contentEquals(MAGIC) || buffer.getInt(8) != VERSION) return false
+            val pageCount = buffer.getInt(12)
+            val termCount = buffer.getInt(16)
+            val postingCount = buffer.getInt(20)
+            if (pageCount < 0 || termCount < 0 || postingCount < 0) return false
+
+            val stringStart = HEADER_SIZE.toLong() + termCount.toLong() * TERM_SIZE + postingCount.toLong() * POSTING_SIZE
+            if (stringStart > size) return false
+            val stringChars = (size - stringStart) / 2
+
+            for (term in 0 until termCount) {
+                val entry = HEADER_SIZE + term * TERM_SIZE
+                val offset = buffer.getInt(entry).toLong()
+                val length = buffer.getInt(entry + 4).toLong()
+                val first = buffer.getInt(entry + 8).toLong()
+                val count = buffer.getInt(entry + 12).toLong()
+                if (offset < 0 || length < 0 || offset + length > stringChars) return false
+                if (first < 0 || count < 0 || first + count > postingCount) return false
+            }
+            val postingStart = HEADER_SIZE + termCount * TERM_SIZE
+            for (p in 0 until postingCount) {
+                val page = buffer.getInt(postingStart + p * POSTING_SIZE)
+                if (page < 0 || page >= pageCount) return false
+            }
+            return true
+        }
+
+        private inline fun forEachWord(text: CharSequence, action: (start: Int, end: Int) -> Unit) {
+            var i = 0
+            while (i < text.length) {
+                while (i < text.length && !Character.isLetterOrDigit(text[i])) i++
+                val start = i
+                while (i < text.length && Character.isLetterOrDigit(text[i])) i++
+                if (i > start) action(start, i)
+            }
+        }
+
+        private fun normalize(text: CharSequence, start: Int, end: Int): String {
+            val chars = CharArray(end - start)
+            for (i in start until end) chars[i - start] = Character.toLowerCase(text[i])
+            return String(chars)
+        }
+
+        private fun write(file: File, pageCount: Int, terms: Map<String, IntList>, postings: PostingWriter) {
+            val sorted = terms.keys.sorted()
+            DataOutputStream(BufferedOutputStream(FileOutputStream(file), 64 * 1024)).use { out ->
+                out.write(MAGIC)
+                out.writeIntLe(VERSION)
+                out.writeIntLe(pageCount)
+                out.writeIntLe(sorted.size)
+                out.writeIntLe(postings.size)
+
+                var stringOffset = 0
+                var postingStart = 0
+                for (term in sorted) {
+                    val count = terms.getValue(term).size
+                    out.writeIntLe(stringOffset)
+                    out.writeIntLe(term.length)
+                    out.writeIntLe(postingStart)
+                    out.writeIntLe(count)
+                    stringOffset += term.length
+                    postingStart += count
+                }
+
+                for (term in sorted) {
+                    val list = terms.getValue(term)
+                    for (i in 0 until list.size) postings.write(out, list[i])
+                }
+
+                for (term in sorted) {
+                    for (c in term) out.writeShort(java.lang.Short.reverseBytes(c.code.toShort()).toInt())
+                }
+            }
+        }
+
+        private fun DataOutputStream.writeIntLe(value: Int) = writeInt(Integer.reverseBytes(value))
+    }
+
+    private val termTableOffset = HEADER_SIZE
+    private val postingOffset = termTableOffset + termCount * TERM_SIZE
+    private val stringOffset = postingOffset + postingCount * POSTING_SIZE
+
+    // Null once closed
+    private val buffer: ByteBuffer
+        get() = mapped ?: throw IllegalStateException("Index is closed")
+
+    /**
+     * Find every occurrence of the words of [query], in order, as consecutive words.
+     *
+     * @param query One or more words; punctuation and case are ignored
+     * @param prefixMatch Let the last word match as a prefix, for search-as-you-type
+     * @return Hits in page order
+     */
+    fun search(query: String, prefixMatch: Boolean = true): List<PdfIndexHit> {
+        check(mapped != null) { "Index is closed" }
+        val words = ArrayList<String>()
+        forEachWord(query) { start, end -> words.add(normalize(query, start, end)) }
+        if (words.isEmpty()) return emptyList()
+
+        val postingsPerWord = words.mapIndexed { i, word ->
+            postingsFor(word, prefix = prefixMatch && i == words.lastIndex)
+        }
+        // Later words are looked up by (page, ordinal) relative to the first one
+        val positions = postingsPerWord.drop(1).map { postings ->
+            HashMap<Long, Int>(postings.size * 2).apply {
+                for (p in postings) put(positionKey(page(p), ordinal(p)), p)
+            }
+        }
+
+        val hits = ArrayList<PdfIndexHit>()
+        for (first in postingsPerWord[0]) {
+            val page = page(first)
+            val ordinal = ordinal(first)
+            val matched = ArrayList<Int>(words.size).apply { add(first) }
+            for ((k, map) in positions.withIndex()) {
+                matched.add(map[positionKey(page, ordinal + k + 1)] ?: break)
+            }
+            if (matched.size != words.size) continue
+
+            val last = matched.last()
+            val start = charIndex(first)
+            hits.add(PdfIndexHit(page, start, charIndex(last) + charCount(last) - start, matched.map { box(it) }))
+        }
+        hits.sortWith(compareBy({ it.pageIndex }, { it.startIndex }))
+        return hits
+    }
+
+    /**
+     * Close the file and drop the mapping, which is unmapped once collected.
+     * The file stays on disk.
+     */
+    @Synchronized
+    override fun close() {
+        mapped = null
+        channel?.close()
+        channel = null
+    }
+
+    private fun positionKey(page: Int, ordinal: Int): Long = (page.toLong() shl 32) or (ordinal.toLong() and 0xFFFFFFFFL)
+
+    private fun postingsFor(word: String, prefix: Boolean): IntList {
+        val result = IntList()
+        var term = lowerBound(word)
+        while (term < termCount) {
+            val cmp = compareTerm(term, word, prefix)
+            if (cmp != 0) break
+            val start = buffer.getInt(termTableOffset + term * TERM_SIZE + 8)
+            val count = buffer.getInt(termTableOffset + term * TERM_SIZE + 12)
+            for (p in start until start + count) result.add(p)
+            if (!prefix) break
+            term++
+        }
+        return result
+    }
+
+    // First term >= word
+    private fun lowerBound(word: String): Int {
+        var low = 0
+        var high = termCount
+        while (low < high) {
+            val mid = (low + high) ushr 1
+            if (compareTerm(mid, word, prefix = false) < 0) low = mid + 1 else high = mid
+        }
+        return low
+    }
+
+    // With prefix, terms starting with word compare equal
+    private fun compareTerm(term: Int, word: String, prefix: Boolean): Int {
+        val entry = termTableOffset + term * TERM_SIZE
+        val offset = stringOffset + buffer.getInt(entry) * 2
+        val length = buffer.getInt(entry + 4)
+        val n = minOf(length, word.length)
+        for (i in 0 until n) {
+            val c = buffer.getChar(offset + i * 2)
+            if (c != word[i]) return c.compareTo(word[i])
+        }
+        if (prefix && length >= word.length) return 0
+        return length.compareTo(word.length)
+    }
+
+    private fun page(p: Int) = buffer.getInt(postingOffset + p * POSTING_SIZE)
+    private fun ordinal(p: Int) = buffer.getInt(postingOffset + p * POSTING_SIZE + 4)
+    private fun charIndex(p: Int) = buffer.getInt(postingOffset + p * POSTING_SIZE + 8)
+    private fun charCount(p: Int) = buffer.getShort(postingOffset + p * POSTING_SIZE + 12).toInt() and 0xFFFF
+
+    private fun box(p: Int): RectF {
+        val base = postingOffset + p * POSTING_SIZE + 14
+        return RectF(
+            buffer.getShort(base) / BOX_SCALE,
+            buffer.getShort(base + 2) / BOX_SCALE,
+            buffer.getShort(base + 4) / BOX_SCALE,
+            buffer.getShort(base + 6) / BOX_SCALE
+        )
+    }
+
+    /**
+     * Growable int array, to avoid boxing millions of posting indices.
+     */
+    private class IntList : Iterable<Int> {
+        private var values = IntArray(4)
+        var size = 0
+            private set
+
+        fun add(value: Int) {
+            if (size == values.size) values = values.copyOf(size * 2)
+            values[size++] = value
+        }
+
+        operator fun get(index: Int): Int = values[index]
+
+        override fun iterator(): Iterator<Int> = object : Iterator<Int> {
+            private var next = 0
+            override fun hasNext() = next < size
+            override fun next() = values[next++]
+        }
+    }
+
+    /**
+     * Postings collected during [build], in document order.
+     */
+    private class PostingWriter {
+        private val pages = IntList()
+        private val ordinals = IntList()
+        private val charIndices = IntList()
+        private val charCounts = IntList()
+        private val boxes = IntList()   // left/top/right/bottom in half points, two per int
+        val size: Int get() = pages.size
+
+        fun add(page: Int, ordinal: Int, start: Int, count: Int, charBoxes: FloatArray): Int {
+            var left = Float.MAX_VALUE
+            var top = -Float.MAX_VALUE
+            var right = -Float.MAX_VALUE
+            var bottom = Float.MAX_VALUE
+            for (i in start until start + count) {
+                if (i * 4 + 3 >= charBoxes.size) break
+                left = minOf(left, charBoxes[i * 4])
+                top = maxOf(top, charBoxes[i * 4 + 1])
+                right = maxOf(right, charBoxes[i * 4 + 2])
+                bottom = minOf(bottom, charBoxes[i * 4 + 3])
+            }
+            if (left > right) {
+                left = 0f; top = 0f; right = 0f; bottom = 0f
+            }
+            pages.add(page)
+            ordinals.add(ordinal)
+            charIndices.add(start)
+            charCounts.add(count.coerceAtMost(0xFFFF))
+            boxes.add(pack(left, top))
+            boxes.add(pack(right, bottom))
+            return size - 1
+        }
+
+        fun write(out: DataOutputStream, p: Int) {
+            out.writeInt(Integer.reverseBytes(pages[p]))
+            out.writeInt(Integer.reverseBytes(ordinals[p]))
+            out.writeInt(Integer.reverseBytes(charIndices[p]))
+            out.writeShort(java.lang.Short.reverseBytes(charCounts[p].toShort()).toInt())
+            for (half in 0..1) {
+                val packed = boxes[p * 2 + half]
+                out.writeShort(java.lang.Short.reverseBytes((packed shr 16).toShort()).toInt())
+                out.writeShort(java.lang.Short.reverseBytes(packed.toShort()).toInt())
+            }
+            out.writeShort(0)
+        }
+
+        private fun pack(a: Float, b: Float): Int = (quantize(a) shl 16) or (quantize(b) and 0xFFFF)
+
+        private fun quantize(value: Float): Int =
+            (value * BOX_SCALE).toInt().coerceIn(Short.MIN_VALUE.toInt(), Short.MAX_VALUE.toInt())
+    }
+}
@@ -0,0 +1,67 @@
+package com.hyntix.pdfium.search
+
+import android.os.CancellationSignal
+import com.hyntix.pdfium.PdfDocument
+import java.io.File
+import java.security.MessageDigest
+
+/**
+ * Directory of [PdfTextIndex] files keyed per document, so a document is
+ * indexed once and every later search, even in a new process, only maps a file.
+ *
+ * The default key is [PdfDocument.fileIdentifier], falling back to
+ * [PdfDocument.sourceFingerprint] for documents without a file ID. New and
+ * progressively loaded documents have neither and need an explicit key, such
+ * as a stable URI.
+ */
+class PdfTextIndexStore(private val directory: File) {
+
+    /**
+     * Open the stored index for [key], or null if there is none.
+     */
+    fun get(key: String): PdfTextIndex? = PdfTextIndex.open(fileFor(key))
+
+    /**
+     * Open the stored index for [document], building it first if it is missing
+     * or was built for a different page count. Building extracts the text of
+     * every page; call this off the main thread, for example right after opening
+     * the document.
+     *
+     * @return The index, or null if there is no key, or the build was cancelled or failed
+     */
+    fun getOrBuild(
+        document: PdfDocument,
+        key: String? = document.fileIdentifier ?: document.sourceFingerprint?.let { "source-$it" },
+        cancellationSignal: CancellationSignal? = null
+    ): PdfTextIndex? {
+        if (key == null) return null
+        val file = fileFor(key)
+        PdfTextIndex.open(file)?.let { index ->
+            if (index.pageCount == document.pageCount) return index
+            index.close()
+        }
+        directory.mkdirs()
+        return PdfTextIndex.build(document, file, cancellationSignal)
+    }
+
+    /**
+     * Delete the stored index for [key].
+     */
+    fun remove(key: String): Boolean = fileFor(key).delete()
+
+    /**
+     * Delete every stored index.
+     */
+    fun clear() {
+        directory.listFiles { f -> f.name.endsWith(SUFFIX) }?.forEach { it.delete() }
+    }
+
+    private fun fileFor(key: String): File {
+        val digest = MessageDigest.getInstance("SHA-1").digest(key.toByteArray())
+        return File(directory, digest.joinToString("") { "%02x".format(it) } + SUFFIX)
+    }
+
+    private companion object {
+        const val SUFFIX = ".idx"
+    }
+}